@@ -4,6 +4,9 @@
 // See the LICENSE file in the root of this repository for more details.
 
 #include "bitSerialBase.h"
+#include <fstream>
+#include <sstream>
+#include <cstdio>
 
 //! @brief  Create device
 void
@@ -60,3 +63,41 @@ bitSerialBase::runTests(const std::vector<std::string>& testList)
   return ok;
 }
 
+
+//! @brief  Get number of row reads, row writes and logic ops since last stats reset
+//!         Micro-ops are counted from command rows of a CSV stats export
+std::tuple<int, int, int>
+bitSerialBase::getMicroOpCounts() const
+{
+  const std::string fileName = "bitSerialStats.csv";
+  int numR = 0;
+  int numW = 0;
+  int numL = 0;
+  PimStatus status = pimExportStats(fileName.c_str(), PIM_STATS_CSV);
+  assert(status == PIM_OK);
+  std::ifstream file(fileName);
+  std::string line;
+  std::getline(file, line); // header
+  while (std::getline(file, line)) {
+    std::vector<std::string> fields;
+    std::stringstream ss(line);
+    std::string field;
+    while (std::getline(ss, field, ',')) {
+      fields.push_back(field);
+    }
+    if (fields.size() < 4 || fields[1] != "command") {
+      continue;
+    }
+    int count = std::stoi(fields[3]);
+    if (fields[2] == "row_r") {
+      numR += count;
+    } else if (fields[2] == "row_w") {
+      numW += count;
+    } else if (fields[2].find("rreg.") == 0) {
+      numL += count;
+    }
+  }
+  file.close();
+  std::remove(fileName.c_str());
+  return std::make_tuple(numR, numW, numL);
+}
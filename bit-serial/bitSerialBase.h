@@ -14,6 +14,7 @@
 #include <string>
 #include <map>
 #include <memory>
+#include <tuple>
 
 //! @class  bitSerialBase
 //! @brief  Bit-serial perf base class
@@ -27,6 +28,10 @@ public:
 
   const std::map<std::string, std::pair<int, int>>& getStats() const { return m_stats; }
 
+  // data type category -> op -> (#R, #W, #L) of passed micro-programs, collected if table generation is enabled
+  void setGenTable(bool genTable) { m_genTable = genTable; }
+  const std::map<std::string, std::map<std::string, std::tuple<int, int, int>>>& getPerfCounts() const { return m_perfCounts; }
+
 protected:
 
   // virtual: get device type
@@ -100,6 +105,7 @@ protected:
   void createDevice();
   void deleteDevice();
   bool getBit(uint64_t val, int nth) const { return (val >> nth) & 1; }
+  std::tuple<int, int, int> getMicroOpCounts() const;
 
   template <typename T> std::vector<T> getRandInt(uint64_t numElements, T min, T max, bool allowZero = true);
   template <typename T> std::vector<T> getRandFp(uint64_t numElements, T min, T max, bool allowZero = true);
@@ -107,7 +113,9 @@ protected:
   template <typename T> bool testFp(const std::string& category, PimDataType dataType);
 
   std::map<std::string, std::pair<int, int>> m_stats; // data type category -> (numPassed, numTests)
+  std::map<std::string, std::map<std::string, std::tuple<int, int, int>>> m_perfCounts;
   std::string m_deviceName;
+  bool m_genTable = false;
 };
 
 
@@ -364,6 +372,10 @@ bitSerialBase::testInt(const std::string& category, PimDataType dataType)
       }
     }
 
+    std::tuple<int, int, int> counts;
+    if (m_genTable) {
+      counts = getMicroOpCounts();
+    }
     pimShowStats();
 
     pimCopyDeviceToHost(dest1, (void*)vecDestVerify.data());
@@ -407,6 +419,9 @@ bitSerialBase::testInt(const std::string& category, PimDataType dataType)
     std::cout << tag << " End " << (ok ? " -- Succeeded" : " -- Failed!") << std::endl;
     if (ok) {
       numPassed++;
+      if (m_genTable) {
+        m_perfCounts[category][testNames[testId]] = counts;
+      }
     }
   }
 
@@ -508,6 +523,10 @@ bitSerialBase::testFp(const std::string& category, PimDataType dataType)
       }
     }
 
+    std::tuple<int, int, int> counts;
+    if (m_genTable) {
+      counts = getMicroOpCounts();
+    }
     pimShowStats();
 
     pimCopyDeviceToHost(dest1, (void*)vecDestVerify.data());
@@ -546,6 +565,9 @@ bitSerialBase::testFp(const std::string& category, PimDataType dataType)
     std::cout << tag << " End " << (ok ? " -- Succeeded" : " -- Failed!") << std::endl;
     if (ok) {
       numPassed++;
+      if (m_genTable) {
+        m_perfCounts[category][testNames[testId]] = counts;
+      }
     }
   }
 
@@ -18,11 +18,11 @@ bitSerialBitsimd::bitSerialIntAbs(int numBits, PimObjId src, PimObjId dest)
   pimOpMove(src, PIM_RREG_SA, PIM_RREG_R2);
   for (int i = 0; i < numBits; ++i) {
     pimOpReadRowToSa(src, i);
-    pimOpXor(src, PIM_RREG_SA, PIM_RREG_R2, PIM_RREG_SA);
-    pimOpXor(src, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_SA);
+    implOpXor(src, PIM_RREG_SA, PIM_RREG_R2, PIM_RREG_SA);
+    implOpXor(src, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_SA);
     pimOpWriteSaToRow(dest, i);
-    pimOpNot(src, PIM_RREG_SA, PIM_RREG_SA);
-    pimOpAnd(src, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R1);
+    implOpNot(src, PIM_RREG_SA, PIM_RREG_SA);
+    implOpAnd(src, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R1);
   }
 }
 
@@ -51,9 +51,9 @@ bitSerialBitsimd::bitSerialIntPopCount(int numBits, PimObjId src, PimObjId dest)
     pimOpMove(src, PIM_RREG_SA, PIM_RREG_R1);
     pimOpReadRowToSa(src, i + 1);
     pimOpMove(src, PIM_RREG_SA, PIM_RREG_R2);
-    pimOpXor(src, PIM_RREG_R1, PIM_RREG_R2, PIM_RREG_SA);
+    implOpXor(src, PIM_RREG_R1, PIM_RREG_R2, PIM_RREG_SA);
     pimOpWriteSaToRow(dest, i);
-    pimOpAnd(src, PIM_RREG_R1, PIM_RREG_R2, PIM_RREG_SA);
+    implOpAnd(src, PIM_RREG_R1, PIM_RREG_R2, PIM_RREG_SA);
     pimOpWriteSaToRow(dest, i + 1);
   }
 
@@ -63,10 +63,10 @@ bitSerialBitsimd::bitSerialIntPopCount(int numBits, PimObjId src, PimObjId dest)
       pimOpSet(src, PIM_RREG_R1, 0);
       for (int j = 0; j < iter; ++j) {
         pimOpReadRowToSa(dest, i + j);
-        pimOpXor(src, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R2);
+        implOpXor(src, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R2);
         pimOpReadRowToSa(dest, i + (1 << (iter - 1)) + j);
-        pimOpSel(src, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R1);
-        pimOpXor(src, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_SA);
+        implOpSel(src, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R1);
+        implOpXor(src, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_SA);
         pimOpWriteSaToRow(dest, i + j);
       }
       pimOpMove(src, PIM_RREG_R1, PIM_RREG_SA);
@@ -102,10 +102,10 @@ bitSerialBitsimd::implIntAdd(int numBits, PimObjId src1, PimObjId src2, PimObjId
   pimOpSet(src1, PIM_RREG_R1, 0);
   for (int i = 0; i < numBits; ++i) {
     pimOpReadRowToSa(src1, i);
-    pimOpXor(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R2);
+    implOpXor(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R2);
     implReadRowOrScalar(src2, i, useScalar, scalarVal);
-    pimOpSel(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R1);
-    pimOpXor(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_SA);
+    implOpSel(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R1);
+    implOpXor(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_SA);
     pimOpWriteSaToRow(dest, i);
   }
 }
@@ -131,10 +131,10 @@ bitSerialBitsimd::implIntSub(int numBits, PimObjId src1, PimObjId src2, PimObjId
   pimOpSet(src1, PIM_RREG_R1, 0);
   for (int i = 0; i < numBits; ++i) {
     pimOpReadRowToSa(src1, i);
-    pimOpXor(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R2);
+    implOpXor(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R2);
     implReadRowOrScalar(src2, i, useScalar, scalarVal);
-    pimOpSel(src1, PIM_RREG_R2, PIM_RREG_R1, PIM_RREG_SA, PIM_RREG_R1);
-    pimOpXor(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_SA);
+    implOpSel(src1, PIM_RREG_R2, PIM_RREG_R1, PIM_RREG_SA, PIM_RREG_R1);
+    implOpXor(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_SA);
     pimOpWriteSaToRow(dest, i);
   }
 }
@@ -168,7 +168,7 @@ bitSerialBitsimd::implIntMul3Reg(int numBits, PimObjId src1, PimObjId src2, PimO
   pimOpSet(src1, PIM_RREG_R1, 0);
   for (int i = 0; i < numBits; ++i) {
     implReadRowOrScalar(src2, i, useScalar, scalarVal);
-    pimOpSel(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_SA);
+    implOpSel(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_SA);
     pimOpWriteSaToRow(dest, i);
   }
 
@@ -177,10 +177,10 @@ bitSerialBitsimd::implIntMul3Reg(int numBits, PimObjId src1, PimObjId src2, PimO
     pimOpSet(src1, PIM_RREG_R1, 0);
     for (int j = 0; i + j < numBits; ++j) {
       pimOpReadRowToSa(dest, i + j);
-      pimOpXor(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R2);
+      implOpXor(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R2);
       implReadRowOrScalar(src2, j, useScalar, scalarVal);
-      pimOpSel(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R1);
-      pimOpXor(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_SA);
+      implOpSel(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R1);
+      implOpXor(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_SA);
       pimOpWriteSaToRow(tmp, j);
     }
     pimOpReadRowToSa(src1, i);
@@ -189,7 +189,7 @@ bitSerialBitsimd::implIntMul3Reg(int numBits, PimObjId src1, PimObjId src2, PimO
       pimOpReadRowToSa(dest, i + j);
       pimOpMove(src1, PIM_RREG_SA, PIM_RREG_R1);
       pimOpReadRowToSa(tmp, j);
-      pimOpSel(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_SA);
+      implOpSel(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_SA);
       pimOpWriteSaToRow(dest, i + j);
     }
   }
@@ -208,7 +208,7 @@ bitSerialBitsimd::implIntMul4Reg(int numBits, PimObjId src1, PimObjId src2, PimO
   pimOpSet(src1, PIM_RREG_R1, 0);
   for (int i = 0; i < numBits; ++i) {
     implReadRowOrScalar(src2, i, useScalar, scalarVal);
-    pimOpSel(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_SA);
+    implOpSel(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_SA);
     pimOpWriteSaToRow(dest, i);
   }
 
@@ -221,12 +221,12 @@ bitSerialBitsimd::implIntMul4Reg(int numBits, PimObjId src1, PimObjId src2, PimO
     for (int j = 0; i + j < numBits; ++j) {
       // add
       implReadRowOrScalar(src2, j, useScalar, scalarVal);
-      pimOpXor(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R2);
+      implOpXor(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R2);
       pimOpReadRowToSa(dest, i + j);
-      pimOpSel(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R1);
-      pimOpXor(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_R2);
+      implOpSel(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R1);
+      implOpXor(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_R2);
       // cond write
-      pimOpSel(src1, PIM_RREG_R3, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_SA);
+      implOpSel(src1, PIM_RREG_R3, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_SA);
       pimOpWriteSaToRow(dest, i + j);
     }
   }
@@ -289,17 +289,17 @@ bitSerialBitsimd::implIntDivRem(int numBits, PimObjId src1, PimObjId src2, PimOb
   pimOpReadRowToSa(src1, numBits - 1);
   pimOpMove(src1, PIM_RREG_SA, PIM_RREG_R1);
   implReadRowOrScalar(src2, numBits - 1, useScalar, scalarVal);
-  pimOpXor(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R1);
+  implOpXor(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R1);
 
   // sign ext
   pimOpMove(src1, PIM_RREG_R1, PIM_RREG_R2);
   for (int i = 0; i < numBits; ++i) {
     pimOpReadRowToSa(dest, i);
-    pimOpXor(src1, PIM_RREG_SA, PIM_RREG_R2, PIM_RREG_SA);
-    pimOpXor(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_SA);
+    implOpXor(src1, PIM_RREG_SA, PIM_RREG_R2, PIM_RREG_SA);
+    implOpXor(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_SA);
     pimOpWriteSaToRow(dest, i);
-    pimOpNot(src1, PIM_RREG_SA, PIM_RREG_SA);
-    pimOpAnd(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R1);
+    implOpNot(src1, PIM_RREG_SA, PIM_RREG_SA);
+    implOpAnd(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R1);
   }
 
   pimFree(abs1);
@@ -331,15 +331,15 @@ bitSerialBitsimd::implUintDivRem(int numBits, PimObjId src1, PimObjId src2, PimO
     pimOpSet(src1, PIM_RREG_R1, 0);
     for (int j = 0; j < numBits; ++j) {
       pimOpReadRowToSa(qr, numBits - 1 - i + j);
-      pimOpXor(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R2);
+      implOpXor(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R2);
       implReadRowOrScalar(src2, j, useScalar, scalarVal);
-      pimOpSel(src1, PIM_RREG_R2, PIM_RREG_R1, PIM_RREG_SA, PIM_RREG_R1);
-      pimOpXor(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_SA);
+      implOpSel(src1, PIM_RREG_R2, PIM_RREG_R1, PIM_RREG_SA, PIM_RREG_R1);
+      implOpXor(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_SA);
       pimOpWriteSaToRow(tmp, j);
     }
 
     // update quotient
-    pimOpNot(src1, PIM_RREG_R1, PIM_RREG_R1);
+    implOpNot(src1, PIM_RREG_R1, PIM_RREG_R1);
     pimOpMove(src1, PIM_RREG_R1, PIM_RREG_SA);
     pimOpWriteSaToRow(qr, numBits * 2 - 1 - i);
 
@@ -349,7 +349,7 @@ bitSerialBitsimd::implUintDivRem(int numBits, PimObjId src1, PimObjId src2, PimO
       pimOpReadRowToSa(tmp, j);
       pimOpMove(src1, PIM_RREG_SA, PIM_RREG_R1);
       pimOpReadRowToSa(qr, numBits - 1 - i + j);
-      pimOpSel(src1, PIM_RREG_R2, PIM_RREG_R1, PIM_RREG_SA, PIM_RREG_SA);
+      implOpSel(src1, PIM_RREG_R2, PIM_RREG_R1, PIM_RREG_SA, PIM_RREG_SA);
       pimOpWriteSaToRow(qr, numBits - 1 - i + j);
     }
   }
@@ -386,7 +386,7 @@ bitSerialBitsimd::implIntAnd(int numBits, PimObjId src1, PimObjId src2, PimObjId
     pimOpReadRowToSa(src1, i);
     pimOpMove(src1, PIM_RREG_SA, PIM_RREG_R1);
     implReadRowOrScalar(src2, i, useScalar, scalarVal);
-    pimOpAnd(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_SA);
+    implOpAnd(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_SA);
     pimOpWriteSaToRow(dest, i);
   }
 }
@@ -413,7 +413,7 @@ bitSerialBitsimd::implIntOr(int numBits, PimObjId src1, PimObjId src2, PimObjId
     pimOpReadRowToSa(src1, i);
     pimOpMove(src1, PIM_RREG_SA, PIM_RREG_R1);
     implReadRowOrScalar(src2, i, useScalar, scalarVal);
-    pimOpOr(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_SA);
+    implOpOr(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_SA);
     pimOpWriteSaToRow(dest, i);
   }
 }
@@ -440,7 +440,7 @@ bitSerialBitsimd::implIntXor(int numBits, PimObjId src1, PimObjId src2, PimObjId
     pimOpReadRowToSa(src1, i);
     pimOpMove(src1, PIM_RREG_SA, PIM_RREG_R1);
     implReadRowOrScalar(src2, i, useScalar, scalarVal);
-    pimOpXor(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_SA);
+    implOpXor(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_SA);
     pimOpWriteSaToRow(dest, i);
   }
 }
@@ -467,8 +467,8 @@ bitSerialBitsimd::implIntXnor(int numBits, PimObjId src1, PimObjId src2, PimObjI
     pimOpReadRowToSa(src1, i);
     pimOpMove(src1, PIM_RREG_SA, PIM_RREG_R1);
     implReadRowOrScalar(src2, i, useScalar, scalarVal);
-    pimOpXor(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_SA);
-    pimOpNot(src1, PIM_RREG_SA, PIM_RREG_SA);
+    implOpXor(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_SA);
+    implOpNot(src1, PIM_RREG_SA, PIM_RREG_SA);
     pimOpWriteSaToRow(dest, i);
   }
 }
@@ -495,17 +495,17 @@ bitSerialBitsimd::implIntGT(int numBits, PimObjId src1, PimObjId src2, PimObjId
   pimOpSet(src1, PIM_RREG_R1, 0);
   for (int i = 0; i < numBits - 1; ++i) {
     implReadRowOrScalar(src2, i, useScalar, scalarVal);
-    pimOpXor(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R2);
+    implOpXor(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R2);
     pimOpReadRowToSa(src1, i);
-    pimOpNot(src1, PIM_RREG_R2, PIM_RREG_R2);
-    pimOpSel(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R1);
+    implOpNot(src1, PIM_RREG_R2, PIM_RREG_R2);
+    implOpSel(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R1);
   }
   // handle sign bit
   pimOpReadRowToSa(src1, numBits - 1);
   pimOpMove(src1, PIM_RREG_SA, PIM_RREG_R2);
   implReadRowOrScalar(src2, numBits - 1, useScalar, scalarVal);
-  pimOpXor(src1, PIM_RREG_SA, PIM_RREG_R2, PIM_RREG_R2);
-  pimOpSel(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_SA);
+  implOpXor(src1, PIM_RREG_SA, PIM_RREG_R2, PIM_RREG_R2);
+  implOpSel(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_SA);
   pimOpWriteSaToRow(dest, 0);
 
   // set other bits of dest to 0
@@ -534,10 +534,10 @@ bitSerialBitsimd::implUIntGT(int numBits, PimObjId src1, PimObjId src2, PimObjId
   pimOpSet(src1, PIM_RREG_R1, 0);
   for (int i = 0; i < numBits; ++i) {
     implReadRowOrScalar(src2, i, useScalar, scalarVal);
-    pimOpXor(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R2);
+    implOpXor(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R2);
     pimOpReadRowToSa(src1, i);
-    pimOpNot(src1, PIM_RREG_R2, PIM_RREG_R2);
-    pimOpSel(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R1);
+    implOpNot(src1, PIM_RREG_R2, PIM_RREG_R2);
+    implOpSel(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R1);
   }
   pimOpMove(src1, PIM_RREG_R1, PIM_RREG_SA);
   pimOpWriteSaToRow(dest, 0);
@@ -571,17 +571,17 @@ bitSerialBitsimd::implIntLT(int numBits, PimObjId src1, PimObjId src2, PimObjId
   pimOpSet(src1, PIM_RREG_R1, 0);
   for (int i = 0; i < numBits - 1; ++i) {
     pimOpReadRowToSa(src1, i);
-    pimOpXor(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R2);
+    implOpXor(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R2);
     implReadRowOrScalar(src2, i, useScalar, scalarVal);
-    pimOpNot(src1, PIM_RREG_R2, PIM_RREG_R2);
-    pimOpSel(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R1);
+    implOpNot(src1, PIM_RREG_R2, PIM_RREG_R2);
+    implOpSel(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R1);
   }
   // handle sign bit
   implReadRowOrScalar(src2, numBits - 1, useScalar, scalarVal);
   pimOpMove(src1, PIM_RREG_SA, PIM_RREG_R2);
   pimOpReadRowToSa(src1, numBits - 1);
-  pimOpXor(src1, PIM_RREG_SA, PIM_RREG_R2, PIM_RREG_R2);
-  pimOpSel(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_SA);
+  implOpXor(src1, PIM_RREG_SA, PIM_RREG_R2, PIM_RREG_R2);
+  implOpSel(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_SA);
   pimOpWriteSaToRow(dest, 0);
 
   // set other bits of dest to 0
@@ -610,10 +610,10 @@ bitSerialBitsimd::implUIntLT(int numBits, PimObjId src1, PimObjId src2, PimObjId
   pimOpSet(src1, PIM_RREG_R1, 0);
   for (int i = 0; i < numBits; ++i) {
     pimOpReadRowToSa(src1, i);
-    pimOpXor(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R2);
+    implOpXor(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R2);
     implReadRowOrScalar(src2, i, useScalar, scalarVal);
-    pimOpNot(src1, PIM_RREG_R2, PIM_RREG_R2);
-    pimOpSel(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R1);
+    implOpNot(src1, PIM_RREG_R2, PIM_RREG_R2);
+    implOpSel(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R1);
   }
   pimOpMove(src1, PIM_RREG_R1, PIM_RREG_SA);
   pimOpWriteSaToRow(dest, 0);
@@ -648,10 +648,10 @@ bitSerialBitsimd::implIntEQ(int numBits, PimObjId src1, PimObjId src2, PimObjId
     pimOpReadRowToSa(src1, i);
     pimOpMove(src1, PIM_RREG_SA, PIM_RREG_R1);
     implReadRowOrScalar(src2, i, useScalar, scalarVal);
-    pimOpXor(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R1);
-    pimOpOr(src1, PIM_RREG_R2, PIM_RREG_R1, PIM_RREG_R2);
+    implOpXor(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R1);
+    implOpOr(src1, PIM_RREG_R2, PIM_RREG_R1, PIM_RREG_R2);
   }
-  pimOpNot(src1, PIM_RREG_R2, PIM_RREG_SA);
+  implOpNot(src1, PIM_RREG_R2, PIM_RREG_SA);
   pimOpWriteSaToRow(dest, 0);
 
   // set other bits of dest to 0
@@ -683,23 +683,23 @@ bitSerialBitsimd::implIntMin(int numBits, PimObjId src1, PimObjId src2, PimObjId
   pimOpSet(src1, PIM_RREG_R1, 0);
   for (int i = 0; i < numBits - 1; ++i) {
     pimOpReadRowToSa(src1, i);
-    pimOpXor(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R2);
+    implOpXor(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R2);
     implReadRowOrScalar(src2, i, useScalar, scalarVal);
-    pimOpNot(src1, PIM_RREG_R2, PIM_RREG_R2);
-    pimOpSel(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R1);
+    implOpNot(src1, PIM_RREG_R2, PIM_RREG_R2);
+    implOpSel(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R1);
   }
   implReadRowOrScalar(src2, numBits - 1, useScalar, scalarVal);
   pimOpMove(src1, PIM_RREG_SA, PIM_RREG_R2);
   pimOpReadRowToSa(src1, numBits - 1);
-  pimOpXor(src1, PIM_RREG_SA, PIM_RREG_R2, PIM_RREG_R2);
-  pimOpSel(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R2);
+  implOpXor(src1, PIM_RREG_SA, PIM_RREG_R2, PIM_RREG_R2);
+  implOpSel(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R2);
 
   // if-else copy
   for (int i = 0; i < numBits; ++i) {
     pimOpReadRowToSa(src1, i);
     pimOpMove(src1, PIM_RREG_SA, PIM_RREG_R1);
     implReadRowOrScalar(src2, i, useScalar, scalarVal);
-    pimOpSel(src1, PIM_RREG_R2, PIM_RREG_R1, PIM_RREG_SA, PIM_RREG_SA);
+    implOpSel(src1, PIM_RREG_R2, PIM_RREG_R1, PIM_RREG_SA, PIM_RREG_SA);
     pimOpWriteSaToRow(dest, i);
   }
 }
@@ -723,10 +723,10 @@ bitSerialBitsimd::implUIntMin(int numBits, PimObjId src1, PimObjId src2, PimObjI
   pimOpSet(src1, PIM_RREG_R1, 0);
   for (int i = 0; i < numBits; ++i) {
     pimOpReadRowToSa(src1, i);
-    pimOpXor(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R2);
+    implOpXor(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R2);
     implReadRowOrScalar(src2, i, useScalar, scalarVal);
-    pimOpNot(src1, PIM_RREG_R2, PIM_RREG_R2);
-    pimOpSel(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R1);
+    implOpNot(src1, PIM_RREG_R2, PIM_RREG_R2);
+    implOpSel(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R1);
   }
   pimOpMove(src1, PIM_RREG_R1, PIM_RREG_R2);
 
@@ -735,7 +735,7 @@ bitSerialBitsimd::implUIntMin(int numBits, PimObjId src1, PimObjId src2, PimObjI
     pimOpReadRowToSa(src1, i);
     pimOpMove(src1, PIM_RREG_SA, PIM_RREG_R1);
     implReadRowOrScalar(src2, i, useScalar, scalarVal);
-    pimOpSel(src1, PIM_RREG_R2, PIM_RREG_R1, PIM_RREG_SA, PIM_RREG_SA);
+    implOpSel(src1, PIM_RREG_R2, PIM_RREG_R1, PIM_RREG_SA, PIM_RREG_SA);
     pimOpWriteSaToRow(dest, i);
   }
 }
@@ -762,23 +762,23 @@ bitSerialBitsimd::implIntMax(int numBits, PimObjId src1, PimObjId src2, PimObjId
   pimOpSet(src1, PIM_RREG_R1, 0);
   for (int i = 0; i < numBits - 1; ++i) {
     implReadRowOrScalar(src2, i, useScalar, scalarVal);
-    pimOpXor(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R2);
+    implOpXor(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R2);
     pimOpReadRowToSa(src1, i);
-    pimOpNot(src1, PIM_RREG_R2, PIM_RREG_R2);
-    pimOpSel(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R1);
+    implOpNot(src1, PIM_RREG_R2, PIM_RREG_R2);
+    implOpSel(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R1);
   }
   pimOpReadRowToSa(src1, numBits - 1);
   pimOpMove(src1, PIM_RREG_SA, PIM_RREG_R2);
   implReadRowOrScalar(src2, numBits - 1, useScalar, scalarVal);
-  pimOpXor(src1, PIM_RREG_SA, PIM_RREG_R2, PIM_RREG_R2);
-  pimOpSel(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R2);
+  implOpXor(src1, PIM_RREG_SA, PIM_RREG_R2, PIM_RREG_R2);
+  implOpSel(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R2);
 
   // if-else copy
   for (int i = 0; i < numBits; ++i) {
     pimOpReadRowToSa(src1, i);
     pimOpMove(src1, PIM_RREG_SA, PIM_RREG_R1);
     implReadRowOrScalar(src2, i, useScalar, scalarVal);
-    pimOpSel(src1, PIM_RREG_R2, PIM_RREG_R1, PIM_RREG_SA, PIM_RREG_SA);
+    implOpSel(src1, PIM_RREG_R2, PIM_RREG_R1, PIM_RREG_SA, PIM_RREG_SA);
     pimOpWriteSaToRow(dest, i);
   }
 }
@@ -801,10 +801,10 @@ bitSerialBitsimd::implUIntMax(int numBits, PimObjId src1, PimObjId src2, PimObjI
   pimOpSet(src1, PIM_RREG_R1, 0);
   for (int i = 0; i < numBits; ++i) {
     implReadRowOrScalar(src2, i, useScalar, scalarVal);
-    pimOpXor(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R2);
+    implOpXor(src1, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R2);
     pimOpReadRowToSa(src1, i);
-    pimOpNot(src1, PIM_RREG_R2, PIM_RREG_R2);
-    pimOpSel(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R1);
+    implOpNot(src1, PIM_RREG_R2, PIM_RREG_R2);
+    implOpSel(src1, PIM_RREG_R2, PIM_RREG_SA, PIM_RREG_R1, PIM_RREG_R1);
   }
   pimOpMove(src1, PIM_RREG_R1, PIM_RREG_R2);
 
@@ -813,7 +813,7 @@ bitSerialBitsimd::implUIntMax(int numBits, PimObjId src1, PimObjId src2, PimObjI
     pimOpReadRowToSa(src1, i);
     pimOpMove(src1, PIM_RREG_SA, PIM_RREG_R1);
     implReadRowOrScalar(src2, i, useScalar, scalarVal);
-    pimOpSel(src1, PIM_RREG_R2, PIM_RREG_R1, PIM_RREG_SA, PIM_RREG_SA);
+    implOpSel(src1, PIM_RREG_R2, PIM_RREG_R1, PIM_RREG_SA, PIM_RREG_SA);
     pimOpWriteSaToRow(dest, i);
   }
 }
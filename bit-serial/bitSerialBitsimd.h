@@ -69,6 +69,13 @@ protected:
   virtual void bitSerialUIntMinScalar(int numBits, PimObjId src1, PimObjId dest, uint64_t scalarVal) override;
   virtual void bitSerialUIntMaxScalar(int numBits, PimObjId src1, PimObjId dest, uint64_t scalarVal) override;
 
+  // virtual: logic micro-ops. Devices with other logic families emulate them with R4 and R5 as temporaries.
+  virtual void implOpNot(PimObjId objId, PimRowReg src, PimRowReg dest) { pimOpNot(objId, src, dest); }
+  virtual void implOpAnd(PimObjId objId, PimRowReg src1, PimRowReg src2, PimRowReg dest) { pimOpAnd(objId, src1, src2, dest); }
+  virtual void implOpOr(PimObjId objId, PimRowReg src1, PimRowReg src2, PimRowReg dest) { pimOpOr(objId, src1, src2, dest); }
+  virtual void implOpXor(PimObjId objId, PimRowReg src1, PimRowReg src2, PimRowReg dest) { pimOpXor(objId, src1, src2, dest); }
+  virtual void implOpSel(PimObjId objId, PimRowReg cond, PimRowReg src1, PimRowReg src2, PimRowReg dest) { pimOpSel(objId, cond, src1, src2, dest); }
+
 private:
   void implIntAdd(int numBits, PimObjId src1, PimObjId src2, PimObjId dest, bool useScalar, uint64_t scalarVal);
   void implIntSub(int numBits, PimObjId src1, PimObjId src2, PimObjId dest, bool useScalar, uint64_t scalarVal);
@@ -0,0 +1,47 @@
+// Bit-Serial Performance Modeling - BitSIMD_V_MAJ
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "bitSerialBitsimdMaj.h"
+
+//! @brief  AND(a, b) = MAJ(a, b, 0)
+void
+bitSerialBitsimdMaj::implOpAnd(PimObjId objId, PimRowReg src1, PimRowReg src2, PimRowReg dest)
+{
+  pimOpSet(objId, PIM_RREG_R4, 0);
+  pimOpMaj(objId, src1, src2, PIM_RREG_R4, dest);
+}
+
+//! @brief  OR(a, b) = MAJ(a, b, 1)
+void
+bitSerialBitsimdMaj::implOpOr(PimObjId objId, PimRowReg src1, PimRowReg src2, PimRowReg dest)
+{
+  pimOpSet(objId, PIM_RREG_R4, 1);
+  pimOpMaj(objId, src1, src2, PIM_RREG_R4, dest);
+}
+
+//! @brief  XOR(a, b) = MAJ(NOT MAJ(a, b, 0), MAJ(a, b, 1), 0). Inputs are consumed before dest is used as constant.
+void
+bitSerialBitsimdMaj::implOpXor(PimObjId objId, PimRowReg src1, PimRowReg src2, PimRowReg dest)
+{
+  pimOpSet(objId, PIM_RREG_R4, 0);
+  pimOpMaj(objId, src1, src2, PIM_RREG_R4, PIM_RREG_R4);
+  pimOpNot(objId, PIM_RREG_R4, PIM_RREG_R4);
+  pimOpSet(objId, PIM_RREG_R5, 1);
+  pimOpMaj(objId, src1, src2, PIM_RREG_R5, PIM_RREG_R5);
+  pimOpSet(objId, dest, 0);
+  pimOpMaj(objId, PIM_RREG_R4, PIM_RREG_R5, dest, dest);
+}
+
+//! @brief  SEL(c, a, b) = MAJ(NOT MAJ(c, a, 1), MAJ(c, b, 1), a)
+void
+bitSerialBitsimdMaj::implOpSel(PimObjId objId, PimRowReg cond, PimRowReg src1, PimRowReg src2, PimRowReg dest)
+{
+  pimOpSet(objId, PIM_RREG_R4, 1);
+  pimOpMaj(objId, cond, src1, PIM_RREG_R4, PIM_RREG_R4);
+  pimOpNot(objId, PIM_RREG_R4, PIM_RREG_R4);
+  pimOpSet(objId, PIM_RREG_R5, 1);
+  pimOpMaj(objId, cond, src2, PIM_RREG_R5, PIM_RREG_R5);
+  pimOpMaj(objId, PIM_RREG_R4, PIM_RREG_R5, src1, dest);
+}
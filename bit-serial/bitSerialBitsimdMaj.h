@@ -0,0 +1,39 @@
+// Bit-Serial Performance Modeling - BitSIMD_V_MAJ
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#ifndef BIT_SERIAL_BITSIMD_MAJ_H
+#define BIT_SERIAL_BITSIMD_MAJ_H
+
+#include "bitSerialBitsimd.h"
+#include "libpimeval.h"
+
+//! @class  bitSerialBitsimdMaj
+//! @brief  Bit-serial perf for BitSIMD_V_MAJ
+//!
+//! Instruction set: read/write/move/set + NOT/MAJ
+//! Bit registers: SA, R1, R2, R3, with R4 and R5 as temporaries of logic emulation
+//!
+//! Reuses BitSIMD-V micro-programs, with AND/OR/XOR/SEL emulated by MAJ gates with constant registers
+//!
+class bitSerialBitsimdMaj : public bitSerialBitsimd
+{
+public:
+  bitSerialBitsimdMaj() { m_deviceName = "bitsimd_v_maj"; }
+  ~bitSerialBitsimdMaj() {}
+
+protected:
+
+  // virtual: create device
+  virtual PimDeviceEnum getDeviceType() override { return PIM_DEVICE_BITSIMD_V_MAJ; }
+
+  // virtual: logic micro-ops
+  virtual void implOpAnd(PimObjId objId, PimRowReg src1, PimRowReg src2, PimRowReg dest) override;
+  virtual void implOpOr(PimObjId objId, PimRowReg src1, PimRowReg src2, PimRowReg dest) override;
+  virtual void implOpXor(PimObjId objId, PimRowReg src1, PimRowReg src2, PimRowReg dest) override;
+  virtual void implOpSel(PimObjId objId, PimRowReg cond, PimRowReg src1, PimRowReg src2, PimRowReg dest) override;
+};
+
+#endif
+
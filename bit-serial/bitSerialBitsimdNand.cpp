@@ -0,0 +1,50 @@
+// Bit-Serial Performance Modeling - BitSIMD_V_NAND
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "bitSerialBitsimdNand.h"
+
+//! @brief  NOT a = NAND(a, a)
+void
+bitSerialBitsimdNand::implOpNot(PimObjId objId, PimRowReg src, PimRowReg dest)
+{
+  pimOpNand(objId, src, src, dest);
+}
+
+//! @brief  AND(a, b) = NOT NAND(a, b)
+void
+bitSerialBitsimdNand::implOpAnd(PimObjId objId, PimRowReg src1, PimRowReg src2, PimRowReg dest)
+{
+  pimOpNand(objId, src1, src2, PIM_RREG_R4);
+  pimOpNand(objId, PIM_RREG_R4, PIM_RREG_R4, dest);
+}
+
+//! @brief  OR(a, b) = NAND(NOT a, NOT b)
+void
+bitSerialBitsimdNand::implOpOr(PimObjId objId, PimRowReg src1, PimRowReg src2, PimRowReg dest)
+{
+  pimOpNand(objId, src1, src1, PIM_RREG_R4);
+  pimOpNand(objId, src2, src2, PIM_RREG_R5);
+  pimOpNand(objId, PIM_RREG_R4, PIM_RREG_R5, dest);
+}
+
+//! @brief  XOR(a, b) = NAND(NAND(a, t), NAND(b, t)), where t = NAND(a, b)
+void
+bitSerialBitsimdNand::implOpXor(PimObjId objId, PimRowReg src1, PimRowReg src2, PimRowReg dest)
+{
+  pimOpNand(objId, src1, src2, PIM_RREG_R4);
+  pimOpNand(objId, src1, PIM_RREG_R4, PIM_RREG_R5);
+  pimOpNand(objId, src2, PIM_RREG_R4, PIM_RREG_R4);
+  pimOpNand(objId, PIM_RREG_R4, PIM_RREG_R5, dest);
+}
+
+//! @brief  SEL(c, a, b) = NAND(NAND(c, a), NAND(NOT c, b))
+void
+bitSerialBitsimdNand::implOpSel(PimObjId objId, PimRowReg cond, PimRowReg src1, PimRowReg src2, PimRowReg dest)
+{
+  pimOpNand(objId, cond, cond, PIM_RREG_R5);
+  pimOpNand(objId, PIM_RREG_R5, src2, PIM_RREG_R5);
+  pimOpNand(objId, cond, src1, PIM_RREG_R4);
+  pimOpNand(objId, PIM_RREG_R4, PIM_RREG_R5, dest);
+}
@@ -0,0 +1,40 @@
+// Bit-Serial Performance Modeling - BitSIMD_V_NAND
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#ifndef BIT_SERIAL_BITSIMD_NAND_H
+#define BIT_SERIAL_BITSIMD_NAND_H
+
+#include "bitSerialBitsimd.h"
+#include "libpimeval.h"
+
+//! @class  bitSerialBitsimdNand
+//! @brief  Bit-serial perf for BitSIMD_V_NAND
+//!
+//! Instruction set: read/write/move/set + NAND
+//! Bit registers: SA, R1, R2, R3, with R4 and R5 as temporaries of logic emulation
+//!
+//! Reuses BitSIMD-V micro-programs, with NOT/AND/OR/XOR/SEL emulated by NAND gates
+//!
+class bitSerialBitsimdNand : public bitSerialBitsimd
+{
+public:
+  bitSerialBitsimdNand() { m_deviceName = "bitsimd_v_nand"; }
+  ~bitSerialBitsimdNand() {}
+
+protected:
+
+  // virtual: create device
+  virtual PimDeviceEnum getDeviceType() override { return PIM_DEVICE_BITSIMD_V_NAND; }
+
+  // virtual: logic micro-ops
+  virtual void implOpNot(PimObjId objId, PimRowReg src, PimRowReg dest) override;
+  virtual void implOpAnd(PimObjId objId, PimRowReg src1, PimRowReg src2, PimRowReg dest) override;
+  virtual void implOpOr(PimObjId objId, PimRowReg src1, PimRowReg src2, PimRowReg dest) override;
+  virtual void implOpXor(PimObjId objId, PimRowReg src1, PimRowReg src2, PimRowReg dest) override;
+  virtual void implOpSel(PimObjId objId, PimRowReg cond, PimRowReg src1, PimRowReg src2, PimRowReg dest) override;
+};
+
+#endif
+
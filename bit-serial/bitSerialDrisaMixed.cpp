@@ -0,0 +1,26 @@
+// Bit-Serial Performance Modeling - DRISA_MIXED
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "bitSerialDrisaMixed.h"
+
+//! @brief  XOR(a, b) = AND(NOT AND(a, b), OR(a, b))
+void
+bitSerialDrisaMixed::implOpXor(PimObjId objId, PimRowReg src1, PimRowReg src2, PimRowReg dest)
+{
+  pimOpAnd(objId, src1, src2, PIM_RREG_R4);
+  pimOpNot(objId, PIM_RREG_R4, PIM_RREG_R4);
+  pimOpOr(objId, src1, src2, PIM_RREG_R5);
+  pimOpAnd(objId, PIM_RREG_R4, PIM_RREG_R5, dest);
+}
+
+//! @brief  SEL(c, a, b) = OR(AND(c, a), NOR(c, NOT b))
+void
+bitSerialDrisaMixed::implOpSel(PimObjId objId, PimRowReg cond, PimRowReg src1, PimRowReg src2, PimRowReg dest)
+{
+  pimOpAnd(objId, cond, src1, PIM_RREG_R4);
+  pimOpNot(objId, src2, PIM_RREG_R5);
+  pimOpNor(objId, cond, PIM_RREG_R5, PIM_RREG_R5);
+  pimOpOr(objId, PIM_RREG_R4, PIM_RREG_R5, dest);
+}
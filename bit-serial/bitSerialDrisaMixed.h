@@ -0,0 +1,37 @@
+// Bit-Serial Performance Modeling - DRISA_MIXED
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#ifndef BIT_SERIAL_DRISA_MIXED_H
+#define BIT_SERIAL_DRISA_MIXED_H
+
+#include "bitSerialBitsimd.h"
+#include "libpimeval.h"
+
+//! @class  bitSerialDrisaMixed
+//! @brief  Bit-serial perf for DRISA_MIXED
+//!
+//! Instruction set: read/write/move/set + NOT/AND/OR/NOR
+//! Bit registers: SA, R1, R2, R3, with R4 and R5 as temporaries of logic emulation
+//!
+//! Reuses BitSIMD-V micro-programs, with XOR/SEL emulated by the gates of the 1T1C-mixed design
+//!
+class bitSerialDrisaMixed : public bitSerialBitsimd
+{
+public:
+  bitSerialDrisaMixed() { m_deviceName = "drisa_mixed"; }
+  ~bitSerialDrisaMixed() {}
+
+protected:
+
+  // virtual: create device
+  virtual PimDeviceEnum getDeviceType() override { return PIM_DEVICE_DRISA_MIXED; }
+
+  // virtual: logic micro-ops
+  virtual void implOpXor(PimObjId objId, PimRowReg src1, PimRowReg src2, PimRowReg dest) override;
+  virtual void implOpSel(PimObjId objId, PimRowReg cond, PimRowReg src1, PimRowReg src2, PimRowReg dest) override;
+};
+
+#endif
+
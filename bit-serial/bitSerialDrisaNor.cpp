@@ -0,0 +1,51 @@
+// Bit-Serial Performance Modeling - DRISA_NOR
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "bitSerialDrisaNor.h"
+
+//! @brief  NOT a = NOR(a, a)
+void
+bitSerialDrisaNor::implOpNot(PimObjId objId, PimRowReg src, PimRowReg dest)
+{
+  pimOpNor(objId, src, src, dest);
+}
+
+//! @brief  AND(a, b) = NOR(NOT a, NOT b)
+void
+bitSerialDrisaNor::implOpAnd(PimObjId objId, PimRowReg src1, PimRowReg src2, PimRowReg dest)
+{
+  pimOpNor(objId, src1, src1, PIM_RREG_R4);
+  pimOpNor(objId, src2, src2, PIM_RREG_R5);
+  pimOpNor(objId, PIM_RREG_R4, PIM_RREG_R5, dest);
+}
+
+//! @brief  OR(a, b) = NOT NOR(a, b)
+void
+bitSerialDrisaNor::implOpOr(PimObjId objId, PimRowReg src1, PimRowReg src2, PimRowReg dest)
+{
+  pimOpNor(objId, src1, src2, PIM_RREG_R4);
+  pimOpNor(objId, PIM_RREG_R4, PIM_RREG_R4, dest);
+}
+
+//! @brief  XOR(a, b) = NOT NOR(NOR(a, t), NOR(b, t)), where t = NOR(a, b)
+void
+bitSerialDrisaNor::implOpXor(PimObjId objId, PimRowReg src1, PimRowReg src2, PimRowReg dest)
+{
+  pimOpNor(objId, src1, src2, PIM_RREG_R4);
+  pimOpNor(objId, src1, PIM_RREG_R4, PIM_RREG_R5);
+  pimOpNor(objId, src2, PIM_RREG_R4, PIM_RREG_R4);
+  pimOpNor(objId, PIM_RREG_R4, PIM_RREG_R5, PIM_RREG_R4);
+  pimOpNor(objId, PIM_RREG_R4, PIM_RREG_R4, dest);
+}
+
+//! @brief  SEL(c, a, b) = NOR(NOR(NOT c, a), NOR(c, b))
+void
+bitSerialDrisaNor::implOpSel(PimObjId objId, PimRowReg cond, PimRowReg src1, PimRowReg src2, PimRowReg dest)
+{
+  pimOpNor(objId, cond, cond, PIM_RREG_R4);
+  pimOpNor(objId, PIM_RREG_R4, src1, PIM_RREG_R4);
+  pimOpNor(objId, cond, src2, PIM_RREG_R5);
+  pimOpNor(objId, PIM_RREG_R4, PIM_RREG_R5, dest);
+}
@@ -0,0 +1,40 @@
+// Bit-Serial Performance Modeling - DRISA_NOR
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#ifndef BIT_SERIAL_DRISA_NOR_H
+#define BIT_SERIAL_DRISA_NOR_H
+
+#include "bitSerialBitsimd.h"
+#include "libpimeval.h"
+
+//! @class  bitSerialDrisaNor
+//! @brief  Bit-serial perf for DRISA_NOR
+//!
+//! Instruction set: read/write/move/set + NOR
+//! Bit registers: SA, R1, R2, R3, with R4 and R5 as temporaries of logic emulation
+//!
+//! Reuses BitSIMD-V micro-programs, with NOT/AND/OR/XOR/SEL emulated by NOR gates of the 3T1C design
+//!
+class bitSerialDrisaNor : public bitSerialBitsimd
+{
+public:
+  bitSerialDrisaNor() { m_deviceName = "drisa_nor"; }
+  ~bitSerialDrisaNor() {}
+
+protected:
+
+  // virtual: create device
+  virtual PimDeviceEnum getDeviceType() override { return PIM_DEVICE_DRISA_NOR; }
+
+  // virtual: logic micro-ops
+  virtual void implOpNot(PimObjId objId, PimRowReg src, PimRowReg dest) override;
+  virtual void implOpAnd(PimObjId objId, PimRowReg src1, PimRowReg src2, PimRowReg dest) override;
+  virtual void implOpOr(PimObjId objId, PimRowReg src1, PimRowReg src2, PimRowReg dest) override;
+  virtual void implOpXor(PimObjId objId, PimRowReg src1, PimRowReg src2, PimRowReg dest) override;
+  virtual void implOpSel(PimObjId objId, PimRowReg cond, PimRowReg src1, PimRowReg src2, PimRowReg dest) override;
+};
+
+#endif
+
@@ -7,14 +7,24 @@
 #include "bitSerialBase.h"
 #include "bitSerialBitsimd.h"
 #include "bitSerialBitsimdAp.h"
+#include "bitSerialBitsimdNand.h"
+#include "bitSerialBitsimdMaj.h"
+#include "bitSerialDrisaNor.h"
+#include "bitSerialDrisaMixed.h"
 #include "bitSerialSimdram.h"
 #include <iostream>
+#include <fstream>
+#include <cctype>
 
 bitSerialMain::bitSerialMain()
 {
   m_deviceList = {
     "bitsimd_v",
     "bitsimd_v_ap",
+    "bitsimd_v_nand",
+    "bitsimd_v_maj",
+    "drisa_nor",
+    "drisa_mixed",
     "simdram",
   };
   m_testList = {
@@ -46,13 +56,23 @@ bitSerialMain::runTests(const std::vector<std::string>& deviceList, const std::v
       model = std::make_unique<bitSerialBitsimd>();
     } else if (device == "bitsimd_v_ap") {
       model = std::make_unique<bitSerialBitsimdAp>();
+    } else if (device == "bitsimd_v_nand") {
+      model = std::make_unique<bitSerialBitsimdNand>();
+    } else if (device == "bitsimd_v_maj") {
+      model = std::make_unique<bitSerialBitsimdMaj>();
+    } else if (device == "drisa_nor") {
+      model = std::make_unique<bitSerialDrisaNor>();
+    } else if (device == "drisa_mixed") {
+      model = std::make_unique<bitSerialDrisaMixed>();
     } else if (device == "simdram") {
       model = std::make_unique<bitSerialSimdram>();
     }
     bool ok = false;
     if (model) {
+      model->setGenTable(m_genTable);
       ok = model->runTests(myTestList);
       stats[device] = model->getStats();
+      m_perfCounts[device] = model->getPerfCounts();
     }
     std::cout << "INFO: Bit Serial Performance Modeling for " << device << (ok ? " -- Succeed" : " -- Failed!") << std::endl;
   }
@@ -75,10 +95,59 @@ bitSerialMain::runTests(const std::vector<std::string>& deviceList, const std::v
   std::cout << "----------------------------------------" << std::endl;
 }
 
-int main()
+//! @brief  Write (#R, #W, #L) of all passed micro-programs as a JSON perf table
+//!         The table can be loaded by PIMeval with environment variable PIMEVAL_BITSERIAL_PERF_TABLE
+bool
+bitSerialMain::writePerfTable(const std::string& fileName) const
 {
+  std::ofstream file(fileName);
+  if (!file.is_open()) {
+    std::cout << "Error: Cannot open " << fileName << std::endl;
+    return false;
+  }
+  file << "{\n  \"format\": \"pimeval-bitserial-perf-table\",\n  \"version\": " << PIMEVAL_BITSERIAL_PERF_TABLE_VERSION
+       << ",\n  \"entries\": [";
+  bool isFirst = true;
+  for (const auto& [device, categories] : m_perfCounts) {
+    std::string deviceEnum = "PIM_DEVICE_";
+    for (char c : device) {
+      deviceEnum += static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    }
+    for (const auto& [category, ops] : categories) {
+      for (const auto& [op, counts] : ops) {
+        const auto& [numR, numW, numL] = counts;
+        file << (isFirst ? "\n" : ",\n") << "    { \"device\": \"" << deviceEnum << "\", \"data_type\": \"" << category
+             << "\", \"cmd\": \"" << op << "\", \"num_r\": " << numR << ", \"num_w\": " << numW
+             << ", \"num_l\": " << numL << " }";
+        isFirst = false;
+      }
+    }
+  }
+  file << "\n  ]\n}\n";
+  std::cout << "INFO: Wrote bit-serial perf table to " << fileName << std::endl;
+  return true;
+}
+
+int main(int argc, char* argv[])
+{
+  // usage: ./bitSerial.out [-o <perf-table.json>]
+  std::string tableFile;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "-o" && i + 1 < argc) {
+      tableFile = argv[++i];
+    } else {
+      std::cout << "Usage: " << argv[0] << " [-o <perf-table.json>]" << std::endl;
+      return 1;
+    }
+  }
+
   bitSerialMain app;
+  app.setGenTable(!tableFile.empty());
   app.runTests();
+  if (!tableFile.empty() && !app.writePerfTable(tableFile)) {
+    return 1;
+  }
   return 0;
 }
 
@@ -8,6 +8,8 @@
 
 #include <string>
 #include <vector>
+#include <map>
+#include <tuple>
 
 //! @class  bitSerialMain
 //! @brief  Bit-serial performance tests main entry
@@ -18,6 +20,9 @@ public:
   ~bitSerialMain() {}
 
   void runTests(const std::vector<std::string>& deviceList = {}, const std::vector<std::string>& testList = {});
+  bool writePerfTable(const std::string& fileName) const;
+
+  void setGenTable(bool genTable) { m_genTable = genTable; }
 
   const std::vector<std::string>& getDeviceList() const { return m_deviceList; }
   const std::vector<std::string>& getTestList() const { return m_testList; }
@@ -25,6 +30,9 @@ public:
 private:
   std::vector<std::string> m_deviceList;
   std::vector<std::string> m_testList;
+  bool m_genTable = false;
+  // device -> data type category -> op -> (#R, #W, #L)
+  std::map<std::string, std::map<std::string, std::map<std::string, std::tuple<int, int, int>>>> m_perfCounts;
 };
 
 #endif
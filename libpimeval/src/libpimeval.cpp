@@ -7,6 +7,7 @@
 #include "libpimeval.h"
 #include "pimSim.h"
 #include "pimUtils.h"
+#include "pimTrace.h"
 
 
 //! @brief  Create a PIM device
@@ -41,6 +42,72 @@ pimDeleteDevice()
   return ok ? PIM_OK : PIM_ERROR;
 }
 
+//! @brief  Create an independent simulator context
+PimContextId
+pimCreateContext()
+{
+  return pimSim::createContext();
+}
+
+//! @brief  Destroy a simulator context with all its devices
+PimStatus
+pimDestroyContext(PimContextId ctx)
+{
+  bool ok = pimSim::destroyContext(ctx);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
+//! @brief  Set the simulator context of the calling thread
+PimStatus
+pimSetContext(PimContextId ctx)
+{
+  bool ok = pimSim::setContext(ctx);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
+//! @brief  Get the simulator context of the calling thread
+PimContextId
+pimGetContext()
+{
+  return pimSim::get()->getContextId();
+}
+
+//! @brief  Add a PIM device to the current context
+PimDeviceId
+pimAddDevice(PimDeviceEnum deviceType, unsigned numRanks, unsigned numBankPerRank, unsigned numSubarrayPerBank, unsigned numRows, unsigned numCols)
+{
+  return pimSim::get()->addDevice(deviceType, numRanks, numBankPerRank, numSubarrayPerBank, numRows, numCols);
+}
+
+//! @brief  Set the current device for allocations and streams
+PimStatus
+pimSetDevice(PimDeviceId device)
+{
+  bool ok = pimSim::get()->setCurrentDevice(device);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
+//! @brief  Get the current device
+PimDeviceId
+pimGetDevice()
+{
+  return pimSim::get()->getCurrentDeviceId();
+}
+
+//! @brief  Get number of devices of the current context
+unsigned
+pimGetNumDevices()
+{
+  return pimSim::get()->getNumDevices();
+}
+
+//! @brief  Get the device owning a PIM object
+PimDeviceId
+pimGetObjectDevice(PimObjId obj)
+{
+  return pimSim::get()->getObjDeviceId(obj);
+}
+
 //! @brief  Show PIM command stats
 void
 pimShowStats()
@@ -55,6 +122,89 @@ pimResetStats()
   pimSim::get()->resetStats();
 }
 
+//! @brief  Export PIM stats into a JSON or CSV file
+PimStatus
+pimExportStats(const char* fileName, PimStatsFormat format)
+{
+  bool ok = pimSim::get()->exportStats(fileName, format);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
+//! @brief  Begin a phase of the application, which may be nested
+PimStatus
+pimBeginPhase(const char* name)
+{
+  bool ok = pimSim::get()->beginPhase(name);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
+//! @brief  End the current phase
+PimStatus
+pimEndPhase()
+{
+  bool ok = pimSim::get()->endPhase();
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
+//! @brief  Replay a binary command trace recorded with PIMEVAL_TRACE_FILE
+PimStatus
+pimReplayTrace(const char* traceFileName, PimDeviceEnum deviceType, const char* configFileName)
+{
+  if (!traceFileName) {
+    std::printf("PIM-Error: Trace file name is not specified\n");
+    return PIM_ERROR;
+  }
+  pimTraceReplayer replayer(deviceType, configFileName);
+  bool ok = replayer.replay(traceFileName);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
+//! @brief  Create an asynchronous command stream. Return -1 on error
+PimStreamId
+pimStreamCreate()
+{
+  return pimSim::get()->pimStreamCreate();
+}
+
+//! @brief  Destroy a stream after its pending commands are finished
+PimStatus
+pimStreamDestroy(PimStreamId stream)
+{
+  bool ok = pimSim::get()->pimStreamDestroy(stream);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
+//! @brief  Set the stream of subsequent commands issued by the calling thread. Stream 0 is synchronous
+PimStatus
+pimSetStream(PimStreamId stream)
+{
+  bool ok = pimSim::get()->pimSetStream(stream);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
+//! @brief  Wait until all commands of a stream are finished
+PimStatus
+pimStreamSynchronize(PimStreamId stream)
+{
+  bool ok = pimSim::get()->pimStreamSynchronize(stream);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
+//! @brief  Record an event which completes when all prior commands of a stream are finished
+PimEventId
+pimEventRecord(PimStreamId stream)
+{
+  return pimSim::get()->pimEventRecord(stream);
+}
+
+//! @brief  Block the host until an event is completed
+PimStatus
+pimEventWait(PimEventId event)
+{
+  bool ok = pimSim::get()->pimEventWait(event);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
 //! @brief  Allocate a PIM resource
 PimObjId
 pimAlloc(PimAllocEnum allocType, uint64_t numElements, PimDataType dataType)
@@ -79,6 +229,38 @@ pimFree(PimObjId obj)
   return ok ? PIM_OK : PIM_ERROR;
 }
 
+//! @brief  Release freed objects kept for reuse by later allocations
+PimStatus
+pimTrimObjectPool()
+{
+  bool ok = pimSim::get()->pimTrimObjectPool();
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
+//! @brief  Compact rows of live objects to defragment PIM cores
+PimStatus
+pimCompact()
+{
+  bool ok = pimSim::get()->pimCompact();
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
+//! @brief  Save states of all devices into a checkpoint file
+PimStatus
+pimSaveCheckpoint(const char* fileName)
+{
+  bool ok = pimSim::get()->saveCheckpoint(fileName);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
+//! @brief  Restore states of all devices from a checkpoint file
+PimStatus
+pimLoadCheckpoint(const char* fileName)
+{
+  bool ok = pimSim::get()->loadCheckpoint(fileName);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
 //! @brief  Create an obj referencing to a range of an existing obj
 PimObjId
 pimCreateRangedRef(PimObjId refId, uint64_t idxBegin, uint64_t idxEnd)
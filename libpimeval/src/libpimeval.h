@@ -76,6 +76,12 @@ enum PimDataType {
   PIM_FP32,
 };
 
+//! @brief  PIM stats export formats
+enum PimStatsFormat {
+  PIM_STATS_JSON = 0,
+  PIM_STATS_CSV,
+};
+
 //! @brief  PIM device properties
 struct PimDeviceProperties {
   PimDeviceEnum deviceType = PIM_DEVICE_NONE;
@@ -88,8 +94,14 @@ struct PimDeviceProperties {
 
 typedef int PimCoreId;
 typedef int PimObjId;
+typedef int PimStreamId;
+typedef int PimEventId;
+typedef int PimDeviceId;
+typedef int PimContextId;
 
 // Device creation and deletion
+// Simulation mode (sim_mode) and row allocation policy (alloc_policy) are set in the config file or by env vars.
+// In perf_only mode data-dependent APIs return zeros. See README.md.
 PimStatus pimCreateDevice(PimDeviceEnum deviceType, unsigned numRanks, unsigned numBankPerRank, unsigned numSubarrayPerBank, unsigned numRows, unsigned numCols);
 PimStatus pimCreateDeviceFromConfig(PimDeviceEnum deviceType, const char* configFileName);
 PimStatus pimGetDeviceProperties(PimDeviceProperties* deviceProperties);
@@ -97,10 +109,69 @@ PimStatus pimDeleteDevice();
 void pimShowStats();
 void pimResetStats();
 
+// Machine-readable stats
+// Export stats of all devices of the current context as JSON or CSV. See README.md for PIMEVAL_STATS_OUTPUT.
+PimStatus pimExportStats(const char* fileName, PimStatsFormat format);
+
+// Phases
+// Attribute commands, copies and time between begin and end to a named phase. Phases may be nested.
+PimStatus pimBeginPhase(const char* name);
+PimStatus pimEndPhase();
+
+// Multiple devices and contexts
+// A context is an independent simulation with its own devices. Context 0 and device 0 are the defaults.
+// Allocations and streams go to the current device. Other APIs go to the device owning their objects.
+PimContextId pimCreateContext();
+PimStatus pimDestroyContext(PimContextId ctx);
+PimStatus pimSetContext(PimContextId ctx);
+PimContextId pimGetContext();
+PimDeviceId pimAddDevice(PimDeviceEnum deviceType, unsigned numRanks, unsigned numBankPerRank, unsigned numSubarrayPerBank, unsigned numRows, unsigned numCols);
+PimStatus pimSetDevice(PimDeviceId device);
+PimDeviceId pimGetDevice();
+unsigned pimGetNumDevices();
+PimDeviceId pimGetObjectDevice(PimObjId obj);
+
+// Command trace recording and replay
+// Replay a trace recorded with PIMEVAL_TRACE_FILE, optionally with another device type or config file.
+PimStatus pimReplayTrace(const char* traceFileName, PimDeviceEnum deviceType, const char* configFileName);
+
+// Command timeline
+// Set PIMEVAL_TIMELINE_FILE to record commands and copies as Chrome trace events. See README.md.
+
+// Bit-serial perf table
+// Set PIMEVAL_BITSERIAL_PERF_TABLE to load micro-program op counts from a JSON table. See README.md.
+#define PIMEVAL_BITSERIAL_PERF_TABLE_VERSION 1
+
+// DRAM trace
+// Set PIMEVAL_DRAM_TRACE_PREFIX to write row operations as DRAMsim3 traces per channel. See README.md.
+
+// Activation throttling
+// Set PIMEVAL_ACT_POWER_BUDGET to limit concurrent row activations per rank. See README.md.
+
+// Checkpoint and restore
+// Save or load states of all devices of the current context. Load into devices of the same targets and dimensions.
+PimStatus pimSaveCheckpoint(const char* fileName);
+PimStatus pimLoadCheckpoint(const char* fileName);
+
+// Asynchronous streams
+// APIs of a thread bound to a stream by pimSetStream are enqueued and return immediately.
+// Results of device-to-host copies and reductions are available after pimStreamSynchronize or pimEventWait.
+PimStreamId pimStreamCreate();
+PimStatus pimStreamDestroy(PimStreamId stream);
+PimStatus pimSetStream(PimStreamId stream);
+PimStatus pimStreamSynchronize(PimStreamId stream);
+PimEventId pimEventRecord(PimStreamId stream);
+PimStatus pimEventWait(PimEventId event);
+
 // Resource allocation and deletion
 PimObjId pimAlloc(PimAllocEnum allocType, uint64_t numElements, PimDataType dataType);
 PimObjId pimAllocAssociated(PimObjId assocId, PimDataType dataType);
 PimStatus pimFree(PimObjId obj);
+// Release objects kept by the object pool (obj_pool). See README.md.
+PimStatus pimTrimObjectPool();
+// Move rows of live objects to close holes. Also runs when an allocation does not fit. Object IDs stay valid.
+PimStatus pimCompact();
+// View elements [idxBegin, idxEnd) of an object without data movement. Freed by pimFree or with its root.
 PimObjId pimCreateRangedRef(PimObjId refId, uint64_t idxBegin, uint64_t idxEnd);
 
 // Data transfer
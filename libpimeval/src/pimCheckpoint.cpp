@@ -0,0 +1,205 @@
+// File: pimCheckpoint.cpp
+// PIMeval Simulator - Checkpoint and Restore
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "pimCheckpoint.h"
+#include <cstring>
+#include <vector>
+#include <algorithm>
+
+static constexpr const char* pimCheckpointMagic = "PIMCKPT";
+static constexpr uint32_t pimCheckpointVersion = 2;
+
+//! @brief  Open a checkpoint file for writing and write its header
+bool
+pimCheckpointWriter::open(const std::string& fileName)
+{
+  close();
+  m_hasError = false;
+  m_offset = 0;
+  m_file = std::fopen(fileName.c_str(), "wb");
+  if (!m_file) {
+    std::printf("PIM-Error: Failed to open checkpoint file %s for writing\n", fileName.c_str());
+    m_hasError = true;
+    return false;
+  }
+  writeBytes(pimCheckpointMagic, 8);
+  write(pimCheckpointVersion);
+  return !m_hasError;
+}
+
+//! @brief  Flush and close the checkpoint file. Return false if any write failed
+bool
+pimCheckpointWriter::close()
+{
+  if (m_file) {
+    if (std::fclose(m_file) != 0) {
+      m_hasError = true;
+    }
+    m_file = nullptr;
+  }
+  return !m_hasError;
+}
+
+//! @brief  Write raw bytes
+void
+pimCheckpointWriter::writeBytes(const void* data, uint64_t numBytes)
+{
+  if (!m_file || m_hasError || numBytes == 0) {
+    return;
+  }
+  if (std::fwrite(data, 1, numBytes, m_file) != numBytes) {
+    m_hasError = true;
+    return;
+  }
+  m_offset += numBytes;
+}
+
+//! @brief  Write a string with its length
+void
+pimCheckpointWriter::writeString(const std::string& str)
+{
+  write(static_cast<uint32_t>(str.size()));
+  writeBytes(str.data(), str.size());
+}
+
+//! @brief  Pad with zeros until the file offset is a multiple of alignment
+void
+pimCheckpointWriter::alignTo(uint64_t alignment)
+{
+  static const char zeros[64] = {};
+  while (m_offset % alignment != 0 && !m_hasError) {
+    uint64_t numBytes = std::min<uint64_t>(alignment - m_offset % alignment, sizeof(zeros));
+    writeBytes(zeros, numBytes);
+  }
+}
+
+//! @brief  Begin a record which can be skipped by readers. Return offset of its size field
+uint64_t
+pimCheckpointWriter::beginRecord()
+{
+  uint64_t recordOffset = m_offset;
+  write(static_cast<uint64_t>(0));
+  return recordOffset;
+}
+
+//! @brief  End a record by writing its size after the size field
+void
+pimCheckpointWriter::endRecord(uint64_t recordOffset)
+{
+  if (!m_file || m_hasError) {
+    return;
+  }
+  uint64_t numBytes = m_offset - recordOffset - sizeof(uint64_t);
+  if (std::fseek(m_file, static_cast<long>(recordOffset), SEEK_SET) != 0 ||
+      std::fwrite(&numBytes, 1, sizeof(numBytes), m_file) != sizeof(numBytes) ||
+      std::fseek(m_file, static_cast<long>(m_offset), SEEK_SET) != 0) {
+    m_hasError = true;
+  }
+}
+
+//! @brief  Open a checkpoint file for reading and check its header
+bool
+pimCheckpointReader::open(const std::string& fileName)
+{
+  close();
+  m_hasError = false;
+  m_offset = 0;
+  m_file = std::fopen(fileName.c_str(), "rb");
+  if (!m_file) {
+    std::printf("PIM-Error: Failed to open checkpoint file %s\n", fileName.c_str());
+    m_hasError = true;
+    return false;
+  }
+  char magic[8];
+  uint32_t version = 0;
+  if (!readBytes(magic, 8) || std::memcmp(magic, pimCheckpointMagic, 8) != 0 || !read(version)) {
+    std::printf("PIM-Error: Invalid checkpoint file %s\n", fileName.c_str());
+    m_hasError = true;
+    return false;
+  }
+  if (version != pimCheckpointVersion) {
+    std::printf("PIM-Error: Unsupported checkpoint version %u in %s, expecting %u\n", version, fileName.c_str(), pimCheckpointVersion);
+    m_hasError = true;
+    return false;
+  }
+  return true;
+}
+
+//! @brief  Close the checkpoint file
+void
+pimCheckpointReader::close()
+{
+  if (m_file) {
+    std::fclose(m_file);
+    m_file = nullptr;
+  }
+}
+
+//! @brief  Read raw bytes
+bool
+pimCheckpointReader::readBytes(void* data, uint64_t numBytes)
+{
+  if (!m_file || m_hasError) {
+    return false;
+  }
+  if (numBytes > 0 && std::fread(data, 1, numBytes, m_file) != numBytes) {
+    m_hasError = true;
+    return false;
+  }
+  m_offset += numBytes;
+  return true;
+}
+
+//! @brief  Read a string with its length
+bool
+pimCheckpointReader::readString(std::string& str)
+{
+  uint32_t len = 0;
+  if (!read(len)) {
+    return false;
+  }
+  std::vector<char> buf(len);
+  if (!readBytes(buf.data(), len)) {
+    return false;
+  }
+  str.assign(buf.begin(), buf.end());
+  return true;
+}
+
+//! @brief  Read and check a section tag
+bool
+pimCheckpointReader::readSection(PimCheckpointSection section)
+{
+  uint32_t tag = 0;
+  if (!read(tag) || tag != static_cast<uint32_t>(section)) {
+    m_hasError = true;
+    return false;
+  }
+  return true;
+}
+
+//! @brief  Skip padding until the file offset is a multiple of alignment
+bool
+pimCheckpointReader::alignTo(uint64_t alignment)
+{
+  return skip((alignment - m_offset % alignment) % alignment);
+}
+
+//! @brief  Skip bytes, e.g., a record not needed
+bool
+pimCheckpointReader::skip(uint64_t numBytes)
+{
+  if (!m_file || m_hasError) {
+    return false;
+  }
+  if (numBytes > 0 && std::fseek(m_file, static_cast<long>(numBytes), SEEK_CUR) != 0) {
+    m_hasError = true;
+    return false;
+  }
+  m_offset += numBytes;
+  return true;
+}
+
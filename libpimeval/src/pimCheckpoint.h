@@ -0,0 +1,92 @@
+// File: pimCheckpoint.h
+// PIMeval Simulator - Checkpoint and Restore
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#ifndef LAVA_PIM_CHECKPOINT_H
+#define LAVA_PIM_CHECKPOINT_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <type_traits>
+
+//! @brief  Section tags, which are checked when reading a checkpoint. Comments show their bytes in file
+enum class PimCheckpointSection : uint32_t {
+  DEVICE = 0x43564544,   // "DEVC"
+  RES_MGR = 0x52534552,  // "RESR"
+  CORES = 0x45524f43,    // "CORE"
+  STATS = 0x54415453,    // "STAT"
+};
+
+//! @class  pimCheckpointWriter
+//! @brief  Write simulator states into a binary checkpoint file
+//!
+//! Checkpoint format: 8-byte magic "PIMCKPT" and a 4-byte version, followed by a section per device.
+//! Fields are fixed-width integers and doubles in host byte order. Memory of a core is written only if
+//! it is materialized, and only its runs of non-zero rows. Row words of a run start at a 64-byte
+//! aligned file offset with the same layout as pimCore, so that they can be mapped into memory directly.
+class pimCheckpointWriter
+{
+public:
+  pimCheckpointWriter() {}
+  ~pimCheckpointWriter() { close(); }
+
+  bool open(const std::string& fileName);
+  bool close();
+  bool hasError() const { return m_hasError; }
+  uint64_t getOffset() const { return m_offset; }
+
+  //! @brief  Write a fixed-width field
+  template <typename T>
+  void write(const T& val) {
+    static_assert(std::is_trivially_copyable<T>::value, "checkpoint fields must be trivially copyable");
+    writeBytes(&val, sizeof(T));
+  }
+  void writeBytes(const void* data, uint64_t numBytes);
+  void writeString(const std::string& str);
+  void writeSection(PimCheckpointSection section) { write(static_cast<uint32_t>(section)); }
+  void alignTo(uint64_t alignment);
+  uint64_t beginRecord();
+  void endRecord(uint64_t recordOffset);
+
+private:
+  std::FILE* m_file = nullptr;
+  uint64_t m_offset = 0;
+  bool m_hasError = false;
+};
+
+//! @class  pimCheckpointReader
+//! @brief  Read simulator states from a binary checkpoint file
+class pimCheckpointReader
+{
+public:
+  pimCheckpointReader() {}
+  ~pimCheckpointReader() { close(); }
+
+  bool open(const std::string& fileName);
+  void close();
+  bool hasError() const { return m_hasError; }
+
+  //! @brief  Read a fixed-width field. Return false at end of file
+  template <typename T>
+  bool read(T& val) {
+    static_assert(std::is_trivially_copyable<T>::value, "checkpoint fields must be trivially copyable");
+    return readBytes(&val, sizeof(T));
+  }
+  bool readBytes(void* data, uint64_t numBytes);
+  bool readString(std::string& str);
+  bool readSection(PimCheckpointSection section);
+  bool alignTo(uint64_t alignment);
+  bool readRecordSize(uint64_t& numBytes) { return read(numBytes); }
+  bool skip(uint64_t numBytes);
+
+private:
+  std::FILE* m_file = nullptr;
+  uint64_t m_offset = 0;
+  bool m_hasError = false;
+};
+
+#endif
+
@@ -9,11 +9,14 @@
 #include "pimDevice.h"
 #include "pimCore.h"
 #include "pimResMgr.h"
+#include <algorithm>
 #include <cstdio>
+#include <cstring>
 #include <cmath>
 #include <unordered_map>
 #include <unordered_set>
 #include <climits>
+#include <type_traits>
 
 
 //! @brief  Get PIM command name from command type enum
@@ -80,6 +83,7 @@ pimCmd::getName(PimCmdEnum cmdType, const std::string& suffix)
     { PimCmdEnum::RREG_ROTATE_L, "rreg.rotate_l" },
     { PimCmdEnum::ROW_AP, "row_ap" },
     { PimCmdEnum::ROW_AAP, "row_aap" },
+    { PimCmdEnum::ROW_CLONE, "row_clone" },
   };
   auto it = cmdNames.find(cmdType);
   return it != cmdNames.end() ? it->second + suffix : "unknown";
@@ -135,15 +139,16 @@ pimCmd::isConvertibleType(const pimObjInfo& src, const pimObjInfo& dest) const
 bool
 pimCmd::computeAllRegions(unsigned numRegions)
 {
+  // no functional computation in performance-model-only mode
+  if (m_device->isPerfOnly()) {
+    return true;
+  }
   if (pimSim::get()->getNumThreads() > 1) { // MT
-    std::vector<pimUtils::threadWorker*> workers;
-    for (unsigned i = 0; i < numRegions; ++i) {
-      workers.push_back(new regionWorker(this, i));
-    }
-    pimSim::get()->getThreadPool()->doWork(workers);
-    for (unsigned i = 0; i < numRegions; ++i) {
-      delete workers[i];
-    }
+    pimSim::get()->getThreadPool()->parallelFor(numRegions, [this](uint64_t begin, uint64_t end) {
+      for (uint64_t i = begin; i < end; ++i) {
+        computeRegion(static_cast<unsigned>(i));
+      }
+    });
   } else { // single thread
     for (unsigned i = 0; i < numRegions; ++i) {
       computeRegion(i);
@@ -168,6 +173,11 @@ pimCmdCopy::execute()
   } else if (m_cmdType == PimCmdEnum::COPY_D2H) {
     const pimObjInfo &objSrc = m_device->getResMgr()->getObjInfo(m_src);
     unsigned numRegions = objSrc.getRegions().size();
+    if (m_device->isPerfOnly()) {
+      // no data in performance-model-only mode: return zeros
+      uint64_t numElements = m_copyFullRange ? objSrc.getNumElements() : m_idxEnd - m_idxBegin;
+      std::memset(m_ptr, 0, (numElements * objSrc.getBitsPerElement() + 7) / 8);
+    }
     computeAllRegions(numRegions);
   } else if (m_cmdType == PimCmdEnum::COPY_D2D) {
     const pimObjInfo &objSrc = m_device->getResMgr()->getObjInfo(m_src);
@@ -260,137 +270,180 @@ pimCmdCopy::sanityCheck() const
 bool
 pimCmdCopy::computeRegion(unsigned index)
 {
-  // read in bits from src (host or PIM)
-  std::vector<bool> bits;
-  if (m_cmdType == PimCmdEnum::COPY_H2D) {
+  const pimObjInfo &obj = m_device->getResMgr()->getObjInfo(m_cmdType == PimCmdEnum::COPY_H2D ? m_dest : m_src);
+  const pimRegion& region = obj.getRegions()[index];
+  bool isElementWise = isElementCopy(obj, region);
+  if (m_cmdType == PimCmdEnum::COPY_D2D) {
     const pimObjInfo &objDest = m_device->getResMgr()->getObjInfo(m_dest);
-    const pimRegion& region = objDest.getRegions()[index];
-    unsigned numAllocRows = region.getNumAllocRows();
-    unsigned numAllocCols = region.getNumAllocCols();
-    unsigned bitsPerElement = objDest.getBitsPerElement();
-    unsigned numElementInCurRegion = numAllocRows * numAllocCols / bitsPerElement;
-    uint64_t byteOfst = (uint64_t)index * objDest.getMaxElementsPerRegion() * bitsPerElement / 8;
-    void* ptr = (void*)((char*)m_ptr + byteOfst);
-    bits = pimUtils::readBitsFromHost(ptr, numElementInCurRegion, bitsPerElement);
-  } else if (m_cmdType == PimCmdEnum::COPY_D2H || m_cmdType == PimCmdEnum::COPY_D2D) {
-    const pimObjInfo &objSrc = m_device->getResMgr()->getObjInfo(m_src);
-    const pimRegion& region = objSrc.getRegions()[index];
-    unsigned rowIdx = region.getRowIdx();
-    unsigned colIdx = region.getColIdx();
-    unsigned numAllocRows = region.getNumAllocRows();
-    unsigned numAllocCols = region.getNumAllocCols();
-    unsigned bitsPerElement = objSrc.getBitsPerElement();
-    PimCoreId coreId = region.getCoreId();
-    pimCore& core = m_device->getCore(coreId);
-    bool isDCCN = objSrc.isDualContactRef();
-    uint64_t reginBeginIdx = (uint64_t)objSrc.getMaxElementsPerRegion() * index; 
-    if (m_copyType == PIM_COPY_V) {
-      for (unsigned c = 0; c < numAllocCols; ++c) {
-        for (unsigned r = 0; r < numAllocRows; ++r) {
-          unsigned row = rowIdx + r;
-          unsigned col = colIdx + c;
-          bool val = core.getBit(row, col);
-          if (isDCCN) { val = !val; }
-          if (!m_copyFullRange) {
-            uint64_t currIdx = reginBeginIdx + c; 
-            if (currIdx >= m_idxBegin && currIdx < m_idxEnd) {
-              bits.push_back(val);
-            }
-          }
-          else {
-            bits.push_back(val);
-          }
-        }
-      }
-    } else if (m_copyType == PIM_COPY_H) {
-      for (unsigned r = 0; r < numAllocRows; ++r) {
-        for (unsigned c = 0; c < numAllocCols; ++c) {
-          unsigned row = rowIdx + r;
-          unsigned col = colIdx + c;
-          bool val = core.getBit(row, col);
-          if (isDCCN) { val = !val; }
-          if (!m_copyFullRange) {
-            uint64_t currIdx = reginBeginIdx + c / bitsPerElement; 
-            if (currIdx >= m_idxBegin && currIdx < m_idxEnd) {
-              bits.push_back(val);
-            }
-          }
-          else {
-            bits.push_back(val);
-          }
-        }
-      }
+    isElementWise = isElementWise && isElementCopy(objDest, objDest.getRegions()[index])
+                    && objDest.getBitsPerElement() == obj.getBitsPerElement();
+  }
+  if (isElementWise) {
+    copyRegionElements(index);
+  } else {
+    copyRegionBits(index);
+  }
+  return true;
+}
+
+//! @brief  PIM Data Copy - check if copy type matches the data layout of a region,
+//!         i.e., each column holds one element for V copy or each row holds consecutive elements for H copy
+bool
+pimCmdCopy::isElementCopy(const pimObjInfo& obj, const pimRegion& region) const
+{
+  unsigned bitsPerElement = obj.getBitsPerElement();
+  if (bitsPerElement % 8 != 0 || bitsPerElement > 64) {
+    return false;
+  }
+  if (m_copyType == PIM_COPY_V) {
+    return obj.isVLayout() && region.getNumAllocRows() == bitsPerElement;
+  }
+  return !obj.isVLayout() && region.getNumAllocRows() == 1 && region.getNumColsPerElem() == bitsPerElement;
+}
+
+//! @brief  PIM Data Copy - copy elements of a region between host buffer and packed core words.
+//!         Host element k corresponds to element idxBegin + k of the PIM object.
+void
+pimCmdCopy::copyRegionElements(unsigned index)
+{
+  const pimObjInfo &objSrcOrDest = m_device->getResMgr()->getObjInfo(m_cmdType == PimCmdEnum::COPY_H2D ? m_dest : m_src);
+  const pimRegion& region = objSrcOrDest.getRegions()[index];
+  unsigned bitsPerElement = objSrcOrDest.getBitsPerElement();
+  uint64_t bitsMask = (bitsPerElement == 64 ? ~0ULL : ((1ULL << bitsPerElement) - 1));
+
+  // element range within this region
+  uint64_t idxBegin = m_copyFullRange ? 0 : m_idxBegin;
+  uint64_t idxEnd = m_copyFullRange ? objSrcOrDest.getNumElements() : m_idxEnd;
+  uint64_t elemBegin = std::max(region.getElemIdxBegin(), idxBegin);
+  uint64_t elemEnd = std::min(region.getElemIdxEnd(), idxEnd);
+  if (elemBegin >= elemEnd) {
+    return;
+  }
+  unsigned regionElemBegin = elemBegin - region.getElemIdxBegin();
+  unsigned numElements = elemEnd - elemBegin;
+  uint64_t hostByteOfst = (elemBegin - idxBegin) * bitsPerElement / 8;
+
+  // H layout between host and PIM: bit-packed little-endian row words share the host byte order
+  if (m_cmdType != PimCmdEnum::COPY_D2D && !objSrcOrDest.isVLayout() && !objSrcOrDest.isDualContactRef()
+      && region.getColIdx() % 8 == 0) {
+    pimCore& core = m_device->getCore(region.getCoreId());
+    auto loc = region.locateIthElemInRegion(regionElemBegin);
+    char* rowBytes = reinterpret_cast<char*>(core.getRowWords(loc.first)) + loc.second / 8;
+    uint64_t numBytes = (uint64_t)numElements * bitsPerElement / 8;
+    if (m_cmdType == PimCmdEnum::COPY_H2D) {
+      std::memcpy(rowBytes, static_cast<const char*>(m_ptr) + hostByteOfst, numBytes);
     } else {
-      assert(0);
+      std::memcpy(static_cast<char*>(m_ptr) + hostByteOfst, rowBytes, numBytes);
     }
+    return;
+  }
+
+  std::vector<uint64_t> vals(numElements);
+
+  // read from src (host or PIM)
+  if (m_cmdType == PimCmdEnum::COPY_H2D) {
+    pimUtils::readElementsFromHost(static_cast<const char*>(m_ptr) + hostByteOfst, numElements, bitsPerElement, vals.data());
   } else {
-    assert(0);
+    const pimObjInfo &objSrc = m_device->getResMgr()->getObjInfo(m_src);
+    pimCore& core = m_device->getCore(region.getCoreId());
+    getRegionBits(core, objSrc.isVLayout(), region, bitsPerElement, vals.data(), regionElemBegin, numElements);
+    if (objSrc.isDualContactRef()) {
+      for (uint64_t& val : vals) { val = ~val & bitsMask; }
+    }
   }
 
-  // write bits to dest (host or PIM)
-  if (m_cmdType == PimCmdEnum::COPY_H2D || m_cmdType == PimCmdEnum::COPY_D2D) {
+  // write to dest (host or PIM)
+  if (m_cmdType == PimCmdEnum::COPY_D2H) {
+    pimUtils::writeElementsToHost(static_cast<char*>(m_ptr) + hostByteOfst, numElements, bitsPerElement, vals.data());
+  } else {
     const pimObjInfo &objDest = m_device->getResMgr()->getObjInfo(m_dest);
-    const pimRegion& region = objDest.getRegions()[index];
-    unsigned rowIdx = region.getRowIdx();
-    unsigned colIdx = region.getColIdx();
-    unsigned numAllocRows = region.getNumAllocRows();
-    unsigned numAllocCols = region.getNumAllocCols();
-    unsigned bitsPerElement = objDest.getBitsPerElement();
-    PimCoreId coreId = region.getCoreId();
-    pimCore& core = m_device->getCore(coreId);
-    bool isDCCN = objDest.isDualContactRef();
-    uint64_t regionBeginIdx = (uint64_t)objDest.getMaxElementsPerRegion() * index;
-    if (m_copyType == PIM_COPY_V) {
-      size_t bitIdx = 0;
-      for (size_t i = 0; i < (size_t)numAllocRows * numAllocCols; ++i) {
-        unsigned row = rowIdx + i % numAllocRows;
-        unsigned col = colIdx + i / numAllocRows;
-        if (!m_copyFullRange) {
-          uint64_t currIdx = regionBeginIdx + col;
-          if (currIdx >= m_idxBegin && currIdx < m_idxEnd) {
-            bool val = bits[bitIdx++];
-            if (isDCCN) { val = !val; }
-            core.setBit(row, col, val);
-          }
-        } 
-        else {
-          bool val = bits[bitIdx++];
-          if (isDCCN) { val = !val; }
-          core.setBit(row, col, val);
-        }
-      }
-    } else if (m_copyType == PIM_COPY_H) {
-      size_t bitIdx = 0;
-      for (size_t i = 0; i < (size_t)numAllocRows * numAllocCols; ++i) {
-        unsigned row = rowIdx + i / numAllocCols;
-        unsigned col = colIdx + i % numAllocCols;
-        if (!m_copyFullRange) {
-          uint64_t currIdx = regionBeginIdx + col / bitsPerElement;
-          if (currIdx >= m_idxBegin && currIdx < m_idxEnd) {
-            bool val = bits[bitIdx++];
-            if (isDCCN) { val = !val; }
-            core.setBit(row, col, val);
-          }
-        } 
-        else {
-          bool val = bits[bitIdx++];
-          if (isDCCN) { val = !val; }
-          core.setBit(row, col, val);
-        }
-      }
+    const pimRegion& destRegion = objDest.getRegions()[index];
+    pimCore& core = m_device->getCore(destRegion.getCoreId());
+    if (objDest.isDualContactRef()) {
+      for (uint64_t& val : vals) { val = ~val & bitsMask; }
+    }
+    setRegionBits(core, objDest.isVLayout(), destRegion, bitsPerElement, vals.data(), regionElemBegin, numElements);
+  }
+}
+
+//! @brief  PIM Data Copy - copy raw bits of a region when copy type does not match the data layout.
+//!         Bits are streamed column by column for V copy or row by row for H copy.
+void
+pimCmdCopy::copyRegionBits(unsigned index)
+{
+  const pimObjInfo &objSrcOrDest = m_device->getResMgr()->getObjInfo(m_cmdType == PimCmdEnum::COPY_H2D ? m_dest : m_src);
+  const pimRegion& region = objSrcOrDest.getRegions()[index];
+  unsigned bitsPerElement = objSrcOrDest.getBitsPerElement();
+  unsigned numAllocRows = region.getNumAllocRows();
+  unsigned numAllocCols = region.getNumAllocCols();
+  uint64_t idxBegin = m_copyFullRange ? 0 : m_idxBegin;
+  uint64_t idxEnd = m_copyFullRange ? objSrcOrDest.getNumElements() : m_idxEnd;
+  uint64_t regionBeginIdx = region.getElemIdxBegin();
+  if (regionBeginIdx >= idxEnd) {
+    return;
+  }
+  uint64_t hostBitIdx = (std::max(regionBeginIdx, idxBegin) - idxBegin) * bitsPerElement;
+
+  const pimObjInfo *objSrc = (m_cmdType == PimCmdEnum::COPY_H2D ? nullptr : &m_device->getResMgr()->getObjInfo(m_src));
+  const pimObjInfo *objDest = (m_cmdType == PimCmdEnum::COPY_D2H ? nullptr : &m_device->getResMgr()->getObjInfo(m_dest));
+  pimCore* coreSrc = objSrc ? &m_device->getCore(objSrc->getRegions()[index].getCoreId()) : nullptr;
+  pimCore* coreDest = objDest ? &m_device->getCore(objDest->getRegions()[index].getCoreId()) : nullptr;
+  const pimRegion* regionSrc = objSrc ? &objSrc->getRegions()[index] : nullptr;
+  const pimRegion* regionDest = objDest ? &objDest->getRegions()[index] : nullptr;
+  const uint8_t* hostSrc = static_cast<const uint8_t*>(m_ptr);
+  uint8_t* hostDest = static_cast<uint8_t*>(m_ptr);
+
+  uint64_t numBits = (uint64_t)numAllocRows * numAllocCols;
+  for (uint64_t i = 0; i < numBits; ++i) {
+    unsigned r = (m_copyType == PIM_COPY_V ? i % numAllocRows : i / numAllocCols);
+    unsigned c = (m_copyType == PIM_COPY_V ? i / numAllocRows : i % numAllocCols);
+    uint64_t currIdx = regionBeginIdx + (m_copyType == PIM_COPY_V ? c : c / bitsPerElement);
+    if (currIdx < idxBegin || currIdx >= idxEnd) {
+      continue;
+    }
+    bool val = false;
+    if (objSrc) {
+      val = coreSrc->getBit(regionSrc->getRowIdx() + r, regionSrc->getColIdx() + c);
+      if (objSrc->isDualContactRef()) { val = !val; }
     } else {
-      assert(0);
+      val = (hostSrc[hostBitIdx >> 3] >> (hostBitIdx & 7)) & 1;
     }
-  } else if (m_cmdType == PimCmdEnum::COPY_D2H) {
-    const pimObjInfo &objSrc = m_device->getResMgr()->getObjInfo(m_src);
-    unsigned bitsPerElement = objSrc.getBitsPerElement();
-    uint64_t byteOfst = (uint64_t)index * objSrc.getMaxElementsPerRegion() * bitsPerElement / 8;
-    void* ptr = (void*)((char*)m_ptr + byteOfst);
-    pimUtils::writeBitsToHost(ptr, bits);
-  } else {
-    assert(0);
+    if (objDest) {
+      if (objDest->isDualContactRef()) { val = !val; }
+      coreDest->setBit(regionDest->getRowIdx() + r, regionDest->getColIdx() + c, val);
+    } else {
+      uint8_t mask = 1 << (hostBitIdx & 7);
+      hostDest[hostBitIdx >> 3] = (hostDest[hostBitIdx >> 3] & ~mask) | (val ? mask : 0);
+    }
+    ++hostBitIdx;
   }
+}
 
+//! @brief  PIM Data Copy - get bytes of the copied range in each rank. Cores are numbered rank by rank
+bool
+pimCmdCopy::getNumBytesPerRank(std::vector<uint64_t>& numBytesPerRank) const
+{
+  if (m_cmdType != PimCmdEnum::COPY_H2D && m_cmdType != PimCmdEnum::COPY_D2H) {
+    return false;
+  }
+  const pimObjInfo &obj = m_device->getResMgr()->getObjInfo(m_cmdType == PimCmdEnum::COPY_H2D ? m_dest : m_src);
+  unsigned numRanks = std::max(1u, m_device->getNumRanks());
+  unsigned numCoresPerRank = std::max(1u, m_device->getNumCores() / numRanks);
+  uint64_t idxBegin = m_copyFullRange ? 0 : m_idxBegin;
+  uint64_t idxEnd = m_copyFullRange ? obj.getNumElements() : m_idxEnd;
+  std::vector<uint64_t> numBitsPerRank(numRanks, 0);
+  for (const pimRegion& region : obj.getRegions()) {
+    uint64_t begin = std::max(region.getElemIdxBegin(), idxBegin);
+    uint64_t end = std::min(region.getElemIdxEnd(), idxEnd);
+    if (begin < end) {
+      unsigned rank = std::min<unsigned>(region.getCoreId() / numCoresPerRank, numRanks - 1);
+      numBitsPerRank[rank] += (end - begin) * obj.getBitsPerElement();
+    }
+  }
+  numBytesPerRank.clear();
+  for (uint64_t numBits : numBitsPerRank) {
+    numBytesPerRank.push_back((numBits + 7) / 8);
+  }
   return true;
 }
 
@@ -405,12 +458,14 @@ pimCmdCopy::updateStats() const
       numElements = m_idxEnd - m_idxBegin;
     }
     unsigned bitsPerElement = objDest.getBitsPerElement();
-    pimeval::perfEnergy mPerfEnergy = pimSim::get()->getPerfEnergyModel()->getPerfEnergyForBytesTransfer(m_cmdType, numElements * bitsPerElement / 8);
-    pimSim::get()->getStatsMgr()->recordCopyMainToDevice(numElements * bitsPerElement, mPerfEnergy);
+    std::vector<uint64_t> numBytesPerRank;
+    getNumBytesPerRank(numBytesPerRank);
+    pimeval::perfEnergy mPerfEnergy = m_device->getPerfEnergyModel()->getPerfEnergyForBytesTransfer(m_cmdType, numBytesPerRank);
+    m_device->getStatsMgr()->recordCopyMainToDevice(numElements * bitsPerElement, mPerfEnergy);
 
     #if defined(DEBUG)
     std::printf("PIM-Info: Copied %llu elements of %u bits from host to PIM obj %d\n",
-                numElements, bitsPerElement, m_dest);
+                (unsigned long long)numElements, bitsPerElement, m_dest);
     #endif
 
   } else if (m_cmdType == PimCmdEnum::COPY_D2H) {
@@ -420,12 +475,14 @@ pimCmdCopy::updateStats() const
       numElements = m_idxEnd - m_idxBegin;
     }
     unsigned bitsPerElement = objSrc.getBitsPerElement();
-    pimeval::perfEnergy mPerfEnergy = pimSim::get()->getPerfEnergyModel()->getPerfEnergyForBytesTransfer(m_cmdType, numElements * bitsPerElement / 8);
-    pimSim::get()->getStatsMgr()->recordCopyDeviceToMain(numElements * bitsPerElement, mPerfEnergy);
+    std::vector<uint64_t> numBytesPerRank;
+    getNumBytesPerRank(numBytesPerRank);
+    pimeval::perfEnergy mPerfEnergy = m_device->getPerfEnergyModel()->getPerfEnergyForBytesTransfer(m_cmdType, numBytesPerRank);
+    m_device->getStatsMgr()->recordCopyDeviceToMain(numElements * bitsPerElement, mPerfEnergy);
 
     #if defined(DEBUG)
     std::printf("PIM-Info: Copied %llu elements of %u bits from PIM obj %d to host\n",
-                numElements, bitsPerElement, m_src);
+                (unsigned long long)numElements, bitsPerElement, m_src);
     #endif
 
   } else if (m_cmdType == PimCmdEnum::COPY_D2D) {
@@ -435,12 +492,12 @@ pimCmdCopy::updateStats() const
       numElements = m_idxEnd - m_idxBegin;
     }
     unsigned bitsPerElement = objSrc.getBitsPerElement();
-    pimeval::perfEnergy mPerfEnergy = pimSim::get()->getPerfEnergyModel()->getPerfEnergyForBytesTransfer(m_cmdType, numElements * bitsPerElement / 8);
-    pimSim::get()->getStatsMgr()->recordCopyDeviceToDevice(numElements * bitsPerElement, mPerfEnergy);
+    pimeval::perfEnergy mPerfEnergy = m_device->getPerfEnergyModel()->getPerfEnergyForBytesTransfer(m_cmdType, numElements * bitsPerElement / 8);
+    m_device->getStatsMgr()->recordCopyDeviceToDevice(numElements * bitsPerElement, mPerfEnergy);
 
     #if defined(DEBUG)
     std::printf("PIM-Info: Copied %llu elements of %u bits from PIM obj %d to PIM obj %d\n",
-                numElements, bitsPerElement, m_src, m_dest);
+                (unsigned long long)numElements, bitsPerElement, m_src, m_dest);
     #endif
 
   } else {
@@ -450,6 +507,30 @@ pimCmdCopy::updateStats() const
 }
 
 
+//! @brief  Compute type of a PIM element type. Integers are widened to 64 bits
+template <typename T> using pimComputeType = typename std::conditional<std::is_floating_point<T>::value, T,
+    typename std::conditional<std::is_signed<T>::value, int64_t, uint64_t>::type>::type;
+
+//! @brief  Convert raw element bits to the compute type of T, with sign extension for signed integers
+template <typename T> inline pimComputeType<T> bitsToOperand(uint64_t bits)
+{
+  if constexpr (std::is_floating_point<T>::value) {
+    return pimUtils::castBitsToType<T>(bits);
+  } else {
+    return static_cast<pimComputeType<T>>(static_cast<T>(bits));
+  }
+}
+
+//! @brief  Convert scalar value bits to the compute type of T
+template <typename T> inline pimComputeType<T> bitsToScalar(uint64_t bits)
+{
+  if constexpr (std::is_floating_point<T>::value) {
+    return pimUtils::castBitsToType<T>(bits);
+  } else {
+    return static_cast<pimComputeType<T>>(bits);
+  }
+}
+
 //! @brief  PIM CMD: Functional 1-operand
 bool
 pimCmdFunc1::execute()
@@ -463,6 +544,10 @@ pimCmdFunc1::execute()
   }
 
   const pimObjInfo& objSrc = m_device->getResMgr()->getObjInfo(m_src);
+  if (!selectKernel(objSrc.getDataType())) {
+    return false;
+  }
+
   unsigned numRegions = objSrc.getRegions().size();
   computeAllRegions(numRegions);
 
@@ -486,13 +571,117 @@ pimCmdFunc1::sanityCheck() const
   return true;
 }
 
+//! @brief  PIM CMD: Functional 1-operand - type-specialized kernel
+template <typename T, PimCmdEnum CmdType> bool
+pimCmdFunc1::computeKernel(const uint64_t* src, uint64_t* dest, unsigned numElements, uint64_t scalarValue)
+{
+  typedef pimComputeType<T> C;
+  const C scalar = bitsToScalar<T>(scalarValue);
+  if constexpr (CmdType == PimCmdEnum::DIV_SCALAR) {
+    if (scalar == 0) {
+      std::printf("PIM-Error: Division by zero\n");
+      return false;
+    }
+  }
+  for (unsigned j = 0; j < numElements; ++j) {
+    const C operand = bitsToOperand<T>(src[j]);
+    C result = operand;
+    if constexpr (CmdType == PimCmdEnum::ADD_SCALAR) { result = operand + scalar; }
+    else if constexpr (CmdType == PimCmdEnum::SUB_SCALAR) { result = operand - scalar; }
+    else if constexpr (CmdType == PimCmdEnum::MUL_SCALAR) { result = operand * scalar; }
+    else if constexpr (CmdType == PimCmdEnum::DIV_SCALAR) { result = operand / scalar; }
+    else if constexpr (CmdType == PimCmdEnum::AND_SCALAR) { result = operand & scalar; }
+    else if constexpr (CmdType == PimCmdEnum::OR_SCALAR) { result = operand | scalar; }
+    else if constexpr (CmdType == PimCmdEnum::XOR_SCALAR) { result = operand ^ scalar; }
+    else if constexpr (CmdType == PimCmdEnum::XNOR_SCALAR) { result = ~(operand ^ scalar); }
+    else if constexpr (CmdType == PimCmdEnum::GT_SCALAR) { result = (operand > scalar) ? 1 : 0; }
+    else if constexpr (CmdType == PimCmdEnum::LT_SCALAR) { result = (operand < scalar) ? 1 : 0; }
+    else if constexpr (CmdType == PimCmdEnum::EQ_SCALAR) { result = (operand == scalar) ? 1 : 0; }
+    else if constexpr (CmdType == PimCmdEnum::MIN_SCALAR) { result = std::min(operand, scalar); }
+    else if constexpr (CmdType == PimCmdEnum::MAX_SCALAR) { result = std::max(operand, scalar); }
+    else if constexpr (CmdType == PimCmdEnum::POPCOUNT) { result = std::bitset<sizeof(T) * 8>(operand).count(); }
+    else if constexpr (CmdType == PimCmdEnum::SHIFT_BITS_R) { result = operand >> static_cast<uint64_t>(scalar); }
+    else if constexpr (CmdType == PimCmdEnum::SHIFT_BITS_L) { result = operand << static_cast<uint64_t>(scalar); }
+    else if constexpr (CmdType == PimCmdEnum::ABS) {
+      if constexpr (std::is_signed<T>::value) {
+        result = (operand < 0) ? -operand : operand;
+      }
+    }
+    dest[j] = pimUtils::castTypeToBits(result);
+  }
+  return true;
+}
+
+//! @brief  PIM CMD: Functional 1-operand - get kernel of a command type for element type T
+template <typename T> pimCmdFunc1::kernelFunc
+pimCmdFunc1::getKernel(PimCmdEnum cmdType)
+{
+  switch (cmdType) {
+  case PimCmdEnum::ADD_SCALAR: return &computeKernel<T, PimCmdEnum::ADD_SCALAR>;
+  case PimCmdEnum::SUB_SCALAR: return &computeKernel<T, PimCmdEnum::SUB_SCALAR>;
+  case PimCmdEnum::MUL_SCALAR: return &computeKernel<T, PimCmdEnum::MUL_SCALAR>;
+  case PimCmdEnum::DIV_SCALAR: return &computeKernel<T, PimCmdEnum::DIV_SCALAR>;
+  case PimCmdEnum::GT_SCALAR: return &computeKernel<T, PimCmdEnum::GT_SCALAR>;
+  case PimCmdEnum::LT_SCALAR: return &computeKernel<T, PimCmdEnum::LT_SCALAR>;
+  case PimCmdEnum::EQ_SCALAR: return &computeKernel<T, PimCmdEnum::EQ_SCALAR>;
+  case PimCmdEnum::MIN_SCALAR: return &computeKernel<T, PimCmdEnum::MIN_SCALAR>;
+  case PimCmdEnum::MAX_SCALAR: return &computeKernel<T, PimCmdEnum::MAX_SCALAR>;
+  case PimCmdEnum::ABS: return &computeKernel<T, PimCmdEnum::ABS>;
+  case PimCmdEnum::AND_SCALAR:
+  case PimCmdEnum::OR_SCALAR:
+  case PimCmdEnum::XOR_SCALAR:
+  case PimCmdEnum::XNOR_SCALAR:
+  case PimCmdEnum::POPCOUNT:
+  case PimCmdEnum::SHIFT_BITS_R:
+  case PimCmdEnum::SHIFT_BITS_L:
+    if constexpr (std::is_floating_point<T>::value) {
+      std::printf("PIM-Error: Cannot perform bitwise operation on floating point values.\n");
+    } else {
+      switch (cmdType) {
+      case PimCmdEnum::AND_SCALAR: return &computeKernel<T, PimCmdEnum::AND_SCALAR>;
+      case PimCmdEnum::OR_SCALAR: return &computeKernel<T, PimCmdEnum::OR_SCALAR>;
+      case PimCmdEnum::XOR_SCALAR: return &computeKernel<T, PimCmdEnum::XOR_SCALAR>;
+      case PimCmdEnum::XNOR_SCALAR: return &computeKernel<T, PimCmdEnum::XNOR_SCALAR>;
+      case PimCmdEnum::POPCOUNT: return &computeKernel<T, PimCmdEnum::POPCOUNT>;
+      case PimCmdEnum::SHIFT_BITS_R: return &computeKernel<T, PimCmdEnum::SHIFT_BITS_R>;
+      case PimCmdEnum::SHIFT_BITS_L: return &computeKernel<T, PimCmdEnum::SHIFT_BITS_L>;
+      default: break;
+      }
+    }
+    break;
+  default:
+    std::printf("PIM-Error: Unexpected cmd type %d\n", static_cast<int>(cmdType));
+  }
+  return nullptr;
+}
+
+//! @brief  PIM CMD: Functional 1-operand - select kernel once per command based on data type
+bool
+pimCmdFunc1::selectKernel(PimDataType dataType)
+{
+  switch (dataType) {
+  case PIM_INT8: m_kernel = getKernel<int8_t>(m_cmdType); break;
+  case PIM_INT16: m_kernel = getKernel<int16_t>(m_cmdType); break;
+  case PIM_INT32: m_kernel = getKernel<int32_t>(m_cmdType); break;
+  case PIM_INT64: m_kernel = getKernel<int64_t>(m_cmdType); break;
+  case PIM_UINT8: m_kernel = getKernel<uint8_t>(m_cmdType); break;
+  case PIM_UINT16: m_kernel = getKernel<uint16_t>(m_cmdType); break;
+  case PIM_UINT32: m_kernel = getKernel<uint32_t>(m_cmdType); break;
+  case PIM_UINT64: m_kernel = getKernel<uint64_t>(m_cmdType); break;
+  case PIM_FP32: m_kernel = getKernel<float>(m_cmdType); break;
+  default:
+    std::printf("PIM-Error: Unsupported data type %s\n", pimUtils::pimDataTypeEnumToStr(dataType).c_str());
+    m_kernel = nullptr;
+  }
+  return m_kernel != nullptr;
+}
+
 //! @brief  PIM CMD: Functional 1-operand - compute region
 bool
 pimCmdFunc1::computeRegion(unsigned index)
 {
   const pimObjInfo& objSrc = m_device->getResMgr()->getObjInfo(m_src);
   const pimObjInfo& objDest = m_device->getResMgr()->getObjInfo(m_dest);
-  PimDataType dataType = objSrc.getDataType();
   bool isVLayout = objSrc.isVLayout();
   unsigned bitsPerElementSrc = objSrc.getBitsPerElement();
   unsigned bitsPerElementDest = objDest.getBitsPerElement();
@@ -503,34 +692,15 @@ pimCmdFunc1::computeRegion(unsigned index)
   PimCoreId coreId = srcRegion.getCoreId();
   pimCore& core = m_device->getCore(coreId);
 
-  // perform the computation
+  // gather, compute, scatter
   unsigned numElementsInRegion = srcRegion.getNumElemInRegion();
-  for (unsigned j = 0; j < numElementsInRegion; ++j) {
-    if (dataType == PIM_INT8 || dataType == PIM_INT16 || dataType == PIM_INT32 || dataType == PIM_INT64 || dataType == PIM_UINT8 || dataType == PIM_UINT16 || dataType == PIM_UINT32 || dataType == PIM_UINT64 || dataType == PIM_FP32) {
-      auto locSrc = srcRegion.locateIthElemInRegion(j);
-      auto locDest = destRegion.locateIthElemInRegion(j);
-      uint64_t operandBits = getBits(core, isVLayout, locSrc.first, locSrc.second, bitsPerElementSrc);
-      bool isSigned = (dataType == PIM_INT8 || dataType == PIM_INT16 || dataType == PIM_INT32 || dataType == PIM_INT64);
-      if (isSigned) {
-        int64_t signedOperand = pimUtils::signExt(operandBits, dataType);
-        int64_t result = 0;
-        if(!computeResult(signedOperand, m_cmdType, (int64_t)m_scalarValue, result, bitsPerElementSrc)) return false;
-        setBits(core, isVLayout, locDest.first, locDest.second, pimUtils::castTypeToBits(result), bitsPerElementDest);
-      } else if (dataType != PIM_FP32) { // signed int.
-        uint64_t unsignedOperand = operandBits;
-        uint64_t result = 0;
-        if(!computeResult(unsignedOperand, m_cmdType, m_scalarValue, result, bitsPerElementSrc)) return false;
-        setBits(core, isVLayout, locDest.first, locDest.second, result, bitsPerElementDest);
-      } else if (dataType == PIM_FP32){
-        float floatOperand = pimUtils::castBitsToType<float>(operandBits);
-        float result = 0.0;
-        if(!computeResultFP(floatOperand, m_cmdType, pimUtils::castBitsToType<float>(m_scalarValue), result, bitsPerElementSrc)) return false;
-        setBits(core, isVLayout, locDest.first, locDest.second, pimUtils::castTypeToBits(result), bitsPerElementDest);
-      } else {
-      assert(0); // todo: data type
-      }
-    }
+  std::vector<uint64_t> srcBits(numElementsInRegion);
+  std::vector<uint64_t> destBits(numElementsInRegion);
+  getRegionBits(core, isVLayout, srcRegion, bitsPerElementSrc, srcBits.data());
+  if (!m_kernel(srcBits.data(), destBits.data(), numElementsInRegion, m_scalarValue)) {
+    return false;
   }
+  setRegionBits(core, isVLayout, destRegion, bitsPerElementDest, destBits.data());
   return true;
 }
 
@@ -543,8 +713,8 @@ pimCmdFunc1::updateStats() const
   bool isVLayout = objSrc.isVLayout();
 
   
-  pimeval::perfEnergy mPerfEnergy = pimSim::get()->getPerfEnergyModel()->getPerfEnergyForFunc1(m_cmdType, objSrc);
-  pimSim::get()->getStatsMgr()->recordCmd(getName(dataType, isVLayout), mPerfEnergy);
+  pimeval::perfEnergy mPerfEnergy = m_device->getPerfEnergyModel()->getPerfEnergyForFunc1(m_cmdType, objSrc);
+  m_device->getStatsMgr()->recordCmd(m_cmdType, dataType, isVLayout, mPerfEnergy);
   return true;
 }
 
@@ -561,6 +731,10 @@ pimCmdFunc2::execute()
   }
 
   const pimObjInfo& objSrc1 = m_device->getResMgr()->getObjInfo(m_src1);
+  if (!selectKernel(objSrc1.getDataType())) {
+    return false;
+  }
+
   unsigned numRegions = objSrc1.getRegions().size();
   computeAllRegions(numRegions);
 
@@ -585,6 +759,98 @@ pimCmdFunc2::sanityCheck() const
   return true;
 }
 
+//! @brief  PIM CMD: Functional 2-operand - type-specialized kernel
+template <typename T, PimCmdEnum CmdType> bool
+pimCmdFunc2::computeKernel(const uint64_t* src1, const uint64_t* src2, uint64_t* dest, unsigned numElements, uint64_t scalarValue)
+{
+  typedef pimComputeType<T> C;
+  if constexpr (CmdType == PimCmdEnum::DIV) {
+    for (unsigned j = 0; j < numElements; ++j) {
+      if (bitsToOperand<T>(src2[j]) == 0) {
+        std::printf("PIM-Error: Division by zero\n");
+        return false;
+      }
+    }
+  }
+  for (unsigned j = 0; j < numElements; ++j) {
+    const C operand1 = bitsToOperand<T>(src1[j]);
+    const C operand2 = bitsToOperand<T>(src2[j]);
+    C result = 0;
+    if constexpr (CmdType == PimCmdEnum::ADD) { result = operand1 + operand2; }
+    else if constexpr (CmdType == PimCmdEnum::SUB) { result = operand1 - operand2; }
+    else if constexpr (CmdType == PimCmdEnum::MUL) { result = operand1 * operand2; }
+    else if constexpr (CmdType == PimCmdEnum::DIV) { result = operand1 / operand2; }
+    else if constexpr (CmdType == PimCmdEnum::AND) { result = operand1 & operand2; }
+    else if constexpr (CmdType == PimCmdEnum::OR) { result = operand1 | operand2; }
+    else if constexpr (CmdType == PimCmdEnum::XOR) { result = operand1 ^ operand2; }
+    else if constexpr (CmdType == PimCmdEnum::XNOR) { result = ~(operand1 ^ operand2); }
+    else if constexpr (CmdType == PimCmdEnum::GT) { result = operand1 > operand2 ? 1 : 0; }
+    else if constexpr (CmdType == PimCmdEnum::LT) { result = operand1 < operand2 ? 1 : 0; }
+    else if constexpr (CmdType == PimCmdEnum::EQ) { result = operand1 == operand2 ? 1 : 0; }
+    else if constexpr (CmdType == PimCmdEnum::MIN) { result = (operand1 < operand2) ? operand1 : operand2; }
+    else if constexpr (CmdType == PimCmdEnum::MAX) { result = (operand1 > operand2) ? operand1 : operand2; }
+    else if constexpr (CmdType == PimCmdEnum::SCALED_ADD) {
+      // scalar multiply in 64-bit unsigned arithmetic to wrap around without overflow
+      result = static_cast<C>(static_cast<uint64_t>(operand1) * scalarValue + static_cast<uint64_t>(operand2));
+    }
+    dest[j] = pimUtils::castTypeToBits(result);
+  }
+  return true;
+}
+
+//! @brief  PIM CMD: Functional 2-operand - get kernel of a command type for element type T
+template <typename T> pimCmdFunc2::kernelFunc
+pimCmdFunc2::getKernel(PimCmdEnum cmdType)
+{
+  switch (cmdType) {
+  case PimCmdEnum::ADD: return &computeKernel<T, PimCmdEnum::ADD>;
+  case PimCmdEnum::SUB: return &computeKernel<T, PimCmdEnum::SUB>;
+  case PimCmdEnum::MUL: return &computeKernel<T, PimCmdEnum::MUL>;
+  case PimCmdEnum::DIV: return &computeKernel<T, PimCmdEnum::DIV>;
+  default: break;
+  }
+  if constexpr (std::is_floating_point<T>::value) {
+    std::printf("PIM-Error: Unsupported FP32 cmd type %d\n", static_cast<int>(cmdType));
+  } else {
+    switch (cmdType) {
+    case PimCmdEnum::AND: return &computeKernel<T, PimCmdEnum::AND>;
+    case PimCmdEnum::OR: return &computeKernel<T, PimCmdEnum::OR>;
+    case PimCmdEnum::XOR: return &computeKernel<T, PimCmdEnum::XOR>;
+    case PimCmdEnum::XNOR: return &computeKernel<T, PimCmdEnum::XNOR>;
+    case PimCmdEnum::GT: return &computeKernel<T, PimCmdEnum::GT>;
+    case PimCmdEnum::LT: return &computeKernel<T, PimCmdEnum::LT>;
+    case PimCmdEnum::EQ: return &computeKernel<T, PimCmdEnum::EQ>;
+    case PimCmdEnum::MIN: return &computeKernel<T, PimCmdEnum::MIN>;
+    case PimCmdEnum::MAX: return &computeKernel<T, PimCmdEnum::MAX>;
+    case PimCmdEnum::SCALED_ADD: return &computeKernel<T, PimCmdEnum::SCALED_ADD>;
+    default:
+      std::printf("PIM-Error: Unexpected cmd type %d\n", static_cast<int>(cmdType));
+    }
+  }
+  return nullptr;
+}
+
+//! @brief  PIM CMD: Functional 2-operand - select kernel once per command based on data type
+bool
+pimCmdFunc2::selectKernel(PimDataType dataType)
+{
+  switch (dataType) {
+  case PIM_INT8: m_kernel = getKernel<int8_t>(m_cmdType); break;
+  case PIM_INT16: m_kernel = getKernel<int16_t>(m_cmdType); break;
+  case PIM_INT32: m_kernel = getKernel<int32_t>(m_cmdType); break;
+  case PIM_INT64: m_kernel = getKernel<int64_t>(m_cmdType); break;
+  case PIM_UINT8: m_kernel = getKernel<uint8_t>(m_cmdType); break;
+  case PIM_UINT16: m_kernel = getKernel<uint16_t>(m_cmdType); break;
+  case PIM_UINT32: m_kernel = getKernel<uint32_t>(m_cmdType); break;
+  case PIM_UINT64: m_kernel = getKernel<uint64_t>(m_cmdType); break;
+  case PIM_FP32: m_kernel = getKernel<float>(m_cmdType); break;
+  default:
+    std::printf("PIM-Error: Unsupported data type %s\n", pimUtils::pimDataTypeEnumToStr(dataType).c_str());
+    m_kernel = nullptr;
+  }
+  return m_kernel != nullptr;
+}
+
 //! @brief  PIM CMD: Functional 2-operand - compute region
 bool
 pimCmdFunc2::computeRegion(unsigned index)
@@ -593,7 +859,6 @@ pimCmdFunc2::computeRegion(unsigned index)
   const pimObjInfo& objSrc2 = m_device->getResMgr()->getObjInfo(m_src2);
   const pimObjInfo& objDest = m_device->getResMgr()->getObjInfo(m_dest);
 
-  PimDataType dataType = objSrc1.getDataType();
   bool isVLayout = objSrc1.isVLayout();
   unsigned bitsPerElementSrc1 = objSrc1.getBitsPerElement();
   unsigned bitsPerElementSrc2 = objSrc2.getBitsPerElement();
@@ -606,104 +871,17 @@ pimCmdFunc2::computeRegion(unsigned index)
   PimCoreId coreId = src1Region.getCoreId();
   pimCore& core = m_device->getCore(coreId);
 
-  // perform the computation
+  // gather, compute, scatter
   unsigned numElementsInRegion = src1Region.getNumElemInRegion();
-  for (unsigned j = 0; j < numElementsInRegion; ++j) {
-    auto locSrc1 = src1Region.locateIthElemInRegion(j);
-    auto locSrc2 = src2Region.locateIthElemInRegion(j);
-    auto locDest = destRegion.locateIthElemInRegion(j);
-
-    if (dataType == PIM_INT8 || dataType == PIM_INT16 || dataType == PIM_INT32 || dataType == PIM_INT64 || dataType == PIM_UINT8 || dataType == PIM_UINT16 || dataType == PIM_UINT32 || dataType == PIM_UINT64) {
-      uint64_t operandBits1 = getBits(core, isVLayout, locSrc1.first, locSrc1.second, bitsPerElementSrc1);
-      uint64_t operandBits2 = getBits(core, isVLayout, locSrc2.first, locSrc2.second, bitsPerElementSrc2);
-      // The following if-else block is the perfect example of where a Template would have been much more cleaner and efficient and less error prone
-      if (dataType == PIM_INT8 || dataType == PIM_INT16 || dataType == PIM_INT32 || dataType == PIM_INT64) {
-        int64_t operand1 = pimUtils::signExt(operandBits1, dataType);
-        int64_t operand2 = pimUtils::signExt(operandBits2, dataType);
-        int64_t result = 0;
-        switch (m_cmdType) {
-        case PimCmdEnum::ADD: result = operand1 + operand2; break;
-        case PimCmdEnum::SUB: result = operand1 - operand2; break;
-        case PimCmdEnum::MUL: result = operand1 * operand2; break;
-        case PimCmdEnum::DIV:
-          if (operand2 == 0) {
-            std::printf("PIM-Error: Division by zero\n");
-            return false;
-          }
-          result = operand1 / operand2;
-          break;
-        case PimCmdEnum::AND: result = operand1 & operand2; break;
-        case PimCmdEnum::OR: result = operand1 | operand2; break;
-        case PimCmdEnum::XOR: result = operand1 ^ operand2; break;
-        case PimCmdEnum::XNOR: result = ~(operand1 ^ operand2); break;
-        case PimCmdEnum::GT: result = operand1 > operand2 ? 1 : 0; break;
-        case PimCmdEnum::LT: result = operand1 < operand2 ? 1 : 0; break;
-        case PimCmdEnum::EQ: result = operand1 == operand2 ? 1 : 0; break;
-        case PimCmdEnum::MIN: result = (operand1 < operand2) ? operand1 : operand2; break;
-        case PimCmdEnum::MAX: result = (operand1 > operand2) ? operand1 : operand2; break;
-        case PimCmdEnum::SCALED_ADD: result = (operand1 * m_scalarValue) + operand2; break;
-        default:
-          std::printf("PIM-Error: Unexpected cmd type %d\n", m_cmdType);
-          assert(0);
-        }
-        setBits(core, isVLayout, locDest.first, locDest.second, pimUtils::castTypeToBits(result), bitsPerElementdest);
-      } else {
-        uint64_t operand1 = operandBits1;
-        uint64_t operand2 = operandBits2;
-        uint64_t result = 0;
-        switch (m_cmdType) {
-        case PimCmdEnum::ADD: result = operand1 + operand2; break;
-        case PimCmdEnum::SUB: result = operand1 - operand2; break;
-        case PimCmdEnum::MUL: result = operand1 * operand2; break;
-        case PimCmdEnum::DIV:
-          if (operand2 == 0) {
-            std::printf("PIM-Error: Division by zero\n");
-            return false;
-          }
-          result = operand1 / operand2;
-          break;
-        case PimCmdEnum::AND: result = operand1 & operand2; break;
-        case PimCmdEnum::OR: result = operand1 | operand2; break;
-        case PimCmdEnum::XOR: result = operand1 ^ operand2; break;
-        case PimCmdEnum::XNOR: result = ~(operand1 ^ operand2); break;
-        case PimCmdEnum::GT: result = operand1 > operand2 ? 1 : 0; break;
-        case PimCmdEnum::LT: result = operand1 < operand2 ? 1 : 0; break;
-        case PimCmdEnum::EQ: result = operand1 == operand2 ? 1 : 0; break;
-        case PimCmdEnum::MIN: result = (operand1 < operand2) ? operand1 : operand2; break;
-        case PimCmdEnum::MAX: result = (operand1 > operand2) ? operand1 : operand2; break;
-        case PimCmdEnum::SCALED_ADD: result = (operand1 * m_scalarValue) + operand2; break;
-        default:
-          std::printf("PIM-Error: Unexpected cmd type %d\n", m_cmdType);
-          assert(0);
-        }
-        setBits(core, isVLayout, locDest.first, locDest.second, result, bitsPerElementdest);
-      }
-    } else if (dataType == PIM_FP32) {
-      uint64_t operandBits1 = getBits(core, isVLayout, locSrc1.first, locSrc1.second, bitsPerElementSrc1);
-      uint64_t operandBits2 = getBits(core, isVLayout, locSrc2.first, locSrc2.second, bitsPerElementSrc2);
-      float operand1 = pimUtils::castBitsToType<float>(operandBits1);
-      float operand2 = pimUtils::castBitsToType<float>(operandBits2);
-      float result = 0;
-      switch (m_cmdType) {
-      case PimCmdEnum::ADD: result = operand1 + operand2; break;
-      case PimCmdEnum::SUB: result = operand1 - operand2; break;
-      case PimCmdEnum::MUL: result = operand1 * operand2; break;
-      case PimCmdEnum::DIV:
-        if (operand2 == 0) {
-          std::printf("PIM-Error: Division by zero\n");
-          return false;
-        }
-        result = operand1 / operand2;
-        break;
-      default:
-        std::printf("PIM-Error: Unsupported FP32 cmd type %d\n", static_cast<int>(m_cmdType));
-        assert(0);
-      }
-      setBits(core, isVLayout, locDest.first, locDest.second, pimUtils::castTypeToBits(result), bitsPerElementdest);
-    } else {
-      assert(0); // todo: data type
-    }
+  std::vector<uint64_t> src1Bits(numElementsInRegion);
+  std::vector<uint64_t> src2Bits(numElementsInRegion);
+  std::vector<uint64_t> destBits(numElementsInRegion);
+  getRegionBits(core, isVLayout, src1Region, bitsPerElementSrc1, src1Bits.data());
+  getRegionBits(core, isVLayout, src2Region, bitsPerElementSrc2, src2Bits.data());
+  if (!m_kernel(src1Bits.data(), src2Bits.data(), destBits.data(), numElementsInRegion, m_scalarValue)) {
+    return false;
   }
+  setRegionBits(core, isVLayout, destRegion, bitsPerElementdest, destBits.data());
   return true;
 }
 
@@ -715,8 +893,8 @@ pimCmdFunc2::updateStats() const
   PimDataType dataType = objSrc1.getDataType();
   bool isVLayout = objSrc1.isVLayout();
 
-  pimeval::perfEnergy mPerfEnergy = pimSim::get()->getPerfEnergyModel()->getPerfEnergyForFunc2(m_cmdType, objSrc1);
-  pimSim::get()->getStatsMgr()->recordCmd(getName(dataType, isVLayout), mPerfEnergy);
+  pimeval::perfEnergy mPerfEnergy = m_device->getPerfEnergyModel()->getPerfEnergyForFunc2(m_cmdType, objSrc1);
+  m_device->getStatsMgr()->recordCmd(m_cmdType, dataType, isVLayout, mPerfEnergy);
   return true;
 }
 
@@ -775,10 +953,14 @@ pimCmdRedSum<T>::computeRegion(unsigned index)
 
   unsigned numElementsInRegion = srcRegion.getNumElemInRegion();
   uint64_t currIdx = srcRegion.getElemIdxBegin();
+  if (currIdx >= m_idxEnd || currIdx + numElementsInRegion <= m_idxBegin) {
+    return true;
+  }
+  std::vector<uint64_t> srcBits(numElementsInRegion);
+  getRegionBits(core, isVLayout, srcRegion, bitsPerElement, srcBits.data());
   for (unsigned j = 0; j < numElementsInRegion && currIdx < m_idxEnd; ++j) {
     if (currIdx >= m_idxBegin) {
-      auto locSrc = srcRegion.locateIthElemInRegion(j);
-      uint64_t operandBits = getBits(core, isVLayout, locSrc.first, locSrc.second, bitsPerElement);
+      uint64_t operandBits = srcBits[j];
       T operand = pimUtils::signExt(operandBits, objSrc.getDataType());
       m_regionSum[index] += operand;
     }
@@ -818,8 +1000,8 @@ pimCmdRedSum<T>::updateStats() const
     numPass = objSrc.getMaxNumRegionsPerCore();
   }
 
-  pimeval::perfEnergy mPerfEnergy = pimSim::get()->getPerfEnergyModel()->getPerfEnergyForRedSum(m_cmdType, objSrc, numPass);
-  pimSim::get()->getStatsMgr()->recordCmd(getName(dataType, isVLayout), mPerfEnergy);
+  pimeval::perfEnergy mPerfEnergy = m_device->getPerfEnergyModel()->getPerfEnergyForRedSum(m_cmdType, objSrc, numPass);
+  m_device->getStatsMgr()->recordCmd(m_cmdType, dataType, isVLayout, mPerfEnergy);
   return true;
 }
 
@@ -828,7 +1010,7 @@ bool
 pimCmdBroadcast::execute()
 {
   #if defined(DEBUG)
-  std::printf("PIM-Info: %s (obj id %d value %llu)\n", getName().c_str(), m_dest, m_signExtBits);
+  std::printf("PIM-Info: %s (obj id %d value %llu)\n", getName().c_str(), m_dest, (unsigned long long)m_signExtBits);
   #endif
 
   if (!sanityCheck()) {
@@ -868,11 +1050,8 @@ pimCmdBroadcast::computeRegion(unsigned index)
   pimCore &core = m_device->getCore(coreId);
 
   unsigned numElementsInRegion = destRegion.getNumElemInRegion();
-
-  for (unsigned j = 0; j < numElementsInRegion; ++j) {
-    auto locDest = destRegion.locateIthElemInRegion(j);
-    setBits(core, isVLayout, locDest.first, locDest.second, m_signExtBits, bitsPerElement);
-  }
+  std::vector<uint64_t> destBits(numElementsInRegion, m_signExtBits);
+  setRegionBits(core, isVLayout, destRegion, bitsPerElement, destBits.data());
   return true;
 }
 
@@ -884,8 +1063,8 @@ pimCmdBroadcast::updateStats() const
   PimDataType dataType = objDest.getDataType();
   bool isVLayout = objDest.isVLayout();
 
-  pimeval::perfEnergy mPerfEnergy = pimSim::get()->getPerfEnergyModel()->getPerfEnergyForBroadcast(m_cmdType, objDest);
-  pimSim::get()->getStatsMgr()->recordCmd(getName(dataType, isVLayout), mPerfEnergy);
+  pimeval::perfEnergy mPerfEnergy = m_device->getPerfEnergyModel()->getPerfEnergyForBroadcast(m_cmdType, objDest);
+  m_device->getStatsMgr()->recordCmd(m_cmdType, dataType, isVLayout, mPerfEnergy);
   return true;
 }
 
@@ -911,7 +1090,9 @@ pimCmdRotate::execute()
   // handle region boundaries
   bool isVLayout = objSrc.isVLayout();
   unsigned bitsPerElement = objSrc.getBitsPerElement();
-  if (m_cmdType == PimCmdEnum::ROTATE_ELEM_R || m_cmdType == PimCmdEnum::SHIFT_ELEM_R) {
+  if (m_device->isPerfOnly()) {
+    // no functional computation in performance-model-only mode
+  } else if (m_cmdType == PimCmdEnum::ROTATE_ELEM_R || m_cmdType == PimCmdEnum::SHIFT_ELEM_R) {
     for (unsigned i = 0; i < numRegions; ++i) {
       const pimRegion &srcRegion = objSrc.getRegions()[i];
       unsigned coreId = srcRegion.getCoreId();
@@ -974,10 +1155,7 @@ pimCmdRotate::computeRegion(unsigned index)
   // read out values
   unsigned numElementsInRegion = srcRegion.getNumElemInRegion();
   std::vector<uint64_t> regionVector(numElementsInRegion);
-  for (unsigned j = 0; j < numElementsInRegion; ++j) {
-    auto locSrc = srcRegion.locateIthElemInRegion(j);
-    regionVector[j] = getBits(core, isVLayout, locSrc.first, locSrc.second, bitsPerElement);
-  }
+  getRegionBits(core, isVLayout, srcRegion, bitsPerElement, regionVector.data());
 
   // perform rotation
   if (m_cmdType == PimCmdEnum::ROTATE_ELEM_R || m_cmdType == PimCmdEnum::SHIFT_ELEM_R) {
@@ -1001,10 +1179,7 @@ pimCmdRotate::computeRegion(unsigned index)
   }
 
   // write back values
-  for (unsigned j = 0; j < numElementsInRegion; ++j) {
-    auto locSrc = srcRegion.locateIthElemInRegion(j);
-    setBits(core, isVLayout, locSrc.first, locSrc.second, regionVector[j], bitsPerElement);
-  }
+  setRegionBits(core, isVLayout, srcRegion, bitsPerElement, regionVector.data());
   return true;
 }
 
@@ -1016,8 +1191,8 @@ pimCmdRotate::updateStats() const
   PimDataType dataType = objSrc.getDataType();
   bool isVLayout = objSrc.isVLayout();
 
-  pimeval::perfEnergy mPerfEnergy = pimSim::get()->getPerfEnergyModel()->getPerfEnergyForRotate(m_cmdType, objSrc);
-  pimSim::get()->getStatsMgr()->recordCmd(getName(dataType, isVLayout), mPerfEnergy);
+  pimeval::perfEnergy mPerfEnergy = m_device->getPerfEnergyModel()->getPerfEnergyForRotate(m_cmdType, objSrc);
+  m_device->getStatsMgr()->recordCmd(m_cmdType, dataType, isVLayout, mPerfEnergy);
   return true;
 }
 
@@ -1038,13 +1213,15 @@ pimCmdReadRowToSa::execute()
       std::printf("PIM-Error: Row offset %u out of range [0, %u)\n", m_ofst, srcRegion.getNumAllocRows());
       return false;
     }
-    PimCoreId coreId = srcRegion.getCoreId();
-    m_device->getCore(coreId).readRow(srcRegion.getRowIdx() + m_ofst);
+    if (!m_device->isPerfOnly()) {
+      PimCoreId coreId = srcRegion.getCoreId();
+      m_device->getCore(coreId).readRow(srcRegion.getRowIdx() + m_ofst);
+    }
   }
 
   // Update stats
   pimeval::perfEnergy prfEnrgy;
-  pimSim::get()->getStatsMgr()->recordCmd(getName(), prfEnrgy);
+  m_device->getStatsMgr()->recordCmd(m_cmdType, prfEnrgy);
   return true;
 }
 
@@ -1064,13 +1241,15 @@ pimCmdWriteSaToRow::execute()
       std::printf("PIM-Error: Row offset %u out of range [0, %u)\n", m_ofst, srcRegion.getNumAllocRows());
       return false;
     }
-    PimCoreId coreId = srcRegion.getCoreId();
-    m_device->getCore(coreId).writeRow(srcRegion.getRowIdx() + m_ofst);
+    if (!m_device->isPerfOnly()) {
+      PimCoreId coreId = srcRegion.getCoreId();
+      m_device->getCore(coreId).writeRow(srcRegion.getRowIdx() + m_ofst);
+    }
   }
 
   // Update stats
   pimeval::perfEnergy prfEnrgy;
-  pimSim::get()->getStatsMgr()->recordCmd(getName(), prfEnrgy);
+  m_device->getStatsMgr()->recordCmd(m_cmdType, prfEnrgy);
   return true;
 }
 
@@ -1085,96 +1264,121 @@ pimCmdRRegOp::execute()
 
   pimResMgr* resMgr = m_device->getResMgr();
   const pimObjInfo& refObj = resMgr->getObjInfo(m_objId);
-  for (unsigned i = 0; i < refObj.getRegions().size(); ++i) {
+  unsigned numRegions = m_device->isPerfOnly() ? 0 : refObj.getRegions().size();
+  for (unsigned i = 0; i < numRegions; ++i) {
     const pimRegion& refRegion = refObj.getRegions()[i];
     PimCoreId coreId = refRegion.getCoreId();
-    for (unsigned j = 0; j < m_device->getNumCols(); j++) {
-      switch (m_cmdType) {
-      case PimCmdEnum::RREG_MOV:
-      {
-        m_device->getCore(coreId).getRowReg(m_dest)[j] = m_device->getCore(coreId).getRowReg(m_src1)[j];
-        break;
-      }
-      case PimCmdEnum::RREG_SET:
-      {
-        m_device->getCore(coreId).getRowReg(m_dest)[j] = m_val;
-        break;
+    pimCore& core = m_device->getCore(coreId);
+    unsigned numWords = core.getNumWordsPerRow();
+    std::vector<uint64_t>& dest = core.getRowReg(m_dest);
+    switch (m_cmdType) {
+    case PimCmdEnum::RREG_MOV:
+    {
+      const std::vector<uint64_t>& src1 = core.getRowReg(m_src1);
+      for (unsigned w = 0; w < numWords; ++w) {
+        dest[w] = src1[w];
       }
-      case PimCmdEnum::RREG_NOT:
-      {
-        bool src = m_device->getCore(coreId).getRowReg(m_src1)[j];
-        m_device->getCore(coreId).getRowReg(m_dest)[j] = !src;
-        break;
+      break;
+    }
+    case PimCmdEnum::RREG_SET:
+    {
+      uint64_t val = m_val ? ~0ULL : 0ULL;
+      for (unsigned w = 0; w < numWords; ++w) {
+        dest[w] = val;
       }
-      case PimCmdEnum::RREG_AND:
-      {
-        bool src1 = m_device->getCore(coreId).getRowReg(m_src1)[j];
-        bool src2 = m_device->getCore(coreId).getRowReg(m_src2)[j];
-        m_device->getCore(coreId).getRowReg(m_dest)[j] = (src1 & src2);
-        break;
+      break;
+    }
+    case PimCmdEnum::RREG_NOT:
+    {
+      const std::vector<uint64_t>& src1 = core.getRowReg(m_src1);
+      for (unsigned w = 0; w < numWords; ++w) {
+        dest[w] = ~src1[w];
       }
-      case PimCmdEnum::RREG_OR:
-      {
-        bool src1 = m_device->getCore(coreId).getRowReg(m_src1)[j];
-        bool src2 = m_device->getCore(coreId).getRowReg(m_src2)[j];
-        m_device->getCore(coreId).getRowReg(m_dest)[j] = src1 | src2;
-        break;
+      break;
+    }
+    case PimCmdEnum::RREG_AND:
+    {
+      const std::vector<uint64_t>& src1 = core.getRowReg(m_src1);
+      const std::vector<uint64_t>& src2 = core.getRowReg(m_src2);
+      for (unsigned w = 0; w < numWords; ++w) {
+        dest[w] = src1[w] & src2[w];
       }
-      case PimCmdEnum::RREG_NAND:
-      {
-        bool src1 = m_device->getCore(coreId).getRowReg(m_src1)[j];
-        bool src2 = m_device->getCore(coreId).getRowReg(m_src2)[j];
-        m_device->getCore(coreId).getRowReg(m_dest)[j] = !(src1 & src2);
-        break;
+      break;
+    }
+    case PimCmdEnum::RREG_OR:
+    {
+      const std::vector<uint64_t>& src1 = core.getRowReg(m_src1);
+      const std::vector<uint64_t>& src2 = core.getRowReg(m_src2);
+      for (unsigned w = 0; w < numWords; ++w) {
+        dest[w] = src1[w] | src2[w];
       }
-      case PimCmdEnum::RREG_NOR:
-      {
-        bool src1 = m_device->getCore(coreId).getRowReg(m_src1)[j];
-        bool src2 = m_device->getCore(coreId).getRowReg(m_src2)[j];
-        m_device->getCore(coreId).getRowReg(m_dest)[j] = !(src1 | src2);
-        break;
+      break;
+    }
+    case PimCmdEnum::RREG_NAND:
+    {
+      const std::vector<uint64_t>& src1 = core.getRowReg(m_src1);
+      const std::vector<uint64_t>& src2 = core.getRowReg(m_src2);
+      for (unsigned w = 0; w < numWords; ++w) {
+        dest[w] = ~(src1[w] & src2[w]);
       }
-      case PimCmdEnum::RREG_XOR:
-      {
-        bool src1 = m_device->getCore(coreId).getRowReg(m_src1)[j];
-        bool src2 = m_device->getCore(coreId).getRowReg(m_src2)[j];
-        m_device->getCore(coreId).getRowReg(m_dest)[j] = src1 ^ src2;
-        break;
+      break;
+    }
+    case PimCmdEnum::RREG_NOR:
+    {
+      const std::vector<uint64_t>& src1 = core.getRowReg(m_src1);
+      const std::vector<uint64_t>& src2 = core.getRowReg(m_src2);
+      for (unsigned w = 0; w < numWords; ++w) {
+        dest[w] = ~(src1[w] | src2[w]);
       }
-      case PimCmdEnum::RREG_XNOR:
-      {
-        bool src1 = m_device->getCore(coreId).getRowReg(m_src1)[j];
-        bool src2 = m_device->getCore(coreId).getRowReg(m_src2)[j];
-        m_device->getCore(coreId).getRowReg(m_dest)[j] = !(src1 ^ src2);
-        break;
+      break;
+    }
+    case PimCmdEnum::RREG_XOR:
+    {
+      const std::vector<uint64_t>& src1 = core.getRowReg(m_src1);
+      const std::vector<uint64_t>& src2 = core.getRowReg(m_src2);
+      for (unsigned w = 0; w < numWords; ++w) {
+        dest[w] = src1[w] ^ src2[w];
       }
-      case PimCmdEnum::RREG_MAJ:
-      {
-        bool src1 = m_device->getCore(coreId).getRowReg(m_src1)[j];
-        bool src2 = m_device->getCore(coreId).getRowReg(m_src2)[j];
-        bool src3 = m_device->getCore(coreId).getRowReg(m_src3)[j];
-        m_device->getCore(coreId).getRowReg(m_dest)[j] =
-            ((src1 & src2) || (src1 & src3) || (src2 & src3));
-        break;
+      break;
+    }
+    case PimCmdEnum::RREG_XNOR:
+    {
+      const std::vector<uint64_t>& src1 = core.getRowReg(m_src1);
+      const std::vector<uint64_t>& src2 = core.getRowReg(m_src2);
+      for (unsigned w = 0; w < numWords; ++w) {
+        dest[w] = ~(src1[w] ^ src2[w]);
       }
-      case PimCmdEnum::RREG_SEL:
-      {
-        bool cond = m_device->getCore(coreId).getRowReg(m_src1)[j];
-        bool src2 = m_device->getCore(coreId).getRowReg(m_src2)[j];
-        bool src3 = m_device->getCore(coreId).getRowReg(m_src3)[j];
-        m_device->getCore(coreId).getRowReg(m_dest)[j] = (cond ? src2 : src3);
-        break;
+      break;
+    }
+    case PimCmdEnum::RREG_MAJ:
+    {
+      const std::vector<uint64_t>& src1 = core.getRowReg(m_src1);
+      const std::vector<uint64_t>& src2 = core.getRowReg(m_src2);
+      const std::vector<uint64_t>& src3 = core.getRowReg(m_src3);
+      for (unsigned w = 0; w < numWords; ++w) {
+        dest[w] = (src1[w] & src2[w]) | (src1[w] & src3[w]) | (src2[w] & src3[w]);
       }
-      default:
-        std::printf("PIM-Error: Unexpected cmd type %d\n", static_cast<int>(m_cmdType));
-        assert(0);
+      break;
+    }
+    case PimCmdEnum::RREG_SEL:
+    {
+      const std::vector<uint64_t>& cond = core.getRowReg(m_src1);
+      const std::vector<uint64_t>& src2 = core.getRowReg(m_src2);
+      const std::vector<uint64_t>& src3 = core.getRowReg(m_src3);
+      for (unsigned w = 0; w < numWords; ++w) {
+        dest[w] = (cond[w] & src2[w]) | (~cond[w] & src3[w]);
       }
+      break;
+    }
+    default:
+      std::printf("PIM-Error: Unexpected cmd type %d\n", static_cast<int>(m_cmdType));
+      assert(0);
     }
   }
 
   // Update stats
   pimeval::perfEnergy prfEnrgy;
-  pimSim::get()->getStatsMgr()->recordCmd(getName(), prfEnrgy);
+  m_device->getStatsMgr()->recordCmd(m_cmdType, prfEnrgy);
   return true;
 }
 
@@ -1189,15 +1393,17 @@ pimCmdRRegRotate::execute()
 
   pimResMgr* resMgr = m_device->getResMgr();
   const pimObjInfo& objSrc = resMgr->getObjInfo(m_objId);
-  if (m_cmdType == PimCmdEnum::RREG_ROTATE_R) {  // Right Rotate
+  if (m_device->isPerfOnly()) {
+    // no functional computation in performance-model-only mode
+  } else if (m_cmdType == PimCmdEnum::RREG_ROTATE_R) {  // Right Rotate
     bool prevVal = 0;
     for (unsigned i = 0; i < objSrc.getRegions().size(); ++i) {
       const pimRegion &srcRegion = objSrc.getRegions()[i];
       PimCoreId coreId = srcRegion.getCoreId();
       for (unsigned j = 0; j < srcRegion.getNumAllocCols(); ++j) {
         unsigned colIdx = srcRegion.getColIdx() + j;
-        bool tmp = m_device->getCore(coreId).getRowReg(m_dest)[colIdx];
-        m_device->getCore(coreId).getRowReg(m_dest)[colIdx] = prevVal;
+        bool tmp = m_device->getCore(coreId).getRowRegBit(m_dest, colIdx);
+        m_device->getCore(coreId).setRowRegBit(m_dest, colIdx, prevVal);
         prevVal = tmp;
       }
     }
@@ -1205,7 +1411,7 @@ pimCmdRRegRotate::execute()
     const pimRegion &firstRegion = objSrc.getRegions().front();
     PimCoreId firstCoreId = firstRegion.getCoreId();
     unsigned firstColIdx = firstRegion.getColIdx();
-    m_device->getCore(firstCoreId).getRowReg(m_dest)[firstColIdx] = prevVal;
+    m_device->getCore(firstCoreId).setRowRegBit(m_dest, firstColIdx, prevVal);
   } else if (m_cmdType == PimCmdEnum::RREG_ROTATE_L) {  // Left Rotate
     bool prevVal = 0;
     for (unsigned i = objSrc.getRegions().size(); i > 0; --i) {
@@ -1213,8 +1419,8 @@ pimCmdRRegRotate::execute()
       PimCoreId coreId = srcRegion.getCoreId();
       for (unsigned j = srcRegion.getNumAllocCols(); j > 0; --j) {
         unsigned colIdx = srcRegion.getColIdx() + j - 1;
-        bool tmp = m_device->getCore(coreId).getRowReg(m_dest)[colIdx];
-        m_device->getCore(coreId).getRowReg(m_dest)[colIdx] = prevVal;
+        bool tmp = m_device->getCore(coreId).getRowRegBit(m_dest, colIdx);
+        m_device->getCore(coreId).setRowRegBit(m_dest, colIdx, prevVal);
         prevVal = tmp;
       }
     }
@@ -1222,12 +1428,12 @@ pimCmdRRegRotate::execute()
     const pimRegion &lastRegion = objSrc.getRegions().back();
     PimCoreId lastCoreId = lastRegion.getCoreId();
     unsigned lastColIdx = lastRegion.getColIdx() + lastRegion.getNumAllocCols() - 1;
-    m_device->getCore(lastCoreId).getRowReg(m_dest)[lastColIdx] = prevVal;
+    m_device->getCore(lastCoreId).setRowRegBit(m_dest, lastColIdx, prevVal);
   }
 
   // Update stats
   pimeval::perfEnergy prfEnrgy;
-  pimSim::get()->getStatsMgr()->recordCmd(getName(), prfEnrgy);
+  m_device->getStatsMgr()->recordCmd(m_cmdType, prfEnrgy);
   return true;
 }
 
@@ -1249,10 +1455,6 @@ pimCmdAnalogAAP::execute()
   // 1st activate: compute majority
   std::unordered_set<unsigned> visitedRows;
   for (unsigned i = 0; i < objSrc.getRegions().size(); ++i) {
-    const pimRegion& srcRegion = objSrc.getRegions()[i];
-    PimCoreId coreId = srcRegion.getCoreId();
-    pimCore &core = m_device->getCore(coreId);
-
     std::vector<std::pair<unsigned, bool>> rowIdxs;
     for (const auto& objOfst : m_srcRows) {
       if (!isValidObjId(resMgr, objOfst.first)) {
@@ -1275,16 +1477,15 @@ pimCmdAnalogAAP::execute()
         }
       }
     }
-    core.readMultiRows(rowIdxs);
+    if (!m_device->isPerfOnly()) {
+      PimCoreId coreId = objSrc.getRegions()[i].getCoreId();
+      m_device->getCore(coreId).readMultiRows(rowIdxs);
+    }
   }
 
   // 2nd activate: write multiple rows
   if (!m_destRows.empty()) {
     for (unsigned i = 0; i < objSrc.getRegions().size(); ++i) {
-      const pimRegion& srcRegion = objSrc.getRegions()[i];
-      PimCoreId coreId = srcRegion.getCoreId();
-      pimCore &core = m_device->getCore(coreId);
-
       std::vector<std::pair<unsigned, bool>> rowIdxs;
       for (const auto& objOfst : m_destRows) {
         if (!isValidObjId(resMgr, objOfst.first)) {
@@ -1307,15 +1508,16 @@ pimCmdAnalogAAP::execute()
           }
         }
       }
-      core.writeMultiRows(rowIdxs);
+      if (!m_device->isPerfOnly()) {
+        PimCoreId coreId = objSrc.getRegions()[i].getCoreId();
+        m_device->getCore(coreId).writeMultiRows(rowIdxs);
+      }
     }
   }
 
   // Update stats
-  std::string cmdName = getName();
-  cmdName += "@" + std::to_string(m_srcRows.size()) + "," + std::to_string(m_destRows.size());
   pimeval::perfEnergy prfEnrgy;
-  pimSim::get()->getStatsMgr()->recordCmd(cmdName, prfEnrgy);
+  m_device->getStatsMgr()->recordCmd(m_cmdType, m_srcRows.size(), m_destRows.size(), prfEnrgy);
   return true;
 }
 
@@ -87,6 +87,8 @@ enum class PimCmdEnum {
   // SIMDRAM
   ROW_AP,
   ROW_AAP,
+  // Resource management
+  ROW_CLONE,
 };
 
 
@@ -100,6 +102,14 @@ public:
 
   void setDevice(pimDevice* device) { m_device = device; }
   virtual bool execute() = 0;
+  PimCmdEnum getCmdType() const { return m_cmdType; }
+
+  //! @brief  Get PIM objects accessed by this command. Return false if it accesses device-wide states
+  virtual bool getObjIds(std::vector<PimObjId>& objIds) const { return false; }
+  //! @brief  Get bytes transferred over the data bus of each rank. Return false if it is not a host-device copy
+  virtual bool getNumBytesPerRank(std::vector<uint64_t>& numBytesPerRank) const { return false; }
+  //! @brief  Check if command arguments are valid. Commands without argument checks are always valid
+  virtual bool sanityCheck() const { return true; }
 
   std::string getName() const {
     return getName(m_cmdType, "");
@@ -119,7 +129,6 @@ protected:
 
   unsigned getNumElementsInRegion(const pimRegion& region, unsigned bitsPerElement) const;
 
-  virtual bool sanityCheck() const { return false; }
   virtual bool computeRegion(unsigned index) { return false; }
   virtual bool updateStats() const { return false; }
   bool computeAllRegions(unsigned numRegions);
@@ -140,22 +149,48 @@ protected:
     }
   }
 
-  PimCmdEnum m_cmdType;
-  pimDevice* m_device = nullptr;
+  //! @brief  Utility: Get bits of all elements in a region. The bits are stored as uint64_t without sign extension
+  inline void getRegionBits(const pimCore& core, bool isVLayout, const pimRegion& region, unsigned numBits, uint64_t* out) const
+  {
+    getRegionBits(core, isVLayout, region, numBits, out, 0, region.getNumElemInRegion());
+  }
+
+  //! @brief  Utility: Get bits of #numElements elements in a region starting from the elemBegin-th element
+  inline void getRegionBits(const pimCore& core, bool isVLayout, const pimRegion& region, unsigned numBits, uint64_t* out,
+                            unsigned elemBegin, unsigned numElements) const
+  {
+    if (isVLayout) {
+      core.getElementsV(region.getColIdx() + elemBegin, numElements, region.getRowIdx(), numBits, out);
+    } else {
+      for (unsigned j = 0; j < numElements; ++j) {
+        auto loc = region.locateIthElemInRegion(elemBegin + j);
+        out[j] = core.getBitsH(loc.first, loc.second, numBits);
+      }
+    }
+  }
+
+  //! @brief  Utility: Set bits of all elements in a region
+  inline void setRegionBits(pimCore& core, bool isVLayout, const pimRegion& region, unsigned numBits, const uint64_t* in) const
+  {
+    setRegionBits(core, isVLayout, region, numBits, in, 0, region.getNumElemInRegion());
+  }
 
-  //! @class  pimCmd::regionWorker
-  //! @brief  Thread worker to process regions in parallel
-  class regionWorker : public pimUtils::threadWorker {
-  public:
-    regionWorker(pimCmd* cmd, unsigned regionIdx) : m_cmd(cmd), m_regionIdx(regionIdx) {}
-    virtual ~regionWorker() {}
-    virtual void execute() {
-      m_cmd->computeRegion(m_regionIdx);
+  //! @brief  Utility: Set bits of #numElements elements in a region starting from the elemBegin-th element
+  inline void setRegionBits(pimCore& core, bool isVLayout, const pimRegion& region, unsigned numBits, const uint64_t* in,
+                            unsigned elemBegin, unsigned numElements) const
+  {
+    if (isVLayout) {
+      core.setElementsV(region.getColIdx() + elemBegin, numElements, region.getRowIdx(), numBits, in);
+    } else {
+      for (unsigned j = 0; j < numElements; ++j) {
+        auto loc = region.locateIthElemInRegion(elemBegin + j);
+        core.setBitsH(loc.first, loc.second, in[j], numBits);
+      }
     }
-  private:
-    pimCmd* m_cmd = nullptr;
-    unsigned m_regionIdx = 0;
-  };
+  }
+
+  PimCmdEnum m_cmdType;
+  pimDevice* m_device = nullptr;
 };
 
 //! @class  pimCmdDataTransfer
@@ -172,10 +207,20 @@ public:
 
   virtual ~pimCmdCopy() {}
   virtual bool execute() override;
+  virtual bool getObjIds(std::vector<PimObjId>& objIds) const override {
+    if (m_src >= 0) objIds.push_back(m_src);
+    if (m_dest >= 0) objIds.push_back(m_dest);
+    return true;
+  }
+  virtual bool getNumBytesPerRank(std::vector<uint64_t>& numBytesPerRank) const override;
   virtual bool sanityCheck() const override;
   virtual bool computeRegion(unsigned index) override;
   virtual bool updateStats() const override;
 protected:
+  bool isElementCopy(const pimObjInfo& obj, const pimRegion& region) const;
+  void copyRegionElements(unsigned index);
+  void copyRegionBits(unsigned index);
+
   PimCopyEnum m_copyType;
   void* m_ptr = nullptr;
   PimObjId m_src = -1;
@@ -194,6 +239,7 @@ public:
     : pimCmd(cmdType), m_src(src), m_dest(dest), m_scalarValue(scalarValue) {}
   virtual ~pimCmdFunc1() {}
   virtual bool execute() override;
+  virtual bool getObjIds(std::vector<PimObjId>& objIds) const override { objIds.push_back(m_src); objIds.push_back(m_dest); return true; }
   virtual bool sanityCheck() const override;
   virtual bool computeRegion(unsigned index) override;
   virtual bool updateStats() const override;
@@ -202,101 +248,13 @@ protected:
   PimObjId m_dest;
   uint64_t m_scalarValue;
 private:
-  template<typename T>
-  inline bool computeResult(T operand, PimCmdEnum cmdType, T scalarValue, T& result, int bitsPerElementSrc) {
-    result = operand;
-    switch (cmdType) {
-    case PimCmdEnum::ADD_SCALAR: result += scalarValue; break;
-    case PimCmdEnum::SUB_SCALAR: result -= scalarValue; break;
-    case PimCmdEnum::MUL_SCALAR: result *= scalarValue; break;
-    case PimCmdEnum::DIV_SCALAR:
-        if (scalarValue == 0) {
-            std::printf("PIM-Error: Division by zero\n");
-            return false;
-        }
-        result /= scalarValue;
-        break;
-    case PimCmdEnum::AND_SCALAR: result &= scalarValue; break;
-    case PimCmdEnum::OR_SCALAR: result |= scalarValue; break;
-    case PimCmdEnum::XOR_SCALAR: result ^= scalarValue; break;
-    case PimCmdEnum::XNOR_SCALAR: result = ~(operand ^ scalarValue); break;
-    case PimCmdEnum::GT_SCALAR: result = (operand > scalarValue) ? 1 : 0; break;
-    case PimCmdEnum::LT_SCALAR: result = (operand < scalarValue) ? 1 : 0; break;
-    case PimCmdEnum::EQ_SCALAR: result = (operand == scalarValue) ? 1 : 0; break;
-    case PimCmdEnum::MIN_SCALAR: result = std::min(operand, scalarValue); break;
-    case PimCmdEnum::MAX_SCALAR: result = std::max(operand, scalarValue); break;
-    case PimCmdEnum::POPCOUNT:
-        switch (bitsPerElementSrc) {
-        case 8: result = std::bitset<8>(operand).count(); break;
-        case 16: result = std::bitset<16>(operand).count(); break;
-        case 32: result = std::bitset<32>(operand).count(); break;
-        case 64: result = std::bitset<64>(operand).count(); break;
-        default:
-            std::printf("PIM-Error: Unsupported bits per element %u\n", bitsPerElementSrc);
-            return false;
-        }
-        break;
-    case PimCmdEnum::SHIFT_BITS_R: result >>= static_cast<uint64_t>(scalarValue); break;
-    case PimCmdEnum::SHIFT_BITS_L: result <<= static_cast<uint64_t>(scalarValue); break;
-    case PimCmdEnum::ABS:
-    {
-        if (std::is_signed<T>::value) {
-          result = (operand < 0) ? -operand : operand;
-        } else {
-          result = operand;
-        }
-        break;
-    }
-    default:
-        std::printf("PIM-Error: Unexpected cmd type %d\n", static_cast<int>(cmdType));
-        assert(0);
-    }
-    return true;
-  }
+  //! @brief  Type-specialized kernel: compute numElements results from raw source bits
+  typedef bool (*kernelFunc)(const uint64_t* src, uint64_t* dest, unsigned numElements, uint64_t scalarValue);
+  template <typename T> static kernelFunc getKernel(PimCmdEnum cmdType);
+  template <typename T, PimCmdEnum CmdType> static bool computeKernel(const uint64_t* src, uint64_t* dest, unsigned numElements, uint64_t scalarValue);
+  bool selectKernel(PimDataType dataType);
 
-  template<typename T>
-  inline bool computeResultFP(T operand, PimCmdEnum cmdType, T scalerValue, T& result, int bitsPerElementSrc) {
-    result = operand;
-    switch (cmdType) {
-    case PimCmdEnum::ADD_SCALAR: result += scalerValue; break;
-    case PimCmdEnum::SUB_SCALAR: result -= scalerValue; break;
-    case PimCmdEnum::MUL_SCALAR: result *= scalerValue; break;
-    case PimCmdEnum::DIV_SCALAR:
-        if (scalerValue == 0) {
-            std::printf("PIM-Error: Division by zero\n");
-            return false;
-        }
-        result /= scalerValue;
-        break;
-    case PimCmdEnum::GT_SCALAR: result = (operand > scalerValue) ? 1 : 0; break;
-    case PimCmdEnum::LT_SCALAR: result = (operand < scalerValue) ? 1 : 0; break;
-    case PimCmdEnum::EQ_SCALAR: result = (operand == scalerValue) ? 1 : 0; break;
-    case PimCmdEnum::MIN_SCALAR: result = std::min(operand, scalerValue); break;
-    case PimCmdEnum::MAX_SCALAR: result = std::max(operand, scalerValue); break;
-    case PimCmdEnum::ABS:
-    {
-        if (std::is_signed<T>::value) {
-          result = (operand < 0) ? -operand : operand;
-        } else {
-          result = operand;
-        }
-        break;
-    }
-    case PimCmdEnum::AND_SCALAR:
-    case PimCmdEnum::OR_SCALAR:
-    case PimCmdEnum::XOR_SCALAR:
-    case PimCmdEnum::XNOR_SCALAR:
-    case PimCmdEnum::POPCOUNT:
-    case PimCmdEnum::SHIFT_BITS_R:
-    case PimCmdEnum::SHIFT_BITS_L:
-        std::printf("PIM-Error: Cannot perform bitwise operation on floating point values.\n");
-        return false;
-    default:
-        std::printf("PIM-Error: Unexpected cmd type %d\n", static_cast<int>(cmdType));
-        assert(0);
-    }
-    return true;
-  }
+  kernelFunc m_kernel = nullptr;
 };
 
 //! @class  pimCmdFunc2
@@ -310,6 +268,7 @@ public:
     : pimCmd(cmdType), m_src1(src1), m_src2(src2), m_dest(dest), m_scalarValue(scalarValue) {}
   virtual ~pimCmdFunc2() {}
   virtual bool execute() override;
+  virtual bool getObjIds(std::vector<PimObjId>& objIds) const override { objIds.push_back(m_src1); objIds.push_back(m_src2); objIds.push_back(m_dest); return true; }
   virtual bool sanityCheck() const override;
   virtual bool computeRegion(unsigned index) override;
   virtual bool updateStats() const override;
@@ -317,7 +276,15 @@ protected:
   PimObjId m_src1;
   PimObjId m_src2;
   PimObjId m_dest;
-  uint64_t m_scalarValue;
+  uint64_t m_scalarValue = 0;
+private:
+  //! @brief  Type-specialized kernel: compute numElements results from two raw source bit buffers
+  typedef bool (*kernelFunc)(const uint64_t* src1, const uint64_t* src2, uint64_t* dest, unsigned numElements, uint64_t scalarValue);
+  template <typename T> static kernelFunc getKernel(PimCmdEnum cmdType);
+  template <typename T, PimCmdEnum CmdType> static bool computeKernel(const uint64_t* src1, const uint64_t* src2, uint64_t* dest, unsigned numElements, uint64_t scalarValue);
+  bool selectKernel(PimDataType dataType);
+
+  kernelFunc m_kernel = nullptr;
 };
 
 //! @class  pimCmdedSum
@@ -337,6 +304,7 @@ public:
   }
   virtual ~pimCmdRedSum() {}
   virtual bool execute() override;
+  virtual bool getObjIds(std::vector<PimObjId>& objIds) const override { objIds.push_back(m_src); return true; }
   virtual bool sanityCheck() const override;
   virtual bool computeRegion(unsigned index) override;
   virtual bool updateStats() const override;
@@ -360,6 +328,7 @@ public:
   }
   virtual ~pimCmdBroadcast() {}
   virtual bool execute() override;
+  virtual bool getObjIds(std::vector<PimObjId>& objIds) const override { objIds.push_back(m_dest); return true; }
   virtual bool sanityCheck() const override;
   virtual bool computeRegion(unsigned index) override;
   virtual bool updateStats() const override;
@@ -381,6 +350,7 @@ public:
   }
   virtual ~pimCmdRotate() {}
   virtual bool execute() override;
+  virtual bool getObjIds(std::vector<PimObjId>& objIds) const override { objIds.push_back(m_src); return true; }
   virtual bool sanityCheck() const override;
   virtual bool computeRegion(unsigned index) override;
   virtual bool updateStats() const override;
@@ -5,31 +5,22 @@
 // See the LICENSE file in the root of this repository for more details.
 
 #include "pimCore.h"
+#include "pimCheckpoint.h"
 #include <random>
 #include <cstdio>
 #include <iomanip>
 #include <sstream>
+#include <algorithm>
 
 
 //! @brief  pimCore ctor
 pimCore::pimCore(unsigned numRows, unsigned numCols)
   : m_numRows(numRows),
     m_numCols(numCols),
-    m_array(numRows, std::vector<bool>(numCols)),
+    m_numWordsPerRow((numCols + 63) / 64),
+    m_lastWordMask(numCols % 64 == 0 ? ~0ULL : ((1ULL << (numCols % 64)) - 1)),
     m_senseAmpCol(numRows)
 {
-  // Initialize memory contents with random 0/1
-  if (0) {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<int> dist(0, 1);
-    for (unsigned row = 0; row < m_numRows; ++row) {
-      for (unsigned col = 0; col < m_numCols; ++col) {
-        m_array[row][col] = dist(gen);
-      }
-    }
-  }
-
   declareRowReg(PIM_RREG_SA);
   declareRowReg(PIM_RREG_R1);
   declareRowReg(PIM_RREG_R2);
@@ -43,11 +34,114 @@ pimCore::~pimCore()
 {
 }
 
+//! @brief  Allocate zero-initialized memory array on first touch. Return true if newly allocated
+bool
+pimCore::materialize()
+{
+  if (isMaterialized()) {
+    return false;
+  }
+  m_array.assign((size_t)m_numRows * m_numWordsPerRow, 0ULL);
+
+  // Initialize memory contents with random 0/1
+  if (0) {
+    std::random_device rd;
+    std::mt19937_64 gen(rd());
+    for (unsigned row = 0; row < m_numRows; ++row) {
+      uint64_t* rowWords = getRowWords(row);
+      for (unsigned w = 0; w < m_numWordsPerRow; ++w) {
+        rowWords[w] = gen();
+      }
+      rowWords[m_numWordsPerRow - 1] &= m_lastWordMask;
+    }
+  }
+  return true;
+}
+
+//! @brief  Zero memory array and row registers, e.g., before restoring a checkpoint
+void
+pimCore::clear()
+{
+  std::fill(m_array.begin(), m_array.end(), 0ULL);
+  for (auto& reg : m_rowRegs) {
+    std::fill(reg.begin(), reg.end(), 0ULL);
+  }
+}
+
+//! @brief  Save row registers and runs of non-zero memory rows of a materialized core
+void
+pimCore::saveCheckpoint(pimCheckpointWriter& writer) const
+{
+  writer.write(static_cast<uint32_t>(m_rowRegs.size()));
+  for (const auto& reg : m_rowRegs) {
+    writer.writeBytes(reg.data(), reg.size() * sizeof(uint64_t));
+  }
+
+  // find runs of non-zero rows
+  std::vector<std::pair<uint32_t, uint32_t>> runs; // (row index, number of rows)
+  for (unsigned row = 0; row < m_numRows; ++row) {
+    const uint64_t* rowWords = getRowWords(row);
+    if (std::all_of(rowWords, rowWords + m_numWordsPerRow, [](uint64_t word) { return word == 0; })) {
+      continue;
+    }
+    if (!runs.empty() && runs.back().first + runs.back().second == row) {
+      runs.back().second++;
+    } else {
+      runs.emplace_back(row, 1);
+    }
+  }
+  writer.write(static_cast<uint32_t>(runs.size()));
+  for (const auto& [rowIdx, numRows] : runs) {
+    writer.write(rowIdx);
+    writer.write(numRows);
+  }
+  for (const auto& [rowIdx, numRows] : runs) {
+    writer.alignTo(64);
+    writer.writeBytes(getRowWords(rowIdx), (uint64_t)numRows * m_numWordsPerRow * sizeof(uint64_t));
+  }
+}
+
+//! @brief  Restore row registers and memory rows of a materialized core. Rows not in the checkpoint are zeros
+bool
+pimCore::loadCheckpoint(pimCheckpointReader& reader)
+{
+  clear();
+  uint32_t numRegs = 0;
+  if (!reader.read(numRegs) || numRegs != m_rowRegs.size()) {
+    return false;
+  }
+  for (auto& reg : m_rowRegs) {
+    if (!reader.readBytes(reg.data(), reg.size() * sizeof(uint64_t))) {
+      return false;
+    }
+  }
+  uint32_t numRuns = 0;
+  if (!reader.read(numRuns)) {
+    return false;
+  }
+  std::vector<std::pair<uint32_t, uint32_t>> runs(numRuns);
+  for (auto& [rowIdx, numRows] : runs) {
+    if (!reader.read(rowIdx) || !reader.read(numRows) || (uint64_t)rowIdx + numRows > m_numRows) {
+      return false;
+    }
+  }
+  for (const auto& [rowIdx, numRows] : runs) {
+    if (!reader.alignTo(64) ||
+        !reader.readBytes(getRowWords(rowIdx), (uint64_t)numRows * m_numWordsPerRow * sizeof(uint64_t))) {
+      return false;
+    }
+  }
+  return true;
+}
+
 //! @brief  Initialize a row reg
 bool
 pimCore::declareRowReg(PimRowReg reg)
 {
-  m_rowRegs[reg].resize(m_numCols);
+  if (m_rowRegs.size() <= static_cast<size_t>(reg)) {
+    m_rowRegs.resize(static_cast<size_t>(reg) + 1);
+  }
+  m_rowRegs[reg].resize(m_numWordsPerRow);
   return true;
 }
 
@@ -59,7 +153,8 @@ pimCore::readRow(unsigned rowIndex)
     std::printf("PIM-Error: Out-of-boundary subarray row read: index = %u, numRows = %u\n", rowIndex, m_numRows);
     return false;
   }
-  m_rowRegs[PIM_RREG_SA] = m_array[rowIndex];
+  const uint64_t* rowWords = getRowWords(rowIndex);
+  std::copy(rowWords, rowWords + m_numWordsPerRow, m_rowRegs[PIM_RREG_SA].begin());
   return true;
 }
 
@@ -72,7 +167,7 @@ pimCore::readCol(unsigned colIndex)
     return false;
   }
   for (unsigned row = 0; row < m_numRows; ++row) {
-    m_senseAmpCol[row] = m_array[row][colIndex];
+    m_senseAmpCol[row] = getBit(row, colIndex);
   }
   return true;
 }
@@ -93,22 +188,35 @@ pimCore::readMultiRows(const std::vector<std::pair<unsigned, bool>>& rowIdxs)
       return false;
     }
   }
-  // compute majority
-  for (unsigned col = 0; col < m_numCols; ++col) {
-    unsigned sum = 0;
-    for (const auto& kv : rowIdxs) {
-      unsigned idx = kv.first;
-      bool isDCCN = kv.second;
-      bool val = (isDCCN ? !m_array[idx][col] : m_array[idx][col]);
-      sum += val ? 1 : 0;
+  // compute majority word by word
+  std::vector<uint64_t>& sa = m_rowRegs[PIM_RREG_SA];
+  unsigned numRowsToRead = rowIdxs.size();
+  std::vector<uint64_t> vals(numRowsToRead);
+  for (unsigned w = 0; w < m_numWordsPerRow; ++w) {
+    for (unsigned i = 0; i < numRowsToRead; ++i) {
+      uint64_t word = getRowWords(rowIdxs[i].first)[w];
+      vals[i] = (rowIdxs[i].second ? ~word : word);
+    }
+    uint64_t maj = 0;
+    if (numRowsToRead == 1) {
+      maj = vals[0];
+    } else if (numRowsToRead == 3) {
+      maj = (vals[0] & vals[1]) | (vals[0] & vals[2]) | (vals[1] & vals[2]);
+    } else {
+      for (unsigned bit = 0; bit < 64; ++bit) {
+        unsigned sum = 0;
+        for (unsigned i = 0; i < numRowsToRead; ++i) {
+          sum += (vals[i] >> bit) & 1ULL;
+        }
+        maj |= (uint64_t)(sum > numRowsToRead / 2) << bit;
+      }
     }
-    bool maj = (sum > rowIdxs.size() / 2);
+    uint64_t validMask = (w == m_numWordsPerRow - 1 ? m_lastWordMask : ~0ULL);
+    maj &= validMask;
     for (const auto& kv : rowIdxs) {
-      unsigned idx = kv.first;
-      bool isDCCN = kv.second;
-      m_array[idx][col] = (isDCCN ? !maj : maj);
+      getRowWords(kv.first)[w] = (kv.second ? ~maj : maj) & validMask;
     }
-    m_rowRegs[PIM_RREG_SA][col] = maj;
+    sa[w] = maj;
   }
   return true;
 }
@@ -126,13 +234,14 @@ pimCore::writeMultiRows(const std::vector<std::pair<unsigned, bool>>& rowIdxs)
     }
   }
   // write
-  for (unsigned col = 0; col < m_numCols; ++col) {
-    bool val = m_rowRegs[PIM_RREG_SA][col];
-    for (const auto& kv : rowIdxs) {
-      unsigned idx = kv.first;
-      bool isDCCN = kv.second;
-      m_array[idx][col] = (isDCCN ? !val :val);
+  const std::vector<uint64_t>& sa = m_rowRegs[PIM_RREG_SA];
+  for (const auto& kv : rowIdxs) {
+    uint64_t* rowWords = getRowWords(kv.first);
+    bool isDCCN = kv.second;
+    for (unsigned w = 0; w < m_numWordsPerRow; ++w) {
+      rowWords[w] = (isDCCN ? ~sa[w] : sa[w]);
     }
+    rowWords[m_numWordsPerRow - 1] &= m_lastWordMask;
   }
   return true;
 }
@@ -145,7 +254,10 @@ pimCore::writeRow(unsigned rowIndex)
     std::printf("PIM-Error: Out-of-boundary subarray row write: index = %u, numRows = %u\n", rowIndex, m_numRows);
     return false;
   }
-  m_array[rowIndex] = m_rowRegs[PIM_RREG_SA];
+  uint64_t* rowWords = getRowWords(rowIndex);
+  const std::vector<uint64_t>& sa = m_rowRegs[PIM_RREG_SA];
+  std::copy(sa.begin(), sa.end(), rowWords);
+  rowWords[m_numWordsPerRow - 1] &= m_lastWordMask;
   return true;
 }
 
@@ -158,17 +270,17 @@ pimCore::writeCol(unsigned colIndex)
     return false;
   }
   for (unsigned row = 0; row < m_numRows; ++row) {
-    m_array[row][colIndex] = m_senseAmpCol[row];
+    setBit(row, colIndex, m_senseAmpCol[row]);
   }
   return true;
 }
 
 //! @brief  Set values to row sense amplifiers
 bool
-pimCore::setSenseAmpRow(const std::vector<bool>& vals)
+pimCore::setSenseAmpRow(const std::vector<uint64_t>& vals)
 {
-  if (vals.size() != m_numCols) {
-    std::printf("PIM-Error: Incorrect data size write to row SAs: size = %lu, numCols = %u\n", vals.size(), m_numCols);
+  if (vals.size() != m_numWordsPerRow) {
+    std::printf("PIM-Error: Incorrect data size write to row SAs: size = %lu words, numCols = %u\n", vals.size(), m_numCols);
     return false;
   }
   m_rowRegs[PIM_RREG_SA] = vals;
@@ -187,6 +299,46 @@ pimCore::setSenseAmpCol(const std::vector<bool>& vals)
   return true;
 }
 
+//! @brief  Get #numElems V-layout elements of #numBits bits starting from a column.
+//!         Every 64 columns are transposed from vertical bit-slices into 64 native integers.
+void
+pimCore::getElementsV(unsigned colBegin, unsigned numElems, unsigned rowLoc, unsigned numBits, uint64_t* out) const
+{
+  assert(numBits > 0 && numBits <= 64);
+  assert(rowLoc + numBits <= m_numRows && colBegin + numElems <= m_numCols);
+  alignas(64) uint64_t block[64];
+  for (unsigned elemIdx = 0; elemIdx < numElems; elemIdx += 64) {
+    unsigned numElemsInBlock = std::min(64u, numElems - elemIdx);
+    unsigned colIdx = colBegin + elemIdx;
+    for (unsigned i = 0; i < numBits; ++i) {
+      block[i] = getBitsH(rowLoc + i, colIdx, numElemsInBlock);
+    }
+    std::fill(block + numBits, block + 64, 0ULL);
+    pimUtils::transposeBits64x64(block);
+    std::copy(block, block + numElemsInBlock, out + elemIdx);
+  }
+}
+
+//! @brief  Set #numElems V-layout elements of #numBits bits starting from a column.
+//!         Every 64 native integers are transposed into vertical bit-slices.
+void
+pimCore::setElementsV(unsigned colBegin, unsigned numElems, unsigned rowLoc, unsigned numBits, const uint64_t* in)
+{
+  assert(numBits > 0 && numBits <= 64);
+  assert(rowLoc + numBits <= m_numRows && colBegin + numElems <= m_numCols);
+  alignas(64) uint64_t block[64];
+  for (unsigned elemIdx = 0; elemIdx < numElems; elemIdx += 64) {
+    unsigned numElemsInBlock = std::min(64u, numElems - elemIdx);
+    unsigned colIdx = colBegin + elemIdx;
+    std::copy(in + elemIdx, in + elemIdx + numElemsInBlock, block);
+    std::fill(block + numElemsInBlock, block + 64, 0ULL);
+    pimUtils::transposeBits64x64(block);
+    for (unsigned i = 0; i < numBits; ++i) {
+      setBitsH(rowLoc + i, colIdx, block[i], numElemsInBlock);
+    }
+  }
+}
+
 //! @brief  Print out memory subarray contents
 void
 pimCore::print() const
@@ -194,33 +346,32 @@ pimCore::print() const
   std::ostringstream oss;
   // header
   oss << "  Row S ";
-  for (unsigned col = 0; col < m_array[0].size(); ++col) {
+  for (unsigned col = 0; col < m_numCols; ++col) {
     oss << (col % 8 == 0 ? '+' : '-');
   }
   oss << std::endl;
-  for (unsigned row = 0; row < m_array.size(); ++row) {
+  for (unsigned row = 0; row < m_numRows; ++row) {
     // row index
     oss << std::setw(5) << row << ' ';
     // col SA
     oss << m_senseAmpCol[row] << ' ';
     // row contents
-    for (unsigned col = 0; col < m_array[0].size(); ++col) {
-      oss << m_array[row][col];
+    for (unsigned col = 0; col < m_numCols; ++col) {
+      oss << getBit(row, col);
     }
     oss << std::endl;
   }
   // footer
   oss << "        ";
-  for (unsigned col = 0; col < m_array[0].size(); ++col) {
+  for (unsigned col = 0; col < m_numCols; ++col) {
     oss << (col % 8 == 0 ? '+' : '-');
   }
   oss << std::endl;
   // row SA
   oss << "     SA ";
-  for (unsigned col = 0; col < m_array[0].size(); ++col) {
-    oss << m_rowRegs.at(PIM_RREG_SA)[col];
+  for (unsigned col = 0; col < m_numCols; ++col) {
+    oss << getRowRegBit(PIM_RREG_SA, col);
   }
   oss << std::endl;
   std::printf("%s\n", oss.str().c_str());
 }
-
@@ -8,18 +8,31 @@
 #define LAVA_PIM_CORE_H
 
 #include "libpimeval.h"
+#include "pimUtils.h"
 #include <vector>
 #include <string>
 #include <map>
 #include <cassert>
 #include <cstdint>
 
+class pimCheckpointWriter;
+class pimCheckpointReader;
+
 
 //! @class  pimCore
 //! @brief  A PIM core which performs computation on a 2D memory subarray
+//!
+//! Memory contents are bit-packed into a contiguous, 64-byte aligned array of 64-bit words.
+//! Each row occupies ceil(numCols / 64) words, and column c of a row is stored at bit (c % 64)
+//! of word (c / 64). Row registers use the same word layout as a memory row.
+//!
+//! The memory array is allocated on first touch by materialize(). A core that never holds any
+//! PIM object only keeps its row registers.
 class pimCore
 {
 public:
+  typedef std::vector<uint64_t, pimUtils::alignedAllocator<uint64_t, 64>> pimWordArray;
+
   pimCore(unsigned numRows, unsigned numCols);
   ~pimCore();
 
@@ -27,11 +40,21 @@ public:
   void setCoreId(int id) { m_coreId = id; }
   PimCoreId getCoreId() const { return m_coreId; }
 
+  // Lazy memory allocation
+  bool materialize();
+  bool isMaterialized() const { return !m_array.empty(); }
+  uint64_t getNumArrayBytes() const { return (uint64_t)m_numRows * m_numWordsPerRow * sizeof(uint64_t); }
+  void clear();
+
+  // Checkpoint of memory array and row registers of a materialized core
+  void saveCheckpoint(pimCheckpointWriter& writer) const;
+  bool loadCheckpoint(pimCheckpointReader& reader);
+
   // Row-based operations
   bool readRow(unsigned rowIndex);
   bool writeRow(unsigned rowIndex);
-  std::vector<bool>& getSenseAmpRow() { return m_rowRegs[PIM_RREG_SA]; }
-  bool setSenseAmpRow(const std::vector<bool>& vals);
+  std::vector<uint64_t>& getSenseAmpRow() { return m_rowRegs[PIM_RREG_SA]; }
+  bool setSenseAmpRow(const std::vector<uint64_t>& vals);
   bool readMultiRows(const std::vector<std::pair<unsigned, bool>>& rowIdxs);
   bool writeMultiRows(const std::vector<std::pair<unsigned, bool>>& rowIdxs);
 
@@ -42,42 +65,75 @@ public:
   bool setSenseAmpCol(const std::vector<bool>& vals);
 
   // Reg access
-  std::vector<bool>& getRowReg(PimRowReg reg) { return m_rowRegs[reg]; }
+  std::vector<uint64_t>& getRowReg(PimRowReg reg) { return m_rowRegs[reg]; }
+  //! @brief  Get a bit of a row register
+  inline bool getRowRegBit(PimRowReg reg, unsigned colIdx) const {
+    assert(colIdx < m_numCols);
+    return (m_rowRegs[reg][colIdx >> 6] >> (colIdx & 63)) & 1ULL;
+  }
+  //! @brief  Set a bit of a row register
+  inline void setRowRegBit(PimRowReg reg, unsigned colIdx, bool val) {
+    assert(colIdx < m_numCols);
+    uint64_t& word = m_rowRegs[reg][colIdx >> 6];
+    uint64_t mask = 1ULL << (colIdx & 63);
+    word = (word & ~mask) | (val ? mask : 0ULL);
+  }
 
   // Utilities
   bool declareRowReg(PimRowReg reg);
   bool declareColReg(const std::string& name);
   void print() const;
+  unsigned getNumRows() const { return m_numRows; }
+  unsigned getNumCols() const { return m_numCols; }
+  unsigned getNumWordsPerRow() const { return m_numWordsPerRow; }
+  //! @brief  Mask of valid bits in the last word of a row
+  uint64_t getLastWordMask() const { return m_lastWordMask; }
+
+  // Directly access packed words of a row for functional implementation
+  uint64_t* getRowWords(unsigned rowIdx) {
+    assert(rowIdx < m_numRows);
+    return m_array.data() + (size_t)rowIdx * m_numWordsPerRow;
+  }
+  const uint64_t* getRowWords(unsigned rowIdx) const {
+    assert(rowIdx < m_numRows);
+    return m_array.data() + (size_t)rowIdx * m_numWordsPerRow;
+  }
 
   // Directly manipulate bits for functional implementation
   //! @brief  Directly set a bit for functional simulation
   inline void setBit(unsigned rowIdx, unsigned colIdx, bool val) {
     assert(rowIdx < m_numRows && colIdx < m_numCols);
-    m_array[rowIdx][colIdx] = val;
+    uint64_t& word = m_array[(size_t)rowIdx * m_numWordsPerRow + (colIdx >> 6)];
+    uint64_t mask = 1ULL << (colIdx & 63);
+    word = (word & ~mask) | (val ? mask : 0ULL);
   }
   //! @brief  Directly get a bit for functional simulation
   inline bool getBit(unsigned rowIdx, unsigned colIdx) const {
     assert(rowIdx < m_numRows && colIdx < m_numCols);
-    return m_array[rowIdx][colIdx];
+    return (m_array[(size_t)rowIdx * m_numWordsPerRow + (colIdx >> 6)] >> (colIdx & 63)) & 1ULL;
   }
   //! @brief  Directly set #numBits bits for V-layout functional simulation
   inline void setBitsV(unsigned rowIdx, unsigned colIdx, uint64_t val, unsigned numBits) {
     assert(numBits > 0 && numBits <= 64);
     assert(rowIdx + (numBits - 1) < m_numRows && colIdx < m_numCols);
+    uint64_t* word = &m_array[(size_t)rowIdx * m_numWordsPerRow + (colIdx >> 6)];
+    unsigned shift = colIdx & 63;
+    uint64_t mask = ~(1ULL << shift);
     for (unsigned i = 0; i < numBits; ++i) {
-      bool bitVal = val & 1;
-      setBit(rowIdx + i, colIdx, bitVal);
-      val = val >> 1;
+      *word = (*word & mask) | (((val >> i) & 1ULL) << shift);
+      word += m_numWordsPerRow;
     }
   }
   //! @brief  Directly get #numBits bits for V-layout functional simulation
   inline uint64_t getBitsV(unsigned rowIdx, unsigned colIdx, unsigned numBits) const {
     assert(numBits > 0 && numBits <= 64);
     assert(rowIdx + (numBits - 1) < m_numRows && colIdx < m_numCols);
+    const uint64_t* word = &m_array[(size_t)rowIdx * m_numWordsPerRow + (colIdx >> 6)];
+    unsigned shift = colIdx & 63;
     uint64_t val = 0;
-    for (int i = (numBits - 1); i >= 0; --i) {
-      bool bitVal = getBit(rowIdx + i, colIdx);
-      val = (val << 1) | bitVal;
+    for (unsigned i = 0; i < numBits; ++i) {
+      val |= ((*word >> shift) & 1ULL) << i;
+      word += m_numWordsPerRow;
     }
     return val;
   }
@@ -85,33 +141,44 @@ public:
   inline void setBitsH(unsigned rowIdx, unsigned colIdx, uint64_t val, unsigned numBits) {
     assert(numBits > 0 && numBits <= 64);
     assert(rowIdx < m_numRows && colIdx + (numBits - 1) < m_numCols);
-    for (unsigned i = 0; i < numBits; ++i) {
-      bool bitVal = val & 1;
-      setBit(rowIdx, colIdx + i, bitVal);
-      val = val >> 1;
+    uint64_t* word = &m_array[(size_t)rowIdx * m_numWordsPerRow + (colIdx >> 6)];
+    unsigned shift = colIdx & 63;
+    uint64_t mask = (numBits == 64 ? ~0ULL : ((1ULL << numBits) - 1));
+    val &= mask;
+    word[0] = (word[0] & ~(mask << shift)) | (val << shift);
+    if (shift + numBits > 64) {
+      unsigned numBitsLo = 64 - shift;
+      word[1] = (word[1] & ~(mask >> numBitsLo)) | (val >> numBitsLo);
     }
   }
   //! @brief  Directly get #numBits bits for H-layout functional simulation
   inline uint64_t getBitsH(unsigned rowIdx, unsigned colIdx, unsigned numBits) const {
     assert(numBits > 0 && numBits <= 64);
     assert(rowIdx < m_numRows && colIdx + (numBits - 1) < m_numCols);
-    uint64_t val = 0;
-    for (int i = (numBits - 1); i >= 0; --i) {
-      bool bitVal = getBit(rowIdx, colIdx + i);
-      val = (val << 1) | bitVal;
+    const uint64_t* word = &m_array[(size_t)rowIdx * m_numWordsPerRow + (colIdx >> 6)];
+    unsigned shift = colIdx & 63;
+    uint64_t val = word[0] >> shift;
+    if (shift + numBits > 64) {
+      val |= word[1] << (64 - shift);
     }
-    return val;
+    return (numBits == 64 ? val : (val & ((1ULL << numBits) - 1)));
   }
 
+  // Batched element access for V-layout functional simulation
+  void getElementsV(unsigned colBegin, unsigned numElems, unsigned rowLoc, unsigned numBits, uint64_t* out) const;
+  void setElementsV(unsigned colBegin, unsigned numElems, unsigned rowLoc, unsigned numBits, const uint64_t* in);
+
 private:
   PimCoreId m_coreId;
   unsigned m_numRows;
   unsigned m_numCols;
+  unsigned m_numWordsPerRow;
+  uint64_t m_lastWordMask;
 
-  std::vector<std::vector<bool>> m_array;
+  pimWordArray m_array;
   std::vector<bool> m_senseAmpCol;
 
-  std::map<PimRowReg, std::vector<bool>> m_rowRegs;
+  std::vector<std::vector<uint64_t>> m_rowRegs;
   std::map<std::string, std::vector<bool>> m_colRegs;
 };
 
@@ -7,6 +7,7 @@
 #include "pimDevice.h"
 #include "pimResMgr.h"
 #include "pimSim.h"
+#include "pimCheckpoint.h"
 #include "libpimeval.h"
 #include "pimUtils.h"
 #include <cstdio>
@@ -23,13 +24,24 @@
 #include <filesystem>
 
 //! @brief  pimDevice ctor
-pimDevice::pimDevice()
+pimDevice::pimDevice(PimDeviceId deviceId)
+  : m_deviceId(deviceId)
 {
 }
 
+//! @brief  Current stream of the calling thread and the device owning it. Stream 0 executes commands synchronously
+static thread_local PimStreamId s_currentStream = 0;
+static thread_local const pimDevice* s_currentStreamDevice = nullptr;
+
 //! @brief  pimDevice dtor
 pimDevice::~pimDevice()
 {
+  // finish pending stream commands before releasing device resources
+  m_streamMgr.reset();
+  if (s_currentStreamDevice == this) {
+    s_currentStream = 0;
+    s_currentStreamDevice = nullptr;
+  }
 }
 
 //! @brief  Adjust config for modeling different simulation target with same inputs
@@ -194,13 +206,20 @@ pimDevice::init(PimDeviceEnum deviceType, unsigned numRanks, unsigned numBankPer
   }
 
   m_resMgr = std::make_unique<pimResMgr>(this);
+  m_statsMgr = std::make_unique<pimStatsMgr>(this);
   const pimParamsDram& paramsDram = pimSim::get()->getParamsDram(); // created before pimDevice ctor
-  pimPerfEnergyModelParams params(m_simTarget, m_numRanks, paramsDram);
+  pimPerfEnergyModelParams params(m_simTarget, m_numRanks, numBankPerRank, m_numCores, paramsDram);
   m_perfEnergyModel = pimPerfEnergyFactory::createPerfEnergyModel(params);
 
-  m_cores.resize(m_numCores, pimCore(m_numRows, m_numCols));
+  // no PIM core arrays in performance-model-only mode
+  // otherwise core memory arrays are materialized on first touch
+  m_isPerfOnly = pimSim::get()->isPerfOnly();
+  if (!m_isPerfOnly) {
+    m_cores.resize(m_numCores, pimCore(m_numRows, m_numCols));
+  }
 
   std::printf("PIM-Info: Created PIM device with %u cores, each with %u rows and %u columns.\n", m_numCores, m_numRows, m_numCols);
+  initDramTrace(paramsDram);
 
   m_isInit = true;
   return m_isValid;
@@ -288,17 +307,38 @@ pimDevice::init(PimDeviceEnum deviceType, const char* configFileName)
   }
 
   m_resMgr = std::make_unique<pimResMgr>(this);
+  m_statsMgr = std::make_unique<pimStatsMgr>(this);
   const pimParamsDram& paramsDram = pimSim::get()->getParamsDram(); // created before pimDevice ctor
-  pimPerfEnergyModelParams params(m_simTarget, m_numRanks, paramsDram);
+  pimPerfEnergyModelParams params(m_simTarget, m_numRanks, numBankPerRank, m_numCores, paramsDram);
   m_perfEnergyModel = pimPerfEnergyFactory::createPerfEnergyModel(params);
-  m_cores.resize(m_numCores, pimCore(m_numRows, m_numCols));
+  // no PIM core arrays in performance-model-only mode
+  // otherwise core memory arrays are materialized on first touch
+  m_isPerfOnly = pimSim::get()->isPerfOnly();
+  if (!m_isPerfOnly) {
+    m_cores.resize(m_numCores, pimCore(m_numRows, m_numCols));
+  }
 
   std::printf("PIM-Info: Created PIM device with %u cores of %u rows and %u columns.\n", m_numCores, m_numRows, m_numCols);
+  initDramTrace(paramsDram);
 
   m_isInit = true;
   return m_isValid;
 }
 
+//! @brief  Start recording DRAM traces if environment variable PIMEVAL_DRAM_TRACE_PREFIX is set
+void
+pimDevice::initDramTrace(const pimParamsDram& paramsDram)
+{
+  std::string filePrefix;
+  if (!pimUtils::getEnvVar(pimUtils::envVarPimEvalDramTracePrefix, filePrefix) || filePrefix.empty()) {
+    return;
+  }
+  auto writer = std::make_unique<pimDramTraceWriter>(*this, paramsDram);
+  if (writer->open(filePrefix)) {
+    m_dramTraceWriter = std::move(writer);
+  }
+}
+
 //! @brief Initilize the device config parameters by parsing the config file
 bool
 pimDevice::parseConfigFromFile(const std::string& config, unsigned& numRanks, unsigned& numBankPerRank, unsigned& numSubarrayPerBank, unsigned& numRows, unsigned& numCols)
@@ -376,6 +416,7 @@ pimDevice::pimAlloc(PimAllocEnum allocType, uint64_t numElements, unsigned bitsP
       assert(0);
     }
   }
+  std::lock_guard<std::mutex> lock(m_cmdMutex);
   return m_resMgr->pimAlloc(allocType, numElements, bitsPerElement, dataType);
 }
 
@@ -383,6 +424,7 @@ pimDevice::pimAlloc(PimAllocEnum allocType, uint64_t numElements, unsigned bitsP
 PimObjId
 pimDevice::pimAllocAssociated(unsigned bitsPerElement, PimObjId assocId, PimDataType dataType)
 {
+  std::lock_guard<std::mutex> lock(m_cmdMutex);
   return m_resMgr->pimAllocAssociated(bitsPerElement, assocId, dataType);
 }
 
@@ -390,13 +432,24 @@ pimDevice::pimAllocAssociated(unsigned bitsPerElement, PimObjId assocId, PimData
 bool
 pimDevice::pimFree(PimObjId obj)
 {
-  return m_resMgr->pimFree(obj);
+  if (m_streamMgr) {
+    m_streamMgr->waitForObj(obj);
+  }
+  std::lock_guard<std::mutex> lock(m_cmdMutex);
+  if (!m_resMgr->pimFree(obj)) {
+    return false;
+  }
+  if (m_perfEnergyModel) {
+    m_perfEnergyModel->getResourceTimeline().releaseObj(obj);
+  }
+  return true;
 }
 
 //! @brief  Create an obj referencing to a range of an existing obj
 PimObjId
 pimDevice::pimCreateRangedRef(PimObjId refId, uint64_t idxBegin, uint64_t idxEnd)
 {
+  std::lock_guard<std::mutex> lock(m_cmdMutex);
   return m_resMgr->pimCreateRangedRef(refId, idxBegin, idxEnd);
 }
 
@@ -404,9 +457,105 @@ pimDevice::pimCreateRangedRef(PimObjId refId, uint64_t idxBegin, uint64_t idxEnd
 PimObjId
 pimDevice::pimCreateDualContactRef(PimObjId refId)
 {
+  std::lock_guard<std::mutex> lock(m_cmdMutex);
   return m_resMgr->pimCreateDualContactRef(refId);
 }
 
+//! @brief  Release freed objects kept for reuse
+void
+pimDevice::pimTrimObjectPool()
+{
+  std::lock_guard<std::mutex> lock(m_cmdMutex);
+  m_resMgr->trimObjPool();
+}
+
+//! @brief  Compact rows of live objects after all pending stream commands
+void
+pimDevice::pimCompact()
+{
+  synchronizeAll();
+  std::lock_guard<std::mutex> lock(m_cmdMutex);
+  m_resMgr->compact();
+}
+
+//! @brief  Save device configuration, resource manager, materialized cores and stats into a checkpoint
+void
+pimDevice::saveCheckpoint(pimCheckpointWriter& writer)
+{
+  synchronizeAll();
+  std::lock_guard<std::mutex> lock(m_cmdMutex);
+  writer.writeSection(PimCheckpointSection::DEVICE);
+  writer.write(static_cast<int32_t>(m_simTarget));
+  writer.write(m_numCores);
+  writer.write(m_numRows);
+  writer.write(m_numCols);
+  m_resMgr->saveCheckpoint(writer);
+
+  writer.writeSection(PimCheckpointSection::CORES);
+  for (const pimCore& core : m_cores) {
+    uint8_t isMaterialized = core.isMaterialized();
+    writer.write(isMaterialized);
+    if (isMaterialized) {
+      uint64_t recordOffset = writer.beginRecord();
+      core.saveCheckpoint(writer);
+      writer.endRecord(recordOffset);
+    }
+  }
+  m_statsMgr->saveCheckpoint(writer);
+}
+
+//! @brief  Restore states of a device with the same simulation target and dimensions from a checkpoint.
+//!         Cores not materialized in the checkpoint are zeros. Perf-only devices skip memory contents
+bool
+pimDevice::loadCheckpoint(pimCheckpointReader& reader)
+{
+  synchronizeAll();
+  std::lock_guard<std::mutex> lock(m_cmdMutex);
+  int32_t simTarget = 0;
+  unsigned numCores = 0, numRows = 0, numCols = 0;
+  if (!reader.readSection(PimCheckpointSection::DEVICE) || !reader.read(simTarget) || !reader.read(numCores) ||
+      !reader.read(numRows) || !reader.read(numCols)) {
+    return false;
+  }
+  if (simTarget != m_simTarget || numCores != m_numCores || numRows != m_numRows || numCols != m_numCols) {
+    std::printf("PIM-Error: Checkpoint of device %d has %u cores of %u rows and %u columns for simulation target %s, "
+                "which does not match the device\n", m_deviceId, numCores, numRows, numCols,
+                pimUtils::pimDeviceEnumToStr(static_cast<PimDeviceEnum>(simTarget)).c_str());
+    return false;
+  }
+  if (!m_resMgr->loadCheckpoint(reader) || !reader.readSection(PimCheckpointSection::CORES)) {
+    return false;
+  }
+  for (PimCoreId coreId = 0; coreId < static_cast<PimCoreId>(m_numCores); ++coreId) {
+    pimCore& core = m_cores[coreId];
+    uint8_t isMaterialized = 0;
+    if (!reader.read(isMaterialized)) {
+      return false;
+    }
+    if (!isMaterialized) {
+      if (core.isMaterialized()) {
+        core.clear();
+      }
+      continue;
+    }
+    uint64_t recordBytes = 0;
+    if (!reader.readRecordSize(recordBytes)) {
+      return false;
+    }
+    if (m_isPerfOnly) {
+      if (!reader.skip(recordBytes)) {
+        return false;
+      }
+      continue;
+    }
+    materializeCore(coreId);
+    if (!core.loadCheckpoint(reader)) {
+      return false;
+    }
+  }
+  return m_statsMgr->loadCheckpoint(reader);
+}
+
 //! @brief  Copy data from host to PIM within a range
 bool
 pimDevice::pimCopyMainToDevice(void* src, PimObjId dest, uint64_t idxBegin, uint64_t idxEnd)
@@ -452,13 +601,216 @@ pimDevice::pimCopyDeviceToDevice(PimObjId src, PimObjId dest, uint64_t idxBegin,
   return executeCmd(std::move(cmd));
 }
 
+//! @brief  Allocate memory array of a PIM core when it is touched for the first time
+void
+pimDevice::materializeCore(PimCoreId coreId)
+{
+  if (m_isPerfOnly) {
+    return;
+  }
+  assert(coreId >= 0 && static_cast<unsigned>(coreId) < m_cores.size());
+  if (m_cores[coreId].materialize()) {
+    ++m_numMaterializedCores;
+  }
+}
+
+//! @brief  Get number of bytes of materialized PIM core memory arrays
+uint64_t
+pimDevice::getMaterializedBytes() const
+{
+  return m_cores.empty() ? 0 : m_cores[0].getNumArrayBytes() * m_numMaterializedCores;
+}
+
+//! @brief  Get number of bytes of all PIM core memory arrays if fully materialized
+uint64_t
+pimDevice::getNominalBytes() const
+{
+  return (uint64_t)m_numCores * m_numRows * ((m_numCols + 63) / 64) * sizeof(uint64_t);
+}
+
 //! @brief  Execute a PIM command
 bool
 pimDevice::executeCmd(std::unique_ptr<pimCmd> cmd)
 {
   cmd->setDevice(this);
-  bool ok = cmd->execute();
+  PimStreamId stream = getCurrentStream();
+  if (stream != 0) {
+    if (!m_streamMgr) {
+      std::printf("PIM-Error: Invalid PIM stream ID %d\n", stream);
+      return false;
+    }
+    return m_streamMgr->enqueue(stream, std::move(cmd));
+  }
+  if (m_streamMgr) {
+    m_streamMgr->waitForCmd(*cmd);
+  }
+  return runCmd(*cmd);
+}
+
+//! @brief  Run a PIM command on the calling thread. Commands are serialized across host and stream executor.
+//!         Stream commands are scheduled at msIssue, the modeled host time when they were enqueued
+bool
+pimDevice::runCmd(pimCmd& cmd, PimStreamId stream, double msIssue)
+{
+  std::lock_guard<std::mutex> lock(m_cmdMutex);
+  pimeval::perfEnergy before = m_statsMgr->getThreadPerfEnergy();
+  auto wallBegin = m_timelineWriter ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+  bool ok = cmd.execute();
+  auto wallEnd = m_timelineWriter ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+  pimeval::perfEnergy cmdPerfEnergy = m_statsMgr->getThreadPerfEnergy().since(before);
+  bool isHostTransfer = (cmd.getCmdType() == PimCmdEnum::COPY_H2D || cmd.getCmdType() == PimCmdEnum::COPY_D2H);
+
+  // schedule on the cores of the objects, with references mapped to the objects they reference for dependencies
+  std::vector<PimObjId> objIds;
+  std::vector<PimObjId> depIds;
+  std::vector<PimCoreId> coreIds;
+  if (cmd.getObjIds(objIds)) {
+    for (PimObjId objId : objIds) {
+      if (!m_resMgr->isValidObjId(objId)) {
+        continue;
+      }
+      const pimObjInfo& obj = m_resMgr->getObjInfo(objId);
+      depIds.push_back(obj.getRefObjId() >= 0 ? obj.getRefObjId() : objId);
+      for (const pimRegion& region : obj.getRegions()) {
+        coreIds.push_back(region.getCoreId());
+      }
+    }
+  }
+  // host-device copies occupy the data bus of each rank for the transfer time of its own bytes
+  std::vector<double> msRankBus;
+  std::vector<uint64_t> numBytesPerRank;
+  if (ok && isHostTransfer && cmd.getNumBytesPerRank(numBytesPerRank)) {
+    for (uint64_t numBytes : numBytesPerRank) {
+      msRankBus.push_back(m_perfEnergyModel->getMsForRankTransfer(numBytes));
+    }
+  }
+  double msStart = 0.0;
+  if (ok) {
+    pimResourceTimeline& timeline = m_perfEnergyModel->getResourceTimeline();
+    msStart = timeline.scheduleCmd(depIds, coreIds, msRankBus, cmdPerfEnergy.m_msRuntime, stream, msIssue);
+    // synchronous commands returning data to the host block it until the data arrives
+    PimCmdEnum cmdType = cmd.getCmdType();
+    if (stream == 0 && (cmdType == PimCmdEnum::COPY_D2H || cmdType == PimCmdEnum::REDSUM || cmdType == PimCmdEnum::REDSUM_RANGE)) {
+      timeline.waitHost(msStart + cmdPerfEnergy.m_msRuntime);
+    }
+    if (m_dramTraceWriter) {
+      m_dramTraceWriter->recordCmd(cmdType, objIds, cmdPerfEnergy, msStart, timeline.getMsEarliestStart());
+    }
+  }
+  if (!m_timelineWriter) {
+    return ok;
+  }
 
+  // name the event as in stats, with data type and layout of the first object
+  std::string name = cmd.getName();
+  uint64_t numElements = 0;
+  if (!objIds.empty() && m_resMgr->isValidObjId(objIds[0])) {
+    const pimObjInfo& obj = m_resMgr->getObjInfo(objIds[0]);
+    name = cmd.getName(obj.getDataType(), obj.isVLayout());
+    numElements = obj.getNumElements();
+  }
+  // commands sharing their lowest core never overlap, so they share a track. Device-wide commands occupy core 0
+  PimCoreId trackCoreId = coreIds.empty() ? 0 : *std::min_element(coreIds.begin(), coreIds.end());
+  m_timelineWriter->recordCmd(m_deviceId, name, isHostTransfer, trackCoreId, objIds, numElements, msStart,
+                              cmdPerfEnergy.m_msRuntime, cmdPerfEnergy.m_mjEnergy, wallBegin, wallEnd);
   return ok;
 }
 
+//! @brief  Create an asynchronous stream
+PimStreamId
+pimDevice::createStream()
+{
+  if (!m_streamMgr) {
+    m_streamMgr = std::make_unique<pimStreamMgr>(this);
+  }
+  return m_streamMgr->createStream();
+}
+
+//! @brief  Destroy a stream after finishing its pending commands
+bool
+pimDevice::destroyStream(PimStreamId stream)
+{
+  if (!m_streamMgr || !m_streamMgr->isValidStream(stream)) {
+    std::printf("PIM-Error: Invalid PIM stream ID %d\n", stream);
+    return false;
+  }
+  if (getCurrentStream() == stream) {
+    s_currentStream = 0;
+  }
+  return m_streamMgr->destroyStream(stream);
+}
+
+//! @brief  Set the stream of subsequent commands issued by the calling thread. Stream 0 is synchronous
+bool
+pimDevice::setCurrentStream(PimStreamId stream)
+{
+  if (stream != 0 && (!m_streamMgr || !m_streamMgr->isValidStream(stream))) {
+    std::printf("PIM-Error: Invalid PIM stream ID %d\n", stream);
+    return false;
+  }
+  s_currentStream = stream;
+  s_currentStreamDevice = this;
+  return true;
+}
+
+//! @brief  Get the stream of commands issued by the calling thread
+PimStreamId
+pimDevice::getCurrentStream() const
+{
+  return s_currentStreamDevice == this ? s_currentStream : 0;
+}
+
+//! @brief  Wait until all commands of a stream are finished
+bool
+pimDevice::synchronizeStream(PimStreamId stream)
+{
+  if (stream == 0) {
+    return true;
+  }
+  if (!m_streamMgr) {
+    std::printf("PIM-Error: Invalid PIM stream ID %d\n", stream);
+    return false;
+  }
+  return m_streamMgr->synchronizeStream(stream);
+}
+
+//! @brief  Wait until all commands of all streams are finished
+void
+pimDevice::synchronizeAll()
+{
+  if (m_streamMgr) {
+    m_streamMgr->synchronizeAll();
+  }
+}
+
+//! @brief  Record an event on a stream
+PimEventId
+pimDevice::recordEvent(PimStreamId stream)
+{
+  if (!m_streamMgr) {
+    std::printf("PIM-Error: Invalid PIM stream ID %d\n", stream);
+    return -1;
+  }
+  return m_streamMgr->recordEvent(stream);
+}
+
+//! @brief  Block the host until an event is completed
+bool
+pimDevice::waitEvent(PimEventId event)
+{
+  if (!m_streamMgr) {
+    std::printf("PIM-Error: Invalid PIM event ID %d\n", event);
+    return false;
+  }
+  return m_streamMgr->waitEvent(event);
+}
+
+//! @brief  Reset the modeled resource timeline
+void
+pimDevice::resetTimeline()
+{
+  if (m_perfEnergyModel) {
+    m_perfEnergyModel->getResourceTimeline().reset();
+  }
+}
+
@@ -11,14 +11,21 @@
 #include "pimCore.h"
 #include "pimCmd.h"
 #include "pimPerfEnergyBase.h"
+#include "pimStream.h"
+#include "pimStats.h"
+#include "pimTimeline.h"
+#include "pimDramTrace.h"
 #ifdef DRAMSIM3_INTEG
 #include "cpu.h"
 #endif
 #include <memory>
+#include <mutex>
 #include <filesystem>
 #include <string>
 
 class pimResMgr;
+class pimCheckpointWriter;
+class pimCheckpointReader;
 
 
 //! @class  pimDevice
@@ -26,12 +33,13 @@ class pimResMgr;
 class pimDevice
 {
 public:
-  pimDevice();
+  pimDevice(PimDeviceId deviceId = 0);
   ~pimDevice();
 
   bool init(PimDeviceEnum deviceType, unsigned numRanks, unsigned numBankPerRank, unsigned numSubarrayPerBank, unsigned numRows, unsigned numCols);
   bool init(PimDeviceEnum deviceType, const char* configFileName);
 
+  PimDeviceId getDeviceId() const { return m_deviceId; }
   PimDeviceEnum getDeviceType() const { return m_deviceType; }
   PimDeviceEnum getSimTarget() const { return m_simTarget; }
   unsigned getNumRanks() const { return m_numRanks; }
@@ -43,6 +51,7 @@ public:
   unsigned getNumRows() const { return m_numRows; }
   unsigned getNumCols() const { return m_numCols; }
   bool isValid() const { return m_isValid; }
+  bool isPerfOnly() const { return m_isPerfOnly; }
 
   bool isVLayoutDevice() const;
   bool isHLayoutDevice() const;
@@ -53,6 +62,10 @@ public:
   bool pimFree(PimObjId obj);
   PimObjId pimCreateRangedRef(PimObjId refId, uint64_t idxBegin, uint64_t idxEnd);
   PimObjId pimCreateDualContactRef(PimObjId refId);
+  void pimTrimObjectPool();
+  void pimCompact();
+  void saveCheckpoint(pimCheckpointWriter& writer);
+  bool loadCheckpoint(pimCheckpointReader& reader);
 
   bool pimCopyMainToDevice(void* src, PimObjId dest, uint64_t idxBegin = 0, uint64_t idxEnd = 0);
   bool pimCopyDeviceToMain(PimObjId src, void* dest, uint64_t idxBegin = 0, uint64_t idxEnd = 0);
@@ -61,15 +74,39 @@ public:
   bool pimCopyDeviceToDevice(PimObjId src, PimObjId dest, uint64_t idxBegin = 0, uint64_t idxEnd = 0);
 
   pimResMgr* getResMgr() { return m_resMgr.get(); }
+  const pimResMgr* getResMgr() const { return m_resMgr.get(); }
   pimPerfEnergyBase* getPerfEnergyModel() { return m_perfEnergyModel.get(); }
-  pimCore& getCore(PimCoreId coreId) { return m_cores[coreId]; }
+  const pimPerfEnergyBase* getPerfEnergyModel() const { return m_perfEnergyModel.get(); }
+  pimStatsMgr* getStatsMgr() const { return m_statsMgr.get(); }
+  pimCore& getCore(PimCoreId coreId) { assert(m_cores[coreId].isMaterialized()); return m_cores[coreId]; }
+  void materializeCore(PimCoreId coreId);
+  unsigned getNumMaterializedCores() const { return m_numMaterializedCores; }
+  uint64_t getMaterializedBytes() const;
+  uint64_t getNominalBytes() const;
   bool executeCmd(std::unique_ptr<pimCmd> cmd);
+  bool runCmd(pimCmd& cmd, PimStreamId stream = 0, double msIssue = 0.0);
+  void setTimelineWriter(pimTimelineWriter* timelineWriter) { m_timelineWriter = timelineWriter; }
+  pimTimelineWriter* getTimelineWriter() const { return m_timelineWriter; }
+  pimDramTraceWriter* getDramTraceWriter() const { return m_dramTraceWriter.get(); }
+
+  PimStreamId createStream();
+  bool destroyStream(PimStreamId stream);
+  bool setCurrentStream(PimStreamId stream);
+  PimStreamId getCurrentStream() const;
+  bool synchronizeStream(PimStreamId stream);
+  void synchronizeAll();
+  PimEventId recordEvent(PimStreamId stream);
+  bool waitEvent(PimEventId event);
+  const pimStreamMgr* getStreamMgr() const { return m_streamMgr.get(); }
+  void resetTimeline();
 
 private:
   bool adjustConfigForSimTarget(unsigned& numRanks, unsigned& numBankPerRank, unsigned& numSubarrayPerBank, unsigned& numRows, unsigned& numCols);
   void configSimTarget(PimDeviceEnum deviceType = PIM_FUNCTIONAL);
   bool parseConfigFromFile(const std::string& config, unsigned& numRanks, unsigned& numBankPerRank, unsigned& numSubarrayPerBank, unsigned& numRows, unsigned& numCols);
+  void initDramTrace(const pimParamsDram& paramsDram);
 
+  PimDeviceId m_deviceId = 0;
   PimDeviceEnum m_deviceType = PIM_DEVICE_NONE;
   PimDeviceEnum m_simTarget = PIM_DEVICE_NONE;
   unsigned m_numRanks = 0;
@@ -82,9 +119,16 @@ private:
   unsigned m_numCols = 0;
   bool m_isValid = false;
   bool m_isInit = false;
+  bool m_isPerfOnly = false;
   std::unique_ptr<pimResMgr> m_resMgr;
   std::unique_ptr<pimPerfEnergyBase> m_perfEnergyModel;
+  std::unique_ptr<pimStatsMgr> m_statsMgr;
   std::vector<pimCore> m_cores;
+  unsigned m_numMaterializedCores = 0;
+  std::mutex m_cmdMutex;
+  std::unique_ptr<pimStreamMgr> m_streamMgr;
+  pimTimelineWriter* m_timelineWriter = nullptr;  // owned by the simulator
+  std::unique_ptr<pimDramTraceWriter> m_dramTraceWriter;
 
 #ifdef DRAMSIM3_INTEG
   dramsim3::PIMCPU* m_hostMemory = nullptr;
@@ -0,0 +1,298 @@
+// File: pimDramTrace.cpp
+// PIMeval Simulator - DRAM Command Trace Export
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "pimDramTrace.h"
+#include "pimDevice.h"
+#include "pimResMgr.h"
+#include <algorithm>
+#include <map>
+#include <cmath>
+
+//! @brief  Floor of log2, as DRAMsim3 computes address field widths
+static unsigned
+log2Floor(uint64_t val)
+{
+  unsigned bits = 0;
+  while (val > 1) {
+    val >>= 1;
+    ++bits;
+  }
+  return bits;
+}
+
+//! @brief  pimDramTraceWriter ctor. Derive the address mapping of DRAMsim3 from the DRAM config
+pimDramTraceWriter::pimDramTraceWriter(const pimDevice& device, const pimParamsDram& paramsDram)
+  : m_device(device)
+{
+  m_nsTCK = paramsDram.getNsTCK() > 0.0 ? paramsDram.getNsTCK() : 1.0;
+  unsigned numBankGroups = std::max(1, paramsDram.getNumBankGroups());
+  unsigned numBanksPerGroup = std::max(1, paramsDram.getNumBanksPerGroup());
+  unsigned numColumns = std::max(1, paramsDram.getNumColumns());
+  unsigned burstLength = std::max(1, paramsDram.getBurstLength());
+  unsigned busWidth = std::max(1, paramsDram.getBusWidth());
+  m_numBankGroups = numBankGroups;
+  m_numDramBanks = numBankGroups * numBanksPerGroup;
+  m_numDramRows = std::max(1, paramsDram.getNumRowsPerBank());
+  m_bitsPerBurst = busWidth * burstLength;
+
+  // ranks per channel, as Config::CalculateSize of DRAMsim3
+  uint64_t devicesPerRank = std::max(1, paramsDram.getBusWidth() / std::max(1, paramsDram.getDeviceWidth()));
+  uint64_t pageSize = static_cast<uint64_t>(numColumns) * paramsDram.getDeviceWidth() / 8;
+  uint64_t mbPerBank = pageSize * (m_numDramRows / 1024) / 1024;
+  uint64_t mbPerRank = mbPerBank * m_numDramBanks * devicesPerRank;
+  uint64_t mbChannelSize = std::max(0, paramsDram.getMbChannelSize());
+  m_numRanksPerChannel = (mbPerRank == 0 || mbPerRank > mbChannelSize) ? 1 : mbChannelSize / mbPerRank;
+
+  // field positions from the least significant field, as Config::SetAddressMapping of DRAMsim3
+  std::map<std::string, unsigned> widths = {
+    {"ch", log2Floor(std::max(1, paramsDram.getNumChannels()))},
+    {"ra", log2Floor(m_numRanksPerChannel)},
+    {"bg", log2Floor(numBankGroups)},
+    {"ba", log2Floor(numBanksPerGroup)},
+    {"ro", log2Floor(m_numDramRows)},
+    {"co", log2Floor(numColumns) - std::min(log2Floor(numColumns), log2Floor(burstLength))},
+  };
+  std::map<std::string, unsigned> positions;
+  const std::string& mapping = paramsDram.getAddressMapping();
+  if (mapping.size() != 12) {
+    std::printf("PIM-Warning: Unknown address mapping '%s', using rochrababgco for DRAM traces\n", mapping.c_str());
+  }
+  std::string fields = (mapping.size() == 12 ? mapping : std::string("rochrababgco"));
+  unsigned pos = 0;
+  for (int i = static_cast<int>(fields.size()) - 2; i >= 0; i -= 2) {
+    std::string field = fields.substr(i, 2);
+    positions[field] = pos;
+    pos += widths[field];
+  }
+  m_shiftBits = log2Floor(busWidth / 8 * burstLength);
+  m_raPos = positions["ra"];
+  m_bgPos = positions["bg"];
+  m_baPos = positions["ba"];
+  m_roPos = positions["ro"];
+  m_coPos = positions["co"];
+  m_coMask = (1ULL << widths["co"]) - 1;
+}
+
+//! @brief  Open one trace file per channel, named <prefix>_dev<id>_ch<channel>.trace
+bool
+pimDramTraceWriter::open(const std::string& filePrefix)
+{
+  close();
+  unsigned numChannels = (m_device.getNumRanks() + m_numRanksPerChannel - 1) / m_numRanksPerChannel;
+  for (unsigned channel = 0; channel < numChannels; ++channel) {
+    std::string fileName = filePrefix + "_dev" + std::to_string(m_device.getDeviceId()) + "_ch" + std::to_string(channel) + ".trace";
+    std::FILE* file = std::fopen(fileName.c_str(), "w");
+    if (!file) {
+      std::printf("PIM-Error: Failed to open DRAM trace file %s for writing\n", fileName.c_str());
+      close();
+      return false;
+    }
+    m_files.push_back(file);
+  }
+  m_pendingLines.assign(numChannels, {});
+  m_lastCycles.assign(numChannels, 0);
+  m_msFlushed = 0.0;
+  std::printf("PIM-Info: Recording DRAM traces of %u channels to %s_dev%d_ch*.trace\n", numChannels, filePrefix.c_str(),
+              m_device.getDeviceId());
+  return true;
+}
+
+//! @brief  Write all buffered lines and close all trace files
+void
+pimDramTraceWriter::close()
+{
+  flush(0.0, true);
+  for (std::FILE* file : m_files) {
+    std::fclose(file);
+  }
+  m_files.clear();
+}
+
+//! @brief  Get DRAMsim3 address of a burst
+uint64_t
+pimDramTraceWriter::getAddress(unsigned rank, unsigned bank, uint64_t row, uint64_t col) const
+{
+  uint64_t bg = bank % m_numBankGroups;
+  uint64_t ba = bank / m_numBankGroups;
+  uint64_t addr = (static_cast<uint64_t>(rank) << m_raPos) | (bg << m_bgPos) | (ba << m_baPos)
+                  | ((row % m_numDramRows) << m_roPos) | ((col & m_coMask) << m_coPos);
+  return addr << m_shiftBits;
+}
+
+//! @brief  Get DRAM rows of the regions of a PIM object. Cores are numbered rank by rank and bank by bank,
+//!         and subarrays of a bank are stacked in the rows of the bank
+std::vector<pimDramTraceWriter::bankRows>
+pimDramTraceWriter::getBankRows(PimObjId objId, bool isOnePerBank) const
+{
+  std::vector<bankRows> rows;
+  const pimResMgr* resMgr = m_device.getResMgr();
+  if (!resMgr->isValidObjId(objId)) {
+    return rows;
+  }
+  unsigned numCoresPerRank = std::max(1u, m_device.getNumCores() / std::max(1u, m_device.getNumRanks()));
+  unsigned numCoresPerBank = std::max(1u, numCoresPerRank / std::max(1u, m_device.getNumBankPerRank()));
+  std::vector<bool> isBankUsed(static_cast<size_t>(m_device.getNumRanks()) * m_numDramBanks, false);
+  for (const pimRegion& region : resMgr->getObjInfo(objId).getRegions()) {
+    unsigned coreId = region.getCoreId();
+    unsigned rank = std::min(coreId / numCoresPerRank, m_device.getNumRanks() - 1);
+    unsigned bank = ((coreId % numCoresPerRank) / numCoresPerBank) % m_numDramBanks;
+    size_t bankIdx = static_cast<size_t>(rank) * m_numDramBanks + bank;
+    if (isOnePerBank && isBankUsed[bankIdx]) {
+      continue;
+    }
+    isBankUsed[bankIdx] = true;
+    bankRows item;
+    item.m_channel = rank / m_numRanksPerChannel;
+    item.m_rank = rank % m_numRanksPerChannel;
+    item.m_bank = bank;
+    item.m_row = static_cast<uint64_t>(coreId % numCoresPerBank) * m_device.getNumRows() + region.getRowIdx();
+    item.m_numRows = std::max(1u, region.getNumAllocRows());
+    item.m_numBursts = std::max(1u, (region.getNumAllocCols() + m_bitsPerBurst - 1) / m_bitsPerBurst);
+    rows.push_back(item);
+  }
+  return rows;
+}
+
+//! @brief  Write a row read or row write to one row of each bank
+void
+pimDramTraceWriter::writeRowOp(const std::vector<bankRows>& rows, unsigned rowOfst, bool isWrite, double msTime)
+{
+  for (const bankRows& item : rows) {
+    writeLine(item.m_channel, getAddress(item.m_rank, item.m_bank, item.m_row + rowOfst % item.m_numRows, 0), isWrite, msTime);
+  }
+}
+
+//! @brief  Lower a PIM computation command. Row reads cycle through the source objects and rows, and row writes
+//!         go to the rows of the destination object, which is the last object of the command
+void
+pimDramTraceWriter::recordCompute(const std::vector<PimObjId>& objIds, const pimeval::perfEnergy& perfEnergy)
+{
+  uint64_t numR = std::llround(perfEnergy.m_numRowRead);
+  uint64_t numW = std::llround(perfEnergy.m_numRowWrite);
+  uint64_t numL = std::llround(perfEnergy.m_numLogic);
+  if (objIds.empty() || numR + numW == 0) {
+    return;
+  }
+  std::vector<std::vector<bankRows>> srcRows;
+  size_t numSrcObjs = std::max<size_t>(1, objIds.size() - 1);
+  for (size_t i = 0; i < numSrcObjs; ++i) {
+    srcRows.push_back(getBankRows(objIds[i], true));
+  }
+  std::vector<bankRows> destRows = getBankRows(objIds.back(), true);
+
+  // time of each operation from the runtime components, or evenly divided if there are none
+  double msComponents = perfEnergy.m_msRead + perfEnergy.m_msWrite + perfEnergy.m_msLogic;
+  double msPerOp = perfEnergy.m_msRuntime / (numR + numW + numL);
+  double msPerR = msComponents > 0.0 ? (numR ? perfEnergy.m_msRead / numR : 0.0) : msPerOp;
+  double msPerW = msComponents > 0.0 ? (numW ? perfEnergy.m_msWrite / numW : 0.0) : msPerOp;
+  double msPerL = msComponents > 0.0 ? (numL ? perfEnergy.m_msLogic / numL : 0.0) : msPerOp;
+
+  // interleave reads, logic and writes evenly, as in a bit-serial micro-program
+  uint64_t numSteps = std::max(numR, numW);
+  uint64_t idxR = 0;
+  uint64_t idxW = 0;
+  uint64_t idxL = 0;
+  double msTime = m_msStart;
+  for (uint64_t step = 1; step <= numSteps; ++step) {
+    for (; idxR < numR * step / numSteps; ++idxR) {
+      writeRowOp(srcRows[idxR % srcRows.size()], idxR / srcRows.size(), false, msTime);
+      msTime += msPerR;
+    }
+    for (; idxL < numL * step / numSteps; ++idxL) {
+      msTime += msPerL;
+    }
+    for (; idxW < numW * step / numSteps; ++idxW) {
+      writeRowOp(destRows, idxW, true, msTime);
+      msTime += msPerW;
+    }
+  }
+}
+
+//! @brief  Lower a host-device or device-device copy. Bursts of each channel are spread over the runtime
+void
+pimDramTraceWriter::recordCopy(PimCmdEnum cmdType, const std::vector<PimObjId>& objIds, double msRuntime)
+{
+  std::vector<std::pair<std::vector<bankRows>, bool>> targets;  // rows and whether they are written
+  if (cmdType == PimCmdEnum::COPY_D2D && objIds.size() == 2) {
+    targets.emplace_back(getBankRows(objIds[0], false), false);
+    targets.emplace_back(getBankRows(objIds[1], false), true);
+  } else if (objIds.size() == 1) {
+    targets.emplace_back(getBankRows(objIds[0], false), cmdType == PimCmdEnum::COPY_H2D);
+  }
+
+  std::vector<uint64_t> numBursts(m_files.size(), 0);
+  for (const auto& [rows, isWrite] : targets) {
+    for (const bankRows& item : rows) {
+      numBursts[item.m_channel] += static_cast<uint64_t>(item.m_numRows) * item.m_numBursts;
+    }
+  }
+  std::vector<uint64_t> idxBurst(m_files.size(), 0);
+  for (const auto& [rows, isWrite] : targets) {
+    for (const bankRows& item : rows) {
+      for (unsigned row = 0; row < item.m_numRows; ++row) {
+        for (unsigned col = 0; col < item.m_numBursts; ++col) {
+          double msTime = m_msStart + msRuntime * idxBurst[item.m_channel]++ / numBursts[item.m_channel];
+          writeLine(item.m_channel, getAddress(item.m_rank, item.m_bank, item.m_row + row, col), isWrite, msTime);
+        }
+      }
+    }
+  }
+}
+
+//! @brief  Buffer a trace line of a channel
+void
+pimDramTraceWriter::writeLine(unsigned channel, uint64_t addr, bool isWrite, double msTime)
+{
+  traceLine line;
+  line.m_cycle = getCycle(msTime);
+  line.m_addr = addr;
+  line.m_isWrite = isWrite;
+  m_pendingLines[channel].push_back(line);
+}
+
+//! @brief  Write buffered lines before a horizon time in cycle order, or all of them. A channel with too many
+//!         buffered lines is written out regardless, with lines arriving later clamped to its last cycle
+void
+pimDramTraceWriter::flush(double msHorizon, bool isAll)
+{
+  const size_t maxPendingLines = 1 << 20;
+  uint64_t horizonCycle = getCycle(msHorizon);
+  for (size_t channel = 0; channel < m_files.size(); ++channel) {
+    std::vector<traceLine>& lines = m_pendingLines[channel];
+    bool isFull = lines.size() >= maxPendingLines;
+    if (lines.empty() || (!isAll && !isFull && msHorizon <= m_msFlushed)) {
+      continue;
+    }
+    std::stable_sort(lines.begin(), lines.end(), [](const traceLine& a, const traceLine& b) { return a.m_cycle < b.m_cycle; });
+    size_t numLines = 0;
+    for (; numLines < lines.size() && (isAll || isFull || lines[numLines].m_cycle < horizonCycle); ++numLines) {
+      const traceLine& line = lines[numLines];
+      m_lastCycles[channel] = std::max(m_lastCycles[channel], line.m_cycle);
+      std::fprintf(m_files[channel], "0x%llx %s %llu\n", static_cast<unsigned long long>(line.m_addr),
+                   line.m_isWrite ? "WRITE" : "READ", static_cast<unsigned long long>(m_lastCycles[channel]));
+    }
+    lines.erase(lines.begin(), lines.begin() + numLines);
+  }
+  m_msFlushed = std::max(m_msFlushed, msHorizon);
+}
+
+//! @brief  Record a command starting at msStart, and write lines before msEarliestStart, the earliest time a later
+//!         command can start
+void
+pimDramTraceWriter::recordCmd(PimCmdEnum cmdType, const std::vector<PimObjId>& objIds, const pimeval::perfEnergy& perfEnergy,
+                              double msStart, double msEarliestStart)
+{
+  if (m_files.empty()) {
+    return;
+  }
+  m_msStart = msStart;
+  if (cmdType == PimCmdEnum::COPY_H2D || cmdType == PimCmdEnum::COPY_D2H || cmdType == PimCmdEnum::COPY_D2D) {
+    recordCopy(cmdType, objIds, perfEnergy.m_msRuntime);
+  } else {
+    recordCompute(objIds, perfEnergy);
+  }
+  flush(msEarliestStart, false);
+}
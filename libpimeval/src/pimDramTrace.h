@@ -0,0 +1,99 @@
+// File: pimDramTrace.h
+// PIMeval Simulator - DRAM Command Trace Export
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#ifndef LAVA_PIM_DRAM_TRACE_H
+#define LAVA_PIM_DRAM_TRACE_H
+
+#include "libpimeval.h"
+#include "pimCmd.h"
+#include "pimParamsDram.h"
+#include "pimPerfEnergyBase.h"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+class pimDevice;
+class pimObjInfo;
+
+
+//! @class  pimDramTraceWriter
+//! @brief  Lower PIM commands to per-channel DRAM transaction traces in DRAMsim3 trace format
+//!
+//! Each line is "<hex address> READ|WRITE <cycle>", which can be replayed by the trace-based front end of DRAMsim3
+//! with the same DRAM config file, where the memory controller adds ACT and PRE commands, refresh and bank
+//! conflicts. A row read of a PIM command is a READ and a row write is a WRITE, issued to one row of every bank
+//! that the objects of the command occupy. Row reads, row writes and logic operations are the counts modeled by
+//! the performance model, issued in the interleaved order of a bit-serial micro-program from the start time of
+//! the command on the resource timeline of the device, so that the replayed runtime can be compared with the
+//! analytical one. Host-device copies are lowered to one burst per bus width times burst length bits of each row
+//! of the objects. Overlapped commands may start before commands recorded earlier, so lines are buffered and
+//! written in cycle order once no later command can start before them.
+//!
+//! PIM ranks are mapped to DRAMsim3 ranks and channels as configured by channel_size, with one file per channel,
+//! and PIM banks and rows are folded into the DRAM banks and rows of the config. Commands without modeled row
+//! operations, such as those of non-bit-serial devices, only advance the modeled time.
+class pimDramTraceWriter
+{
+public:
+  pimDramTraceWriter(const pimDevice& device, const pimParamsDram& paramsDram);
+  ~pimDramTraceWriter() { close(); }
+
+  bool open(const std::string& filePrefix);
+  void close();
+  void recordCmd(PimCmdEnum cmdType, const std::vector<PimObjId>& objIds, const pimeval::perfEnergy& perfEnergy,
+                 double msStart, double msEarliestStart);
+
+private:
+  //! @brief  DRAM rows of a region of a PIM object
+  struct bankRows {
+    unsigned m_channel = 0;
+    unsigned m_rank = 0;        // rank within the channel
+    unsigned m_bank = 0;        // DRAM bank, with bank group in the lower bits
+    uint64_t m_row = 0;         // first DRAM row of the region
+    unsigned m_numRows = 0;
+    unsigned m_numBursts = 0;   // bursts of each row
+  };
+  //! @brief  A buffered trace line
+  struct traceLine {
+    uint64_t m_cycle = 0;
+    uint64_t m_addr = 0;
+    bool m_isWrite = false;
+  };
+
+  std::vector<bankRows> getBankRows(PimObjId objId, bool isOnePerBank) const;
+  uint64_t getAddress(unsigned rank, unsigned bank, uint64_t row, uint64_t col) const;
+  uint64_t getCycle(double msTime) const { return static_cast<uint64_t>(msTime * 1000000.0 / m_nsTCK + 0.5); }
+  void writeRowOp(const std::vector<bankRows>& rows, unsigned rowOfst, bool isWrite, double msTime);
+  void recordCompute(const std::vector<PimObjId>& objIds, const pimeval::perfEnergy& perfEnergy);
+  void recordCopy(PimCmdEnum cmdType, const std::vector<PimObjId>& objIds, double msRuntime);
+  void writeLine(unsigned channel, uint64_t addr, bool isWrite, double msTime);
+  void flush(double msHorizon, bool isAll);
+
+  const pimDevice& m_device;
+  std::vector<std::FILE*> m_files;  // one per channel
+  std::vector<std::vector<traceLine>> m_pendingLines;  // per channel, not yet written
+  std::vector<uint64_t> m_lastCycles;  // per channel, of the last written line
+  double m_msStart = 0.0;  // start time of the command being recorded
+  double m_msFlushed = 0.0;  // horizon of the last flush
+  double m_nsTCK = 1.0;
+
+  // DRAMsim3 address mapping
+  unsigned m_numRanksPerChannel = 1;
+  unsigned m_numDramBanks = 1;
+  unsigned m_numBankGroups = 1;
+  uint64_t m_numDramRows = 1;
+  unsigned m_bitsPerBurst = 512;
+  unsigned m_shiftBits = 0;
+  unsigned m_raPos = 0;
+  unsigned m_bgPos = 0;
+  unsigned m_baPos = 0;
+  unsigned m_roPos = 0;
+  unsigned m_coPos = 0;
+  uint64_t m_coMask = 0;
+};
+
+#endif
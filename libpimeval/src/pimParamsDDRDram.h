@@ -28,6 +28,9 @@ public:
   double getNsTCCD_S() const override { return m_tCK * m_tCCD_S; }
   double getNsTCAS() const override { return m_tCK * m_CL; }
   double getNsAAP() const override { return m_tCK * (m_tRAS + m_tRP); }
+  double getNsTFAW() const override { return m_tCK * m_tFAW; }
+  double getNsTRRD_S() const override { return m_tCK * m_tRRD_S; }
+  double getNsTRRD_L() const override { return m_tCK * m_tRRD_L; }
   double getTypicalRankBW() const override { return m_typicalRankBW; }
   double getPjRowRead() const override { return m_VDD * (m_IDD0 * (m_tRAS + m_tRP) - (m_IDD3N * m_tRAS + m_IDD2N * m_tRP)); } // Energy for 1 Activate command (and the correspound precharge command) in one subarray of one bank of one chip
   double getPjLogic() const override { return 0.007 * m_tCK * m_tCCD_S ; } // 0.007 mW is the total power per BSLU, 0.007 * m_tCK * m_tCCD_S is the energy of one BSLU during one logic operation in pJ.
@@ -35,6 +38,15 @@ public:
   double getMwIDD3N() const override {return m_VDD * m_IDD3N; }
   double getMwRead() const override { return m_VDD * (m_IDD4R - m_IDD3N); } // read power per chip (data copy)
   double getMwWrite() const override { return m_VDD * (m_IDD4W - m_IDD3N); } // write power per chip (data copy)
+  double getNsTCK() const override { return m_tCK; }
+  int getNumBankGroups() const override { return m_bankgroups; }
+  int getNumBanksPerGroup() const override { return m_banksPerGroup; }
+  int getNumRowsPerBank() const override { return m_rows; }
+  int getNumColumns() const override { return m_columns; }
+  int getBusWidth() const override { return m_busWidth; }
+  int getNumChannels() const override { return m_channels; }
+  int getMbChannelSize() const override { return m_channelSize; }
+  const std::string& getAddressMapping() const override { return m_addressMapping; }
 
 private:
   // [dram_structure]
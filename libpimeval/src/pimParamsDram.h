@@ -41,6 +41,22 @@ public:
   virtual double getMwIDD3N() const = 0;
   virtual double getMwRead() const = 0;
   virtual double getMwWrite() const = 0;
+
+  // Activation window constraints, used to throttle concurrent row activations
+  virtual double getNsTFAW() const = 0;
+  virtual double getNsTRRD_S() const = 0;
+  virtual double getNsTRRD_L() const = 0;
+
+  // DRAM organization and address mapping, used to lower PIM commands to DRAMsim3 traces
+  virtual double getNsTCK() const = 0;
+  virtual int getNumBankGroups() const = 0;
+  virtual int getNumBanksPerGroup() const = 0;
+  virtual int getNumRowsPerBank() const = 0;
+  virtual int getNumColumns() const = 0;
+  virtual int getBusWidth() const = 0;
+  virtual int getNumChannels() const = 0;
+  virtual int getMbChannelSize() const = 0;
+  virtual const std::string& getAddressMapping() const = 0;
 };
 
 #endif
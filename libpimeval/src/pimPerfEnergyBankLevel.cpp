@@ -18,6 +18,10 @@ pimPerfEnergyBankLevel::getPerfEnergyForFunc1(PimCmdEnum cmdType, const pimObjIn
   unsigned numPass = obj.getMaxNumRegionsPerCore();
   unsigned bitsPerElement = obj.getBitsPerElement();
   unsigned numCores = obj.getNumCoresUsed();
+  double msRead = 0.0;
+  double msWrite = 0.0;
+  double mjRead = 0.0;
+  double mjWrite = 0.0;
 
   unsigned maxElementsPerRegion = obj.getMaxElementsPerRegion();
   double numberOfOperationPerElement = ((double)bitsPerElement / m_blimpCoreBitWidth);
@@ -37,6 +41,11 @@ pimPerfEnergyBankLevel::getPerfEnergyForFunc1(PimCmdEnum cmdType, const pimObjIn
       msRuntime = m_tR + m_tW + totalGDLOverhead + (maxElementsPerRegion * m_blimpCoreLatency * numberOfOperationPerElement * numPass);
       mjEnergy = (m_eAP * 2 + (m_eGDL * 2 + (maxElementsPerRegion * m_blimpLogicalEnergy * numberOfOperationPerElement))) * numCores * numPass;
       mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      // GDL transfers are attributed to row reads
+      msRead = m_tR + totalGDLOverhead;
+      msWrite = m_tW;
+      mjRead = (m_eAP + m_eGDL * 2) * numCores * numPass;
+      mjWrite = m_eAP * numCores * numPass;
       break;
     }
     case PimCmdEnum::AND_SCALAR:
@@ -58,6 +67,11 @@ pimPerfEnergyBankLevel::getPerfEnergyForFunc1(PimCmdEnum cmdType, const pimObjIn
       msRuntime = m_tR + m_tW + totalGDLOverhead + (maxElementsPerRegion * m_blimpCoreLatency * numberOfOperationPerElement * numPass);
       mjEnergy = ((m_eAP * 2) + (m_eGDL * 2 + (maxElementsPerRegion * m_blimpLogicalEnergy * numberOfOperationPerElement))) * numCores * numPass ;
       mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      // GDL transfers are attributed to row reads
+      msRead = m_tR + totalGDLOverhead;
+      msWrite = m_tW;
+      mjRead = (m_eAP + m_eGDL * 2) * numCores * numPass;
+      mjWrite = m_eAP * numCores * numPass;
       break;
     }
     default:
@@ -65,7 +79,7 @@ pimPerfEnergyBankLevel::getPerfEnergyForFunc1(PimCmdEnum cmdType, const pimObjIn
       break;
   }
 
-  return pimeval::perfEnergy(msRuntime, mjEnergy);
+  return getPerfEnergyWithComponents(msRuntime, mjEnergy, msRead, msWrite, mjRead, mjWrite);
 }
 
 //! @brief  Perf energy model of bank-level PIM for func2
@@ -77,6 +91,10 @@ pimPerfEnergyBankLevel::getPerfEnergyForFunc2(PimCmdEnum cmdType, const pimObjIn
   unsigned numPass = obj.getMaxNumRegionsPerCore();
   unsigned bitsPerElement = obj.getBitsPerElement();
   unsigned numCoresUsed = obj.getNumCoresUsed();
+  double msRead = 0.0;
+  double msWrite = 0.0;
+  double mjRead = 0.0;
+  double mjWrite = 0.0;
 
   unsigned maxElementsPerRegion = obj.getMaxElementsPerRegion();
   double numberOfOperationPerElement = ((double)bitsPerElement / m_blimpCoreBitWidth);
@@ -95,6 +113,10 @@ pimPerfEnergyBankLevel::getPerfEnergyForFunc2(PimCmdEnum cmdType, const pimObjIn
       msRuntime *= numPass;
       mjEnergy = ((m_eAP * 3) + (m_eGDL * 3 + (maxElementsPerRegion * m_blimpArithmeticEnergy * numberOfOperationPerElement))) * numCoresUsed * numPass;
       mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      msRead = (2 * m_tR + totalGDLOverhead) * numPass;
+      msWrite = m_tW * numPass;
+      mjRead = (m_eAP * 2 + m_eGDL * 3) * numCoresUsed * numPass;
+      mjWrite = m_eAP * numCoresUsed * numPass;
       break;
     }
     case PimCmdEnum::SCALED_ADD:
@@ -119,6 +141,10 @@ pimPerfEnergyBankLevel::getPerfEnergyForFunc2(PimCmdEnum cmdType, const pimObjIn
       mjEnergy += maxElementsPerRegion * numberOfOperationPerElement * m_blimpArithmeticEnergy * numCoresUsed;
       mjEnergy *= numPass;
       mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      msRead = m_tR + totalGDLOverhead * numPass;
+      msWrite = m_tW * numPass;
+      mjRead = (m_eAP * 2 + m_eGDL * 3) * numCoresUsed * numPass;
+      mjWrite = m_eAP * numCoresUsed * numPass;
       break;
     }
     case PimCmdEnum::AND:
@@ -137,6 +163,10 @@ pimPerfEnergyBankLevel::getPerfEnergyForFunc2(PimCmdEnum cmdType, const pimObjIn
       mjEnergy = ((m_eAP * 3) + (m_eGDL * 3 + (maxElementsPerRegion * m_blimpLogicalEnergy * numberOfOperationPerElement))) * numCoresUsed;
       mjEnergy *= numPass;
       mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      msRead = (2 * m_tR + totalGDLOverhead) * numPass;
+      msWrite = m_tW * numPass;
+      mjRead = (m_eAP * 2 + m_eGDL * 3) * numCoresUsed * numPass;
+      mjWrite = m_eAP * numCoresUsed * numPass;
       break;
     }
     default:
@@ -144,7 +174,7 @@ pimPerfEnergyBankLevel::getPerfEnergyForFunc2(PimCmdEnum cmdType, const pimObjIn
       break;
   }
 
-  return pimeval::perfEnergy(msRuntime, mjEnergy);
+  return getPerfEnergyWithComponents(msRuntime, mjEnergy, msRead, msWrite, mjRead, mjWrite);
 }
 
 //! @brief  Perf energy model of bank-level PIM for reduction sum
@@ -9,7 +9,13 @@
 #include "pimPerfEnergyBitSerial.h"
 #include "pimPerfEnergyFulcrum.h"
 #include "pimPerfEnergyBankLevel.h"
+#include "pimUtils.h"
 #include <iostream>
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <stdexcept>
+#include <unordered_set>
 
 
 //! @brief  A factory function to create perf energy model for sim target
@@ -19,6 +25,10 @@ pimPerfEnergyFactory::createPerfEnergyModel(const pimPerfEnergyModelParams& para
   switch (params.getSimTarget()) {
     case PIM_DEVICE_BITSIMD_V:
     case PIM_DEVICE_BITSIMD_V_AP:
+    case PIM_DEVICE_BITSIMD_V_NAND:
+    case PIM_DEVICE_BITSIMD_V_MAJ:
+    case PIM_DEVICE_DRISA_NOR:
+    case PIM_DEVICE_DRISA_MIXED:
     case PIM_DEVICE_BITSIMD_H:
     case PIM_DEVICE_SIMDRAM:
       std::cout << "PIM-Info: Created performance energy model for bit-serial PIM" << std::endl;
@@ -40,7 +50,8 @@ pimPerfEnergyFactory::createPerfEnergyModel(const pimPerfEnergyModelParams& para
 pimPerfEnergyBase::pimPerfEnergyBase(const pimPerfEnergyModelParams& params)
   : m_simTarget(params.getSimTarget()),
     m_numRanks(params.getNumRanks()),
-    m_paramsDram(params.getParamsDram())
+    m_paramsDram(params.getParamsDram()),
+    m_resourceTimeline(params.getNumRanks(), params.getNumCores())
 {
   m_tR = m_paramsDram.getNsRowRead() / m_nano_to_milli;
   m_tW = m_paramsDram.getNsRowWrite() / m_nano_to_milli;
@@ -57,7 +68,7 @@ pimPerfEnergyBase::pimPerfEnergyBase(const pimPerfEnergyModelParams& params)
   m_typicalRankBW = m_paramsDram.getTypicalRankBW(); // GB/s
 }
 
-//! @brief  Perf energy model of data transfer between CPU memory and PIM memory
+//! @brief  Perf energy model of data transfer between CPU memory and PIM memory, spread over all ranks
 pimeval::perfEnergy
 pimPerfEnergyBase::getPerfEnergyForBytesTransfer(PimCmdEnum cmdType, uint64_t numBytes) const
 {
@@ -92,6 +103,34 @@ pimPerfEnergyBase::getPerfEnergyForBytesTransfer(PimCmdEnum cmdType, uint64_t nu
   return pimeval::perfEnergy(msRuntime, mjEnergy);
 }
 
+//! @brief  Perf energy model of a host-device copy with the bytes of each rank. Each rank transfers its own bytes
+//!         over its data bus, and ranks transfer in parallel
+pimeval::perfEnergy
+pimPerfEnergyBase::getPerfEnergyForBytesTransfer(PimCmdEnum cmdType, const std::vector<uint64_t>& numBytesPerRank) const
+{
+  double msRuntime = 0.0;
+  double msRankTotal = 0.0;
+  for (uint64_t numBytes : numBytesPerRank) {
+    double msRank = getMsForRankTransfer(numBytes);
+    msRuntime = std::max(msRuntime, msRank);
+    msRankTotal += msRank;
+  }
+  double mjEnergy = 0.0;
+  switch (cmdType) {
+    case PimCmdEnum::COPY_H2D:
+      mjEnergy = m_eW * msRankTotal * m_numChipsPerRank;
+      break;
+    case PimCmdEnum::COPY_D2H:
+      mjEnergy = m_eR * msRankTotal * m_numChipsPerRank;
+      break;
+    default:
+      std::cout << "PIM-Warning: Perf energy model not available for PIM command " << pimCmd::getName(cmdType, "") << std::endl;
+      break;
+  }
+  mjEnergy += getMjBackground(msRuntime);
+  return pimeval::perfEnergy(msRuntime, mjEnergy);
+}
+
 //! @brief  Perf energy model of base class for func1 (placeholder)
 pimeval::perfEnergy
 pimPerfEnergyBase::getPerfEnergyForFunc1(PimCmdEnum cmdType, const pimObjInfo& obj) const
@@ -137,3 +176,276 @@ pimPerfEnergyBase::getPerfEnergyForRotate(PimCmdEnum cmdType, const pimObjInfo&
   return pimeval::perfEnergy(msRuntime, mjEnergy);
 }
 
+//! @brief  Perf energy model of in-subarray row copy with RowClone, used by row compaction
+//!         Each row is copied with one AAP. Cores copy their rows in parallel.
+pimeval::perfEnergy
+pimPerfEnergyBase::getPerfEnergyForRowClone(unsigned maxRowsPerCore, uint64_t totalRows) const
+{
+  double msRuntime = m_paramsDram.getNsAAP() / m_nano_to_milli * maxRowsPerCore;
+  double mjEnergy = m_eAP * 2 * totalRows;
+  pimeval::perfEnergy perfEnergy(msRuntime, mjEnergy);
+  perfEnergy.setMjComponents(m_eAP * totalRows, m_eAP * totalRows, 0.0, 0.0);
+  return perfEnergy;
+}
+
+//! @brief  Fill components of a near-bank model from its row read and write parts. Background energy is
+//!         derived from runtime, and the rest of runtime and energy is attributed to the near-bank logic.
+pimeval::perfEnergy
+pimPerfEnergyBase::getPerfEnergyWithComponents(double msRuntime, double mjEnergy, double msRead, double msWrite,
+                                               double mjRead, double mjWrite) const
+{
+  pimeval::perfEnergy perfEnergy(msRuntime, mjEnergy);
+  double mjBackground = getMjBackground(msRuntime);
+  perfEnergy.setMsComponents(msRead, msWrite, msRuntime - msRead - msWrite);
+  perfEnergy.setMjComponents(mjRead, mjWrite, mjEnergy - mjRead - mjWrite - mjBackground, mjBackground);
+  return perfEnergy;
+}
+
+//! @brief  pimResourceTimeline ctor. Cores are numbered rank by rank
+pimResourceTimeline::pimResourceTimeline(unsigned numRanks, unsigned numCores)
+  : m_numCoresPerRank(numRanks > 0 ? std::max(1u, numCores / numRanks) : 1u),
+    m_msCoreFree(numCores, 0.0),
+    m_msRankBusFree(std::max(1u, numRanks), 0.0)
+{
+}
+
+//! @brief  Schedule a command on the resource timeline and return its modeled start time. Commands without cores,
+//!         e.g., device-wide commands, occupy all cores. Host-device copies also occupy the data bus of each rank
+//!         for the transfer time of the rank in msRankBus, and other commands pass it empty. Synchronous
+//!         commands (stream 0) are issued at the current host time, and stream commands at msIssue, the host time
+//!         when they were enqueued
+double
+pimResourceTimeline::scheduleCmd(const std::vector<PimObjId>& objIds, const std::vector<PimCoreId>& coreIds,
+                                 const std::vector<double>& msRankBus, double msRuntime, PimStreamId stream,
+                                 double msIssue)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  std::vector<unsigned> cores;
+  for (PimCoreId coreId : coreIds) {
+    if (coreId >= 0 && static_cast<size_t>(coreId) < m_msCoreFree.size()) {
+      cores.push_back(coreId);
+    }
+  }
+  if (cores.empty()) {
+    for (unsigned coreId = 0; coreId < m_msCoreFree.size(); ++coreId) {
+      cores.push_back(coreId);
+    }
+  }
+  bool isHostTransfer = !msRankBus.empty();
+  std::vector<unsigned> ranks;
+  for (unsigned rank = 0; rank < msRankBus.size() && rank < m_msRankBusFree.size(); ++rank) {
+    if (msRankBus[rank] > 0.0) {
+      ranks.push_back(rank);
+    }
+  }
+
+  double msStart = (stream == 0 ? m_msHostReady : std::max(msIssue, m_msStreamReady[stream]));
+  for (PimObjId objId : objIds) {
+    auto it = m_msObjReady.find(objId);
+    if (it != m_msObjReady.end()) {
+      msStart = std::max(msStart, it->second);
+    }
+  }
+  for (unsigned coreId : cores) {
+    msStart = std::max(msStart, m_msCoreFree[coreId]);
+  }
+  for (unsigned rank : ranks) {
+    msStart = std::max(msStart, m_msRankBusFree[rank]);
+  }
+
+  double msEnd = msStart + msRuntime;
+  for (PimObjId objId : objIds) {
+    m_msObjReady[objId] = msEnd;
+  }
+  for (unsigned coreId : cores) {
+    m_msCoreFree[coreId] = msEnd;
+  }
+  for (unsigned rank : ranks) {
+    m_msRankBusFree[rank] = msStart + msRankBus[rank];
+  }
+  if (stream != 0) {
+    m_msStreamReady[stream] = msEnd;
+  }
+  ++m_numCmds;
+  m_msSerialized += msRuntime;
+  (isHostTransfer ? m_msCopy : m_msCompute) += msRuntime;
+  m_msMakespan = std::max(m_msMakespan, msEnd);
+  return msStart;
+}
+
+//! @brief  Block the host until a modeled time, e.g., for results of a command or a stream to arrive
+void
+pimResourceTimeline::waitHost(double msTime)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_msHostReady = std::max(m_msHostReady, msTime);
+}
+
+//! @brief  Forget the ready time of a freed PIM object, whose ID may be reused
+void
+pimResourceTimeline::releaseObj(PimObjId objId)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_msObjReady.erase(objId);
+}
+
+//! @brief  Forget the ready time of a destroyed stream
+void
+pimResourceTimeline::releaseStream(PimStreamId stream)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_msStreamReady.erase(stream);
+}
+
+//! @brief  Reset the resource timeline
+void
+pimResourceTimeline::reset()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  std::fill(m_msCoreFree.begin(), m_msCoreFree.end(), 0.0);
+  std::fill(m_msRankBusFree.begin(), m_msRankBusFree.end(), 0.0);
+  m_msObjReady.clear();
+  for (auto& it : m_msStreamReady) {
+    it.second = 0.0;
+  }
+  m_msHostReady = 0.0;
+  m_numCmds = 0;
+  m_msSerialized = 0.0;
+  m_msMakespan = 0.0;
+  m_msCopy = 0.0;
+  m_msCompute = 0.0;
+}
+
+//! @brief  Check if any command has been scheduled
+bool
+pimResourceTimeline::hasTimeline() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_numCmds > 0;
+}
+
+//! @brief  Get number of scheduled commands
+uint64_t
+pimResourceTimeline::getNumCmds() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_numCmds;
+}
+
+//! @brief  Get sum of command runtimes
+double
+pimResourceTimeline::getMsSerialized() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_msSerialized;
+}
+
+//! @brief  Get makespan of the timeline
+double
+pimResourceTimeline::getMsOverlapped() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_msMakespan;
+}
+
+//! @brief  Get sum of host-device copy runtimes
+double
+pimResourceTimeline::getMsCopy() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_msCopy;
+}
+
+//! @brief  Get sum of runtimes of commands other than host-device copies
+double
+pimResourceTimeline::getMsCompute() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_msCompute;
+}
+
+//! @brief  Get the modeled host time, at which the host issues its next command
+double
+pimResourceTimeline::getMsHostReady() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_msHostReady;
+}
+
+//! @brief  Get end time of the last scheduled command of a stream
+double
+pimResourceTimeline::getMsStreamReady(PimStreamId stream) const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_msStreamReady.find(stream);
+  return it != m_msStreamReady.end() ? it->second : 0.0;
+}
+
+//! @brief  Get end time of the last scheduled command of all streams
+double
+pimResourceTimeline::getMsAllStreamsReady() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  double msReady = 0.0;
+  for (const auto& it : m_msStreamReady) {
+    msReady = std::max(msReady, it.second);
+  }
+  return msReady;
+}
+
+//! @brief  Get a lower bound of start times of commands scheduled later. Every command occupies at least one
+//!         core, so none can start before the earliest time a core becomes free
+double
+pimResourceTimeline::getMsEarliestStart() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_msCoreFree.empty() ? 0.0 : *std::min_element(m_msCoreFree.begin(), m_msCoreFree.end());
+}
+
+//! @brief  pimActThrottle ctor. Read the power budget from environment variable PIMEVAL_ACT_POWER_BUDGET.
+//!         Activations rotate across bank groups with tRRD_S when a rank has banks in more than one bank group.
+pimActThrottle::pimActThrottle(const pimPerfEnergyModelParams& params)
+  : m_numCoresPerRank(params.getNumRanks() > 0 ? std::max(1u, params.getNumCores() / params.getNumRanks()) : 1u)
+{
+  std::string budget;
+  if (!pimUtils::getEnvVar(pimUtils::envVarPimEvalActPowerBudget, budget) || budget.empty()) {
+    return;
+  }
+  try {
+    m_powerBudget = std::stod(budget);
+  } catch (const std::exception&) {
+    m_powerBudget = -1.0;
+  }
+  if (m_powerBudget <= 0.0) {
+    if (m_powerBudget < 0.0) {
+      std::printf("PIM-Warning: Invalid value %s for environment variable %s. Activation throttling is disabled\n",
+                  budget.c_str(), pimUtils::envVarPimEvalActPowerBudget);
+    }
+    m_powerBudget = 0.0;
+    return;
+  }
+  const pimParamsDram& paramsDram = params.getParamsDram();
+  bool isMultiBankGroup = params.getNumBankPerRank() > static_cast<unsigned>(paramsDram.getNumBanksPerGroup());
+  double nsTRRD = isMultiBankGroup ? paramsDram.getNsTRRD_S() : paramsDram.getNsTRRD_L();
+  m_nsTFAW = paramsDram.getNsTFAW();
+  m_nsPerAct = std::max(m_nsTFAW / 4, nsTRRD) / m_powerBudget;
+  if (m_nsTFAW <= 0.0 || m_nsPerAct <= 0.0) {
+    m_powerBudget = 0.0;
+  }
+}
+
+//! @brief  Max number of cores of a PIM object in one rank. Cores are numbered rank by rank
+unsigned
+pimActThrottle::getMaxCoresPerRank(const pimObjInfo& obj) const
+{
+  std::unordered_set<PimCoreId> cores;
+  std::unordered_map<unsigned, unsigned> numCoresOfRank;
+  unsigned maxCores = 0;
+  for (const auto& region : obj.getRegions()) {
+    PimCoreId coreId = region.getCoreId();
+    if (cores.insert(coreId).second) {
+      maxCores = std::max(maxCores, ++numCoresOfRank[coreId / m_numCoresPerRank]);
+    }
+  }
+  return maxCores;
+}
@@ -12,9 +12,17 @@
 #include "pimCmd.h"                    // for PimCmdEnum
 #include "pimResMgr.h"                 // for pimObjInfo
 #include <memory>                      // for std::unique_ptr
+#include <cmath>                       // for std::abs
+#include <vector>                      // for std::vector
+#include <unordered_map>               // for std::unordered_map
+#include <algorithm>                   // for std::max
+#include <mutex>                       // for std::mutex
 
 
 namespace pimeval {
+  //! @brief  Runtime and energy of a PIM command, with an optional breakdown into row read, row write, logic
+  //!         and background components. Models fill components they can attribute, and the remaining
+  //!         part of the totals is reported as unattributed.
   class perfEnergy
   {
     public:
@@ -23,6 +31,75 @@ namespace pimeval {
 
       double m_msRuntime;
       double m_mjEnergy;
+
+      double m_msRead = 0.0;
+      double m_msWrite = 0.0;
+      double m_msLogic = 0.0;
+      double m_mjRead = 0.0;
+      double m_mjWrite = 0.0;
+      double m_mjLogic = 0.0;
+      double m_mjBackground = 0.0;
+
+      // row reads, row writes and logic operations of each core, used to lower commands to DRAM commands
+      double m_numRowRead = 0.0;
+      double m_numRowWrite = 0.0;
+      double m_numLogic = 0.0;
+
+      //! @brief  Set runtime components
+      void setMsComponents(double msRead, double msWrite, double msLogic) {
+        m_msRead = msRead;
+        m_msWrite = msWrite;
+        m_msLogic = msLogic;
+      }
+      //! @brief  Set energy components
+      void setMjComponents(double mjRead, double mjWrite, double mjLogic, double mjBackground) {
+        m_mjRead = mjRead;
+        m_mjWrite = mjWrite;
+        m_mjLogic = mjLogic;
+        m_mjBackground = mjBackground;
+      }
+      //! @brief  Set number of row reads, row writes and logic operations of each core
+      void setOpCounts(double numRowRead, double numRowWrite, double numLogic) {
+        m_numRowRead = numRowRead;
+        m_numRowWrite = numRowWrite;
+        m_numLogic = numLogic;
+      }
+      //! @brief  Get runtime not attributed to any component
+      double getMsOther() const { return getRemainder(m_msRuntime, m_msRead + m_msWrite + m_msLogic); }
+      //! @brief  Get energy not attributed to any component
+      double getMjOther() const { return getRemainder(m_mjEnergy, m_mjRead + m_mjWrite + m_mjLogic + m_mjBackground); }
+      //! @brief  Accumulate totals and components of another command
+      void add(const perfEnergy& other) {
+        m_msRuntime += other.m_msRuntime;
+        m_mjEnergy += other.m_mjEnergy;
+        m_msRead += other.m_msRead;
+        m_msWrite += other.m_msWrite;
+        m_msLogic += other.m_msLogic;
+        m_mjRead += other.m_mjRead;
+        m_mjWrite += other.m_mjWrite;
+        m_mjLogic += other.m_mjLogic;
+        m_mjBackground += other.m_mjBackground;
+        m_numRowRead += other.m_numRowRead;
+        m_numRowWrite += other.m_numRowWrite;
+        m_numLogic += other.m_numLogic;
+      }
+      //! @brief  Get totals and components accumulated since an earlier snapshot of the same accumulator
+      perfEnergy since(const perfEnergy& earlier) const {
+        perfEnergy delta(m_msRuntime - earlier.m_msRuntime, m_mjEnergy - earlier.m_mjEnergy);
+        delta.setMsComponents(m_msRead - earlier.m_msRead, m_msWrite - earlier.m_msWrite, m_msLogic - earlier.m_msLogic);
+        delta.setMjComponents(m_mjRead - earlier.m_mjRead, m_mjWrite - earlier.m_mjWrite, m_mjLogic - earlier.m_mjLogic,
+                              m_mjBackground - earlier.m_mjBackground);
+        delta.setOpCounts(m_numRowRead - earlier.m_numRowRead, m_numRowWrite - earlier.m_numRowWrite,
+                          m_numLogic - earlier.m_numLogic);
+        return delta;
+      }
+
+    private:
+      //! @brief  Remainder of a total, with rounding errors of fully attributed totals flushed to zero
+      static double getRemainder(double total, double attributed) {
+        double remainder = total - attributed;
+        return std::abs(remainder) <= std::abs(total) * 1e-12 ? 0.0 : remainder;
+      }
   };
 }
 
@@ -31,17 +108,111 @@ namespace pimeval {
 class pimPerfEnergyModelParams
 {
 public:
-  pimPerfEnergyModelParams(PimDeviceEnum simTarget, unsigned numRanks, const pimParamsDram& paramsDram)
-    : m_simTarget(simTarget), m_numRanks(numRanks), m_paramsDram(paramsDram) {}
+  pimPerfEnergyModelParams(PimDeviceEnum simTarget, unsigned numRanks, unsigned numBankPerRank, unsigned numCores,
+                           const pimParamsDram& paramsDram)
+    : m_simTarget(simTarget), m_numRanks(numRanks), m_numBankPerRank(numBankPerRank), m_numCores(numCores),
+      m_paramsDram(paramsDram) {}
   PimDeviceEnum getSimTarget() const { return m_simTarget; }
   unsigned getNumRanks() const { return m_numRanks; }
+  unsigned getNumBankPerRank() const { return m_numBankPerRank; }
+  unsigned getNumCores() const { return m_numCores; }
   const pimParamsDram& getParamsDram() const { return m_paramsDram; }
 private:
   PimDeviceEnum m_simTarget;
   unsigned m_numRanks;
+  unsigned m_numBankPerRank;
+  unsigned m_numCores;
   const pimParamsDram& m_paramsDram;
 };
 
+//! @class  pimResourceTimeline
+//! @brief  Modeled timeline of PIM commands on per-rank and per-core resources
+//!
+//! Each command starts when its PIM objects are ready, the resources it occupies are free and the host has
+//! issued it, and then occupies them for its modeled runtime. Computation occupies the cores of its objects,
+//! i.e., banks or subarrays depending on the device. Host-device copies also occupy the data bus of the ranks
+//! of those cores, each rank for the transfer time of its own bytes. Commands on disjoint cores overlap, and so
+//! do copies to one rank and computation in another.
+//!
+//! The host issues synchronous commands in program order without waiting for them, except that synchronous
+//! device-to-host copies and reduction sums block the host until their results arrive. Stream commands are
+//! issued when enqueued and execute in order within their stream, and the host waits for them only at stream
+//! synchronization and event waits. Host buffers are assumed not to alias. The overlapped runtime is the
+//! makespan, and the serialized runtime is the sum of command runtimes as in the stats. This is the only
+//! modeled clock of a device: timeline and DRAM trace exports take start times of commands from it.
+class pimResourceTimeline
+{
+public:
+  pimResourceTimeline(unsigned numRanks, unsigned numCores);
+
+  double scheduleCmd(const std::vector<PimObjId>& objIds, const std::vector<PimCoreId>& coreIds,
+                     const std::vector<double>& msRankBus, double msRuntime, PimStreamId stream = 0,
+                     double msIssue = 0.0);
+  void waitHost(double msTime);
+  void releaseObj(PimObjId objId);
+  void releaseStream(PimStreamId stream);
+  void reset();
+
+  bool hasTimeline() const;
+  uint64_t getNumCmds() const;
+  double getMsSerialized() const;
+  double getMsOverlapped() const;
+  double getMsCopy() const;
+  double getMsCompute() const;
+  double getMsHostReady() const;
+  double getMsStreamReady(PimStreamId stream) const;
+  double getMsAllStreamsReady() const;
+  double getMsEarliestStart() const;
+
+private:
+  mutable std::mutex m_mutex;
+  unsigned m_numCoresPerRank;
+  std::vector<double> m_msCoreFree;
+  std::vector<double> m_msRankBusFree;
+  std::unordered_map<PimObjId, double> m_msObjReady;
+  std::unordered_map<PimStreamId, double> m_msStreamReady;
+  double m_msHostReady = 0.0;
+  uint64_t m_numCmds = 0;
+  double m_msSerialized = 0.0;
+  double m_msMakespan = 0.0;
+  double m_msCopy = 0.0;
+  double m_msCompute = 0.0;
+};
+
+//! @class  pimActThrottle
+//! @brief  Activation throttling of a rank by tFAW, tRRD and a power budget
+//!
+//! A DRAM rank can issue at most four activations per tFAW window and one per tRRD, which bounds the current drawn
+//! by row activations. Bit-serial PIM activates one row in every core of a command at each step, i.e., a subarray
+//! or a group of aggregated subarrays, so a rank can only fire as many cores per row cycle as these constraints
+//! allow, and the rest are staggered in later cycles. The power budget scales the activation rate, e.g., 1 for
+//! JEDEC limits and 2 for a power delivery network that sustains twice the activation current. Throttling is
+//! disabled when the budget is 0.
+class pimActThrottle
+{
+public:
+  pimActThrottle(const pimPerfEnergyModelParams& params);
+
+  bool isEnabled() const { return m_powerBudget > 0.0; }
+  double getPowerBudget() const { return m_powerBudget; }
+  unsigned getNumCoresPerRank() const { return m_numCoresPerRank; }
+  //! @brief  Activations a rank can issue per tFAW window
+  double getActsPerWindow() const { return isEnabled() ? m_nsTFAW / m_nsPerAct : 0.0; }
+  //! @brief  Cores a rank can fire in parallel during a row cycle
+  double getMaxActsPerRowCycle(double nsRowCycle) const { return isEnabled() ? nsRowCycle / m_nsPerAct : 0.0; }
+  //! @brief  Slowdown of a row cycle when a rank activates a number of rows at each step
+  double getFactor(double numActsPerRank, double nsRowCycle) const {
+    return isEnabled() ? std::max(1.0, numActsPerRank * m_nsPerAct / nsRowCycle) : 1.0;
+  }
+  unsigned getMaxCoresPerRank(const pimObjInfo& obj) const;
+
+private:
+  double m_powerBudget = 0.0;
+  double m_nsTFAW = 0.0;
+  double m_nsPerAct = 0.0;
+  unsigned m_numCoresPerRank = 1;
+};
+
 //! @class  pimPerfEnergyFactory
 //! @brief  PIM performance energy model factory
 class pimPerfEnergyBase;
@@ -61,13 +232,31 @@ public:
   virtual ~pimPerfEnergyBase() {}
 
   virtual pimeval::perfEnergy getPerfEnergyForBytesTransfer(PimCmdEnum cmdType, uint64_t numBytes) const;
+  virtual pimeval::perfEnergy getPerfEnergyForBytesTransfer(PimCmdEnum cmdType,
+                                                            const std::vector<uint64_t>& numBytesPerRank) const;
   virtual pimeval::perfEnergy getPerfEnergyForFunc1(PimCmdEnum cmdType, const pimObjInfo& obj) const;
   virtual pimeval::perfEnergy getPerfEnergyForFunc2(PimCmdEnum cmdType, const pimObjInfo& obj) const;
   virtual pimeval::perfEnergy getPerfEnergyForRedSum(PimCmdEnum cmdType, const pimObjInfo& obj, unsigned numPass) const;
   virtual pimeval::perfEnergy getPerfEnergyForBroadcast(PimCmdEnum cmdType, const pimObjInfo& obj) const;
   virtual pimeval::perfEnergy getPerfEnergyForRotate(PimCmdEnum cmdType, const pimObjInfo& obj) const;
+  virtual pimeval::perfEnergy getPerfEnergyForRowClone(unsigned maxRowsPerCore, uint64_t totalRows) const;
+
+  //! @brief  Transfer time of bytes over the data bus of one rank
+  double getMsForRankTransfer(uint64_t numBytes) const {
+    return static_cast<double>(numBytes) / (m_typicalRankBW * 1024 * 1024 * 1024 / 1000);
+  }
+
+  pimResourceTimeline& getResourceTimeline() { return m_resourceTimeline; }
+  const pimResourceTimeline& getResourceTimeline() const { return m_resourceTimeline; }
+  //! @brief  Activation throttling applied by the model, if any
+  virtual const pimActThrottle* getActThrottle() const { return nullptr; }
 
 protected:
+  //! @brief  Background energy of all chips during a runtime
+  double getMjBackground(double msRuntime) const { return m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime; }
+  pimeval::perfEnergy getPerfEnergyWithComponents(double msRuntime, double mjEnergy, double msRead, double msWrite,
+                                                  double mjRead, double mjWrite) const;
+
   PimDeviceEnum m_simTarget;
   unsigned m_numRanks;
   const pimParamsDram& m_paramsDram;
@@ -89,6 +278,8 @@ protected:
   double m_pBCore; // background power for each core in W
   double m_pBChip; // background power for each core in W
   double m_eGDL = 0.0000102; // CAS energy in mJ
+
+  pimResourceTimeline m_resourceTimeline;
 };
 
 #endif
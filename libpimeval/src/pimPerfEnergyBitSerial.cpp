@@ -7,9 +7,54 @@
 #include "pimPerfEnergyBitSerial.h"
 #include "pimCmd.h"
 #include "pimPerfEnergyTables.h"
+#include "pimUtils.h"
 #include <iostream>
+#include <cstdio>
+#include <string>
+#include <cmath>
 
 
+//! @brief  pimPerfEnergyBitSerial ctor
+//!         Load generated bit-serial perf table if environment variable PIMEVAL_BITSERIAL_PERF_TABLE is set.
+//!         Commands not in the generated table fall back to the compiled-in table.
+pimPerfEnergyBitSerial::pimPerfEnergyBitSerial(const pimPerfEnergyModelParams& params)
+  : pimPerfEnergyBase(params),
+    m_actThrottle(params)
+{
+  std::string tableFile;
+  if (pimUtils::getEnvVar(pimUtils::envVarPimEvalBitSerialPerfTable, tableFile) && !tableFile.empty()) {
+    m_loadedPerfTable = pimPerfEnergyTables::bitsimdPerfTable;
+    if (pimPerfEnergyTables::loadBitsimdPerfTable(tableFile, m_loadedPerfTable)) {
+      m_perfTable = &m_loadedPerfTable;
+    } else {
+      std::printf("PIM-Warning: Use compiled-in bit-serial perf table\n");
+      m_loadedPerfTable.clear();
+    }
+  }
+  if (m_actThrottle.isEnabled()) {
+    double nsRowRead = m_paramsDram.getNsRowRead();
+    unsigned numCores = m_actThrottle.getNumCoresPerRank();
+    std::printf("PIM-Info: Activation throttling with power budget %g: %.2f ACTs per tFAW window, %.2f of %u cores per rank"
+                " fire per row read, %.2fx row read slowdown with all cores active\n",
+                m_actThrottle.getPowerBudget(), m_actThrottle.getActsPerWindow(), m_actThrottle.getMaxActsPerRowCycle(nsRowRead),
+                numCores, m_actThrottle.getFactor(numCores, nsRowRead));
+  }
+}
+
+//! @brief  Get row read and row write latency of a command, which are throttled when a rank cannot activate
+//!         one row in each core of the PIM object at once
+void
+pimPerfEnergyBitSerial::getThrottledRowLatency(const pimObjInfo& obj, double& msRowRead, double& msRowWrite) const
+{
+  msRowRead = m_tR;
+  msRowWrite = m_tW;
+  if (m_actThrottle.isEnabled()) {
+    unsigned numActs = m_actThrottle.getMaxCoresPerRank(obj);
+    msRowRead *= m_actThrottle.getFactor(numActs, m_paramsDram.getNsRowRead());
+    msRowWrite *= m_actThrottle.getFactor(numActs, m_paramsDram.getNsRowWrite());
+  }
+}
+
 //! @brief  Get performance and energy for bit-serial PIM
 //!         BitSIMD and SIMDRAM need different fields
 pimeval::perfEnergy
@@ -19,40 +64,83 @@ pimPerfEnergyBitSerial::getPerfEnergyBitSerial(PimDeviceEnum deviceType, PimCmdE
   double msRuntime = 0.0;
   double mjEnergy = 0.0;
   unsigned numCores = obj.getNumCoresUsed();
+  pimeval::perfEnergy components;
+  double tR = 0.0;
+  double tW = 0.0;
+  getThrottledRowLatency(obj, tR, tW);
 
   switch (deviceType) {
     case PIM_DEVICE_BITSIMD_V:
     case PIM_DEVICE_BITSIMD_V_AP:
+    case PIM_DEVICE_BITSIMD_V_NAND:
+    case PIM_DEVICE_BITSIMD_V_MAJ:
+    case PIM_DEVICE_DRISA_NOR:
+    case PIM_DEVICE_DRISA_MIXED:
     case PIM_DEVICE_BITSIMD_H:
     {
-      // BitSIMD-H reuse BitISMD-V perf for now
-      if (deviceType == PIM_DEVICE_BITSIMD_H) {
+      // BitSIMD-H reuse BitISMD-V perf unless a generated table provides BitSIMD-H entries
+      if (deviceType == PIM_DEVICE_BITSIMD_H && m_perfTable->find(deviceType) == m_perfTable->end()) {
         deviceType = PIM_DEVICE_BITSIMD_V;
       }
       // look up perf params from table
-      auto it1 = pimPerfEnergyTables::bitsimdPerfTable.find(deviceType);
-      if (it1 != pimPerfEnergyTables::bitsimdPerfTable.end()) {
+      auto it1 = m_perfTable->find(deviceType);
+      if (it1 != m_perfTable->end()) {
         auto it2 = it1->second.find(dataType);
         if (it2 != it1->second.end()) {
           auto it3 = it2->second.find(cmdType);
           if (it3 != it2->second.end()) {
             const auto& [numR, numW, numL] = it3->second;
-            msRuntime += m_tR * numR + m_tW * numW + m_tL * numL;
+            msRuntime += tR * numR + tW * numW + m_tL * numL;
             mjEnergy += ((m_eL * numL * obj.getMaxElementsPerRegion()) + (m_eAP * numR + m_eAP * numW)) * numCores;
             mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+            components.setMsComponents(tR * numR, tW * numW, m_tL * numL);
+            components.setMjComponents(m_eAP * numR * numCores, m_eAP * numW * numCores,
+                                       m_eL * numL * obj.getMaxElementsPerRegion() * numCores, getMjBackground(msRuntime));
+            components.setOpCounts(numR, numW, numL);
             ok = true;
           }
         }
       }
       // handle bit-shift specially
       if (cmdType == PimCmdEnum::SHIFT_BITS_L || cmdType == PimCmdEnum::SHIFT_BITS_R) {
-        msRuntime += m_tR * (bitsPerElement - 1) + m_tW * bitsPerElement + m_tL;
+        msRuntime += tR * (bitsPerElement - 1) + tW * bitsPerElement + m_tL;
+        components.m_msRead += tR * (bitsPerElement - 1);
+        components.m_msWrite += tW * bitsPerElement;
+        components.m_msLogic += m_tL;
+        components.m_numRowRead += bitsPerElement - 1;
+        components.m_numRowWrite += bitsPerElement;
+        components.m_numLogic += 1;
         ok = true;
       }
       break;
     }
     case PIM_DEVICE_SIMDRAM:
     {
+      // count AAP and AP of MAJ/NOT micro-programs, which do not support floating-point
+      if (dataType == PIM_FP32) {
+        break;
+      }
+      double numBits = bitsPerElement;
+      double numAAP = 0.0;
+      double numAP = 0.0;
+      auto it = pimPerfEnergyTables::simdramPerfTable.find(cmdType);
+      if (it != pimPerfEnergyTables::simdramPerfTable.end()) {
+        const auto& [aapPerBit, apPerBit, aapPerBitSq, apPerBitSq] = it->second;
+        numAAP = aapPerBit * numBits + aapPerBitSq * numBits * numBits;
+        numAP = apPerBit * numBits + apPerBitSq * numBits * numBits;
+        ok = true;
+      } else if (cmdType == PimCmdEnum::POPCOUNT) {
+        // accumulate every bit into a counter of log2(N) + 1 bits with half adders
+        double numHalfAdds = numBits * (std::ceil(std::log2(numBits)) + 1);
+        numAAP = 5 * numHalfAdds;
+        numAP = numHalfAdds;
+        ok = true;
+      }
+      if (ok) {
+        components = getPerfEnergySimdram(numAAP, numAP, obj);
+        msRuntime = components.m_msRuntime;
+        mjEnergy = components.m_mjEnergy;
+      }
       break;
     }
     default:
@@ -70,15 +158,50 @@ pimPerfEnergyBitSerial::getPerfEnergyBitSerial(PimDeviceEnum deviceType, PimCmdE
   msRuntime *= numPass;
   mjEnergy *= numPass;
 
-  return pimeval::perfEnergy(msRuntime, mjEnergy);
+  pimeval::perfEnergy result(msRuntime, mjEnergy);
+  if (ok) {
+    result.setMsComponents(components.m_msRead * numPass, components.m_msWrite * numPass, components.m_msLogic * numPass);
+    result.setMjComponents(components.m_mjRead * numPass, components.m_mjWrite * numPass, components.m_mjLogic * numPass,
+                           components.m_mjBackground * numPass);
+    result.setOpCounts(components.m_numRowRead * numPass, components.m_numRowWrite * numPass, components.m_numLogic * numPass);
+  }
+  return result;
+}
+
+//! @brief  Get performance and energy of SIMDRAM for one pass of AAP and AP (triple-row activation) operations
+//!         Both take one activate-precharge cycle. An AAP issues two activate commands in each core, and an AP
+//!         issues one activate command that raises three rows at once. Activation is throttled and charged per
+//!         activate command: the three rows of an AP share one set of sense amplifiers, which dominate the
+//!         energy, so an AP is charged as one row activation and an AAP as two.
+pimeval::perfEnergy
+pimPerfEnergyBitSerial::getPerfEnergySimdram(double numAAP, double numAP, const pimObjInfo& obj) const
+{
+  unsigned numCores = obj.getNumCoresUsed();
+  double nsAAP = m_paramsDram.getNsAAP();
+  double tAAP = nsAAP / m_nano_to_milli;
+  double tAP = tAAP;
+  if (m_actThrottle.isEnabled()) {
+    unsigned numActs = m_actThrottle.getMaxCoresPerRank(obj);
+    tAAP *= m_actThrottle.getFactor(2.0 * numActs, nsAAP);
+    tAP *= m_actThrottle.getFactor(numActs, nsAAP);
+  }
+  double msRuntime = tAAP * numAAP + tAP * numAP;
+  double mjAAP = m_eAP * numAAP * numCores;
+  double mjAP = m_eAP * numAP * numCores;
+  double mjEnergy = 2 * mjAAP + mjAP + getMjBackground(msRuntime);
+  // An AAP reads the source rows with the first activate and writes the destination rows with the second one
+  pimeval::perfEnergy perfEnergy(msRuntime, mjEnergy);
+  perfEnergy.setMsComponents(tAAP * numAAP / 2, tAAP * numAAP / 2, tAP * numAP);
+  perfEnergy.setMjComponents(mjAAP, mjAAP, mjAP, getMjBackground(msRuntime));
+  perfEnergy.setOpCounts(numAAP + numAP, numAAP, 0.0);
+  return perfEnergy;
 }
 
 //! @brief  Perf energy model of bit-serial PIM for func1
 pimeval::perfEnergy
 pimPerfEnergyBitSerial::getPerfEnergyForFunc1(PimCmdEnum cmdType, const pimObjInfo& obj) const
 {
-  double msRuntime = 0.0;
-  double mjEnergy = 0.0;
+  pimeval::perfEnergy perfEnergy;
   unsigned numPass = obj.getMaxNumRegionsPerCore();
   unsigned bitsPerElement = obj.getBitsPerElement();
   PimDataType dataType = obj.getDataType();
@@ -86,27 +209,28 @@ pimPerfEnergyBitSerial::getPerfEnergyForFunc1(PimCmdEnum cmdType, const pimObjIn
   switch (m_simTarget) {
     case PIM_DEVICE_BITSIMD_V:
     case PIM_DEVICE_BITSIMD_V_AP:
+    case PIM_DEVICE_BITSIMD_V_NAND:
+    case PIM_DEVICE_BITSIMD_V_MAJ:
+    case PIM_DEVICE_DRISA_NOR:
+    case PIM_DEVICE_DRISA_MIXED:
     case PIM_DEVICE_BITSIMD_H:
     case PIM_DEVICE_SIMDRAM:
     {
-      pimeval::perfEnergy perfEnergyBS = getPerfEnergyBitSerial(m_simTarget, cmdType, dataType, bitsPerElement, numPass, obj);
-      msRuntime += perfEnergyBS.m_msRuntime;
-      mjEnergy += perfEnergyBS.m_mjEnergy;
+      perfEnergy = getPerfEnergyBitSerial(m_simTarget, cmdType, dataType, bitsPerElement, numPass, obj);
       break;
     }
     default:
       assert(0);
   }
 
-  return pimeval::perfEnergy(msRuntime, mjEnergy);
+  return perfEnergy;
 }
 
 //! @brief  Perf energy model of bit-serial PIM for func2
 pimeval::perfEnergy
 pimPerfEnergyBitSerial::getPerfEnergyForFunc2(PimCmdEnum cmdType, const pimObjInfo& obj) const
 {
-  double msRuntime = 0.0;
-  double mjEnergy = 0.0;
+  pimeval::perfEnergy perfEnergy;
   unsigned numPass = obj.getMaxNumRegionsPerCore();
   unsigned bitsPerElement = obj.getBitsPerElement();
   PimDataType dataType = obj.getDataType();
@@ -114,19 +238,21 @@ pimPerfEnergyBitSerial::getPerfEnergyForFunc2(PimCmdEnum cmdType, const pimObjIn
   switch (m_simTarget) {
     case PIM_DEVICE_BITSIMD_V:
     case PIM_DEVICE_BITSIMD_V_AP:
+    case PIM_DEVICE_BITSIMD_V_NAND:
+    case PIM_DEVICE_BITSIMD_V_MAJ:
+    case PIM_DEVICE_DRISA_NOR:
+    case PIM_DEVICE_DRISA_MIXED:
     case PIM_DEVICE_BITSIMD_H:
     case PIM_DEVICE_SIMDRAM:
     {
-      pimeval::perfEnergy perfEnergyBS = getPerfEnergyBitSerial(m_simTarget, cmdType, dataType, bitsPerElement, numPass, obj);
-      msRuntime += perfEnergyBS.m_msRuntime;
-      mjEnergy += perfEnergyBS.m_mjEnergy;
+      perfEnergy = getPerfEnergyBitSerial(m_simTarget, cmdType, dataType, bitsPerElement, numPass, obj);
       break;
     }
     default:
       assert(0);
   }
 
-  return pimeval::perfEnergy(msRuntime, mjEnergy);
+  return perfEnergy;
 }
 
 //! @brief  Perf energy model of bit-serial PIM for reduction sum
@@ -141,10 +267,18 @@ pimPerfEnergyBitSerial::getPerfEnergyForRedSum(PimCmdEnum cmdType, const pimObjI
   unsigned maxElementsPerRegion = obj.getMaxElementsPerRegion();
   unsigned numCore = obj.getNumCoresUsed();
   double cpuTDP = 200; // W; AMD EPYC 9124 16 core
+  pimeval::perfEnergy components;
+  double tR = 0.0;
+  double tW = 0.0;
+  getThrottledRowLatency(obj, tR, tW);
 
   switch (m_simTarget) {
     case PIM_DEVICE_BITSIMD_V:
     case PIM_DEVICE_BITSIMD_V_AP:
+    case PIM_DEVICE_BITSIMD_V_NAND:
+    case PIM_DEVICE_BITSIMD_V_MAJ:
+    case PIM_DEVICE_DRISA_NOR:
+    case PIM_DEVICE_DRISA_MIXED:
     {
       if (dataType == PIM_INT8 || dataType == PIM_INT16 || dataType == PIM_INT64 || dataType == PIM_INT32 || dataType == PIM_UINT8 || dataType == PIM_UINT16 || dataType == PIM_UINT32 || dataType == PIM_UINT64) {
         // Assume row-wide popcount capability for integer reduction, with a 64-bit popcount logic unit per PIM core
@@ -152,7 +286,7 @@ pimPerfEnergyBitSerial::getPerfEnergyForRedSum(PimCmdEnum cmdType, const pimObjI
         // If there are multiple regions per core, the multi-region reduction sum is stored in the accumulator
         double mjEnergyPerPcl = m_pclNsDelay * m_pclUwPower * 1e-12;
         int numPclPerCore = (maxElementsPerRegion + 63) / 64; // number of 64-bit popcount needed for a row
-        msRuntime = m_tR + (m_pclNsDelay * 1e-6) * numPclPerCore;
+        msRuntime = tR + (m_pclNsDelay * 1e-6) * numPclPerCore;
         msRuntime *= bitsPerElement * numPass;
         mjEnergy = m_eAP * numCore + mjEnergyPerPcl * numPclPerCore * numCore; // energy of one row read and row-wide popcount
         mjEnergy *= bitsPerElement * numPass;
@@ -161,15 +295,30 @@ pimPerfEnergyBitSerial::getPerfEnergyForRedSum(PimCmdEnum cmdType, const pimObjI
         msRuntime += aggregateMs;
         mjEnergy += aggregateMs * cpuTDP;
         mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+        // host-side aggregation is left unattributed
+        double numRowReads = static_cast<double>(bitsPerElement) * numPass;
+        components.setMsComponents(tR * numRowReads, 0.0, (m_pclNsDelay * 1e-6) * numPclPerCore * numRowReads);
+        components.setMjComponents(m_eAP * numCore * numRowReads, 0.0, mjEnergyPerPcl * numPclPerCore * numCore * numRowReads,
+                                   getMjBackground(msRuntime));
+        components.setOpCounts(numRowReads, 0.0, numRowReads);
       } else {
         assert(0);
       }
       break;
     }
     case PIM_DEVICE_SIMDRAM:
-      // todo
-      std::cout << "PIM-Warning: SIMDRAM performance stats not implemented yet." << std::endl;
+    {
+      // SIMDRAM has no data movement across columns. Read all elements to host for reduction.
+      pimeval::perfEnergy perfEnergyD2H = getPerfEnergyForBytesTransfer(PimCmdEnum::COPY_D2H, (numElements * bitsPerElement + 7) / 8);
+      double aggregateMs = static_cast<double>(numElements) / 3200000; // typical 3.2 GHz CPU
+      msRuntime = perfEnergyD2H.m_msRuntime + aggregateMs;
+      mjEnergy = perfEnergyD2H.m_mjEnergy + aggregateMs * cpuTDP + getMjBackground(aggregateMs);
+      // host-side aggregation is left unattributed
+      components.setMsComponents(perfEnergyD2H.m_msRuntime, 0.0, 0.0);
+      components.setMjComponents(perfEnergyD2H.m_mjEnergy - getMjBackground(perfEnergyD2H.m_msRuntime), 0.0, 0.0,
+                                 getMjBackground(msRuntime));
       break;
+    }
     case PIM_DEVICE_BITSIMD_H:
       // Sequentially process all elements per CPU cycle
       msRuntime = static_cast<double>(numElements) / 3200000; // typical 3.2 GHz CPU
@@ -180,7 +329,9 @@ pimPerfEnergyBitSerial::getPerfEnergyForRedSum(PimCmdEnum cmdType, const pimObjI
       assert(0);
   }
 
-  return pimeval::perfEnergy(msRuntime, mjEnergy);
+  components.m_msRuntime = msRuntime;
+  components.m_mjEnergy = mjEnergy;
+  return components;
 }
 
 //! @brief  Perf energy model of bit-serial PIM for broadcast
@@ -193,40 +344,57 @@ pimPerfEnergyBitSerial::getPerfEnergyForBroadcast(PimCmdEnum cmdType, const pimO
   unsigned bitsPerElement = obj.getBitsPerElement();
   unsigned maxElementsPerRegion = obj.getMaxElementsPerRegion();
   unsigned numCore = obj.getNumCoresUsed();
+  pimeval::perfEnergy components;
+  double tR = 0.0;
+  double tW = 0.0;
+  getThrottledRowLatency(obj, tR, tW);
   switch (m_simTarget) {
     case PIM_DEVICE_BITSIMD_V:
     case PIM_DEVICE_BITSIMD_V_AP:
+    case PIM_DEVICE_BITSIMD_V_NAND:
+    case PIM_DEVICE_BITSIMD_V_MAJ:
+    case PIM_DEVICE_DRISA_NOR:
+    case PIM_DEVICE_DRISA_MIXED:
     {
       // For one pass: For every bit: Set SA to bit value; Write SA to row;
-      msRuntime = (m_tL + m_tW) * bitsPerElement;
+      msRuntime = (m_tL + tW) * bitsPerElement;
       msRuntime *= numPass;
       mjEnergy = m_eAP * numCore * numPass ;
       mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      components.setMsComponents(0.0, tW * bitsPerElement * numPass, m_tL * bitsPerElement * numPass);
+      components.setMjComponents(0.0, m_eAP * numCore * numPass, 0.0, getMjBackground(msRuntime));
+      components.setOpCounts(0.0, bitsPerElement * numPass, bitsPerElement * numPass);
       break;
     }
     case PIM_DEVICE_SIMDRAM:
     {
-      // todo
-      msRuntime *= numPass;
-      mjEnergy *= numPass;
-      mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      // For one pass: For every bit: AAP from constant row C0 or C1 to row
+      components = getPerfEnergySimdram(bitsPerElement * numPass, 0.0, obj);
+      msRuntime = components.m_msRuntime;
+      mjEnergy = components.m_mjEnergy;
       break;
     }
     case PIM_DEVICE_BITSIMD_H:
     {
       // For one pass: For every element: 1 tCCD per byte
       uint64_t maxBytesPerRegion = (uint64_t)maxElementsPerRegion * (bitsPerElement / 8);
-      msRuntime = m_tW + m_tL * maxBytesPerRegion; // for one pass
+      msRuntime = tW + m_tL * maxBytesPerRegion; // for one pass
       msRuntime *= numPass;
       mjEnergy = (m_eAP + (m_tL * maxBytesPerRegion)) * numCore * numPass;
       mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      components.setMsComponents(0.0, tW * numPass, m_tL * maxBytesPerRegion * numPass);
+      components.setMjComponents(0.0, m_eAP * numCore * numPass, m_tL * maxBytesPerRegion * numCore * numPass,
+                                 getMjBackground(msRuntime));
+      components.setOpCounts(0.0, numPass, maxBytesPerRegion * numPass);
       break;
     }
     default:
       assert(0);
   }
 
-  return pimeval::perfEnergy(msRuntime, mjEnergy);
+  components.m_msRuntime = msRuntime;
+  components.m_mjEnergy = mjEnergy;
+  return components;
 }
 
 //! @brief  Perf energy model of bit-serial PIM for rotate
@@ -239,37 +407,60 @@ pimPerfEnergyBitSerial::getPerfEnergyForRotate(PimCmdEnum cmdType, const pimObjI
   unsigned bitsPerElement = obj.getBitsPerElement();
   unsigned numRegions = obj.getRegions().size();
   // boundary handling
-  pimeval::perfEnergy perfEnergyBT = getPerfEnergyForBytesTransfer(cmdType, numRegions * bitsPerElement / 8);
+  pimeval::perfEnergy perfEnergyBT = getPerfEnergyForBytesTransfer(cmdType, (numRegions * bitsPerElement + 7) / 8);
+  double numRowRead = 0.0;
+  double numRowWrite = 0.0;
+  double numLogic = 0.0;
+  double tR = 0.0;
+  double tW = 0.0;
+  getThrottledRowLatency(obj, tR, tW);
 
   switch (m_simTarget) {
     case PIM_DEVICE_BITSIMD_V:
     case PIM_DEVICE_BITSIMD_V_AP:
+    case PIM_DEVICE_BITSIMD_V_NAND:
+    case PIM_DEVICE_BITSIMD_V_MAJ:
+    case PIM_DEVICE_DRISA_NOR:
+    case PIM_DEVICE_DRISA_MIXED:
       // rotate within subarray:
       // For every bit: Read row to SA; move SA to R1; Shift R1; Move R1 to SA; Write SA to row
-      msRuntime = (m_tR + 3 * m_tL + m_tW) * bitsPerElement; // for one pass
+      msRuntime = (tR + 3 * m_tL + tW) * bitsPerElement; // for one pass
       msRuntime *= numPass;
       mjEnergy = (m_eAP + 3 * m_eL) * bitsPerElement * numPass; // for one pass
       msRuntime += 2 * perfEnergyBT.m_msRuntime;
       mjEnergy += 2 * perfEnergyBT.m_mjEnergy;
+      numRowRead = numRowWrite = static_cast<double>(bitsPerElement) * numPass;
+      numLogic = 3.0 * bitsPerElement * numPass;
       break;
     case PIM_DEVICE_SIMDRAM:
-      // todo
+    {
+      // SIMDRAM has no data movement across columns. Read all elements to host and write back rotated.
+      uint64_t numBytes = (obj.getNumElements() * bitsPerElement + 7) / 8;
+      pimeval::perfEnergy perfEnergyD2H = getPerfEnergyForBytesTransfer(PimCmdEnum::COPY_D2H, numBytes);
+      pimeval::perfEnergy perfEnergyH2D = getPerfEnergyForBytesTransfer(PimCmdEnum::COPY_H2D, numBytes);
+      msRuntime = perfEnergyD2H.m_msRuntime + perfEnergyH2D.m_msRuntime;
+      mjEnergy = perfEnergyD2H.m_mjEnergy + perfEnergyH2D.m_mjEnergy;
       break;
+    }
     case PIM_DEVICE_BITSIMD_H:
       // rotate within subarray:
       // For every bit: Read row to SA; move SA to R1; Shift R1 by N steps; Move R1 to SA; Write SA to row
       // TODO: separate bank level and GDL
       // TODO: energy unimplemented
-      msRuntime = (m_tR + (bitsPerElement + 2) * m_tL + m_tW); // for one pass
+      msRuntime = (tR + (bitsPerElement + 2) * m_tL + tW); // for one pass
       msRuntime *= numPass;
       mjEnergy = (m_eAP + (bitsPerElement + 2) * m_eL) * numPass;
       msRuntime += 2 * perfEnergyBT.m_msRuntime;
       mjEnergy += 2 * perfEnergyBT.m_mjEnergy;
+      numRowRead = numRowWrite = numPass;
+      numLogic = static_cast<double>(bitsPerElement + 2) * numPass;
       break;
     default:
       assert(0);
   }
 
-  return pimeval::perfEnergy(msRuntime, mjEnergy);
+  pimeval::perfEnergy perfEnergy(msRuntime, mjEnergy);
+  perfEnergy.setOpCounts(numRowRead, numRowWrite, numLogic);
+  return perfEnergy;
 }
 
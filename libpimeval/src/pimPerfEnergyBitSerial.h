@@ -12,6 +12,7 @@
 #include "pimCmd.h"                    // for PimCmdEnum
 #include "pimResMgr.h"                 // for pimObjInfo
 #include "pimPerfEnergyBase.h"         // for pimPerfEnergyBase
+#include "pimPerfEnergyTables.h"       // for bitsimdPerfTableType
 
 
 //! @class  pimPerfEnergyBitSerial
@@ -19,7 +20,7 @@
 class pimPerfEnergyBitSerial : public pimPerfEnergyBase
 {
 public:
-  pimPerfEnergyBitSerial(const pimPerfEnergyModelParams& params) : pimPerfEnergyBase(params) {}
+  pimPerfEnergyBitSerial(const pimPerfEnergyModelParams& params);
   virtual ~pimPerfEnergyBitSerial() {}
 
   virtual pimeval::perfEnergy getPerfEnergyForFunc1(PimCmdEnum cmdType, const pimObjInfo& obj) const override;
@@ -27,9 +28,19 @@ public:
   virtual pimeval::perfEnergy getPerfEnergyForRedSum(PimCmdEnum cmdType, const pimObjInfo& obj, unsigned numPass) const override;
   virtual pimeval::perfEnergy getPerfEnergyForBroadcast(PimCmdEnum cmdType, const pimObjInfo& obj) const override;
   virtual pimeval::perfEnergy getPerfEnergyForRotate(PimCmdEnum cmdType, const pimObjInfo& obj) const override;
+  virtual const pimActThrottle* getActThrottle() const override { return m_actThrottle.isEnabled() ? &m_actThrottle : nullptr; }
 
 protected:
   pimeval::perfEnergy getPerfEnergyBitSerial(PimDeviceEnum deviceType, PimCmdEnum cmdType, PimDataType dataType, unsigned bitsPerElement, unsigned numPass, const pimObjInfo& obj) const;
+  pimeval::perfEnergy getPerfEnergySimdram(double numAAP, double numAP, const pimObjInfo& obj) const;
+  void getThrottledRowLatency(const pimObjInfo& obj, double& msRowRead, double& msRowWrite) const;
+
+  // Compiled-in bit-serial perf table, or a copy merged with a generated table
+  const pimPerfEnergyTables::bitsimdPerfTableType* m_perfTable = &pimPerfEnergyTables::bitsimdPerfTable;
+  pimPerfEnergyTables::bitsimdPerfTableType m_loadedPerfTable;
+
+  // Activation throttling by tFAW, tRRD and power budget
+  pimActThrottle m_actThrottle;
 
   // Popcount logc Params from DRAM-CAM paper
   double m_pclNsDelay = 0.76; // 64-bit popcount logic ns delay, using LUT no pipeline design
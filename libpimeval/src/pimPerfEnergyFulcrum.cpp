@@ -18,6 +18,10 @@ pimPerfEnergyFulcrum::getPerfEnergyForFunc1(PimCmdEnum cmdType, const pimObjInfo
   unsigned numPass = obj.getMaxNumRegionsPerCore();
   unsigned bitsPerElement = obj.getBitsPerElement();
   unsigned numCores = obj.getNumCoresUsed();
+  double msRead = 0.0;
+  double msWrite = 0.0;
+  double mjRead = 0.0;
+  double mjWrite = 0.0;
 
   // Fulcrum utilizes three walkers: two for input operands and one for the output operand.
   // For instructions that operate on a single operand, the next operand is fetched by the walker.
@@ -37,6 +41,9 @@ pimPerfEnergyFulcrum::getPerfEnergyForFunc1(PimCmdEnum cmdType, const pimObjInfo
       double energyLogical = ((maxElementsPerRegion - 1) * 2 *  m_fulcrumShiftEnergy) + ((maxElementsPerRegion) * m_fulcrumALULogicalEnergy * 8);
       mjEnergy = ((energyArithmetic + energyLogical) + m_eAP) * numCores * numPass;
       mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      msRead = m_tR;
+      msWrite = m_tW;
+      mjRead = m_eAP * numCores * numPass;
       break;
     }
     case PimCmdEnum::ADD_SCALAR:
@@ -48,6 +55,10 @@ pimPerfEnergyFulcrum::getPerfEnergyForFunc1(PimCmdEnum cmdType, const pimObjInfo
       msRuntime = m_tR + m_tW + (maxElementsPerRegion * m_fulcrumAluLatency * numberOfALUOperationPerElement * numPass);
       mjEnergy = numPass * numCores * ((m_eAP * 2) + ((maxElementsPerRegion - 1) * 2 *  m_fulcrumShiftEnergy) + ((maxElementsPerRegion) * m_fulcrumALUArithmeticEnergy * numberOfALUOperationPerElement));
       mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      msRead = m_tR;
+      msWrite = m_tW;
+      mjRead = m_eAP * numCores * numPass;
+      mjWrite = m_eAP * numCores * numPass;
       break;
     }
     case PimCmdEnum::AND_SCALAR:
@@ -65,6 +76,10 @@ pimPerfEnergyFulcrum::getPerfEnergyForFunc1(PimCmdEnum cmdType, const pimObjInfo
       msRuntime = m_tR + m_tW + (maxElementsPerRegion * m_fulcrumAluLatency * numberOfALUOperationPerElement * numPass);
       mjEnergy = numPass * numCores * ((m_eAP * 2) + ((maxElementsPerRegion - 1) * 2 *  m_fulcrumShiftEnergy) + ((maxElementsPerRegion) * m_fulcrumALULogicalEnergy * numberOfALUOperationPerElement));
       mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      msRead = m_tR;
+      msWrite = m_tW;
+      mjRead = m_eAP * numCores * numPass;
+      mjWrite = m_eAP * numCores * numPass;
       break;
     }
     default:
@@ -72,7 +87,7 @@ pimPerfEnergyFulcrum::getPerfEnergyForFunc1(PimCmdEnum cmdType, const pimObjInfo
       break;
   }
 
-  return pimeval::perfEnergy(msRuntime, mjEnergy);
+  return getPerfEnergyWithComponents(msRuntime, mjEnergy, msRead, msWrite, mjRead, mjWrite);
 }
 
 //! @brief  Perf energy model of Fulcrum for func2
@@ -84,6 +99,10 @@ pimPerfEnergyFulcrum::getPerfEnergyForFunc2(PimCmdEnum cmdType, const pimObjInfo
   unsigned numPass = obj.getMaxNumRegionsPerCore();
   unsigned bitsPerElement = obj.getBitsPerElement();
   unsigned numCoresUsed = obj.getNumCoresUsed();
+  double msRead = 0.0;
+  double msWrite = 0.0;
+  double mjRead = 0.0;
+  double mjWrite = 0.0;
 
   unsigned maxElementsPerRegion = obj.getMaxElementsPerRegion();
   double numberOfALUOperationPerElement = ((double)bitsPerElement / m_flucrumAluBitWidth);
@@ -98,6 +117,10 @@ pimPerfEnergyFulcrum::getPerfEnergyForFunc2(PimCmdEnum cmdType, const pimObjInfo
       msRuntime *= numPass;
       mjEnergy = numCoresUsed * numPass * ((m_eAP * 3) + ((maxElementsPerRegion - 1) * 3 *  m_fulcrumShiftEnergy) + ((maxElementsPerRegion) * m_fulcrumALUArithmeticEnergy * numberOfALUOperationPerElement));
       mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      msRead = 2 * m_tR * numPass;
+      msWrite = m_tW * numPass;
+      mjRead = m_eAP * 2 * numCoresUsed * numPass;
+      mjWrite = m_eAP * numCoresUsed * numPass;
       break;
     }
     case PimCmdEnum::SCALED_ADD:
@@ -120,6 +143,10 @@ pimPerfEnergyFulcrum::getPerfEnergyForFunc2(PimCmdEnum cmdType, const pimObjInfo
       msRuntime = m_tR + m_tW + (maxElementsPerRegion * numberOfALUOperationPerElement * m_fulcrumAluLatency * 2) * numPass;
       mjEnergy = numCoresUsed * numPass * ((m_eAP * 3) + ((maxElementsPerRegion - 1) * 3 *  m_fulcrumShiftEnergy) + ((maxElementsPerRegion) * m_fulcrumALUArithmeticEnergy * numberOfALUOperationPerElement));
       mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      msRead = m_tR;
+      msWrite = m_tW;
+      mjRead = m_eAP * 2 * numCoresUsed * numPass;
+      mjWrite = m_eAP * numCoresUsed * numPass;
       break;
     }
     case PimCmdEnum::AND:
@@ -137,6 +164,10 @@ pimPerfEnergyFulcrum::getPerfEnergyForFunc2(PimCmdEnum cmdType, const pimObjInfo
       mjEnergy = numCoresUsed * numPass * (((maxElementsPerRegion - 1) * 3 *  m_fulcrumShiftEnergy) + ((maxElementsPerRegion) * m_fulcrumALULogicalEnergy * numberOfALUOperationPerElement));
       mjEnergy += m_eAP * 3 * m_numChipsPerRank * m_numRanks;
       mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      msRead = 2 * m_tR * numPass;
+      msWrite = m_tW * numPass;
+      mjRead = m_eAP * 2 * m_numChipsPerRank * m_numRanks;
+      mjWrite = m_eAP * m_numChipsPerRank * m_numRanks;
       break;
     }
     default:
@@ -144,7 +175,7 @@ pimPerfEnergyFulcrum::getPerfEnergyForFunc2(PimCmdEnum cmdType, const pimObjInfo
       break;
   }
 
-  return pimeval::perfEnergy(msRuntime, mjEnergy);
+  return getPerfEnergyWithComponents(msRuntime, mjEnergy, msRead, msWrite, mjRead, mjWrite);
 }
 
 //! @brief  Perf energy model of Fulcrum for reduction sum
@@ -6,13 +6,18 @@
 
 #include "pimPerfEnergyTables.h"
 #include "pimCmd.h"
+#include "pimUtils.h"
 #include <unordered_map>
 #include <tuple>
+#include <string>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
 
 
 //! @brief  BitSIMD performance table (Tuple: #R, #W, #L)
-const std::unordered_map<PimDeviceEnum, std::unordered_map<PimDataType,
-    std::unordered_map<PimCmdEnum, std::tuple<unsigned, unsigned, unsigned>>>>
+const pimPerfEnergyTables::bitsimdPerfTableType
 pimPerfEnergyTables::bitsimdPerfTable = {
   { PIM_DEVICE_BITSIMD_V, {
     { PIM_INT8, {
@@ -528,6 +533,1227 @@ pimPerfEnergyTables::bitsimdPerfTable = {
       { PimCmdEnum::MUL_SCALAR,   { 2222, 1200, 3664 } },
     }}
   }},
+  { PIM_DEVICE_BITSIMD_V_NAND, {
+    { PIM_INT8, {
+      { PimCmdEnum::ABS,          {    9,    8,   90 } },
+      //{ PimCmdEnum::POPCOUNT,     {    0,    0,    0 } },
+      { PimCmdEnum::ADD,          {   16,    8,   97 } },
+      { PimCmdEnum::SUB,          {   16,    8,   97 } },
+      { PimCmdEnum::MUL,          {   72,   36,  496 } },
+      { PimCmdEnum::DIV,          {  196,  137, 1032 } },
+      { PimCmdEnum::AND,          {   16,    8,   24 } },
+      { PimCmdEnum::OR,           {   16,    8,   32 } },
+      { PimCmdEnum::XOR,          {   16,    8,   40 } },
+      { PimCmdEnum::XNOR,         {   16,    8,   48 } },
+      { PimCmdEnum::GT,           {   16,    8,   74 } },
+      { PimCmdEnum::LT,           {   16,    8,   74 } },
+      { PimCmdEnum::EQ,           {   16,    8,   67 } },
+      { PimCmdEnum::MIN,          {   32,    8,  113 } },
+      { PimCmdEnum::MAX,          {   32,    8,  113 } },
+      { PimCmdEnum::ADD_SCALAR,   {    8,    8,  105 } },
+      { PimCmdEnum::SUB_SCALAR,   {    8,    8,  105 } },
+      { PimCmdEnum::MUL_SCALAR,   {   36,   36,  532 } },
+      { PimCmdEnum::DIV_SCALAR,   {  146,  145, 1090 } },
+      { PimCmdEnum::AND_SCALAR,   {    8,    8,   32 } },
+      { PimCmdEnum::OR_SCALAR,    {    8,    8,   40 } },
+      { PimCmdEnum::XOR_SCALAR,   {    8,    8,   48 } },
+      { PimCmdEnum::XNOR_SCALAR,  {    8,    8,   56 } },
+      { PimCmdEnum::GT_SCALAR,    {    8,    8,   82 } },
+      { PimCmdEnum::LT_SCALAR,    {    8,    8,   82 } },
+      { PimCmdEnum::EQ_SCALAR,    {    8,    8,   75 } },
+      { PimCmdEnum::MIN_SCALAR,   {   16,    8,  129 } },
+      { PimCmdEnum::MAX_SCALAR,   {   16,    8,  129 } },
+      { PimCmdEnum::SCALED_ADD,   {   52,   44,  629 } }, // Derived from adding ADD + MUL_SCALAR
+    }},
+    { PIM_INT16, {
+      { PimCmdEnum::ABS,          {   17,   16,  178 } },
+      //{ PimCmdEnum::POPCOUNT,     {    0,    0,    0 } },
+      { PimCmdEnum::ADD,          {   32,   16,  193 } },
+      { PimCmdEnum::SUB,          {   32,   16,  193 } },
+      { PimCmdEnum::MUL,          {  272,  136, 2016 } },
+      { PimCmdEnum::DIV,          {  772,  469, 3900 } },
+      { PimCmdEnum::AND,          {   32,   16,   48 } },
+      { PimCmdEnum::OR,           {   32,   16,   64 } },
+      { PimCmdEnum::XOR,          {   32,   16,   80 } },
+      { PimCmdEnum::XNOR,         {   32,   16,   96 } },
+      { PimCmdEnum::GT,           {   32,   16,  146 } },
+      { PimCmdEnum::LT,           {   32,   16,  146 } },
+      { PimCmdEnum::EQ,           {   32,   16,  131 } },
+      { PimCmdEnum::MIN,          {   64,   16,  225 } },
+      { PimCmdEnum::MAX,          {   64,   16,  225 } },
+      { PimCmdEnum::ADD_SCALAR,   {   16,   16,  209 } },
+      { PimCmdEnum::SUB_SCALAR,   {   16,   16,  209 } },
+      { PimCmdEnum::MUL_SCALAR,   {  136,  136, 2152 } },
+      { PimCmdEnum::DIV_SCALAR,   {  546,  485, 4142 } },
+      { PimCmdEnum::AND_SCALAR,   {   16,   16,   64 } },
+      { PimCmdEnum::OR_SCALAR,    {   16,   16,   80 } },
+      { PimCmdEnum::XOR_SCALAR,   {   16,   16,   96 } },
+      { PimCmdEnum::XNOR_SCALAR,  {   16,   16,  112 } },
+      { PimCmdEnum::GT_SCALAR,    {   16,   16,  162 } },
+      { PimCmdEnum::LT_SCALAR,    {   16,   16,  162 } },
+      { PimCmdEnum::EQ_SCALAR,    {   16,   16,  147 } },
+      { PimCmdEnum::MIN_SCALAR,   {   32,   16,  257 } },
+      { PimCmdEnum::MAX_SCALAR,   {   32,   16,  257 } },
+      { PimCmdEnum::SCALED_ADD,   {  168,  152, 2345 } }, // Derived from adding ADD + MUL_SCALAR
+    }},
+    { PIM_INT32, {
+      { PimCmdEnum::ABS,          {   33,   32,  354 } },
+      { PimCmdEnum::POPCOUNT,     {  114,  114,  651 } },
+      { PimCmdEnum::ADD,          {   64,   32,  385 } },
+      { PimCmdEnum::SUB,          {   64,   32,  385 } },
+      { PimCmdEnum::MUL,          { 1056,  528, 8128 } },
+      { PimCmdEnum::DIV,          { 3076, 1709, 15204 } },
+      { PimCmdEnum::AND,          {   64,   32,   96 } },
+      { PimCmdEnum::OR,           {   64,   32,  128 } },
+      { PimCmdEnum::XOR,          {   64,   32,  160 } },
+      { PimCmdEnum::XNOR,         {   64,   32,  192 } },
+      { PimCmdEnum::GT,           {   64,   32,  290 } },
+      { PimCmdEnum::LT,           {   64,   32,  290 } },
+      { PimCmdEnum::EQ,           {   64,   32,  259 } },
+      { PimCmdEnum::MIN,          {  128,   32,  449 } },
+      { PimCmdEnum::MAX,          {  128,   32,  449 } },
+      { PimCmdEnum::ADD_SCALAR,   {   32,   32,  417 } },
+      { PimCmdEnum::SUB_SCALAR,   {   32,   32,  417 } },
+      { PimCmdEnum::MUL_SCALAR,   {  528,  528, 8656 } },
+      { PimCmdEnum::DIV_SCALAR,   { 2114, 1741, 16198 } },
+      { PimCmdEnum::AND_SCALAR,   {   32,   32,  128 } },
+      { PimCmdEnum::OR_SCALAR,    {   32,   32,  160 } },
+      { PimCmdEnum::XOR_SCALAR,   {   32,   32,  192 } },
+      { PimCmdEnum::XNOR_SCALAR,  {   32,   32,  224 } },
+      { PimCmdEnum::GT_SCALAR,    {   32,   32,  322 } },
+      { PimCmdEnum::LT_SCALAR,    {   32,   32,  322 } },
+      { PimCmdEnum::EQ_SCALAR,    {   32,   32,  291 } },
+      { PimCmdEnum::MIN_SCALAR,   {   64,   32,  513 } },
+      { PimCmdEnum::MAX_SCALAR,   {   64,   32,  513 } },
+      { PimCmdEnum::SCALED_ADD,   {  592,  560, 9041 } }, // Derived from adding ADD + MUL_SCALAR
+    }},
+    { PIM_INT64, {
+      { PimCmdEnum::ABS,          {   65,   64,  706 } },
+      //{ PimCmdEnum::POPCOUNT,     {    0,    0,    0 } },
+      { PimCmdEnum::ADD,          {  128,   64,  769 } },
+      { PimCmdEnum::SUB,          {  128,   64,  769 } },
+      //{ PimCmdEnum::MUL,          {    0,    0,    0 } },
+      //{ PimCmdEnum::DIV,          {    0,    0,    0 } },
+      { PimCmdEnum::AND,          {  128,   64,  192 } },
+      { PimCmdEnum::OR,           {  128,   64,  256 } },
+      { PimCmdEnum::XOR,          {  128,   64,  320 } },
+      { PimCmdEnum::XNOR,         {  128,   64,  384 } },
+      { PimCmdEnum::GT,           {  128,   64,  578 } },
+      { PimCmdEnum::LT,           {  128,   64,  578 } },
+      { PimCmdEnum::EQ,           {  128,   64,  515 } },
+      { PimCmdEnum::MIN,          {  256,   64,  897 } },
+      { PimCmdEnum::MAX,          {  256,   64,  897 } },
+      { PimCmdEnum::ADD_SCALAR,   {   64,   64,  833 } },
+      { PimCmdEnum::SUB_SCALAR,   {   64,   64,  833 } },
+      //{ PimCmdEnum::MUL_SCALAR,   {    0,    0,    0 } },
+      //{ PimCmdEnum::DIV_SCALAR,   {    0,    0,    0 } },
+      { PimCmdEnum::AND_SCALAR,   {   64,   64,  256 } },
+      { PimCmdEnum::OR_SCALAR,    {   64,   64,  320 } },
+      { PimCmdEnum::XOR_SCALAR,   {   64,   64,  384 } },
+      { PimCmdEnum::XNOR_SCALAR,  {   64,   64,  448 } },
+      { PimCmdEnum::GT_SCALAR,    {   64,   64,  642 } },
+      { PimCmdEnum::LT_SCALAR,    {   64,   64,  642 } },
+      { PimCmdEnum::EQ_SCALAR,    {   64,   64,  579 } },
+      { PimCmdEnum::MIN_SCALAR,   {  128,   64, 1025 } },
+      { PimCmdEnum::MAX_SCALAR,   {  128,   64, 1025 } },
+      //{ PimCmdEnum::SCALED_ADD,   {    0,    0,    0 } }, // Derived from adding ADD + MUL_SCALAR
+    }},
+    { PIM_UINT8, {
+      { PimCmdEnum::ABS,          {    8,    8,    0 } },
+      //{ PimCmdEnum::POPCOUNT,     {    0,    0,    0 } },
+      { PimCmdEnum::ADD,          {   16,    8,   97 } },
+      { PimCmdEnum::SUB,          {   16,    8,   97 } },
+      { PimCmdEnum::MUL,          {   72,   36,  496 } },
+      { PimCmdEnum::DIV,          {  216,  140,  981 } },
+      { PimCmdEnum::AND,          {   16,    8,   24 } },
+      { PimCmdEnum::OR,           {   16,    8,   32 } },
+      { PimCmdEnum::XOR,          {   16,    8,   40 } },
+      { PimCmdEnum::XNOR,         {   16,    8,   48 } },
+      { PimCmdEnum::GT,           {   16,    8,   75 } },
+      { PimCmdEnum::LT,           {   16,    8,   75 } },
+      { PimCmdEnum::EQ,           {   16,    8,   67 } },
+      { PimCmdEnum::MIN,          {   32,    8,  114 } },
+      { PimCmdEnum::MAX,          {   32,    8,  114 } },
+      { PimCmdEnum::ADD_SCALAR,   {    8,    8,  105 } },
+      { PimCmdEnum::SUB_SCALAR,   {    8,    8,  105 } },
+      { PimCmdEnum::MUL_SCALAR,   {   36,   36,  532 } },
+      { PimCmdEnum::DIV_SCALAR,   {  152,  140, 1045 } },
+      { PimCmdEnum::AND_SCALAR,   {    8,    8,   32 } },
+      { PimCmdEnum::OR_SCALAR,    {    8,    8,   40 } },
+      { PimCmdEnum::XOR_SCALAR,   {    8,    8,   48 } },
+      { PimCmdEnum::XNOR_SCALAR,  {    8,    8,   56 } },
+      { PimCmdEnum::GT_SCALAR,    {    8,    8,   83 } },
+      { PimCmdEnum::LT_SCALAR,    {    8,    8,   83 } },
+      { PimCmdEnum::EQ_SCALAR,    {    8,    8,   75 } },
+      { PimCmdEnum::MIN_SCALAR,   {   16,    8,  130 } },
+      { PimCmdEnum::MAX_SCALAR,   {   16,    8,  130 } },
+      { PimCmdEnum::SCALED_ADD,   {   52,   44,  629 } }, // Derived from adding ADD + MUL_SCALAR
+    }},
+    { PIM_UINT16, {
+      { PimCmdEnum::ABS,          {   16,   16,    0 } },
+      //{ PimCmdEnum::POPCOUNT,     {    0,    0,    0 } },
+      { PimCmdEnum::ADD,          {   32,   16,  193 } },
+      { PimCmdEnum::SUB,          {   32,   16,  193 } },
+      { PimCmdEnum::MUL,          {  272,  136, 2016 } },
+      { PimCmdEnum::DIV,          {  816,  472, 3817 } },
+      { PimCmdEnum::AND,          {   32,   16,   48 } },
+      { PimCmdEnum::OR,           {   32,   16,   64 } },
+      { PimCmdEnum::XOR,          {   32,   16,   80 } },
+      { PimCmdEnum::XNOR,         {   32,   16,   96 } },
+      { PimCmdEnum::GT,           {   32,   16,  147 } },
+      { PimCmdEnum::LT,           {   32,   16,  147 } },
+      { PimCmdEnum::EQ,           {   32,   16,  131 } },
+      { PimCmdEnum::MIN,          {   64,   16,  226 } },
+      { PimCmdEnum::MAX,          {   64,   16,  226 } },
+      { PimCmdEnum::ADD_SCALAR,   {   16,   16,  209 } },
+      { PimCmdEnum::SUB_SCALAR,   {   16,   16,  209 } },
+      { PimCmdEnum::MUL_SCALAR,   {  136,  136, 2152 } },
+      { PimCmdEnum::DIV_SCALAR,   {  560,  472, 4073 } },
+      { PimCmdEnum::AND_SCALAR,   {   16,   16,   64 } },
+      { PimCmdEnum::OR_SCALAR,    {   16,   16,   80 } },
+      { PimCmdEnum::XOR_SCALAR,   {   16,   16,   96 } },
+      { PimCmdEnum::XNOR_SCALAR,  {   16,   16,  112 } },
+      { PimCmdEnum::GT_SCALAR,    {   16,   16,  163 } },
+      { PimCmdEnum::LT_SCALAR,    {   16,   16,  163 } },
+      { PimCmdEnum::EQ_SCALAR,    {   16,   16,  147 } },
+      { PimCmdEnum::MIN_SCALAR,   {   32,   16,  258 } },
+      { PimCmdEnum::MAX_SCALAR,   {   32,   16,  258 } },
+      { PimCmdEnum::SCALED_ADD,   {  168,  152, 2345 } }, // Derived from adding ADD + MUL_SCALAR
+    }},
+    { PIM_UINT32, {
+      { PimCmdEnum::ABS,          {   32,   32,    0 } },
+      { PimCmdEnum::POPCOUNT,     {  114,  114,  651 } },
+      { PimCmdEnum::ADD,          {   64,   32,  385 } },
+      { PimCmdEnum::SUB,          {   64,   32,  385 } },
+      { PimCmdEnum::MUL,          { 1056,  528, 8128 } },
+      { PimCmdEnum::DIV,          { 3168, 1712, 15057 } },
+      { PimCmdEnum::AND,          {   64,   32,   96 } },
+      { PimCmdEnum::OR,           {   64,   32,  128 } },
+      { PimCmdEnum::XOR,          {   64,   32,  160 } },
+      { PimCmdEnum::XNOR,         {   64,   32,  192 } },
+      { PimCmdEnum::GT,           {   64,   32,  291 } },
+      { PimCmdEnum::LT,           {   64,   32,  291 } },
+      { PimCmdEnum::EQ,           {   64,   32,  259 } },
+      { PimCmdEnum::MIN,          {  128,   32,  450 } },
+      { PimCmdEnum::MAX,          {  128,   32,  450 } },
+      { PimCmdEnum::ADD_SCALAR,   {   32,   32,  417 } },
+      { PimCmdEnum::SUB_SCALAR,   {   32,   32,  417 } },
+      { PimCmdEnum::MUL_SCALAR,   {  528,  528, 8656 } },
+      { PimCmdEnum::DIV_SCALAR,   { 2144, 1712, 16081 } },
+      { PimCmdEnum::AND_SCALAR,   {   32,   32,  128 } },
+      { PimCmdEnum::OR_SCALAR,    {   32,   32,  160 } },
+      { PimCmdEnum::XOR_SCALAR,   {   32,   32,  192 } },
+      { PimCmdEnum::XNOR_SCALAR,  {   32,   32,  224 } },
+      { PimCmdEnum::GT_SCALAR,    {   32,   32,  323 } },
+      { PimCmdEnum::LT_SCALAR,    {   32,   32,  323 } },
+      { PimCmdEnum::EQ_SCALAR,    {   32,   32,  291 } },
+      { PimCmdEnum::MIN_SCALAR,   {   64,   32,  514 } },
+      { PimCmdEnum::MAX_SCALAR,   {   64,   32,  514 } },
+      { PimCmdEnum::SCALED_ADD,   {  592,  560, 9041 } }, // Derived from adding ADD + MUL_SCALAR
+    }},
+    { PIM_UINT64, {
+      { PimCmdEnum::ABS,          {   64,   64,    0 } },
+      //{ PimCmdEnum::POPCOUNT,     {    0,    0,    0 } },
+      { PimCmdEnum::ADD,          {  128,   64,  769 } },
+      { PimCmdEnum::SUB,          {  128,   64,  769 } },
+      //{ PimCmdEnum::MUL,          {    0,    0,    0 } },
+      //{ PimCmdEnum::DIV,          {    0,    0,    0 } },
+      { PimCmdEnum::AND,          {  128,   64,  192 } },
+      { PimCmdEnum::OR,           {  128,   64,  256 } },
+      { PimCmdEnum::XOR,          {  128,   64,  320 } },
+      { PimCmdEnum::XNOR,         {  128,   64,  384 } },
+      { PimCmdEnum::GT,           {  128,   64,  579 } },
+      { PimCmdEnum::LT,           {  128,   64,  579 } },
+      { PimCmdEnum::EQ,           {  128,   64,  515 } },
+      { PimCmdEnum::MIN,          {  256,   64,  898 } },
+      { PimCmdEnum::MAX,          {  256,   64,  898 } },
+      { PimCmdEnum::ADD_SCALAR,   {   64,   64,  833 } },
+      { PimCmdEnum::SUB_SCALAR,   {   64,   64,  833 } },
+      //{ PimCmdEnum::MUL_SCALAR,   {    0,    0,    0 } },
+      //{ PimCmdEnum::DIV_SCALAR,   {    0,    0,    0 } },
+      { PimCmdEnum::AND_SCALAR,   {   64,   64,  256 } },
+      { PimCmdEnum::OR_SCALAR,    {   64,   64,  320 } },
+      { PimCmdEnum::XOR_SCALAR,   {   64,   64,  384 } },
+      { PimCmdEnum::XNOR_SCALAR,  {   64,   64,  448 } },
+      { PimCmdEnum::GT_SCALAR,    {   64,   64,  643 } },
+      { PimCmdEnum::LT_SCALAR,    {   64,   64,  643 } },
+      { PimCmdEnum::EQ_SCALAR,    {   64,   64,  579 } },
+      { PimCmdEnum::MIN_SCALAR,   {  128,   64, 1026 } },
+      { PimCmdEnum::MAX_SCALAR,   {  128,   64, 1026 } },
+      //{ PimCmdEnum::SCALED_ADD,   {    0,    0,    0 } }, // Derived from adding ADD + MUL_SCALAR
+    }},
+    { PIM_FP32, { // Scaled from BitSIMD-V by #L ratio of the INT32 op
+      { PimCmdEnum::ADD,          { 1331,  685, 6696 } },
+      { PimCmdEnum::SUB,          { 1331,  685, 6696 } },
+      { PimCmdEnum::MUL,          { 1852, 1000, 11934 } },
+      { PimCmdEnum::DIV,          { 2744, 1458, 14494 } },
+      { PimCmdEnum::MUL_SCALAR,   { 1852, 1000, 10136 } },
+    }}
+  }},
+  { PIM_DEVICE_BITSIMD_V_MAJ, {
+    { PIM_INT8, {
+      { PimCmdEnum::ABS,          {    9,    8,  138 } },
+      //{ PimCmdEnum::POPCOUNT,     {    0,    0,    0 } },
+      { PimCmdEnum::ADD,          {   16,    8,  161 } },
+      { PimCmdEnum::SUB,          {   16,    8,  161 } },
+      { PimCmdEnum::MUL,          {   72,   36,  792 } },
+      { PimCmdEnum::DIV,          {  196,  137, 1627 } },
+      { PimCmdEnum::AND,          {   16,    8,   24 } },
+      { PimCmdEnum::OR,           {   16,    8,   24 } },
+      { PimCmdEnum::XOR,          {   16,    8,   64 } },
+      { PimCmdEnum::XNOR,         {   16,    8,   72 } },
+      { PimCmdEnum::GT,           {   16,    8,  114 } },
+      { PimCmdEnum::LT,           {   16,    8,  114 } },
+      { PimCmdEnum::EQ,           {   16,    8,   83 } },
+      { PimCmdEnum::MIN,          {   32,    8,  169 } },
+      { PimCmdEnum::MAX,          {   32,    8,  169 } },
+      { PimCmdEnum::ADD_SCALAR,   {    8,    8,  169 } },
+      { PimCmdEnum::SUB_SCALAR,   {    8,    8,  169 } },
+      { PimCmdEnum::MUL_SCALAR,   {   36,   36,  828 } },
+      { PimCmdEnum::DIV_SCALAR,   {  146,  145, 1685 } },
+      { PimCmdEnum::AND_SCALAR,   {    8,    8,   32 } },
+      { PimCmdEnum::OR_SCALAR,    {    8,    8,   32 } },
+      { PimCmdEnum::XOR_SCALAR,   {    8,    8,   72 } },
+      { PimCmdEnum::XNOR_SCALAR,  {    8,    8,   80 } },
+      { PimCmdEnum::GT_SCALAR,    {    8,    8,  122 } },
+      { PimCmdEnum::LT_SCALAR,    {    8,    8,  122 } },
+      { PimCmdEnum::EQ_SCALAR,    {    8,    8,   91 } },
+      { PimCmdEnum::MIN_SCALAR,   {   16,    8,  185 } },
+      { PimCmdEnum::MAX_SCALAR,   {   16,    8,  185 } },
+      { PimCmdEnum::SCALED_ADD,   {   52,   44,  989 } }, // Derived from adding ADD + MUL_SCALAR
+    }},
+    { PIM_INT16, {
+      { PimCmdEnum::ABS,          {   17,   16,  274 } },
+      //{ PimCmdEnum::POPCOUNT,     {    0,    0,    0 } },
+      { PimCmdEnum::ADD,          {   32,   16,  321 } },
+      { PimCmdEnum::SUB,          {   32,   16,  321 } },
+      { PimCmdEnum::MUL,          {  272,  136, 3248 } },
+      { PimCmdEnum::DIV,          {  772,  469, 6231 } },
+      { PimCmdEnum::AND,          {   32,   16,   48 } },
+      { PimCmdEnum::OR,           {   32,   16,   48 } },
+      { PimCmdEnum::XOR,          {   32,   16,  128 } },
+      { PimCmdEnum::XNOR,         {   32,   16,  144 } },
+      { PimCmdEnum::GT,           {   32,   16,  226 } },
+      { PimCmdEnum::LT,           {   32,   16,  226 } },
+      { PimCmdEnum::EQ,           {   32,   16,  163 } },
+      { PimCmdEnum::MIN,          {   64,   16,  337 } },
+      { PimCmdEnum::MAX,          {   64,   16,  337 } },
+      { PimCmdEnum::ADD_SCALAR,   {   16,   16,  337 } },
+      { PimCmdEnum::SUB_SCALAR,   {   16,   16,  337 } },
+      { PimCmdEnum::MUL_SCALAR,   {  136,  136, 3384 } },
+      { PimCmdEnum::DIV_SCALAR,   {  546,  485, 6473 } },
+      { PimCmdEnum::AND_SCALAR,   {   16,   16,   64 } },
+      { PimCmdEnum::OR_SCALAR,    {   16,   16,   64 } },
+      { PimCmdEnum::XOR_SCALAR,   {   16,   16,  144 } },
+      { PimCmdEnum::XNOR_SCALAR,  {   16,   16,  160 } },
+      { PimCmdEnum::GT_SCALAR,    {   16,   16,  242 } },
+      { PimCmdEnum::LT_SCALAR,    {   16,   16,  242 } },
+      { PimCmdEnum::EQ_SCALAR,    {   16,   16,  179 } },
+      { PimCmdEnum::MIN_SCALAR,   {   32,   16,  369 } },
+      { PimCmdEnum::MAX_SCALAR,   {   32,   16,  369 } },
+      { PimCmdEnum::SCALED_ADD,   {  168,  152, 3705 } }, // Derived from adding ADD + MUL_SCALAR
+    }},
+    { PIM_INT32, {
+      { PimCmdEnum::ABS,          {   33,   32,  546 } },
+      { PimCmdEnum::POPCOUNT,     {  114,  114, 1027 } },
+      { PimCmdEnum::ADD,          {   64,   32,  641 } },
+      { PimCmdEnum::SUB,          {   64,   32,  641 } },
+      { PimCmdEnum::MUL,          { 1056,  528, 13152 } },
+      { PimCmdEnum::DIV,          { 3076, 1709, 24463 } },
+      { PimCmdEnum::AND,          {   64,   32,   96 } },
+      { PimCmdEnum::OR,           {   64,   32,   96 } },
+      { PimCmdEnum::XOR,          {   64,   32,  256 } },
+      { PimCmdEnum::XNOR,         {   64,   32,  288 } },
+      { PimCmdEnum::GT,           {   64,   32,  450 } },
+      { PimCmdEnum::LT,           {   64,   32,  450 } },
+      { PimCmdEnum::EQ,           {   64,   32,  323 } },
+      { PimCmdEnum::MIN,          {  128,   32,  673 } },
+      { PimCmdEnum::MAX,          {  128,   32,  673 } },
+      { PimCmdEnum::ADD_SCALAR,   {   32,   32,  673 } },
+      { PimCmdEnum::SUB_SCALAR,   {   32,   32,  673 } },
+      { PimCmdEnum::MUL_SCALAR,   {  528,  528, 13680 } },
+      { PimCmdEnum::DIV_SCALAR,   { 2114, 1741, 25457 } },
+      { PimCmdEnum::AND_SCALAR,   {   32,   32,  128 } },
+      { PimCmdEnum::OR_SCALAR,    {   32,   32,  128 } },
+      { PimCmdEnum::XOR_SCALAR,   {   32,   32,  288 } },
+      { PimCmdEnum::XNOR_SCALAR,  {   32,   32,  320 } },
+      { PimCmdEnum::GT_SCALAR,    {   32,   32,  482 } },
+      { PimCmdEnum::LT_SCALAR,    {   32,   32,  482 } },
+      { PimCmdEnum::EQ_SCALAR,    {   32,   32,  355 } },
+      { PimCmdEnum::MIN_SCALAR,   {   64,   32,  737 } },
+      { PimCmdEnum::MAX_SCALAR,   {   64,   32,  737 } },
+      { PimCmdEnum::SCALED_ADD,   {  592,  560, 14321 } }, // Derived from adding ADD + MUL_SCALAR
+    }},
+    { PIM_INT64, {
+      { PimCmdEnum::ABS,          {   65,   64, 1090 } },
+      //{ PimCmdEnum::POPCOUNT,     {    0,    0,    0 } },
+      { PimCmdEnum::ADD,          {  128,   64, 1281 } },
+      { PimCmdEnum::SUB,          {  128,   64, 1281 } },
+      //{ PimCmdEnum::MUL,          {    0,    0,    0 } },
+      //{ PimCmdEnum::DIV,          {    0,    0,    0 } },
+      { PimCmdEnum::AND,          {  128,   64,  192 } },
+      { PimCmdEnum::OR,           {  128,   64,  192 } },
+      { PimCmdEnum::XOR,          {  128,   64,  512 } },
+      { PimCmdEnum::XNOR,         {  128,   64,  576 } },
+      { PimCmdEnum::GT,           {  128,   64,  898 } },
+      { PimCmdEnum::LT,           {  128,   64,  898 } },
+      { PimCmdEnum::EQ,           {  128,   64,  643 } },
+      { PimCmdEnum::MIN,          {  256,   64, 1345 } },
+      { PimCmdEnum::MAX,          {  256,   64, 1345 } },
+      { PimCmdEnum::ADD_SCALAR,   {   64,   64, 1345 } },
+      { PimCmdEnum::SUB_SCALAR,   {   64,   64, 1345 } },
+      //{ PimCmdEnum::MUL_SCALAR,   {    0,    0,    0 } },
+      //{ PimCmdEnum::DIV_SCALAR,   {    0,    0,    0 } },
+      { PimCmdEnum::AND_SCALAR,   {   64,   64,  256 } },
+      { PimCmdEnum::OR_SCALAR,    {   64,   64,  256 } },
+      { PimCmdEnum::XOR_SCALAR,   {   64,   64,  576 } },
+      { PimCmdEnum::XNOR_SCALAR,  {   64,   64,  640 } },
+      { PimCmdEnum::GT_SCALAR,    {   64,   64,  962 } },
+      { PimCmdEnum::LT_SCALAR,    {   64,   64,  962 } },
+      { PimCmdEnum::EQ_SCALAR,    {   64,   64,  707 } },
+      { PimCmdEnum::MIN_SCALAR,   {  128,   64, 1473 } },
+      { PimCmdEnum::MAX_SCALAR,   {  128,   64, 1473 } },
+      //{ PimCmdEnum::SCALED_ADD,   {    0,    0,    0 } }, // Derived from adding ADD + MUL_SCALAR
+    }},
+    { PIM_UINT8, {
+      { PimCmdEnum::ABS,          {    8,    8,    0 } },
+      //{ PimCmdEnum::POPCOUNT,     {    0,    0,    0 } },
+      { PimCmdEnum::ADD,          {   16,    8,  161 } },
+      { PimCmdEnum::SUB,          {   16,    8,  161 } },
+      { PimCmdEnum::MUL,          {   72,   36,  792 } },
+      { PimCmdEnum::DIV,          {  216,  140, 1565 } },
+      { PimCmdEnum::AND,          {   16,    8,   24 } },
+      { PimCmdEnum::OR,           {   16,    8,   24 } },
+      { PimCmdEnum::XOR,          {   16,    8,   64 } },
+      { PimCmdEnum::XNOR,         {   16,    8,   72 } },
+      { PimCmdEnum::GT,           {   16,    8,  115 } },
+      { PimCmdEnum::LT,           {   16,    8,  115 } },
+      { PimCmdEnum::EQ,           {   16,    8,   83 } },
+      { PimCmdEnum::MIN,          {   32,    8,  170 } },
+      { PimCmdEnum::MAX,          {   32,    8,  170 } },
+      { PimCmdEnum::ADD_SCALAR,   {    8,    8,  169 } },
+      { PimCmdEnum::SUB_SCALAR,   {    8,    8,  169 } },
+      { PimCmdEnum::MUL_SCALAR,   {   36,   36,  828 } },
+      { PimCmdEnum::DIV_SCALAR,   {  152,  140, 1629 } },
+      { PimCmdEnum::AND_SCALAR,   {    8,    8,   32 } },
+      { PimCmdEnum::OR_SCALAR,    {    8,    8,   32 } },
+      { PimCmdEnum::XOR_SCALAR,   {    8,    8,   72 } },
+      { PimCmdEnum::XNOR_SCALAR,  {    8,    8,   80 } },
+      { PimCmdEnum::GT_SCALAR,    {    8,    8,  123 } },
+      { PimCmdEnum::LT_SCALAR,    {    8,    8,  123 } },
+      { PimCmdEnum::EQ_SCALAR,    {    8,    8,   91 } },
+      { PimCmdEnum::MIN_SCALAR,   {   16,    8,  186 } },
+      { PimCmdEnum::MAX_SCALAR,   {   16,    8,  186 } },
+      { PimCmdEnum::SCALED_ADD,   {   52,   44,  989 } }, // Derived from adding ADD + MUL_SCALAR
+    }},
+    { PIM_UINT16, {
+      { PimCmdEnum::ABS,          {   16,   16,    0 } },
+      //{ PimCmdEnum::POPCOUNT,     {    0,    0,    0 } },
+      { PimCmdEnum::ADD,          {   32,   16,  321 } },
+      { PimCmdEnum::SUB,          {   32,   16,  321 } },
+      { PimCmdEnum::MUL,          {  272,  136, 3248 } },
+      { PimCmdEnum::DIV,          {  816,  472, 6137 } },
+      { PimCmdEnum::AND,          {   32,   16,   48 } },
+      { PimCmdEnum::OR,           {   32,   16,   48 } },
+      { PimCmdEnum::XOR,          {   32,   16,  128 } },
+      { PimCmdEnum::XNOR,         {   32,   16,  144 } },
+      { PimCmdEnum::GT,           {   32,   16,  227 } },
+      { PimCmdEnum::LT,           {   32,   16,  227 } },
+      { PimCmdEnum::EQ,           {   32,   16,  163 } },
+      { PimCmdEnum::MIN,          {   64,   16,  338 } },
+      { PimCmdEnum::MAX,          {   64,   16,  338 } },
+      { PimCmdEnum::ADD_SCALAR,   {   16,   16,  337 } },
+      { PimCmdEnum::SUB_SCALAR,   {   16,   16,  337 } },
+      { PimCmdEnum::MUL_SCALAR,   {  136,  136, 3384 } },
+      { PimCmdEnum::DIV_SCALAR,   {  560,  472, 6393 } },
+      { PimCmdEnum::AND_SCALAR,   {   16,   16,   64 } },
+      { PimCmdEnum::OR_SCALAR,    {   16,   16,   64 } },
+      { PimCmdEnum::XOR_SCALAR,   {   16,   16,  144 } },
+      { PimCmdEnum::XNOR_SCALAR,  {   16,   16,  160 } },
+      { PimCmdEnum::GT_SCALAR,    {   16,   16,  243 } },
+      { PimCmdEnum::LT_SCALAR,    {   16,   16,  243 } },
+      { PimCmdEnum::EQ_SCALAR,    {   16,   16,  179 } },
+      { PimCmdEnum::MIN_SCALAR,   {   32,   16,  370 } },
+      { PimCmdEnum::MAX_SCALAR,   {   32,   16,  370 } },
+      { PimCmdEnum::SCALED_ADD,   {  168,  152, 3705 } }, // Derived from adding ADD + MUL_SCALAR
+    }},
+    { PIM_UINT32, {
+      { PimCmdEnum::ABS,          {   32,   32,    0 } },
+      { PimCmdEnum::POPCOUNT,     {  114,  114, 1027 } },
+      { PimCmdEnum::ADD,          {   64,   32,  641 } },
+      { PimCmdEnum::SUB,          {   64,   32,  641 } },
+      { PimCmdEnum::MUL,          { 1056,  528, 13152 } },
+      { PimCmdEnum::DIV,          { 3168, 1712, 24305 } },
+      { PimCmdEnum::AND,          {   64,   32,   96 } },
+      { PimCmdEnum::OR,           {   64,   32,   96 } },
+      { PimCmdEnum::XOR,          {   64,   32,  256 } },
+      { PimCmdEnum::XNOR,         {   64,   32,  288 } },
+      { PimCmdEnum::GT,           {   64,   32,  451 } },
+      { PimCmdEnum::LT,           {   64,   32,  451 } },
+      { PimCmdEnum::EQ,           {   64,   32,  323 } },
+      { PimCmdEnum::MIN,          {  128,   32,  674 } },
+      { PimCmdEnum::MAX,          {  128,   32,  674 } },
+      { PimCmdEnum::ADD_SCALAR,   {   32,   32,  673 } },
+      { PimCmdEnum::SUB_SCALAR,   {   32,   32,  673 } },
+      { PimCmdEnum::MUL_SCALAR,   {  528,  528, 13680 } },
+      { PimCmdEnum::DIV_SCALAR,   { 2144, 1712, 25329 } },
+      { PimCmdEnum::AND_SCALAR,   {   32,   32,  128 } },
+      { PimCmdEnum::OR_SCALAR,    {   32,   32,  128 } },
+      { PimCmdEnum::XOR_SCALAR,   {   32,   32,  288 } },
+      { PimCmdEnum::XNOR_SCALAR,  {   32,   32,  320 } },
+      { PimCmdEnum::GT_SCALAR,    {   32,   32,  483 } },
+      { PimCmdEnum::LT_SCALAR,    {   32,   32,  483 } },
+      { PimCmdEnum::EQ_SCALAR,    {   32,   32,  355 } },
+      { PimCmdEnum::MIN_SCALAR,   {   64,   32,  738 } },
+      { PimCmdEnum::MAX_SCALAR,   {   64,   32,  738 } },
+      { PimCmdEnum::SCALED_ADD,   {  592,  560, 14321 } }, // Derived from adding ADD + MUL_SCALAR
+    }},
+    { PIM_UINT64, {
+      { PimCmdEnum::ABS,          {   64,   64,    0 } },
+      //{ PimCmdEnum::POPCOUNT,     {    0,    0,    0 } },
+      { PimCmdEnum::ADD,          {  128,   64, 1281 } },
+      { PimCmdEnum::SUB,          {  128,   64, 1281 } },
+      //{ PimCmdEnum::MUL,          {    0,    0,    0 } },
+      //{ PimCmdEnum::DIV,          {    0,    0,    0 } },
+      { PimCmdEnum::AND,          {  128,   64,  192 } },
+      { PimCmdEnum::OR,           {  128,   64,  192 } },
+      { PimCmdEnum::XOR,          {  128,   64,  512 } },
+      { PimCmdEnum::XNOR,         {  128,   64,  576 } },
+      { PimCmdEnum::GT,           {  128,   64,  899 } },
+      { PimCmdEnum::LT,           {  128,   64,  899 } },
+      { PimCmdEnum::EQ,           {  128,   64,  643 } },
+      { PimCmdEnum::MIN,          {  256,   64, 1346 } },
+      { PimCmdEnum::MAX,          {  256,   64, 1346 } },
+      { PimCmdEnum::ADD_SCALAR,   {   64,   64, 1345 } },
+      { PimCmdEnum::SUB_SCALAR,   {   64,   64, 1345 } },
+      //{ PimCmdEnum::MUL_SCALAR,   {    0,    0,    0 } },
+      //{ PimCmdEnum::DIV_SCALAR,   {    0,    0,    0 } },
+      { PimCmdEnum::AND_SCALAR,   {   64,   64,  256 } },
+      { PimCmdEnum::OR_SCALAR,    {   64,   64,  256 } },
+      { PimCmdEnum::XOR_SCALAR,   {   64,   64,  576 } },
+      { PimCmdEnum::XNOR_SCALAR,  {   64,   64,  640 } },
+      { PimCmdEnum::GT_SCALAR,    {   64,   64,  963 } },
+      { PimCmdEnum::LT_SCALAR,    {   64,   64,  963 } },
+      { PimCmdEnum::EQ_SCALAR,    {   64,   64,  707 } },
+      { PimCmdEnum::MIN_SCALAR,   {  128,   64, 1474 } },
+      { PimCmdEnum::MAX_SCALAR,   {  128,   64, 1474 } },
+      //{ PimCmdEnum::SCALED_ADD,   {    0,    0,    0 } }, // Derived from adding ADD + MUL_SCALAR
+    }},
+    { PIM_FP32, { // Scaled from BitSIMD-V by #L ratio of the INT32 op
+      { PimCmdEnum::ADD,          { 1331,  685, 11148 } },
+      { PimCmdEnum::SUB,          { 1331,  685, 11148 } },
+      { PimCmdEnum::MUL,          { 1852, 1000, 19311 } },
+      { PimCmdEnum::DIV,          { 2744, 1458, 23321 } },
+      { PimCmdEnum::MUL_SCALAR,   { 1852, 1000, 16019 } },
+    }}
+  }},
+  { PIM_DEVICE_DRISA_NOR, {
+    { PIM_INT8, {
+      { PimCmdEnum::ABS,          {    9,    8,  114 } },
+      //{ PimCmdEnum::POPCOUNT,     {    0,    0,    0 } },
+      { PimCmdEnum::ADD,          {   16,    8,  113 } },
+      { PimCmdEnum::SUB,          {   16,    8,  113 } },
+      { PimCmdEnum::MUL,          {   72,   36,  552 } },
+      { PimCmdEnum::DIV,          {  196,  137, 1203 } },
+      { PimCmdEnum::AND,          {   16,    8,   32 } },
+      { PimCmdEnum::OR,           {   16,    8,   24 } },
+      { PimCmdEnum::XOR,          {   16,    8,   48 } },
+      { PimCmdEnum::XNOR,         {   16,    8,   56 } },
+      { PimCmdEnum::GT,           {   16,    8,   82 } },
+      { PimCmdEnum::LT,           {   16,    8,   82 } },
+      { PimCmdEnum::EQ,           {   16,    8,   67 } },
+      { PimCmdEnum::MIN,          {   32,    8,  121 } },
+      { PimCmdEnum::MAX,          {   32,    8,  121 } },
+      { PimCmdEnum::ADD_SCALAR,   {    8,    8,  121 } },
+      { PimCmdEnum::SUB_SCALAR,   {    8,    8,  121 } },
+      { PimCmdEnum::MUL_SCALAR,   {   36,   36,  588 } },
+      { PimCmdEnum::DIV_SCALAR,   {  146,  145, 1261 } },
+      { PimCmdEnum::AND_SCALAR,   {    8,    8,   40 } },
+      { PimCmdEnum::OR_SCALAR,    {    8,    8,   32 } },
+      { PimCmdEnum::XOR_SCALAR,   {    8,    8,   56 } },
+      { PimCmdEnum::XNOR_SCALAR,  {    8,    8,   64 } },
+      { PimCmdEnum::GT_SCALAR,    {    8,    8,   90 } },
+      { PimCmdEnum::LT_SCALAR,    {    8,    8,   90 } },
+      { PimCmdEnum::EQ_SCALAR,    {    8,    8,   75 } },
+      { PimCmdEnum::MIN_SCALAR,   {   16,    8,  137 } },
+      { PimCmdEnum::MAX_SCALAR,   {   16,    8,  137 } },
+      { PimCmdEnum::SCALED_ADD,   {   52,   44,  701 } }, // Derived from adding ADD + MUL_SCALAR
+    }},
+    { PIM_INT16, {
+      { PimCmdEnum::ABS,          {   17,   16,  226 } },
+      //{ PimCmdEnum::POPCOUNT,     {    0,    0,    0 } },
+      { PimCmdEnum::ADD,          {   32,   16,  225 } },
+      { PimCmdEnum::SUB,          {   32,   16,  225 } },
+      { PimCmdEnum::MUL,          {  272,  136, 2256 } },
+      { PimCmdEnum::DIV,          {  772,  469, 4495 } },
+      { PimCmdEnum::AND,          {   32,   16,   64 } },
+      { PimCmdEnum::OR,           {   32,   16,   48 } },
+      { PimCmdEnum::XOR,          {   32,   16,   96 } },
+      { PimCmdEnum::XNOR,         {   32,   16,  112 } },
+      { PimCmdEnum::GT,           {   32,   16,  162 } },
+      { PimCmdEnum::LT,           {   32,   16,  162 } },
+      { PimCmdEnum::EQ,           {   32,   16,  131 } },
+      { PimCmdEnum::MIN,          {   64,   16,  241 } },
+      { PimCmdEnum::MAX,          {   64,   16,  241 } },
+      { PimCmdEnum::ADD_SCALAR,   {   16,   16,  241 } },
+      { PimCmdEnum::SUB_SCALAR,   {   16,   16,  241 } },
+      { PimCmdEnum::MUL_SCALAR,   {  136,  136, 2392 } },
+      { PimCmdEnum::DIV_SCALAR,   {  546,  485, 4737 } },
+      { PimCmdEnum::AND_SCALAR,   {   16,   16,   80 } },
+      { PimCmdEnum::OR_SCALAR,    {   16,   16,   64 } },
+      { PimCmdEnum::XOR_SCALAR,   {   16,   16,  112 } },
+      { PimCmdEnum::XNOR_SCALAR,  {   16,   16,  128 } },
+      { PimCmdEnum::GT_SCALAR,    {   16,   16,  178 } },
+      { PimCmdEnum::LT_SCALAR,    {   16,   16,  178 } },
+      { PimCmdEnum::EQ_SCALAR,    {   16,   16,  147 } },
+      { PimCmdEnum::MIN_SCALAR,   {   32,   16,  273 } },
+      { PimCmdEnum::MAX_SCALAR,   {   32,   16,  273 } },
+      { PimCmdEnum::SCALED_ADD,   {  168,  152, 2617 } }, // Derived from adding ADD + MUL_SCALAR
+    }},
+    { PIM_INT32, {
+      { PimCmdEnum::ABS,          {   33,   32,  450 } },
+      { PimCmdEnum::POPCOUNT,     {  114,  114,  765 } },
+      { PimCmdEnum::ADD,          {   64,   32,  449 } },
+      { PimCmdEnum::SUB,          {   64,   32,  449 } },
+      { PimCmdEnum::MUL,          { 1056,  528, 9120 } },
+      { PimCmdEnum::DIV,          { 3076, 1709, 17415 } },
+      { PimCmdEnum::AND,          {   64,   32,  128 } },
+      { PimCmdEnum::OR,           {   64,   32,   96 } },
+      { PimCmdEnum::XOR,          {   64,   32,  192 } },
+      { PimCmdEnum::XNOR,         {   64,   32,  224 } },
+      { PimCmdEnum::GT,           {   64,   32,  322 } },
+      { PimCmdEnum::LT,           {   64,   32,  322 } },
+      { PimCmdEnum::EQ,           {   64,   32,  259 } },
+      { PimCmdEnum::MIN,          {  128,   32,  481 } },
+      { PimCmdEnum::MAX,          {  128,   32,  481 } },
+      { PimCmdEnum::ADD_SCALAR,   {   32,   32,  481 } },
+      { PimCmdEnum::SUB_SCALAR,   {   32,   32,  481 } },
+      { PimCmdEnum::MUL_SCALAR,   {  528,  528, 9648 } },
+      { PimCmdEnum::DIV_SCALAR,   { 2114, 1741, 18409 } },
+      { PimCmdEnum::AND_SCALAR,   {   32,   32,  160 } },
+      { PimCmdEnum::OR_SCALAR,    {   32,   32,  128 } },
+      { PimCmdEnum::XOR_SCALAR,   {   32,   32,  224 } },
+      { PimCmdEnum::XNOR_SCALAR,  {   32,   32,  256 } },
+      { PimCmdEnum::GT_SCALAR,    {   32,   32,  354 } },
+      { PimCmdEnum::LT_SCALAR,    {   32,   32,  354 } },
+      { PimCmdEnum::EQ_SCALAR,    {   32,   32,  291 } },
+      { PimCmdEnum::MIN_SCALAR,   {   64,   32,  545 } },
+      { PimCmdEnum::MAX_SCALAR,   {   64,   32,  545 } },
+      { PimCmdEnum::SCALED_ADD,   {  592,  560, 10097 } }, // Derived from adding ADD + MUL_SCALAR
+    }},
+    { PIM_INT64, {
+      { PimCmdEnum::ABS,          {   65,   64,  898 } },
+      //{ PimCmdEnum::POPCOUNT,     {    0,    0,    0 } },
+      { PimCmdEnum::ADD,          {  128,   64,  897 } },
+      { PimCmdEnum::SUB,          {  128,   64,  897 } },
+      //{ PimCmdEnum::MUL,          {    0,    0,    0 } },
+      //{ PimCmdEnum::DIV,          {    0,    0,    0 } },
+      { PimCmdEnum::AND,          {  128,   64,  256 } },
+      { PimCmdEnum::OR,           {  128,   64,  192 } },
+      { PimCmdEnum::XOR,          {  128,   64,  384 } },
+      { PimCmdEnum::XNOR,         {  128,   64,  448 } },
+      { PimCmdEnum::GT,           {  128,   64,  642 } },
+      { PimCmdEnum::LT,           {  128,   64,  642 } },
+      { PimCmdEnum::EQ,           {  128,   64,  515 } },
+      { PimCmdEnum::MIN,          {  256,   64,  961 } },
+      { PimCmdEnum::MAX,          {  256,   64,  961 } },
+      { PimCmdEnum::ADD_SCALAR,   {   64,   64,  961 } },
+      { PimCmdEnum::SUB_SCALAR,   {   64,   64,  961 } },
+      //{ PimCmdEnum::MUL_SCALAR,   {    0,    0,    0 } },
+      //{ PimCmdEnum::DIV_SCALAR,   {    0,    0,    0 } },
+      { PimCmdEnum::AND_SCALAR,   {   64,   64,  320 } },
+      { PimCmdEnum::OR_SCALAR,    {   64,   64,  256 } },
+      { PimCmdEnum::XOR_SCALAR,   {   64,   64,  448 } },
+      { PimCmdEnum::XNOR_SCALAR,  {   64,   64,  512 } },
+      { PimCmdEnum::GT_SCALAR,    {   64,   64,  706 } },
+      { PimCmdEnum::LT_SCALAR,    {   64,   64,  706 } },
+      { PimCmdEnum::EQ_SCALAR,    {   64,   64,  579 } },
+      { PimCmdEnum::MIN_SCALAR,   {  128,   64, 1089 } },
+      { PimCmdEnum::MAX_SCALAR,   {  128,   64, 1089 } },
+      //{ PimCmdEnum::SCALED_ADD,   {    0,    0,    0 } }, // Derived from adding ADD + MUL_SCALAR
+    }},
+    { PIM_UINT8, {
+      { PimCmdEnum::ABS,          {    8,    8,    0 } },
+      //{ PimCmdEnum::POPCOUNT,     {    0,    0,    0 } },
+      { PimCmdEnum::ADD,          {   16,    8,  113 } },
+      { PimCmdEnum::SUB,          {   16,    8,  113 } },
+      { PimCmdEnum::MUL,          {   72,   36,  552 } },
+      { PimCmdEnum::DIV,          {  216,  140, 1109 } },
+      { PimCmdEnum::AND,          {   16,    8,   32 } },
+      { PimCmdEnum::OR,           {   16,    8,   24 } },
+      { PimCmdEnum::XOR,          {   16,    8,   48 } },
+      { PimCmdEnum::XNOR,         {   16,    8,   56 } },
+      { PimCmdEnum::GT,           {   16,    8,   83 } },
+      { PimCmdEnum::LT,           {   16,    8,   83 } },
+      { PimCmdEnum::EQ,           {   16,    8,   67 } },
+      { PimCmdEnum::MIN,          {   32,    8,  122 } },
+      { PimCmdEnum::MAX,          {   32,    8,  122 } },
+      { PimCmdEnum::ADD_SCALAR,   {    8,    8,  121 } },
+      { PimCmdEnum::SUB_SCALAR,   {    8,    8,  121 } },
+      { PimCmdEnum::MUL_SCALAR,   {   36,   36,  588 } },
+      { PimCmdEnum::DIV_SCALAR,   {  152,  140, 1173 } },
+      { PimCmdEnum::AND_SCALAR,   {    8,    8,   40 } },
+      { PimCmdEnum::OR_SCALAR,    {    8,    8,   32 } },
+      { PimCmdEnum::XOR_SCALAR,   {    8,    8,   56 } },
+      { PimCmdEnum::XNOR_SCALAR,  {    8,    8,   64 } },
+      { PimCmdEnum::GT_SCALAR,    {    8,    8,   91 } },
+      { PimCmdEnum::LT_SCALAR,    {    8,    8,   91 } },
+      { PimCmdEnum::EQ_SCALAR,    {    8,    8,   75 } },
+      { PimCmdEnum::MIN_SCALAR,   {   16,    8,  138 } },
+      { PimCmdEnum::MAX_SCALAR,   {   16,    8,  138 } },
+      { PimCmdEnum::SCALED_ADD,   {   52,   44,  701 } }, // Derived from adding ADD + MUL_SCALAR
+    }},
+    { PIM_UINT16, {
+      { PimCmdEnum::ABS,          {   16,   16,    0 } },
+      //{ PimCmdEnum::POPCOUNT,     {    0,    0,    0 } },
+      { PimCmdEnum::ADD,          {   32,   16,  225 } },
+      { PimCmdEnum::SUB,          {   32,   16,  225 } },
+      { PimCmdEnum::MUL,          {  272,  136, 2256 } },
+      { PimCmdEnum::DIV,          {  816,  472, 4329 } },
+      { PimCmdEnum::AND,          {   32,   16,   64 } },
+      { PimCmdEnum::OR,           {   32,   16,   48 } },
+      { PimCmdEnum::XOR,          {   32,   16,   96 } },
+      { PimCmdEnum::XNOR,         {   32,   16,  112 } },
+      { PimCmdEnum::GT,           {   32,   16,  163 } },
+      { PimCmdEnum::LT,           {   32,   16,  163 } },
+      { PimCmdEnum::EQ,           {   32,   16,  131 } },
+      { PimCmdEnum::MIN,          {   64,   16,  242 } },
+      { PimCmdEnum::MAX,          {   64,   16,  242 } },
+      { PimCmdEnum::ADD_SCALAR,   {   16,   16,  241 } },
+      { PimCmdEnum::SUB_SCALAR,   {   16,   16,  241 } },
+      { PimCmdEnum::MUL_SCALAR,   {  136,  136, 2392 } },
+      { PimCmdEnum::DIV_SCALAR,   {  560,  472, 4585 } },
+      { PimCmdEnum::AND_SCALAR,   {   16,   16,   80 } },
+      { PimCmdEnum::OR_SCALAR,    {   16,   16,   64 } },
+      { PimCmdEnum::XOR_SCALAR,   {   16,   16,  112 } },
+      { PimCmdEnum::XNOR_SCALAR,  {   16,   16,  128 } },
+      { PimCmdEnum::GT_SCALAR,    {   16,   16,  179 } },
+      { PimCmdEnum::LT_SCALAR,    {   16,   16,  179 } },
+      { PimCmdEnum::EQ_SCALAR,    {   16,   16,  147 } },
+      { PimCmdEnum::MIN_SCALAR,   {   32,   16,  274 } },
+      { PimCmdEnum::MAX_SCALAR,   {   32,   16,  274 } },
+      { PimCmdEnum::SCALED_ADD,   {  168,  152, 2617 } }, // Derived from adding ADD + MUL_SCALAR
+    }},
+    { PIM_UINT32, {
+      { PimCmdEnum::ABS,          {   32,   32,    0 } },
+      { PimCmdEnum::POPCOUNT,     {  114,  114,  765 } },
+      { PimCmdEnum::ADD,          {   64,   32,  449 } },
+      { PimCmdEnum::SUB,          {   64,   32,  449 } },
+      { PimCmdEnum::MUL,          { 1056,  528, 9120 } },
+      { PimCmdEnum::DIV,          { 3168, 1712, 17105 } },
+      { PimCmdEnum::AND,          {   64,   32,  128 } },
+      { PimCmdEnum::OR,           {   64,   32,   96 } },
+      { PimCmdEnum::XOR,          {   64,   32,  192 } },
+      { PimCmdEnum::XNOR,         {   64,   32,  224 } },
+      { PimCmdEnum::GT,           {   64,   32,  323 } },
+      { PimCmdEnum::LT,           {   64,   32,  323 } },
+      { PimCmdEnum::EQ,           {   64,   32,  259 } },
+      { PimCmdEnum::MIN,          {  128,   32,  482 } },
+      { PimCmdEnum::MAX,          {  128,   32,  482 } },
+      { PimCmdEnum::ADD_SCALAR,   {   32,   32,  481 } },
+      { PimCmdEnum::SUB_SCALAR,   {   32,   32,  481 } },
+      { PimCmdEnum::MUL_SCALAR,   {  528,  528, 9648 } },
+      { PimCmdEnum::DIV_SCALAR,   { 2144, 1712, 18129 } },
+      { PimCmdEnum::AND_SCALAR,   {   32,   32,  160 } },
+      { PimCmdEnum::OR_SCALAR,    {   32,   32,  128 } },
+      { PimCmdEnum::XOR_SCALAR,   {   32,   32,  224 } },
+      { PimCmdEnum::XNOR_SCALAR,  {   32,   32,  256 } },
+      { PimCmdEnum::GT_SCALAR,    {   32,   32,  355 } },
+      { PimCmdEnum::LT_SCALAR,    {   32,   32,  355 } },
+      { PimCmdEnum::EQ_SCALAR,    {   32,   32,  291 } },
+      { PimCmdEnum::MIN_SCALAR,   {   64,   32,  546 } },
+      { PimCmdEnum::MAX_SCALAR,   {   64,   32,  546 } },
+      { PimCmdEnum::SCALED_ADD,   {  592,  560, 10097 } }, // Derived from adding ADD + MUL_SCALAR
+    }},
+    { PIM_UINT64, {
+      { PimCmdEnum::ABS,          {   64,   64,    0 } },
+      //{ PimCmdEnum::POPCOUNT,     {    0,    0,    0 } },
+      { PimCmdEnum::ADD,          {  128,   64,  897 } },
+      { PimCmdEnum::SUB,          {  128,   64,  897 } },
+      //{ PimCmdEnum::MUL,          {    0,    0,    0 } },
+      //{ PimCmdEnum::DIV,          {    0,    0,    0 } },
+      { PimCmdEnum::AND,          {  128,   64,  256 } },
+      { PimCmdEnum::OR,           {  128,   64,  192 } },
+      { PimCmdEnum::XOR,          {  128,   64,  384 } },
+      { PimCmdEnum::XNOR,         {  128,   64,  448 } },
+      { PimCmdEnum::GT,           {  128,   64,  643 } },
+      { PimCmdEnum::LT,           {  128,   64,  643 } },
+      { PimCmdEnum::EQ,           {  128,   64,  515 } },
+      { PimCmdEnum::MIN,          {  256,   64,  962 } },
+      { PimCmdEnum::MAX,          {  256,   64,  962 } },
+      { PimCmdEnum::ADD_SCALAR,   {   64,   64,  961 } },
+      { PimCmdEnum::SUB_SCALAR,   {   64,   64,  961 } },
+      //{ PimCmdEnum::MUL_SCALAR,   {    0,    0,    0 } },
+      //{ PimCmdEnum::DIV_SCALAR,   {    0,    0,    0 } },
+      { PimCmdEnum::AND_SCALAR,   {   64,   64,  320 } },
+      { PimCmdEnum::OR_SCALAR,    {   64,   64,  256 } },
+      { PimCmdEnum::XOR_SCALAR,   {   64,   64,  448 } },
+      { PimCmdEnum::XNOR_SCALAR,  {   64,   64,  512 } },
+      { PimCmdEnum::GT_SCALAR,    {   64,   64,  707 } },
+      { PimCmdEnum::LT_SCALAR,    {   64,   64,  707 } },
+      { PimCmdEnum::EQ_SCALAR,    {   64,   64,  579 } },
+      { PimCmdEnum::MIN_SCALAR,   {  128,   64, 1090 } },
+      { PimCmdEnum::MAX_SCALAR,   {  128,   64, 1090 } },
+      //{ PimCmdEnum::SCALED_ADD,   {    0,    0,    0 } }, // Derived from adding ADD + MUL_SCALAR
+    }},
+    { PIM_FP32, { // Scaled from BitSIMD-V by #L ratio of the INT32 op
+      { PimCmdEnum::ADD,          { 1331,  685, 7809 } },
+      { PimCmdEnum::SUB,          { 1331,  685, 7809 } },
+      { PimCmdEnum::MUL,          { 1852, 1000, 13391 } },
+      { PimCmdEnum::DIV,          { 2744, 1458, 16602 } },
+      { PimCmdEnum::MUL_SCALAR,   { 1852, 1000, 11298 } },
+    }}
+  }},
+  { PIM_DEVICE_DRISA_MIXED, {
+    { PIM_INT8, {
+      { PimCmdEnum::ABS,          {    9,    8,   82 } },
+      //{ PimCmdEnum::POPCOUNT,     {    0,    0,    0 } },
+      { PimCmdEnum::ADD,          {   16,    8,   97 } },
+      { PimCmdEnum::SUB,          {   16,    8,   97 } },
+      { PimCmdEnum::MUL,          {   72,   36,  496 } },
+      { PimCmdEnum::DIV,          {  196,  137, 1008 } },
+      { PimCmdEnum::AND,          {   16,    8,   16 } },
+      { PimCmdEnum::OR,           {   16,    8,   16 } },
+      { PimCmdEnum::XOR,          {   16,    8,   40 } },
+      { PimCmdEnum::XNOR,         {   16,    8,   48 } },
+      { PimCmdEnum::GT,           {   16,    8,   74 } },
+      { PimCmdEnum::LT,           {   16,    8,   74 } },
+      { PimCmdEnum::EQ,           {   16,    8,   51 } },
+      { PimCmdEnum::MIN,          {   32,    8,  113 } },
+      { PimCmdEnum::MAX,          {   32,    8,  113 } },
+      { PimCmdEnum::ADD_SCALAR,   {    8,    8,  105 } },
+      { PimCmdEnum::SUB_SCALAR,   {    8,    8,  105 } },
+      { PimCmdEnum::MUL_SCALAR,   {   36,   36,  532 } },
+      { PimCmdEnum::DIV_SCALAR,   {  146,  145, 1066 } },
+      { PimCmdEnum::AND_SCALAR,   {    8,    8,   24 } },
+      { PimCmdEnum::OR_SCALAR,    {    8,    8,   24 } },
+      { PimCmdEnum::XOR_SCALAR,   {    8,    8,   48 } },
+      { PimCmdEnum::XNOR_SCALAR,  {    8,    8,   56 } },
+      { PimCmdEnum::GT_SCALAR,    {    8,    8,   82 } },
+      { PimCmdEnum::LT_SCALAR,    {    8,    8,   82 } },
+      { PimCmdEnum::EQ_SCALAR,    {    8,    8,   59 } },
+      { PimCmdEnum::MIN_SCALAR,   {   16,    8,  129 } },
+      { PimCmdEnum::MAX_SCALAR,   {   16,    8,  129 } },
+      { PimCmdEnum::SCALED_ADD,   {   52,   44,  629 } }, // Derived from adding ADD + MUL_SCALAR
+    }},
+    { PIM_INT16, {
+      { PimCmdEnum::ABS,          {   17,   16,  162 } },
+      //{ PimCmdEnum::POPCOUNT,     {    0,    0,    0 } },
+      { PimCmdEnum::ADD,          {   32,   16,  193 } },
+      { PimCmdEnum::SUB,          {   32,   16,  193 } },
+      { PimCmdEnum::MUL,          {  272,  136, 2016 } },
+      { PimCmdEnum::DIV,          {  772,  469, 3852 } },
+      { PimCmdEnum::AND,          {   32,   16,   32 } },
+      { PimCmdEnum::OR,           {   32,   16,   32 } },
+      { PimCmdEnum::XOR,          {   32,   16,   80 } },
+      { PimCmdEnum::XNOR,         {   32,   16,   96 } },
+      { PimCmdEnum::GT,           {   32,   16,  146 } },
+      { PimCmdEnum::LT,           {   32,   16,  146 } },
+      { PimCmdEnum::EQ,           {   32,   16,   99 } },
+      { PimCmdEnum::MIN,          {   64,   16,  225 } },
+      { PimCmdEnum::MAX,          {   64,   16,  225 } },
+      { PimCmdEnum::ADD_SCALAR,   {   16,   16,  209 } },
+      { PimCmdEnum::SUB_SCALAR,   {   16,   16,  209 } },
+      { PimCmdEnum::MUL_SCALAR,   {  136,  136, 2152 } },
+      { PimCmdEnum::DIV_SCALAR,   {  546,  485, 4094 } },
+      { PimCmdEnum::AND_SCALAR,   {   16,   16,   48 } },
+      { PimCmdEnum::OR_SCALAR,    {   16,   16,   48 } },
+      { PimCmdEnum::XOR_SCALAR,   {   16,   16,   96 } },
+      { PimCmdEnum::XNOR_SCALAR,  {   16,   16,  112 } },
+      { PimCmdEnum::GT_SCALAR,    {   16,   16,  162 } },
+      { PimCmdEnum::LT_SCALAR,    {   16,   16,  162 } },
+      { PimCmdEnum::EQ_SCALAR,    {   16,   16,  115 } },
+      { PimCmdEnum::MIN_SCALAR,   {   32,   16,  257 } },
+      { PimCmdEnum::MAX_SCALAR,   {   32,   16,  257 } },
+      { PimCmdEnum::SCALED_ADD,   {  168,  152, 2345 } }, // Derived from adding ADD + MUL_SCALAR
+    }},
+    { PIM_INT32, {
+      { PimCmdEnum::ABS,          {   33,   32,  322 } },
+      { PimCmdEnum::POPCOUNT,     {  114,  114,  635 } },
+      { PimCmdEnum::ADD,          {   64,   32,  385 } },
+      { PimCmdEnum::SUB,          {   64,   32,  385 } },
+      { PimCmdEnum::MUL,          { 1056,  528, 8128 } },
+      { PimCmdEnum::DIV,          { 3076, 1709, 15108 } },
+      { PimCmdEnum::AND,          {   64,   32,   64 } },
+      { PimCmdEnum::OR,           {   64,   32,   64 } },
+      { PimCmdEnum::XOR,          {   64,   32,  160 } },
+      { PimCmdEnum::XNOR,         {   64,   32,  192 } },
+      { PimCmdEnum::GT,           {   64,   32,  290 } },
+      { PimCmdEnum::LT,           {   64,   32,  290 } },
+      { PimCmdEnum::EQ,           {   64,   32,  195 } },
+      { PimCmdEnum::MIN,          {  128,   32,  449 } },
+      { PimCmdEnum::MAX,          {  128,   32,  449 } },
+      { PimCmdEnum::ADD_SCALAR,   {   32,   32,  417 } },
+      { PimCmdEnum::SUB_SCALAR,   {   32,   32,  417 } },
+      { PimCmdEnum::MUL_SCALAR,   {  528,  528, 8656 } },
+      { PimCmdEnum::DIV_SCALAR,   { 2114, 1741, 16102 } },
+      { PimCmdEnum::AND_SCALAR,   {   32,   32,   96 } },
+      { PimCmdEnum::OR_SCALAR,    {   32,   32,   96 } },
+      { PimCmdEnum::XOR_SCALAR,   {   32,   32,  192 } },
+      { PimCmdEnum::XNOR_SCALAR,  {   32,   32,  224 } },
+      { PimCmdEnum::GT_SCALAR,    {   32,   32,  322 } },
+      { PimCmdEnum::LT_SCALAR,    {   32,   32,  322 } },
+      { PimCmdEnum::EQ_SCALAR,    {   32,   32,  227 } },
+      { PimCmdEnum::MIN_SCALAR,   {   64,   32,  513 } },
+      { PimCmdEnum::MAX_SCALAR,   {   64,   32,  513 } },
+      { PimCmdEnum::SCALED_ADD,   {  592,  560, 9041 } }, // Derived from adding ADD + MUL_SCALAR
+    }},
+    { PIM_INT64, {
+      { PimCmdEnum::ABS,          {   65,   64,  642 } },
+      //{ PimCmdEnum::POPCOUNT,     {    0,    0,    0 } },
+      { PimCmdEnum::ADD,          {  128,   64,  769 } },
+      { PimCmdEnum::SUB,          {  128,   64,  769 } },
+      //{ PimCmdEnum::MUL,          {    0,    0,    0 } },
+      //{ PimCmdEnum::DIV,          {    0,    0,    0 } },
+      { PimCmdEnum::AND,          {  128,   64,  128 } },
+      { PimCmdEnum::OR,           {  128,   64,  128 } },
+      { PimCmdEnum::XOR,          {  128,   64,  320 } },
+      { PimCmdEnum::XNOR,         {  128,   64,  384 } },
+      { PimCmdEnum::GT,           {  128,   64,  578 } },
+      { PimCmdEnum::LT,           {  128,   64,  578 } },
+      { PimCmdEnum::EQ,           {  128,   64,  387 } },
+      { PimCmdEnum::MIN,          {  256,   64,  897 } },
+      { PimCmdEnum::MAX,          {  256,   64,  897 } },
+      { PimCmdEnum::ADD_SCALAR,   {   64,   64,  833 } },
+      { PimCmdEnum::SUB_SCALAR,   {   64,   64,  833 } },
+      //{ PimCmdEnum::MUL_SCALAR,   {    0,    0,    0 } },
+      //{ PimCmdEnum::DIV_SCALAR,   {    0,    0,    0 } },
+      { PimCmdEnum::AND_SCALAR,   {   64,   64,  192 } },
+      { PimCmdEnum::OR_SCALAR,    {   64,   64,  192 } },
+      { PimCmdEnum::XOR_SCALAR,   {   64,   64,  384 } },
+      { PimCmdEnum::XNOR_SCALAR,  {   64,   64,  448 } },
+      { PimCmdEnum::GT_SCALAR,    {   64,   64,  642 } },
+      { PimCmdEnum::LT_SCALAR,    {   64,   64,  642 } },
+      { PimCmdEnum::EQ_SCALAR,    {   64,   64,  451 } },
+      { PimCmdEnum::MIN_SCALAR,   {  128,   64, 1025 } },
+      { PimCmdEnum::MAX_SCALAR,   {  128,   64, 1025 } },
+      //{ PimCmdEnum::SCALED_ADD,   {    0,    0,    0 } }, // Derived from adding ADD + MUL_SCALAR
+    }},
+    { PIM_UINT8, {
+      { PimCmdEnum::ABS,          {    8,    8,    0 } },
+      //{ PimCmdEnum::POPCOUNT,     {    0,    0,    0 } },
+      { PimCmdEnum::ADD,          {   16,    8,   97 } },
+      { PimCmdEnum::SUB,          {   16,    8,   97 } },
+      { PimCmdEnum::MUL,          {   72,   36,  496 } },
+      { PimCmdEnum::DIV,          {  216,  140,  981 } },
+      { PimCmdEnum::AND,          {   16,    8,   16 } },
+      { PimCmdEnum::OR,           {   16,    8,   16 } },
+      { PimCmdEnum::XOR,          {   16,    8,   40 } },
+      { PimCmdEnum::XNOR,         {   16,    8,   48 } },
+      { PimCmdEnum::GT,           {   16,    8,   75 } },
+      { PimCmdEnum::LT,           {   16,    8,   75 } },
+      { PimCmdEnum::EQ,           {   16,    8,   51 } },
+      { PimCmdEnum::MIN,          {   32,    8,  114 } },
+      { PimCmdEnum::MAX,          {   32,    8,  114 } },
+      { PimCmdEnum::ADD_SCALAR,   {    8,    8,  105 } },
+      { PimCmdEnum::SUB_SCALAR,   {    8,    8,  105 } },
+      { PimCmdEnum::MUL_SCALAR,   {   36,   36,  532 } },
+      { PimCmdEnum::DIV_SCALAR,   {  152,  140, 1045 } },
+      { PimCmdEnum::AND_SCALAR,   {    8,    8,   24 } },
+      { PimCmdEnum::OR_SCALAR,    {    8,    8,   24 } },
+      { PimCmdEnum::XOR_SCALAR,   {    8,    8,   48 } },
+      { PimCmdEnum::XNOR_SCALAR,  {    8,    8,   56 } },
+      { PimCmdEnum::GT_SCALAR,    {    8,    8,   83 } },
+      { PimCmdEnum::LT_SCALAR,    {    8,    8,   83 } },
+      { PimCmdEnum::EQ_SCALAR,    {    8,    8,   59 } },
+      { PimCmdEnum::MIN_SCALAR,   {   16,    8,  130 } },
+      { PimCmdEnum::MAX_SCALAR,   {   16,    8,  130 } },
+      { PimCmdEnum::SCALED_ADD,   {   52,   44,  629 } }, // Derived from adding ADD + MUL_SCALAR
+    }},
+    { PIM_UINT16, {
+      { PimCmdEnum::ABS,          {   16,   16,    0 } },
+      //{ PimCmdEnum::POPCOUNT,     {    0,    0,    0 } },
+      { PimCmdEnum::ADD,          {   32,   16,  193 } },
+      { PimCmdEnum::SUB,          {   32,   16,  193 } },
+      { PimCmdEnum::MUL,          {  272,  136, 2016 } },
+      { PimCmdEnum::DIV,          {  816,  472, 3817 } },
+      { PimCmdEnum::AND,          {   32,   16,   32 } },
+      { PimCmdEnum::OR,           {   32,   16,   32 } },
+      { PimCmdEnum::XOR,          {   32,   16,   80 } },
+      { PimCmdEnum::XNOR,         {   32,   16,   96 } },
+      { PimCmdEnum::GT,           {   32,   16,  147 } },
+      { PimCmdEnum::LT,           {   32,   16,  147 } },
+      { PimCmdEnum::EQ,           {   32,   16,   99 } },
+      { PimCmdEnum::MIN,          {   64,   16,  226 } },
+      { PimCmdEnum::MAX,          {   64,   16,  226 } },
+      { PimCmdEnum::ADD_SCALAR,   {   16,   16,  209 } },
+      { PimCmdEnum::SUB_SCALAR,   {   16,   16,  209 } },
+      { PimCmdEnum::MUL_SCALAR,   {  136,  136, 2152 } },
+      { PimCmdEnum::DIV_SCALAR,   {  560,  472, 4073 } },
+      { PimCmdEnum::AND_SCALAR,   {   16,   16,   48 } },
+      { PimCmdEnum::OR_SCALAR,    {   16,   16,   48 } },
+      { PimCmdEnum::XOR_SCALAR,   {   16,   16,   96 } },
+      { PimCmdEnum::XNOR_SCALAR,  {   16,   16,  112 } },
+      { PimCmdEnum::GT_SCALAR,    {   16,   16,  163 } },
+      { PimCmdEnum::LT_SCALAR,    {   16,   16,  163 } },
+      { PimCmdEnum::EQ_SCALAR,    {   16,   16,  115 } },
+      { PimCmdEnum::MIN_SCALAR,   {   32,   16,  258 } },
+      { PimCmdEnum::MAX_SCALAR,   {   32,   16,  258 } },
+      { PimCmdEnum::SCALED_ADD,   {  168,  152, 2345 } }, // Derived from adding ADD + MUL_SCALAR
+    }},
+    { PIM_UINT32, {
+      { PimCmdEnum::ABS,          {   32,   32,    0 } },
+      { PimCmdEnum::POPCOUNT,     {  114,  114,  635 } },
+      { PimCmdEnum::ADD,          {   64,   32,  385 } },
+      { PimCmdEnum::SUB,          {   64,   32,  385 } },
+      { PimCmdEnum::MUL,          { 1056,  528, 8128 } },
+      { PimCmdEnum::DIV,          { 3168, 1712, 15057 } },
+      { PimCmdEnum::AND,          {   64,   32,   64 } },
+      { PimCmdEnum::OR,           {   64,   32,   64 } },
+      { PimCmdEnum::XOR,          {   64,   32,  160 } },
+      { PimCmdEnum::XNOR,         {   64,   32,  192 } },
+      { PimCmdEnum::GT,           {   64,   32,  291 } },
+      { PimCmdEnum::LT,           {   64,   32,  291 } },
+      { PimCmdEnum::EQ,           {   64,   32,  195 } },
+      { PimCmdEnum::MIN,          {  128,   32,  450 } },
+      { PimCmdEnum::MAX,          {  128,   32,  450 } },
+      { PimCmdEnum::ADD_SCALAR,   {   32,   32,  417 } },
+      { PimCmdEnum::SUB_SCALAR,   {   32,   32,  417 } },
+      { PimCmdEnum::MUL_SCALAR,   {  528,  528, 8656 } },
+      { PimCmdEnum::DIV_SCALAR,   { 2144, 1712, 16081 } },
+      { PimCmdEnum::AND_SCALAR,   {   32,   32,   96 } },
+      { PimCmdEnum::OR_SCALAR,    {   32,   32,   96 } },
+      { PimCmdEnum::XOR_SCALAR,   {   32,   32,  192 } },
+      { PimCmdEnum::XNOR_SCALAR,  {   32,   32,  224 } },
+      { PimCmdEnum::GT_SCALAR,    {   32,   32,  323 } },
+      { PimCmdEnum::LT_SCALAR,    {   32,   32,  323 } },
+      { PimCmdEnum::EQ_SCALAR,    {   32,   32,  227 } },
+      { PimCmdEnum::MIN_SCALAR,   {   64,   32,  514 } },
+      { PimCmdEnum::MAX_SCALAR,   {   64,   32,  514 } },
+      { PimCmdEnum::SCALED_ADD,   {  592,  560, 9041 } }, // Derived from adding ADD + MUL_SCALAR
+    }},
+    { PIM_UINT64, {
+      { PimCmdEnum::ABS,          {   64,   64,    0 } },
+      //{ PimCmdEnum::POPCOUNT,     {    0,    0,    0 } },
+      { PimCmdEnum::ADD,          {  128,   64,  769 } },
+      { PimCmdEnum::SUB,          {  128,   64,  769 } },
+      //{ PimCmdEnum::MUL,          {    0,    0,    0 } },
+      //{ PimCmdEnum::DIV,          {    0,    0,    0 } },
+      { PimCmdEnum::AND,          {  128,   64,  128 } },
+      { PimCmdEnum::OR,           {  128,   64,  128 } },
+      { PimCmdEnum::XOR,          {  128,   64,  320 } },
+      { PimCmdEnum::XNOR,         {  128,   64,  384 } },
+      { PimCmdEnum::GT,           {  128,   64,  579 } },
+      { PimCmdEnum::LT,           {  128,   64,  579 } },
+      { PimCmdEnum::EQ,           {  128,   64,  387 } },
+      { PimCmdEnum::MIN,          {  256,   64,  898 } },
+      { PimCmdEnum::MAX,          {  256,   64,  898 } },
+      { PimCmdEnum::ADD_SCALAR,   {   64,   64,  833 } },
+      { PimCmdEnum::SUB_SCALAR,   {   64,   64,  833 } },
+      //{ PimCmdEnum::MUL_SCALAR,   {    0,    0,    0 } },
+      //{ PimCmdEnum::DIV_SCALAR,   {    0,    0,    0 } },
+      { PimCmdEnum::AND_SCALAR,   {   64,   64,  192 } },
+      { PimCmdEnum::OR_SCALAR,    {   64,   64,  192 } },
+      { PimCmdEnum::XOR_SCALAR,   {   64,   64,  384 } },
+      { PimCmdEnum::XNOR_SCALAR,  {   64,   64,  448 } },
+      { PimCmdEnum::GT_SCALAR,    {   64,   64,  643 } },
+      { PimCmdEnum::LT_SCALAR,    {   64,   64,  643 } },
+      { PimCmdEnum::EQ_SCALAR,    {   64,   64,  451 } },
+      { PimCmdEnum::MIN_SCALAR,   {  128,   64, 1026 } },
+      { PimCmdEnum::MAX_SCALAR,   {  128,   64, 1026 } },
+      //{ PimCmdEnum::SCALED_ADD,   {    0,    0,    0 } }, // Derived from adding ADD + MUL_SCALAR
+    }},
+    { PIM_FP32, { // Scaled from BitSIMD-V by #L ratio of the INT32 op
+      { PimCmdEnum::ADD,          { 1331,  685, 6696 } },
+      { PimCmdEnum::SUB,          { 1331,  685, 6696 } },
+      { PimCmdEnum::MUL,          { 1852, 1000, 11934 } },
+      { PimCmdEnum::DIV,          { 2744, 1458, 14403 } },
+      { PimCmdEnum::MUL_SCALAR,   { 1852, 1000, 10136 } },
+    }}
+  }},
+};
+
+
+
+//! @brief  SIMDRAM op count table (Tuple: #AAP per bit, #AP per bit, #AAP per bit^2, #AP per bit^2)
+//!         Counts are for MAJ/NOT micro-programs on integer types of N bits: #AAP = N * c1 + N * N * c2.
+//!         Operands are copied into compute rows with AAP, majority is computed with TRA by AP or by AAP
+//!         which also copies the result out, and NOT is done through dual-contact cells.
+//!         Scalar operands are read from the constant C0/C1 rows.
+const std::unordered_map<PimCmdEnum, std::tuple<unsigned, unsigned, unsigned, unsigned>>
+pimPerfEnergyTables::simdramPerfTable = {
+  { PimCmdEnum::ABS,          {   13,    4,    0,    0 } }, // XOR with sign, then add sign
+  { PimCmdEnum::SHIFT_BITS_R, {    1,    0,    0,    0 } }, // one row copy per bit
+  { PimCmdEnum::SHIFT_BITS_L, {    1,    0,    0,    0 } },
+  { PimCmdEnum::ADD,          {    7,    2,    0,    0 } }, // full adder: carry = MAJ(A, B, C)
+  { PimCmdEnum::SUB,          {    8,    2,    0,    0 } }, // full adder with NOT B
+  { PimCmdEnum::MUL,          {    5,    1,    6,    1 } }, // N(N+1)/2 AND and full adder steps
+  { PimCmdEnum::DIV,          {    0,    0,   15,    4 } }, // N iterations of subtract and select
+  { PimCmdEnum::AND,          {    4,    0,    0,    0 } }, // MAJ(A, B, C0)
+  { PimCmdEnum::OR,           {    4,    0,    0,    0 } }, // MAJ(A, B, C1)
+  { PimCmdEnum::XOR,          {    6,    2,    0,    0 } },
+  { PimCmdEnum::XNOR,         {    7,    2,    0,    0 } },
+  { PimCmdEnum::GT,           {    4,    1,    0,    0 } }, // borrow chain
+  { PimCmdEnum::LT,           {    4,    1,    0,    0 } },
+  { PimCmdEnum::EQ,           {    8,    2,    0,    0 } }, // XNOR, then AND into the result
+  { PimCmdEnum::MIN,          {   11,    3,    0,    0 } }, // compare, then select
+  { PimCmdEnum::MAX,          {   11,    3,    0,    0 } },
+  { PimCmdEnum::ADD_SCALAR,   {    7,    2,    0,    0 } },
+  { PimCmdEnum::SUB_SCALAR,   {    7,    2,    0,    0 } },
+  { PimCmdEnum::MUL_SCALAR,   {    2,    0,    2,    1 } }, // add shifted input for set scalar bits
+  { PimCmdEnum::DIV_SCALAR,   {    0,    0,   14,    4 } },
+  { PimCmdEnum::AND_SCALAR,   {    1,    0,    0,    0 } }, // copy input or C0
+  { PimCmdEnum::OR_SCALAR,    {    1,    0,    0,    0 } }, // copy input or C1
+  { PimCmdEnum::XOR_SCALAR,   {    2,    0,    0,    0 } }, // copy input or NOT input
+  { PimCmdEnum::XNOR_SCALAR,  {    2,    0,    0,    0 } },
+  { PimCmdEnum::GT_SCALAR,    {    3,    1,    0,    0 } },
+  { PimCmdEnum::LT_SCALAR,    {    3,    1,    0,    0 } },
+  { PimCmdEnum::EQ_SCALAR,    {    4,    0,    0,    0 } },
+  { PimCmdEnum::MIN_SCALAR,   {    8,    2,    0,    0 } },
+  { PimCmdEnum::MAX_SCALAR,   {    8,    2,    0,    0 } },
+  { PimCmdEnum::SCALED_ADD,   {    9,    2,    2,    1 } }, // MUL_SCALAR + ADD
 };
 
+//! @brief  Skip whitespaces of JSON content
+static void skipJsonSpaces(const std::string& content, size_t& pos)
+{
+  while (pos < content.size() && std::isspace(static_cast<unsigned char>(content[pos]))) {
+    ++pos;
+  }
+}
+
+//! @brief  Parse a flat JSON object with string or number values into key-value pairs
+static bool parseFlatJsonObject(const std::string& content, size_t& pos, std::unordered_map<std::string, std::string>& fields)
+{
+  skipJsonSpaces(content, pos);
+  if (pos >= content.size() || content[pos] != '{') {
+    return false;
+  }
+  ++pos;
+  while (true) {
+    skipJsonSpaces(content, pos);
+    if (pos < content.size() && content[pos] == '}') {
+      ++pos;
+      return true;
+    }
+    if (pos >= content.size() || content[pos] != '"') {
+      return false;
+    }
+    size_t keyEnd = content.find('"', pos + 1);
+    if (keyEnd == std::string::npos) {
+      return false;
+    }
+    std::string key = content.substr(pos + 1, keyEnd - pos - 1);
+    pos = keyEnd + 1;
+    skipJsonSpaces(content, pos);
+    if (pos >= content.size() || content[pos] != ':') {
+      return false;
+    }
+    ++pos;
+    skipJsonSpaces(content, pos);
+    std::string value;
+    if (pos < content.size() && content[pos] == '"') {
+      size_t valEnd = content.find('"', pos + 1);
+      if (valEnd == std::string::npos) {
+        return false;
+      }
+      value = content.substr(pos + 1, valEnd - pos - 1);
+      pos = valEnd + 1;
+    } else {
+      while (pos < content.size() && (std::isdigit(static_cast<unsigned char>(content[pos])) || content[pos] == '-')) {
+        value += content[pos++];
+      }
+      if (value.empty()) {
+        return false;
+      }
+    }
+    fields[key] = value;
+    skipJsonSpaces(content, pos);
+    if (pos < content.size() && content[pos] == ',') {
+      ++pos;
+    }
+  }
+}
+
+//! @brief  Parse a non-negative op count that fits in unsigned
+static bool parseOpCount(const std::string& value, unsigned& count)
+{
+  if (value.empty() || value.size() > 10 || value.find_first_not_of("0123456789") != std::string::npos) {
+    return false;
+  }
+  unsigned long long parsed = std::stoull(value);
+  if (parsed > std::numeric_limits<unsigned>::max()) {
+    return false;
+  }
+  count = static_cast<unsigned>(parsed);
+  return true;
+}
+
+//! @brief  Load a JSON perf table generated by bit-serial/bitSerial.out and merge its entries into perfTable
+//!         Format: { "format": "pimeval-bitserial-perf-table", "version": 1, "entries": [
+//!           { "device": "PIM_DEVICE_BITSIMD_V", "data_type": "int8", "cmd": "abs", "num_r": 9, "num_w": 8, "num_l": 34 }, ... ] }
+//!         Returns false without modifying perfTable if the file cannot be used.
+bool
+pimPerfEnergyTables::loadBitsimdPerfTable(const std::string& fileName, bitsimdPerfTableType& perfTable)
+{
+  std::string content;
+  if (!pimUtils::readFileContent(fileName.c_str(), content)) {
+    return false;
+  }
+  size_t pos = content.find("\"version\"");
+  pos = (pos == std::string::npos ? pos : content.find(':', pos));
+  if (pos == std::string::npos || std::atoi(content.c_str() + pos + 1) != bitsimdPerfTableVersion) {
+    std::printf("PIM-Error: Bit-serial perf table %s is not of version %d\n", fileName.c_str(), bitsimdPerfTableVersion);
+    return false;
+  }
+
+  std::unordered_map<std::string, PimDataType> dataTypes;
+  for (int i = PIM_INT8; i <= PIM_FP32; ++i) {
+    dataTypes[pimUtils::pimDataTypeEnumToStr(static_cast<PimDataType>(i))] = static_cast<PimDataType>(i);
+  }
+  std::unordered_map<std::string, PimCmdEnum> cmdTypes;
+  for (int i = static_cast<int>(PimCmdEnum::NOOP); i <= static_cast<int>(PimCmdEnum::ROW_CLONE); ++i) {
+    cmdTypes[pimCmd::getName(static_cast<PimCmdEnum>(i), "")] = static_cast<PimCmdEnum>(i);
+  }
+
+  pos = content.find("\"entries\"");
+  pos = (pos == std::string::npos ? pos : content.find('[', pos));
+  if (pos == std::string::npos) {
+    std::printf("PIM-Error: Missing entries in bit-serial perf table %s\n", fileName.c_str());
+    return false;
+  }
+  ++pos;
+  bitsimdPerfTableType loaded;
+  unsigned numEntries = 0;
+  while (true) {
+    skipJsonSpaces(content, pos);
+    if (pos < content.size() && content[pos] == ']') {
+      break;
+    }
+    std::unordered_map<std::string, std::string> fields;
+    if (!parseFlatJsonObject(content, pos, fields)) {
+      std::printf("PIM-Error: Malformed entry in bit-serial perf table %s\n", fileName.c_str());
+      return false;
+    }
+    PimDeviceEnum deviceType = pimUtils::strToPimDeviceEnum(fields["device"]);
+    auto itType = dataTypes.find(fields["data_type"]);
+    auto itCmd = cmdTypes.find(fields["cmd"]);
+    if (deviceType == PIM_DEVICE_NONE || itType == dataTypes.end() || itCmd == cmdTypes.end()) {
+      std::printf("PIM-Error: Unknown entry %s:%s:%s in bit-serial perf table %s\n", fields["device"].c_str(),
+                  fields["data_type"].c_str(), fields["cmd"].c_str(), fileName.c_str());
+      return false;
+    }
+    unsigned numR = 0, numW = 0, numL = 0;
+    if (!parseOpCount(fields["num_r"], numR) || !parseOpCount(fields["num_w"], numW) || !parseOpCount(fields["num_l"], numL)) {
+      std::printf("PIM-Error: Invalid op counts of entry %s:%s:%s in bit-serial perf table %s\n", fields["device"].c_str(),
+                  fields["data_type"].c_str(), fields["cmd"].c_str(), fileName.c_str());
+      return false;
+    }
+    loaded[deviceType][itType->second][itCmd->second] = std::make_tuple(numR, numW, numL);
+    ++numEntries;
+    skipJsonSpaces(content, pos);
+    if (pos < content.size() && content[pos] == ',') {
+      ++pos;
+    }
+  }
 
+  for (const auto& [deviceType, typeTable] : loaded) {
+    for (const auto& [dataType, cmdTable] : typeTable) {
+      for (const auto& [cmdType, counts] : cmdTable) {
+        perfTable[deviceType][dataType][cmdType] = counts;
+      }
+    }
+  }
+  std::printf("PIM-Info: Loaded %u entries from bit-serial perf table %s\n", numEntries, fileName.c_str());
+  return true;
+}
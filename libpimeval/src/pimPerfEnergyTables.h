@@ -11,13 +11,25 @@
 #include "pimCmd.h"
 #include <unordered_map>
 #include <tuple>
+#include <string>
 
 
 namespace pimPerfEnergyTables
 {
+  typedef std::unordered_map<PimDeviceEnum, std::unordered_map<PimDataType,
+      std::unordered_map<PimCmdEnum, std::tuple<unsigned, unsigned, unsigned>>>> bitsimdPerfTableType;
+
   // Perf-energy table of BitSIMD-V variants
-  extern const std::unordered_map<PimDeviceEnum, std::unordered_map<PimDataType,
-      std::unordered_map<PimCmdEnum, std::tuple<unsigned, unsigned, unsigned>>>> bitsimdPerfTable;
+  extern const bitsimdPerfTableType bitsimdPerfTable;
+
+  // Version of JSON perf tables generated by bit-serial/bitSerial.out
+  constexpr int bitsimdPerfTableVersion = PIMEVAL_BITSERIAL_PERF_TABLE_VERSION;
+
+  // Load a generated JSON perf table and merge its entries into perfTable
+  bool loadBitsimdPerfTable(const std::string& fileName, bitsimdPerfTableType& perfTable);
+
+  // Triple-row-activation op count table of SIMDRAM for integer types
+  extern const std::unordered_map<PimCmdEnum, std::tuple<unsigned, unsigned, unsigned, unsigned>> simdramPerfTable;
 }
 
 #endif
@@ -6,10 +6,13 @@
 
 #include "pimResMgr.h"
 #include "pimDevice.h"
+#include "pimSim.h"
+#include "pimCheckpoint.h"
 #include <cstdio>
 #include <algorithm>
 #include <stdexcept>
 #include <memory>
+#include <unordered_set>
 
 
 //! @brief  Print info of a PIM region
@@ -17,8 +20,8 @@ void
 pimRegion::print(uint64_t regionId) const
 {
   #if defined(DEBUG)
-  std::printf("{ PIM-Region %lld: CoreId = %d, Loc = (%u, %u), Size = (%u, %u) }\n",
-              regionId, m_coreId, m_rowIdx, m_colIdx, m_numAllocRows, m_numAllocCols);
+  std::printf("{ PIM-Region %llu: CoreId = %d, Loc = (%u, %u), Size = (%u, %u) }\n",
+              (unsigned long long)regionId, m_coreId, m_rowIdx, m_colIdx, m_numAllocRows, m_numAllocCols);
   #endif
 }
 
@@ -87,12 +90,17 @@ pimObjInfo::getRegionsOfCore(PimCoreId coreId) const
 //! @brief  pimResMgr ctor
 pimResMgr::pimResMgr(pimDevice* device)
   : m_device(device),
-    m_availObjId(0)
+    m_availObjId(static_cast<PimObjId>(device->getDeviceId()) << s_objIdDeviceShift),
+    m_maxObjId(m_availObjId + ((1 << s_objIdDeviceShift) - 1))
 {
   unsigned numCores = m_device->getNumCores();
   unsigned numRowsPerCore = m_device->getNumRows();
+  m_allocPolicy = pimSim::get()->getAllocPolicy();
+  m_isObjPoolEnabled = pimSim::get()->isObjPoolEnabled();
+  m_coreUsage.reserve(numCores);
   for (unsigned i = 0; i < numCores; ++i) {
-    m_coreUsage[i] = std::make_unique<coreUsage>(numRowsPerCore);
+    m_coreUsage.emplace_back(numRowsPerCore);
+    m_coresByRowsInUse.emplace(0, i);
   }
 }
 
@@ -107,17 +115,25 @@ pimResMgr::pimAlloc(PimAllocEnum allocType, uint64_t numElements, unsigned bitsP
 {
   #if defined(DEBUG)
   std::printf("PIM-Debug: pimResMgr::pimAlloc for %d alloc-type %llu elements %u bits per element %d data-type\n",
-              (int)allocType, numElements, bitsPerElement, (int)dataType);
+              (int)allocType, (unsigned long long)numElements, bitsPerElement, (int)dataType);
   #endif
 
   if (numElements == 0 || bitsPerElement == 0) {
-    std::printf("PIM-Error: Invalid parameters to allocate %llu elements of %u bits\n", numElements, bitsPerElement);
+    std::printf("PIM-Error: Invalid parameters to allocate %llu elements of %u bits\n", (unsigned long long)numElements, bitsPerElement);
     return -1;
   }
 
-  std::vector<PimCoreId> sortedCoreId = getCoreIdsSortedByLeastUsage();
-  pimObjInfo newObj(m_availObjId, dataType, allocType, numElements, bitsPerElement);
-  m_availObjId++;
+  if (!hasAvailObjId()) {
+    return -1;
+  }
+
+  // reuse the layout of a freed object of the same shape
+  PimObjId pooledObjId = allocFromObjPool(std::make_tuple(allocType, numElements, bitsPerElement, -1), dataType, -1);
+  if (pooledObjId >= 0) {
+    return pooledObjId;
+  }
+
+  pimObjInfo newObj(getNewObjId(), dataType, allocType, numElements, bitsPerElement);
 
   unsigned numCores = m_device->getNumCores();
   unsigned numCols = m_device->getNumCols();
@@ -156,29 +172,28 @@ pimResMgr::pimAlloc(PimAllocEnum allocType, uint64_t numElements, unsigned bitsP
 
   if (numRegions > numCores) {
     if (allocType == PIM_ALLOC_V1 || allocType == PIM_ALLOC_H1) {
-      std::printf("PIM-Error: Obj requires %llu regions among %u cores. Abort.\n", numRegions, numCores);
+      std::printf("PIM-Error: Obj requires %llu regions among %u cores. Abort.\n", (unsigned long long)numRegions, numCores);
       return -1;
     } else {
       #if defined(DEBUG)
-      std::printf("PIM-Warning: Obj requires %llu regions among %u cores. Wrapping up is needed.\n", numRegions, numCores);
+      std::printf("PIM-Warning: Obj requires %llu regions among %u cores. Wrapping up is needed.\n", (unsigned long long)numRegions, numCores);
       #endif
     }
   }
 
   // create new regions
   bool success = true;
-  for (unsigned i = 0; i < numCores; ++i) {
-    m_coreUsage.at(i)->newAllocStart();
-  }
+  PimCoreId failedCoreId = -1;
+  std::vector<PimCoreId> sortedCoreId = getCoreIdsSortedByLeastUsage(std::min<uint64_t>(numRegions, numCores));
   if (allocType == PIM_ALLOC_V || allocType == PIM_ALLOC_V1 || allocType == PIM_ALLOC_H || allocType == PIM_ALLOC_H1) {
     uint64_t elemIdx = 0;
     for (uint64_t i = 0; i < numRegions; ++i) {
-      PimCoreId coreId = sortedCoreId[i % numCores];
+      PimCoreId coreId = sortedCoreId[i % sortedCoreId.size()];
       unsigned numColsToAlloc = (i == numRegions - 1 ? numColsToAllocLast : numCols);
       unsigned numElemInRegion = (i == numRegions - 1 ? numElemPerRegionLast : numElemPerRegion);
-      pimRegion newRegion = findAvailRegionOnCore(coreId, numRowsToAlloc, numColsToAlloc);
+      pimRegion newRegion = allocRegionOnCore(coreId, numRowsToAlloc, numColsToAlloc);
       if (!newRegion.isValid()) {
-        std::printf("PIM-Error: Failed to allocate object with %u rows on core %d\n", numRowsToAlloc, coreId);
+        failedCoreId = coreId;
         success = false;
         break;
       }
@@ -187,32 +202,42 @@ pimResMgr::pimAlloc(PimAllocEnum allocType, uint64_t numElements, unsigned bitsP
       newRegion.setElemIdxEnd(elemIdx); // exclusive
       newRegion.setNumColsPerElem(numColsPerElem);
       newObj.addRegion(newRegion);
-
-      // add to core usage map
-      auto alloc = std::make_pair(newRegion.getRowIdx(), numRowsToAlloc);
-      m_coreUsage.at(coreId)->addRange(alloc, newObj.getObjId());
     }
   }
-  for (unsigned i = 0; i < numCores; ++i) {
-    m_coreUsage.at(i)->newAllocEnd(success); // rollback if failed
-  }
 
   if (!success) {
+    // rollback, and retry after reclaiming rows of pooled objects and fragmented cores
+    for (const pimRegion& region : newObj.getRegions()) {
+      freeRegion(region);
+    }
+    if (reclaimRows()) {
+      if (m_isObjPoolEnabled) {
+        m_numObjPoolMisses--; // counted once per allocation
+      }
+      return pimAlloc(allocType, numElements, bitsPerElement, dataType);
+    }
+    std::printf("PIM-Error: Failed to allocate object with %u rows on core %d\n", numRowsToAlloc, failedCoreId);
     return -1;
   }
+  // materialize cores only after all regions are allocated, so that a failed allocation leaves no memory behind
+  for (const pimRegion& region : newObj.getRegions()) {
+    m_device->materializeCore(region.getCoreId());
+  }
 
   PimObjId objId = -1;
   if (newObj.isValid()) {
     objId = newObj.getObjId();
     newObj.finalize();
     newObj.print();
+    m_numObjsAllocated++;
+    m_numRegionsAllocated += newObj.getRegions().size();
     // update new object to resource mgr
     m_objMap.insert(std::make_pair(newObj.getObjId(), newObj));
   }
 
   #if defined(DEBUG)
   std::printf("PIM-Debug: pimResMgr::pimAlloc allocated new object %d with %llu regions\n",
-              objId, newObj.getRegions().size());
+              objId, (unsigned long long)newObj.getRegions().size());
   #endif
   return objId;
 }
@@ -235,7 +260,6 @@ pimResMgr::pimAllocAssociated(unsigned bitsPerElement, PimObjId assocId, PimData
   }
 
   // get regions of the assoc obj
-  unsigned numCores = m_device->getNumCores();
   const pimObjInfo& assocObj = m_objMap.at(assocId);
 
   // check if the request can be associated with ref
@@ -250,24 +274,34 @@ pimResMgr::pimAllocAssociated(unsigned bitsPerElement, PimObjId assocId, PimData
   }
   assert(allocType == assocObj.getAllocType());
 
+  if (!hasAvailObjId()) {
+    return -1;
+  }
+
+  // reuse the layout of a freed object associated with the same object
+  PimObjId pooledObjId = allocFromObjPool(std::make_tuple(allocType, numElements, bitsPerElement, getObjPoolAnchor(assocObj.getAssocObjId())),
+                                          dataType, assocObj.getAssocObjId());
+  if (pooledObjId >= 0) {
+    return pooledObjId;
+  }
+
   // allocate associated regions
-  pimObjInfo newObj(m_availObjId, dataType, allocType, numElements, bitsPerElement);
-  m_availObjId++;
+  pimObjInfo newObj(getNewObjId(), dataType, allocType, numElements, bitsPerElement);
 
   bool success = true;
-  for (unsigned i = 0; i < numCores; ++i) {
-    m_coreUsage.at(i)->newAllocStart();
-  }
-  for ( const pimRegion& region : assocObj.getRegions()) {
+  PimCoreId failedCoreId = -1;
+  unsigned failedNumRows = 0;
+  for (const pimRegion& region : assocObj.getRegions()) {
     PimCoreId coreId = region.getCoreId();
     unsigned numAllocRows = region.getNumAllocRows();
     unsigned numAllocCols = region.getNumAllocCols();
     if (allocType == PIM_ALLOC_V || allocType == PIM_ALLOC_V1) {
       numAllocRows = bitsPerElement;
     }
-    pimRegion newRegion = findAvailRegionOnCore(coreId, numAllocRows, numAllocCols);
+    pimRegion newRegion = allocRegionOnCore(coreId, numAllocRows, numAllocCols);
     if (!newRegion.isValid()) {
-      std::printf("PIM-Error: Failed to allocate associated object with %u rows on core %d\n", numAllocRows, coreId);
+      failedCoreId = coreId;
+      failedNumRows = numAllocRows;
       success = false;
       break;
     }
@@ -275,18 +309,25 @@ pimResMgr::pimAllocAssociated(unsigned bitsPerElement, PimObjId assocId, PimData
     newRegion.setElemIdxEnd(region.getElemIdxEnd()); // exclusive
     newRegion.setNumColsPerElem(region.getNumColsPerElem());
     newObj.addRegion(newRegion);
-
-    // add to core usage map
-    auto alloc = std::make_pair(newRegion.getRowIdx(), numAllocRows);
-    m_coreUsage.at(coreId)->addRange(alloc, newObj.getObjId());
-  }
-  for (unsigned i = 0; i < numCores; ++i) {
-    m_coreUsage.at(i)->newAllocEnd(success); // rollback if failed
   }
 
   if (!success) {
+    // rollback, and retry after reclaiming rows of pooled objects and fragmented cores
+    for (const pimRegion& region : newObj.getRegions()) {
+      freeRegion(region);
+    }
+    if (reclaimRows()) {
+      if (m_isObjPoolEnabled) {
+        m_numObjPoolMisses--; // counted once per allocation
+      }
+      return pimAllocAssociated(bitsPerElement, assocId, dataType);
+    }
+    std::printf("PIM-Error: Failed to allocate associated object with %u rows on core %d\n", failedNumRows, failedCoreId);
     return -1;
   }
+  for (const pimRegion& region : newObj.getRegions()) {
+    m_device->materializeCore(region.getCoreId());
+  }
 
   PimObjId objId = -1;
   if (newObj.isValid()) {
@@ -294,13 +335,16 @@ pimResMgr::pimAllocAssociated(unsigned bitsPerElement, PimObjId assocId, PimData
     newObj.finalize();
     newObj.print();
     newObj.setAssocObjId(assocObj.getAssocObjId());
+    useRangedRefAssoc(newObj.getAssocObjId());
+    m_numObjsAllocated++;
+    m_numRegionsAllocated += newObj.getRegions().size();
     // update new object to resource mgr
     m_objMap.insert(std::make_pair(newObj.getObjId(), newObj));
   }
 
   #if defined(DEBUG)
   std::printf("PIM-Debug: pimResMgr::pimAllocAssociated allocated new object %d with %llu regions\n",
-              objId, newObj.getRegions().size());
+              objId, (unsigned long long)newObj.getRegions().size());
   #endif
   return objId;
 }
@@ -313,21 +357,43 @@ pimResMgr::pimFree(PimObjId objId)
     std::printf("PIM-Error: Cannot free non-exist object ID %d\n", objId);
     return false;
   }
-  unsigned numCores = m_device->getNumCores();
   const pimObjInfo& obj = m_objMap.at(objId);
 
-  if (!obj.isDualContactRef()) {
-    for (unsigned i = 0; i < numCores; ++i) {
-      m_coreUsage.at(i)->deleteObj(objId);
+  releaseRangedRefAssoc(obj.getAssocObjId());
+
+  PimObjId rootId = obj.getRefObjId();
+  if (rootId >= 0) {
+    // a reference does not own any rows
+    auto it = m_refMap.find(rootId);
+    if (it != m_refMap.end()) {
+      it->second.erase(objId);
+    }
+    m_objMap.erase(objId);
+  } else if (m_isObjPoolEnabled) {
+    // keep the rows and region layout for reuse by a later allocation of the same shape
+    PimObjId anchor = (obj.getAssocObjId() == objId ? -1 : getObjPoolAnchor(obj.getAssocObjId()));
+    objPoolKey key = std::make_tuple(obj.getAllocType(), obj.getNumElements(), obj.getBitsPerElement(), anchor);
+    auto it = m_objMap.find(objId);
+    m_objPool[key].push_back(std::move(it->second));
+    m_numPooledObjs++;
+    m_objMap.erase(it);
+  } else {
+    for (const pimRegion& region : obj.getRegions()) {
+      freeRegion(region);
     }
+    m_objMap.erase(objId);
   }
-  m_objMap.erase(objId);
 
   // free all reference as well
   if (m_refMap.find(objId) != m_refMap.end()) {
     for (auto refId : m_refMap.at(objId)) {
-      m_objMap.erase(refId);
+      auto it = m_objMap.find(refId);
+      if (it != m_objMap.end()) {
+        releaseRangedRefAssoc(it->second.getAssocObjId());
+        m_objMap.erase(it);
+      }
     }
+    m_refMap.erase(objId);
   }
 
   return true;
@@ -337,8 +403,108 @@ pimResMgr::pimFree(PimObjId objId)
 PimObjId
 pimResMgr::pimCreateRangedRef(PimObjId refId, uint64_t idxBegin, uint64_t idxEnd)
 {
-  assert(0); // todo
-  return -1;
+  // check if ref obj is valid
+  if (m_objMap.find(refId) == m_objMap.end()) {
+    std::printf("PIM-Error: Invalid ref object ID %d for PIM ranged ref\n", refId);
+    return -1;
+  }
+
+  const pimObjInfo& refObj = m_objMap.at(refId);
+  if (idxBegin >= idxEnd || idxEnd > refObj.getNumElements()) {
+    std::printf("PIM-Error: Invalid range [%llu, %llu) for PIM ranged ref of object %d with %llu elements\n",
+                (unsigned long long)idxBegin, (unsigned long long)idxEnd, refId, (unsigned long long)refObj.getNumElements());
+    return -1;
+  }
+
+  if (!hasAvailObjId()) {
+    return -1;
+  }
+
+  // The ranged ref is a view of the ref object without data movement.
+  // Its regions are the sub-regions of the ref object overlapping with the range, with element
+  // indices rebased to the beginning of the range. The refObjId field points to the root object.
+  PimObjId objId = getNewObjId();
+  pimObjInfo newObj(objId, refObj.getDataType(), refObj.getAllocType(), idxEnd - idxBegin, refObj.getBitsPerElement());
+  for (const pimRegion& region : refObj.getRegions()) {
+    uint64_t elemBegin = std::max(region.getElemIdxBegin(), idxBegin);
+    uint64_t elemEnd = std::min(region.getElemIdxEnd(), idxEnd);
+    if (elemBegin >= elemEnd) {
+      continue;
+    }
+    unsigned numColsPerElem = region.getNumColsPerElem();
+    pimRegion newRegion = region;
+    newRegion.setColIdx(region.getColIdx() + (elemBegin - region.getElemIdxBegin()) * numColsPerElem);
+    newRegion.setNumAllocCols((elemEnd - elemBegin) * numColsPerElem);
+    newRegion.setElemIdxBegin(elemBegin - idxBegin);
+    newRegion.setElemIdxEnd(elemEnd - idxBegin); // exclusive
+    newObj.addRegion(newRegion);
+  }
+  newObj.finalize();
+
+  PimObjId rootId = refObj.getRefObjId() >= 0 ? refObj.getRefObjId() : refObj.getObjId();
+  newObj.setRefObjId(rootId);
+  newObj.setIsDualContactRef(refObj.isDualContactRef());
+  m_refMap[rootId].insert(objId);
+
+  // Views of the same range of associated objects have identical regions, so they are associated
+  auto key = std::make_tuple(refObj.getAssocObjId(), idxBegin, idxEnd);
+  auto it = m_rangedRefAssocIds.find(key);
+  if (it == m_rangedRefAssocIds.end()) {
+    it = m_rangedRefAssocIds.emplace(key, objId).first;
+    m_rangedRefAssocUses.emplace(objId, std::make_pair(key, 0u));
+  }
+  newObj.setAssocObjId(it->second);
+  useRangedRefAssoc(it->second);
+  m_objMap.insert(std::make_pair(objId, newObj));
+
+  #if defined(DEBUG)
+  std::printf("PIM-Debug: pimResMgr::pimCreateRangedRef created object %d of range [%llu, %llu) of object %d with %llu regions\n",
+              objId, (unsigned long long)idxBegin, (unsigned long long)idxEnd, refId, (unsigned long long)newObj.getRegions().size());
+  #endif
+  return objId;
+}
+
+//! @brief  Count a live object associated by a ranged ref range, i.e., a view of the range or an object allocated
+//!         associated with one. Other association IDs are ignored
+void
+pimResMgr::useRangedRefAssoc(PimObjId assocId)
+{
+  auto it = m_rangedRefAssocUses.find(assocId);
+  if (it != m_rangedRefAssocUses.end()) {
+    it->second.second++;
+  }
+}
+
+//! @brief  Release a freed object associated by a ranged ref range. The range is forgotten with its last object
+void
+pimResMgr::releaseRangedRefAssoc(PimObjId assocId)
+{
+  auto it = m_rangedRefAssocUses.find(assocId);
+  if (it != m_rangedRefAssocUses.end() && --it->second.second == 0) {
+    m_rangedRefAssocIds.erase(it->second.first);
+    m_rangedRefAssocUses.erase(it);
+  }
+}
+
+//! @brief  Count live objects of each ranged ref range, and forget ranges without any
+void
+pimResMgr::rebuildRangedRefAssocUses()
+{
+  m_rangedRefAssocUses.clear();
+  for (const auto& [key, assocId] : m_rangedRefAssocIds) {
+    m_rangedRefAssocUses.emplace(assocId, std::make_pair(key, 0u));
+  }
+  for (const auto& it : m_objMap) {
+    useRangedRefAssoc(it.second.getAssocObjId());
+  }
+  for (auto it = m_rangedRefAssocUses.begin(); it != m_rangedRefAssocUses.end();) {
+    if (it->second.second == 0) {
+      m_rangedRefAssocIds.erase(it->second.first);
+      it = m_rangedRefAssocUses.erase(it);
+    } else {
+      ++it;
+    }
+  }
 }
 
 //! @brief  Create an obj referencing to negation of an existing obj based on dual-contact memory cells
@@ -357,23 +523,530 @@ pimResMgr::pimCreateDualContactRef(PimObjId refId)
     return -1;
   }
 
+  if (!hasAvailObjId()) {
+    return -1;
+  }
+
   // The dual-contact ref has exactly same regions as the ref object.
   // The refObjId field points to the ref object.
   // The isDualContactRef field indicates that values need to be negated during read/write.
+  // The refObjId field points to the root object if the ref object is a ranged ref.
   pimObjInfo newObj = refObj;
-  PimObjId objId = m_availObjId++;
+  PimObjId objId = getNewObjId();
+  PimObjId rootId = refObj.getRefObjId() >= 0 ? refObj.getRefObjId() : refObj.getObjId();
   newObj.setObjId(objId);
-  newObj.setRefObjId(refObj.getObjId());
-  m_refMap[refObj.getObjId()].insert(objId);
+  newObj.setRefObjId(rootId);
+  m_refMap[rootId].insert(objId);
   newObj.setIsDualContactRef(true);
+  useRangedRefAssoc(newObj.getAssocObjId());
   m_objMap.insert(std::make_pair(newObj.getObjId(), newObj));
 
   return objId;
 }
 
-//! @brief  Alloc resource on a specific core. Perform row allocation for now.
+//! @brief  Check if there are object IDs left in the ID range of the device, recycling IDs of freed objects
+//!         after fresh IDs run out
+bool
+pimResMgr::hasAvailObjId()
+{
+  if (m_availObjId > m_maxObjId && m_recycledObjIdRanges.empty() && !recycleObjIds()) {
+    std::printf("PIM-Error: Out of PIM object IDs on device %d\n", m_device->getDeviceId());
+    return false;
+  }
+  return true;
+}
+
+//! @brief  Get a new object ID. Fresh IDs are used first, and then IDs recycled from freed objects
+PimObjId
+pimResMgr::getNewObjId()
+{
+  if (m_availObjId <= m_maxObjId) {
+    return m_availObjId++;
+  }
+  assert(!m_recycledObjIdRanges.empty());
+  std::pair<PimObjId, PimObjId>& range = m_recycledObjIdRanges.back();
+  PimObjId objId = range.first++;
+  if (range.first == range.second) {
+    m_recycledObjIdRanges.pop_back();
+  }
+  return objId;
+}
+
+//! @brief  Collect IDs of freed objects for reuse. Pooled objects are released first, so that an ID is recycled
+//!         only when no live object refers to it as its own, association or reference ID. Return false if none
+bool
+pimResMgr::recycleObjIds()
+{
+  trimObjPool();
+  m_objPoolAnchorAlias.clear();
+
+  PimObjId minObjId = static_cast<PimObjId>(m_device->getDeviceId()) << s_objIdDeviceShift;
+  std::vector<bool> isInUse(static_cast<size_t>(m_maxObjId - minObjId) + 1, false);
+  // association IDs of ranged ref ranges are kept only while objects associated with them are alive
+  for (const auto& it : m_objMap) {
+    const pimObjInfo& obj = it.second;
+    isInUse[obj.getObjId() - minObjId] = true;
+    isInUse[obj.getAssocObjId() - minObjId] = true;
+    if (obj.getRefObjId() >= 0) {
+      isInUse[obj.getRefObjId() - minObjId] = true;
+    }
+  }
+
+  // keep ranges of unused IDs in descending order, so that lower IDs are used first
+  m_recycledObjIdRanges.clear();
+  uint64_t numRecycled = 0;
+  PimObjId rangeEnd = m_maxObjId + 1;
+  for (PimObjId objId = m_maxObjId; objId >= minObjId - 1; --objId) {
+    if (objId >= minObjId && !isInUse[objId - minObjId]) {
+      continue;
+    }
+    if (objId + 1 < rangeEnd) {
+      m_recycledObjIdRanges.emplace_back(objId + 1, rangeEnd);
+      numRecycled += rangeEnd - objId - 1;
+    }
+    rangeEnd = objId;
+  }
+  std::printf("PIM-Info: Recycled %llu PIM object IDs of freed objects on device %d\n", (unsigned long long)numRecycled,
+              m_device->getDeviceId());
+  return !m_recycledObjIdRanges.empty();
+}
+
+//! @brief  Allocate an object from the pool of freed objects with the same shape. Return -1 if not found
+PimObjId
+pimResMgr::allocFromObjPool(const objPoolKey& key, PimDataType dataType, PimObjId assocObjId)
+{
+  if (!m_isObjPoolEnabled) {
+    return -1;
+  }
+  auto it = m_objPool.find(key);
+  if (it == m_objPool.end()) {
+    m_numObjPoolMisses++;
+    return -1;
+  }
+  pimObjInfo obj = std::move(it->second.back());
+  it->second.pop_back();
+  if (it->second.empty()) {
+    m_objPool.erase(it);
+  }
+  m_numPooledObjs--;
+  m_numObjPoolHits++;
+
+  PimObjId objId = getNewObjId();
+  PimObjId prevObjId = obj.getObjId();
+  obj.setObjId(objId);
+  obj.setDataType(dataType);
+  obj.setAssocObjId(assocObjId >= 0 ? assocObjId : objId);
+  useRangedRefAssoc(obj.getAssocObjId());
+  m_numObjsAllocated++;
+  m_objMap.emplace(objId, std::move(obj));
+
+  // a reused root keeps its region layout, so pooled objects associated with its previous ID match the new ID
+  if (assocObjId < 0) {
+    m_objPoolAnchorAlias[prevObjId] = objId;
+    std::vector<objPoolKey> keys;
+    for (const auto& poolIt : m_objPool) {
+      if (std::get<3>(poolIt.first) == prevObjId) {
+        keys.push_back(poolIt.first);
+      }
+    }
+    for (const objPoolKey& prevKey : keys) {
+      objPoolKey newKey = std::make_tuple(std::get<0>(prevKey), std::get<1>(prevKey), std::get<2>(prevKey), objId);
+      std::vector<pimObjInfo>& objs = m_objPool[newKey];
+      for (pimObjInfo& pooledObj : m_objPool[prevKey]) {
+        objs.push_back(std::move(pooledObj));
+      }
+      m_objPool.erase(prevKey);
+    }
+  }
+
+  #if defined(DEBUG)
+  std::printf("PIM-Debug: pimResMgr reused a pooled object as object %d\n", objId);
+  #endif
+  return objId;
+}
+
+//! @brief  Get the pool anchor of objects associated with an object ID, following reuses of pooled root objects
+PimObjId
+pimResMgr::getObjPoolAnchor(PimObjId assocObjId) const
+{
+  auto it = m_objPoolAnchorAlias.find(assocObjId);
+  while (it != m_objPoolAnchorAlias.end()) {
+    assocObjId = it->second;
+    it = m_objPoolAnchorAlias.find(assocObjId);
+  }
+  return assocObjId;
+}
+
+//! @brief  Release all pooled objects
+void
+pimResMgr::trimObjPool()
+{
+  for (const auto& it : m_objPool) {
+    for (const pimObjInfo& obj : it.second) {
+      for (const pimRegion& region : obj.getRegions()) {
+        freeRegion(region);
+      }
+    }
+  }
+  m_objPool.clear();
+  m_numPooledObjs = 0;
+}
+
+//! @brief  Move live rows of each fragmented core towards row 0, so that its free rows form one range.
+//!         Pooled objects are released first. Rows are copied within the core with RowClone, and region
+//!         row indices of moved objects and their references are rewritten. Cost is recorded as row_clone.
+void
+pimResMgr::compact()
+{
+  auto wallBegin = std::chrono::steady_clock::now();
+  trimObjPool();
+
+  // collect row ranges owned by live objects on each fragmented core
+  unsigned numCores = m_coreUsage.size();
+  std::vector<std::vector<std::pair<unsigned, unsigned>>> coreRanges(numCores); // (row index, number of rows)
+  for (const auto& it : m_objMap) {
+    if (it.second.getRefObjId() >= 0) {
+      continue;
+    }
+    for (const pimRegion& region : it.second.getRegions()) {
+      PimCoreId coreId = region.getCoreId();
+      if (m_coreUsage[coreId].isFragmented()) {
+        coreRanges[coreId].emplace_back(region.getRowIdx(), region.getNumAllocRows());
+      }
+    }
+  }
+
+  // slide row ranges down in row order, which never overwrites rows not moved yet
+  std::vector<std::unordered_map<unsigned, unsigned>> newRowIdxs(numCores); // old row index -> new row index
+  unsigned maxRowsMovedPerCore = 0;
+  uint64_t totRowsMoved = 0;
+  for (PimCoreId coreId = 0; coreId < static_cast<PimCoreId>(numCores); ++coreId) {
+    if (!m_coreUsage[coreId].isFragmented()) {
+      continue;
+    }
+    std::vector<std::pair<unsigned, unsigned>>& ranges = coreRanges[coreId];
+    std::sort(ranges.begin(), ranges.end());
+    unsigned numRowsMoved = 0;
+    unsigned cursor = 0;
+    for (const auto& [rowIdx, numRows] : ranges) {
+      if (rowIdx != cursor) {
+        assert(cursor < rowIdx);
+        if (!m_device->isPerfOnly()) {
+          pimCore& core = m_device->getCore(coreId);
+          unsigned numWordsPerRow = core.getNumWordsPerRow();
+          for (unsigned i = 0; i < numRows; ++i) {
+            const uint64_t* src = core.getRowWords(rowIdx + i);
+            std::copy(src, src + numWordsPerRow, core.getRowWords(cursor + i));
+          }
+        }
+        newRowIdxs[coreId][rowIdx] = cursor;
+        numRowsMoved += numRows;
+      }
+      cursor += numRows;
+    }
+    m_coreUsage[coreId].resetFreeRanges();
+    maxRowsMovedPerCore = std::max(maxRowsMovedPerCore, numRowsMoved);
+    totRowsMoved += numRowsMoved;
+  }
+  if (totRowsMoved == 0) {
+    return;
+  }
+
+  // rewrite regions of moved objects and their references
+  for (auto& it : m_objMap) {
+    pimObjInfo& obj = it.second;
+    const std::vector<pimRegion>& regions = obj.getRegions();
+    for (size_t i = 0; i < regions.size(); ++i) {
+      const auto& rowMap = newRowIdxs[regions[i].getCoreId()];
+      auto rowIt = rowMap.find(regions[i].getRowIdx());
+      if (rowIt != rowMap.end()) {
+        obj.setRegionRowIdx(i, rowIt->second);
+      }
+    }
+  }
+
+  m_numCompactions++;
+  m_numRowsCompacted += totRowsMoved;
+  pimeval::perfEnergy mPerfEnergy = m_device->getPerfEnergyModel()->getPerfEnergyForRowClone(maxRowsMovedPerCore, totRowsMoved);
+  m_device->getStatsMgr()->recordCmd(PimCmdEnum::ROW_CLONE, mPerfEnergy);
+  pimResourceTimeline& timeline = m_device->getPerfEnergyModel()->getResourceTimeline();
+  double msStart = timeline.scheduleCmd({}, {}, {}, mPerfEnergy.m_msRuntime);
+  if (pimDramTraceWriter* dramTraceWriter = m_device->getDramTraceWriter()) {
+    dramTraceWriter->recordCmd(PimCmdEnum::ROW_CLONE, {}, mPerfEnergy, msStart, timeline.getMsEarliestStart());
+  }
+  if (pimTimelineWriter* timelineWriter = m_device->getTimelineWriter()) {
+    // compaction occupies all cores, so it is on the tracks of core 0
+    timelineWriter->recordCmd(m_device->getDeviceId(), pimCmd::getName(PimCmdEnum::ROW_CLONE, ""), false, 0, {}, totRowsMoved,
+                              msStart, mPerfEnergy.m_msRuntime, mPerfEnergy.m_mjEnergy, wallBegin, std::chrono::steady_clock::now());
+  }
+
+  #if defined(DEBUG)
+  std::printf("PIM-Debug: pimResMgr::compact moved %llu rows, max %u rows per core\n", (unsigned long long)totRowsMoved, maxRowsMovedPerCore);
+  #endif
+}
+
+//! @brief  Reclaim rows after an allocation failure, in stages for each retry: release pooled objects first,
+//!         then compact fragmented cores. Return false if there is nothing left to reclaim
+bool
+pimResMgr::reclaimRows()
+{
+  if (m_numPooledObjs > 0) {
+    trimObjPool();
+    return true;
+  }
+  for (const coreUsage& usage : m_coreUsage) {
+    if (usage.isFragmented()) {
+      compact();
+      return true;
+    }
+  }
+  return false;
+}
+
+//! @brief  Save meta data of a PIM object into a checkpoint
+static void
+saveObjInfo(pimCheckpointWriter& writer, const pimObjInfo& obj)
+{
+  writer.write(obj.getObjId());
+  writer.write(obj.getAssocObjId());
+  writer.write(obj.getRefObjId());
+  writer.write(static_cast<int32_t>(obj.getDataType()));
+  writer.write(static_cast<int32_t>(obj.getAllocType()));
+  writer.write(obj.getNumElements());
+  writer.write(obj.getBitsPerElement());
+  writer.write(static_cast<uint8_t>(obj.isDualContactRef()));
+  writer.write(static_cast<uint64_t>(obj.getRegions().size()));
+  for (const pimRegion& region : obj.getRegions()) {
+    writer.write(region.getCoreId());
+    writer.write(region.getRowIdx());
+    writer.write(region.getColIdx());
+    writer.write(region.getNumAllocRows());
+    writer.write(region.getNumAllocCols());
+    writer.write(region.getElemIdxBegin());
+    writer.write(region.getElemIdxEnd());
+    writer.write(region.getNumColsPerElem());
+  }
+}
+
+//! @brief  Load meta data of a PIM object from a checkpoint, and check its regions against device dimensions.
+//!         Return nullptr if failed
+static std::unique_ptr<pimObjInfo>
+loadObjInfo(pimCheckpointReader& reader, const pimDevice* device)
+{
+  PimObjId objId = -1, assocObjId = -1, refObjId = -1;
+  int32_t dataType = 0, allocType = 0;
+  uint64_t numElements = 0, numRegions = 0;
+  unsigned bitsPerElement = 0;
+  uint8_t isDualContactRef = 0;
+  if (!reader.read(objId) || !reader.read(assocObjId) || !reader.read(refObjId) || !reader.read(dataType) ||
+      !reader.read(allocType) || !reader.read(numElements) || !reader.read(bitsPerElement) ||
+      !reader.read(isDualContactRef) || !reader.read(numRegions) || numRegions == 0) {
+    return nullptr;
+  }
+  auto obj = std::make_unique<pimObjInfo>(objId, static_cast<PimDataType>(dataType), static_cast<PimAllocEnum>(allocType),
+                                     numElements, bitsPerElement);
+  for (uint64_t i = 0; i < numRegions; ++i) {
+    PimCoreId coreId = -1;
+    unsigned rowIdx = 0, colIdx = 0, numAllocRows = 0, numAllocCols = 0, numColsPerElem = 0;
+    uint64_t elemIdxBegin = 0, elemIdxEnd = 0;
+    if (!reader.read(coreId) || !reader.read(rowIdx) || !reader.read(colIdx) || !reader.read(numAllocRows) ||
+        !reader.read(numAllocCols) || !reader.read(elemIdxBegin) || !reader.read(elemIdxEnd) || !reader.read(numColsPerElem)) {
+      return nullptr;
+    }
+    if (coreId < 0 || static_cast<unsigned>(coreId) >= device->getNumCores() ||
+        (uint64_t)rowIdx + numAllocRows > device->getNumRows() || (uint64_t)colIdx + numAllocCols > device->getNumCols()) {
+      return nullptr;
+    }
+    pimRegion region;
+    region.setCoreId(coreId);
+    region.setRowIdx(rowIdx);
+    region.setColIdx(colIdx);
+    region.setNumAllocRows(numAllocRows);
+    region.setNumAllocCols(numAllocCols);
+    region.setElemIdxBegin(elemIdxBegin);
+    region.setElemIdxEnd(elemIdxEnd);
+    region.setNumColsPerElem(numColsPerElem);
+    region.setIsValid(true);
+    obj->addRegion(region);
+  }
+  obj->finalize();
+  obj->setAssocObjId(assocObjId);
+  obj->setRefObjId(refObjId);
+  obj->setIsDualContactRef(isDualContactRef != 0);
+  return obj;
+}
+
+//! @brief  Save objects, object pool, references and row usage of all cores into a checkpoint
+void
+pimResMgr::saveCheckpoint(pimCheckpointWriter& writer) const
+{
+  writer.writeSection(PimCheckpointSection::RES_MGR);
+  writer.write(m_availObjId);
+  writer.write(m_numObjsAllocated);
+  writer.write(m_numRegionsAllocated);
+  writer.write(m_numObjPoolHits);
+  writer.write(m_numObjPoolMisses);
+  writer.write(m_numCompactions);
+  writer.write(m_numRowsCompacted);
+
+  writer.write(static_cast<uint32_t>(m_coreUsage.size()));
+  for (const coreUsage& usage : m_coreUsage) {
+    usage.saveCheckpoint(writer);
+  }
+
+  // sort by ID for a deterministic checkpoint
+  std::vector<PimObjId> objIds;
+  objIds.reserve(m_objMap.size());
+  for (const auto& it : m_objMap) {
+    objIds.push_back(it.first);
+  }
+  std::sort(objIds.begin(), objIds.end());
+  writer.write(static_cast<uint64_t>(objIds.size()));
+  for (PimObjId objId : objIds) {
+    saveObjInfo(writer, m_objMap.at(objId));
+  }
+
+  writer.write(static_cast<uint64_t>(m_objPool.size()));
+  for (const auto& [key, objs] : m_objPool) {
+    writer.write(static_cast<int32_t>(std::get<0>(key)));
+    writer.write(std::get<1>(key));
+    writer.write(std::get<2>(key));
+    writer.write(std::get<3>(key));
+    writer.write(static_cast<uint64_t>(objs.size()));
+    for (const pimObjInfo& obj : objs) {
+      saveObjInfo(writer, obj);
+    }
+  }
+
+  std::map<PimObjId, const std::set<PimObjId>*> refMap;
+  for (const auto& it : m_refMap) {
+    refMap.emplace(it.first, &it.second);
+  }
+  writer.write(static_cast<uint64_t>(refMap.size()));
+  for (const auto& [rootId, refIds] : refMap) {
+    writer.write(rootId);
+    writer.write(static_cast<uint64_t>(refIds->size()));
+    for (PimObjId refId : *refIds) {
+      writer.write(refId);
+    }
+  }
+
+  writer.write(static_cast<uint64_t>(m_rangedRefAssocIds.size()));
+  for (const auto& [key, assocId] : m_rangedRefAssocIds) {
+    writer.write(std::get<0>(key));
+    writer.write(std::get<1>(key));
+    writer.write(std::get<2>(key));
+    writer.write(assocId);
+  }
+}
+
+//! @brief  Restore objects, object pool, references and row usage of all cores from a checkpoint
+bool
+pimResMgr::loadCheckpoint(pimCheckpointReader& reader)
+{
+  PimObjId availObjId = 0;
+  uint32_t numCores = 0;
+  if (!reader.readSection(PimCheckpointSection::RES_MGR) || !reader.read(availObjId) ||
+      !reader.read(m_numObjsAllocated) || !reader.read(m_numRegionsAllocated) || !reader.read(m_numObjPoolHits) ||
+      !reader.read(m_numObjPoolMisses) || !reader.read(m_numCompactions) || !reader.read(m_numRowsCompacted) ||
+      !reader.read(numCores) || numCores != m_coreUsage.size()) {
+    return false;
+  }
+  if (pimResMgr::getDeviceIdOfObj(availObjId) != m_device->getDeviceId() && availObjId != m_maxObjId + 1) {
+    return false;
+  }
+  m_availObjId = availObjId;
+  m_recycledObjIdRanges.clear();
+
+  m_coresByRowsInUse.clear();
+  for (PimCoreId coreId = 0; coreId < static_cast<PimCoreId>(numCores); ++coreId) {
+    if (!m_coreUsage[coreId].loadCheckpoint(reader)) {
+      return false;
+    }
+    m_coresByRowsInUse.emplace(m_coreUsage[coreId].getTotRowsInUse(), coreId);
+  }
+
+  m_objMap.clear();
+  uint64_t numObjs = 0;
+  if (!reader.read(numObjs)) {
+    return false;
+  }
+  for (uint64_t i = 0; i < numObjs; ++i) {
+    std::unique_ptr<pimObjInfo> obj = loadObjInfo(reader, m_device);
+    if (!obj) {
+      return false;
+    }
+    PimObjId objId = obj->getObjId();
+    m_objMap.emplace(objId, std::move(*obj));
+  }
+
+  m_objPool.clear();
+  m_numPooledObjs = 0;
+  uint64_t numKeys = 0;
+  if (!reader.read(numKeys)) {
+    return false;
+  }
+  for (uint64_t i = 0; i < numKeys; ++i) {
+    int32_t allocType = 0;
+    uint64_t numElements = 0, numPooled = 0;
+    unsigned bitsPerElement = 0;
+    PimObjId anchor = -1;
+    if (!reader.read(allocType) || !reader.read(numElements) || !reader.read(bitsPerElement) ||
+        !reader.read(anchor) || !reader.read(numPooled)) {
+      return false;
+    }
+    std::vector<pimObjInfo>& objs = m_objPool[std::make_tuple(static_cast<PimAllocEnum>(allocType), numElements, bitsPerElement, anchor)];
+    for (uint64_t j = 0; j < numPooled; ++j) {
+      std::unique_ptr<pimObjInfo> obj = loadObjInfo(reader, m_device);
+      if (!obj) {
+        return false;
+      }
+      objs.push_back(std::move(*obj));
+      m_numPooledObjs++;
+    }
+  }
+
+  m_refMap.clear();
+  uint64_t numRoots = 0;
+  if (!reader.read(numRoots)) {
+    return false;
+  }
+  for (uint64_t i = 0; i < numRoots; ++i) {
+    PimObjId rootId = -1;
+    uint64_t numRefs = 0;
+    if (!reader.read(rootId) || !reader.read(numRefs)) {
+      return false;
+    }
+    std::set<PimObjId>& refIds = m_refMap[rootId];
+    for (uint64_t j = 0; j < numRefs; ++j) {
+      PimObjId refId = -1;
+      if (!reader.read(refId)) {
+        return false;
+      }
+      refIds.insert(refId);
+    }
+  }
+
+  m_rangedRefAssocIds.clear();
+  uint64_t numRangedRefs = 0;
+  if (!reader.read(numRangedRefs)) {
+    return false;
+  }
+  for (uint64_t i = 0; i < numRangedRefs; ++i) {
+    PimObjId refAssocId = -1, assocId = -1;
+    uint64_t idxBegin = 0, idxEnd = 0;
+    if (!reader.read(refAssocId) || !reader.read(idxBegin) || !reader.read(idxEnd) || !reader.read(assocId)) {
+      return false;
+    }
+    m_rangedRefAssocIds.emplace(std::make_tuple(refAssocId, idxBegin, idxEnd), assocId);
+  }
+  rebuildRangedRefAssocUses();
+  return true;
+}
+
+//! @brief  Alloc rows of a region on a specific core. Return an invalid region if there is no space
 pimRegion
-pimResMgr::findAvailRegionOnCore(PimCoreId coreId, unsigned numAllocRows, unsigned numAllocCols) const
+pimResMgr::allocRegionOnCore(PimCoreId coreId, unsigned numAllocRows, unsigned numAllocCols)
 {
   pimRegion region;
   region.setCoreId(coreId);
@@ -381,102 +1054,165 @@ pimResMgr::findAvailRegionOnCore(PimCoreId coreId, unsigned numAllocRows, unsign
   region.setNumAllocRows(numAllocRows);
   region.setNumAllocCols(numAllocCols);
 
-  // try to find an available slot
-  unsigned prevAvail = m_coreUsage.at(coreId)->findAvailRange(numAllocRows);
-  if (m_device->getNumRows() - prevAvail >= numAllocRows) {
-    region.setRowIdx(prevAvail);
+  coreUsage& usage = m_coreUsage[coreId];
+  unsigned prevRowsInUse = usage.getTotRowsInUse();
+  int rowIdx = usage.allocRange(numAllocRows, m_allocPolicy);
+  if (rowIdx >= 0) {
+    m_coresByRowsInUse.erase(std::make_pair(prevRowsInUse, coreId));
+    m_coresByRowsInUse.emplace(usage.getTotRowsInUse(), coreId);
+    region.setRowIdx(rowIdx);
     region.setIsValid(true);
-    return region;
   }
-
   return region;
 }
 
-//! @brief  Get a list of core IDs sorted by least usage
+//! @brief  Free rows of a region
+void
+pimResMgr::freeRegion(const pimRegion& region)
+{
+  PimCoreId coreId = region.getCoreId();
+  coreUsage& usage = m_coreUsage[coreId];
+  unsigned prevRowsInUse = usage.getTotRowsInUse();
+  usage.freeRange(region.getRowIdx(), region.getNumAllocRows());
+  m_coresByRowsInUse.erase(std::make_pair(prevRowsInUse, coreId));
+  m_coresByRowsInUse.emplace(usage.getTotRowsInUse(), coreId);
+}
+
+//! @brief  Get a list of core IDs with least rows in use, ordered by rows in use and then core ID
 std::vector<PimCoreId>
-pimResMgr::getCoreIdsSortedByLeastUsage() const
+pimResMgr::getCoreIdsSortedByLeastUsage(unsigned numCoresNeeded) const
 {
-  std::vector<std::pair<unsigned, unsigned>> usages;
-  for (unsigned coreId = 0; coreId < m_device->getNumCores(); ++coreId) {
-    unsigned usage = m_coreUsage.at(coreId)->getTotRowsInUse();
-    usages.emplace_back(usage, coreId);
-  }
-  std::sort(usages.begin(), usages.end());
   std::vector<PimCoreId> result;
-  for (const auto& it : usages) {
-    result.push_back(it.second);
+  result.reserve(numCoresNeeded);
+  for (auto it = m_coresByRowsInUse.begin(); it != m_coresByRowsInUse.end() && result.size() < numCoresNeeded; ++it) {
+    result.push_back(it->second);
   }
   return result;
 }
 
-//! @brief  Find next available range of rows with a given size
-unsigned
-pimResMgr::coreUsage::findAvailRange(unsigned numRowsToAlloc)
+//! @brief  coreUsage ctor. All rows are free initially
+pimResMgr::coreUsage::coreUsage(unsigned numRowsPerCore)
+  : m_numRowsPerCore(numRowsPerCore)
 {
-  unsigned prevAvail = 0;
-  for (const auto& it : m_rangesInUse) {
-    unsigned rowIdx = it.first.first;
-    unsigned numRows = it.first.second;
-    if (rowIdx - prevAvail >= numRowsToAlloc) {
-      return prevAvail;
+  insertFreeRange(0, numRowsPerCore);
+}
+
+//! @brief  Allocate a range of rows with a given size. Return starting row index, or -1 if no space
+//! First-fit walks free ranges in row order. Best-fit looks up the smallest fitting range by size.
+int
+pimResMgr::coreUsage::allocRange(unsigned numRowsToAlloc, PimAllocPolicy policy)
+{
+  if (numRowsToAlloc == 0) {
+    return -1;
+  }
+  auto it = m_freeRanges.end();
+  if (policy == PimAllocPolicy::BEST_FIT) {
+    auto bySize = m_freeRangesBySize.lower_bound(std::make_pair(numRowsToAlloc, 0u));
+    if (bySize != m_freeRangesBySize.end()) {
+      it = m_freeRanges.find(bySize->second);
     }
-    prevAvail = rowIdx + numRows;
+  } else {
+    for (it = m_freeRanges.begin(); it != m_freeRanges.end(); ++it) {
+      if (it->second >= numRowsToAlloc) {
+        break;
+      }
+    }
+  }
+  if (it == m_freeRanges.end()) {
+    return -1;
+  }
+  unsigned rowIdx = it->first;
+  unsigned numRows = it->second;
+  eraseFreeRange(it);
+  if (numRows > numRowsToAlloc) {
+    insertFreeRange(rowIdx + numRowsToAlloc, numRows - numRowsToAlloc);
   }
-  return prevAvail;
+  m_totRowsInUse += numRowsToAlloc;
+  return rowIdx;
 }
 
-//! @brief  Add a new range to core usage.
-//! The new range will be aggregated with previous adjacent ragne if they are from same object
-//! Returned range is after aggregation
+//! @brief  Free a range of rows, and merge it with adjacent free ranges
 void
-pimResMgr::coreUsage::addRange(std::pair<unsigned, unsigned> range, PimObjId objId)
+pimResMgr::coreUsage::freeRange(unsigned rowIdx, unsigned numRows)
 {
-  // aggregate with the prev range
-  if (!m_rangesInUse.empty()) {
-    auto it = std::prev(m_rangesInUse.end());
-    unsigned lastIdx = it->first.first;
-    unsigned lastSize = it->first.second;
-    PimObjId lastObjId = it->second;
-    if (lastIdx + lastSize == range.first && lastObjId == objId) {
-      m_newAlloc.erase(it->first);
-      m_rangesInUse.erase(it);
-      range = std::make_pair(lastIdx, lastSize + range.second);
+  assert(m_totRowsInUse >= numRows);
+  m_totRowsInUse -= numRows;
+  auto next = m_freeRanges.lower_bound(rowIdx);
+  if (next != m_freeRanges.end() && rowIdx + numRows == next->first) {
+    numRows += next->second;
+    eraseFreeRange(next);
+  }
+  next = m_freeRanges.lower_bound(rowIdx);
+  if (next != m_freeRanges.begin()) {
+    auto prev = std::prev(next);
+    if (prev->first + prev->second == rowIdx) {
+      rowIdx = prev->first;
+      numRows += prev->second;
+      eraseFreeRange(prev);
     }
   }
-  m_rangesInUse.insert(std::make_pair(range, objId));
-  m_newAlloc.insert(range);
+  insertFreeRange(rowIdx, numRows);
 }
 
-//! @brief  Delete an object from core usage
+//! @brief  Reset free rows to one range after the rows in use, after rows in use are compacted to row 0
 void
-pimResMgr::coreUsage::deleteObj(PimObjId objId)
+pimResMgr::coreUsage::resetFreeRanges()
 {
-  for (auto it = m_rangesInUse.begin(); it != m_rangesInUse.end();) {
-    if (it->second == objId) {
-      it = m_rangesInUse.erase(it);
-    } else {
-      ++it;
-    }
+  m_freeRanges.clear();
+  m_freeRangesBySize.clear();
+  if (m_totRowsInUse < m_numRowsPerCore) {
+    insertFreeRange(m_totRowsInUse, m_numRowsPerCore - m_totRowsInUse);
   }
 }
 
-//! @brief  Start a new allocation. This is preparing for rollback
+//! @brief  Save rows in use and free row ranges into a checkpoint
 void
-pimResMgr::coreUsage::newAllocStart()
+pimResMgr::coreUsage::saveCheckpoint(pimCheckpointWriter& writer) const
 {
-  m_newAlloc.clear();
+  writer.write(m_totRowsInUse);
+  writer.write(static_cast<uint32_t>(m_freeRanges.size()));
+  for (const auto& [rowIdx, numRows] : m_freeRanges) {
+    writer.write(rowIdx);
+    writer.write(numRows);
+  }
 }
 
-//! @brief  End a new allocation. If failed, rollback all regions
-void
-pimResMgr::coreUsage::newAllocEnd(bool success)
+//! @brief  Restore rows in use and free row ranges from a checkpoint
+bool
+pimResMgr::coreUsage::loadCheckpoint(pimCheckpointReader& reader)
 {
-  if (!success) {
-    for (const auto &range : m_newAlloc) {
-      m_rangesInUse.erase(range);
+  uint32_t numFreeRanges = 0;
+  if (!reader.read(m_totRowsInUse) || !reader.read(numFreeRanges) || m_totRowsInUse > m_numRowsPerCore) {
+    return false;
+  }
+  m_freeRanges.clear();
+  m_freeRangesBySize.clear();
+  uint64_t numFreeRows = 0;
+  for (uint32_t i = 0; i < numFreeRanges; ++i) {
+    unsigned rowIdx = 0, numRows = 0;
+    if (!reader.read(rowIdx) || !reader.read(numRows) || (uint64_t)rowIdx + numRows > m_numRowsPerCore) {
+      return false;
     }
+    insertFreeRange(rowIdx, numRows);
+    numFreeRows += numRows;
   }
-  m_newAlloc.clear();
+  return numFreeRows + m_totRowsInUse == m_numRowsPerCore;
+}
+
+//! @brief  Insert a free range to both indexes
+void
+pimResMgr::coreUsage::insertFreeRange(unsigned rowIdx, unsigned numRows)
+{
+  m_freeRanges.emplace(rowIdx, numRows);
+  m_freeRangesBySize.emplace(numRows, rowIdx);
+}
+
+//! @brief  Erase a free range from both indexes
+void
+pimResMgr::coreUsage::eraseFreeRange(std::map<unsigned, unsigned>::iterator it)
+{
+  m_freeRangesBySize.erase(std::make_pair(it->second, it->first));
+  m_freeRanges.erase(it);
 }
 
 //! @brief  If a PIM object uses vertical data layout
@@ -18,6 +18,14 @@
 #include <cassert>
 
 class pimDevice;
+class pimCheckpointWriter;
+class pimCheckpointReader;
+
+//! @brief  Row allocation policy within a PIM core
+enum class PimAllocPolicy {
+  FIRST_FIT = 0,  // lowest free row range that fits
+  BEST_FIT,       // smallest free row range that fits
+};
 
 
 //! @class  pimRegion
@@ -92,10 +100,12 @@ public:
 
   void addRegion(pimRegion region) { m_regions.push_back(region); }
   void setObjId(PimObjId objId) { m_objId = objId; }
+  void setDataType(PimDataType dataType) { m_dataType = dataType; }
   void setAssocObjId(PimObjId assocObjId) { m_assocObjId = assocObjId; }
   void setRefObjId(PimObjId refObjId) { m_refObjId = refObjId; }
   void setIsDualContactRef(bool val) { m_isDualContactRef = val; }
   void setNumColsPerElem(unsigned val) { m_numColsPerElem = val; }
+  void setRegionRowIdx(size_t regionIdx, unsigned rowIdx) { m_regions[regionIdx].setRowIdx(rowIdx); }
   void finalize();
 
   PimObjId getObjId() const { return m_objId; }
@@ -150,43 +160,100 @@ public:
   bool pimFree(PimObjId objId);
   PimObjId pimCreateRangedRef(PimObjId refId, uint64_t idxBegin, uint64_t idxEnd);
   PimObjId pimCreateDualContactRef(PimObjId refId);
+  void trimObjPool();
+  void compact();
+  void saveCheckpoint(pimCheckpointWriter& writer) const;
+  bool loadCheckpoint(pimCheckpointReader& reader);
+
+  //! @brief  Object IDs of a device start from its device ID in the high bits, so that IDs are unique among
+  //!         devices of a simulator context and commands can be routed to the device owning their objects.
+  //!         After the 2^25 IDs of a device are used, IDs of freed objects are recycled.
+  static constexpr unsigned s_objIdDeviceShift = 25;
+  static constexpr unsigned s_maxNumDevices = 1u << (31 - s_objIdDeviceShift);
+  static PimDeviceId getDeviceIdOfObj(PimObjId objId) { return objId < 0 ? -1 : objId >> s_objIdDeviceShift; }
 
   bool isValidObjId(PimObjId objId) const { return m_objMap.find(objId) != m_objMap.end(); }
   const pimObjInfo& getObjInfo(PimObjId objId) const { return m_objMap.at(objId); }
 
+  PimAllocPolicy getAllocPolicy() const { return m_allocPolicy; }
+  bool isObjPoolEnabled() const { return m_isObjPoolEnabled; }
+  uint64_t getNumObjsAllocated() const { return m_numObjsAllocated; }
+  uint64_t getNumRegionsAllocated() const { return m_numRegionsAllocated; }
+  unsigned getMaxRowsInUse() const { return m_coresByRowsInUse.empty() ? 0 : m_coresByRowsInUse.rbegin()->first; }
+  uint64_t getNumObjPoolHits() const { return m_numObjPoolHits; }
+  uint64_t getNumObjPoolMisses() const { return m_numObjPoolMisses; }
+  uint64_t getNumPooledObjs() const { return m_numPooledObjs; }
+  uint64_t getNumCompactions() const { return m_numCompactions; }
+  uint64_t getNumRowsCompacted() const { return m_numRowsCompacted; }
+
   bool isVLayoutObj(PimObjId objId) const;
   bool isHLayoutObj(PimObjId objId) const;
   bool isHybridLayoutObj(PimObjId objId) const;
 
 private:
-  pimRegion findAvailRegionOnCore(PimCoreId coreId, unsigned numAllocRows, unsigned numAllocCols) const;
-  std::vector<PimCoreId> getCoreIdsSortedByLeastUsage() const;
+  //! @brief  Object pool key: alloc type, number of elements, bits per element, and association anchor
+  //!         which is -1 for objects from pimAlloc or the association ID for objects from pimAllocAssociated
+  typedef std::tuple<PimAllocEnum, uint64_t, unsigned, PimObjId> objPoolKey;
+  typedef std::tuple<PimObjId, uint64_t, uint64_t> rangedRefKey;  // (assoc ID of viewed object, begin, end)
+
+  PimObjId allocFromObjPool(const objPoolKey& key, PimDataType dataType, PimObjId assocObjId);
+  PimObjId getObjPoolAnchor(PimObjId assocObjId) const;
+  bool hasAvailObjId();
+  PimObjId getNewObjId();
+  bool recycleObjIds();
+  void useRangedRefAssoc(PimObjId assocId);
+  void releaseRangedRefAssoc(PimObjId assocId);
+  void rebuildRangedRefAssocUses();
+  pimRegion allocRegionOnCore(PimCoreId coreId, unsigned numAllocRows, unsigned numAllocCols);
+  void freeRegion(const pimRegion& region);
+  bool reclaimRows();
+  std::vector<PimCoreId> getCoreIdsSortedByLeastUsage(unsigned numCoresNeeded) const;
 
   //! @class  coreUsage
-  //! @brief  Track row usage for allocation
+  //! @brief  Track free row ranges of a core for allocation
   class coreUsage {
   public:
-    coreUsage(unsigned numRowsPerCore) : m_numRowsPerCore(numRowsPerCore) {}
+    coreUsage(unsigned numRowsPerCore);
     ~coreUsage() {}
     unsigned getNumRowsPerCore() const { return m_numRowsPerCore; }
     unsigned getTotRowsInUse() const { return m_totRowsInUse; }
-    unsigned findAvailRange(unsigned numRowsToAlloc);
-    void addRange(std::pair<unsigned, unsigned> range, PimObjId objId);
-    void deleteObj(PimObjId objId);
-    void newAllocStart();
-    void newAllocEnd(bool success);
+    int allocRange(unsigned numRowsToAlloc, PimAllocPolicy policy);
+    void freeRange(unsigned rowIdx, unsigned numRows);
+    bool isFragmented() const { return m_freeRanges.size() > 1; }
+    void resetFreeRanges();
+    void saveCheckpoint(pimCheckpointWriter& writer) const;
+    bool loadCheckpoint(pimCheckpointReader& reader);
   private:
+    void insertFreeRange(unsigned rowIdx, unsigned numRows);
+    void eraseFreeRange(std::map<unsigned, unsigned>::iterator it);
+
     unsigned m_numRowsPerCore = 0;
     unsigned m_totRowsInUse = 0;
-    std::map<std::pair<unsigned, unsigned>, PimObjId> m_rangesInUse;
-    std::set<std::pair<unsigned, unsigned>> m_newAlloc;
+    std::map<unsigned, unsigned> m_freeRanges;                   // row index -> number of rows
+    std::set<std::pair<unsigned, unsigned>> m_freeRangesBySize;  // (number of rows, row index)
   };
 
   pimDevice* m_device;
   PimObjId m_availObjId;
+  PimObjId m_maxObjId;
+  std::vector<std::pair<PimObjId, PimObjId>> m_recycledObjIdRanges;  // [begin, end) of freed IDs, used after fresh IDs run out
   std::unordered_map<PimObjId, pimObjInfo> m_objMap;
-  std::unordered_map<PimCoreId, std::unique_ptr<pimResMgr::coreUsage>> m_coreUsage;
+  PimAllocPolicy m_allocPolicy = PimAllocPolicy::FIRST_FIT;
+  bool m_isObjPoolEnabled = false;
+  std::vector<coreUsage> m_coreUsage;
+  std::set<std::pair<unsigned, PimCoreId>> m_coresByRowsInUse;  // (rows in use, core ID)
+  uint64_t m_numObjsAllocated = 0;
+  uint64_t m_numRegionsAllocated = 0;
+  std::map<objPoolKey, std::vector<pimObjInfo>> m_objPool;
+  std::unordered_map<PimObjId, PimObjId> m_objPoolAnchorAlias;  // pooled root object ID -> ID it is reused as
+  uint64_t m_numPooledObjs = 0;
+  uint64_t m_numObjPoolHits = 0;
+  uint64_t m_numObjPoolMisses = 0;
+  uint64_t m_numCompactions = 0;
+  uint64_t m_numRowsCompacted = 0;
   std::unordered_map<PimObjId, std::set<PimObjId>> m_refMap;
+  std::map<rangedRefKey, PimObjId> m_rangedRefAssocIds;
+  std::unordered_map<PimObjId, std::pair<rangedRefKey, unsigned>> m_rangedRefAssocUses;  // assoc ID -> (key, live objects)
 };
 
 #endif
@@ -9,7 +9,11 @@
 #include "pimParamsDram.h"
 #include "pimStats.h"
 #include "pimUtils.h"
+#include "pimTrace.h"
+#include "pimCheckpoint.h"
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <memory>
 #include <algorithm>
 #include <cctype>
@@ -17,31 +21,98 @@
 #include <stdexcept>
 #include <sstream>
 #include <filesystem>
+#include <fstream>
 #include <string>
 
-// The pimSim singleton
+// The pimSim singleton as the default context, and other contexts
 pimSim* pimSim::s_instance = nullptr;
+thread_local pimSim* pimSim::s_current = nullptr;
+std::mutex pimSim::s_contextMutex;
+std::map<PimContextId, pimSim*> pimSim::s_contexts;
+PimContextId pimSim::s_nextContextId = 1;
 
-//! @brief  Get or create the pimSim singleton
+//! @brief  Get the current context of the calling thread, or get or create the default context
 pimSim*
 pimSim::get()
 {
+  if (s_current) {
+    return s_current;
+  }
   if (!s_instance) {
     s_instance = new pimSim();
   }
   return s_instance;
 }
 
-//! @brief  Destroy the pimSim singleton
+//! @brief  Destroy the pimSim singleton and all other contexts
 void
 pimSim::destroy()
 {
+  {
+    std::lock_guard<std::mutex> lock(s_contextMutex);
+    for (auto& it : s_contexts) {
+      delete it.second;
+    }
+    s_contexts.clear();
+  }
+  s_current = nullptr;
   if (s_instance) {
     delete s_instance;
     s_instance = nullptr;
   }
 }
 
+//! @brief  Create a new simulator context
+PimContextId
+pimSim::createContext()
+{
+  std::lock_guard<std::mutex> lock(s_contextMutex);
+  pimSim* sim = new pimSim();
+  sim->m_contextId = s_nextContextId++;
+  s_contexts.emplace(sim->m_contextId, sim);
+  return sim->m_contextId;
+}
+
+//! @brief  Destroy a simulator context with all its devices. The default context cannot be destroyed
+bool
+pimSim::destroyContext(PimContextId ctx)
+{
+  pimSim* sim = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(s_contextMutex);
+    auto it = s_contexts.find(ctx);
+    if (it == s_contexts.end()) {
+      std::printf("PIM-Error: Invalid PIM context ID %d\n", ctx);
+      return false;
+    }
+    sim = it->second;
+    s_contexts.erase(it);
+  }
+  if (s_current == sim) {
+    s_current = nullptr;
+  }
+  delete sim;
+  return true;
+}
+
+//! @brief  Set the current context of the calling thread. Context 0 is the default context
+bool
+pimSim::setContext(PimContextId ctx)
+{
+  if (ctx == 0) {
+    s_current = nullptr;
+    return true;
+  }
+  std::lock_guard<std::mutex> lock(s_contextMutex);
+  auto it = s_contexts.find(ctx);
+  if (it == s_contexts.end()) {
+    std::printf("PIM-Error: Invalid PIM context ID %d\n", ctx);
+    return false;
+  }
+  s_current = it->second;
+  return true;
+}
+
 //! @brief  pimSim ctor
 pimSim::pimSim()
 {
@@ -51,6 +122,74 @@ pimSim::pimSim()
 pimSim::~pimSim()
 {
   uninit();
+  m_traceWriter.reset();
+}
+
+//! @brief  Start recording command trace if environment variable PIMEVAL_TRACE_FILE is set
+void
+pimSim::initTrace()
+{
+  std::string traceFile;
+  if (m_traceWriter || !pimUtils::getEnvVar(pimUtils::envVarPimEvalTraceFile, traceFile) || traceFile.empty()) {
+    return;
+  }
+  std::string tracePayload;
+  bool recordPayload = pimUtils::getEnvVar(pimUtils::envVarPimEvalTracePayload, tracePayload) &&
+                       (tracePayload == "1" || tracePayload == "true");
+  auto writer = std::make_unique<pimTraceWriter>();
+  if (writer->open(traceFile, recordPayload)) {
+    m_traceWriter = std::move(writer);
+    // the simulator singleton may not be destroyed by the application, so flush the trace at exit
+    static bool s_atExitRegistered = false;
+    if (!s_atExitRegistered) {
+      std::atexit([] { if (s_instance) { s_instance->m_traceWriter.reset(); } });
+      s_atExitRegistered = true;
+    }
+  }
+}
+
+//! @brief  Start recording command timeline if environment variable PIMEVAL_TIMELINE_FILE is set
+void
+pimSim::initTimeline()
+{
+  std::string timelineFile;
+  if (m_timelineWriter || !pimUtils::getEnvVar(pimUtils::envVarPimEvalTimelineFile, timelineFile) || timelineFile.empty()) {
+    return;
+  }
+  auto writer = std::make_unique<pimTimelineWriter>();
+  if (writer->open(timelineFile)) {
+    m_timelineWriter = std::move(writer);
+    // finish the JSON array at exit, while devices may still be alive and keep the writer
+    static bool s_atExitRegistered = false;
+    if (!s_atExitRegistered) {
+      std::atexit([] { if (s_instance && s_instance->m_timelineWriter) { s_instance->m_timelineWriter->close(); } });
+      s_atExitRegistered = true;
+    }
+  }
+}
+
+//! @brief  Record a trace entry of a PIM command if trace recording is enabled
+void
+pimSim::traceRecord(PimCmdEnum cmdType, std::initializer_list<uint64_t> args, const void* payload, uint64_t payloadBytes)
+{
+  std::vector<uint64_t> traceArgs;
+  traceArgs.reserve(args.size() + 1);
+  traceArgs.push_back(static_cast<uint64_t>(cmdType));
+  traceArgs.insert(traceArgs.end(), args.begin(), args.end());
+  m_traceWriter->record(PimTraceOp::CMD, traceArgs, payload, payloadBytes);
+}
+
+//! @brief  Get number of bytes of host data of a PIM object or a range of it
+uint64_t
+pimSim::getHostBytes(PimObjId objId, uint64_t idxBegin, uint64_t idxEnd) const
+{
+  pimResMgr* resMgr = getDeviceOfObj(objId)->getResMgr();
+  if (!resMgr->isValidObjId(objId)) {
+    return 0;
+  }
+  const pimObjInfo& obj = resMgr->getObjInfo(objId);
+  uint64_t numElements = (idxEnd == 0) ? obj.getNumElements() : idxEnd - idxBegin;
+  return (numElements * obj.getBitsPerElement() + 7) / 8;
 }
 
 //! @brief  Initialize pimSim member classes from the config file
@@ -58,6 +197,9 @@ bool
 pimSim::init(const std::string& simConfigFileConetnt)
 {
   if (!m_initCalled) {
+    m_isPerfOnly = false;
+    m_allocPolicy = PimAllocPolicy::FIRST_FIT;
+    m_isObjPoolEnabled = false;
     if (!simConfigFileConetnt.empty()) {
       bool success = parseConfigFromFile(simConfigFileConetnt);
       if (!success) {
@@ -83,6 +225,74 @@ pimSim::init(const std::string& simConfigFileConetnt)
       m_statsMgr = std::make_unique<pimStatsMgr>();
       m_initCalled = true;
     }
+    m_initTime = std::chrono::steady_clock::now();
+
+    // Environment variable overrides the simulation mode in config file
+    std::string simMode;
+    if (pimUtils::getEnvVar(pimUtils::envVarPimEvalSimMode, simMode)) {
+      parseSimMode(simMode);
+    }
+    if (m_isPerfOnly) {
+      std::printf("PIM-Info: Performance-model-only simulation mode. Functional computation is skipped.\n");
+    }
+    std::string allocPolicy;
+    if (pimUtils::getEnvVar(pimUtils::envVarPimEvalAllocPolicy, allocPolicy)) {
+      parseAllocPolicy(allocPolicy);
+    }
+    std::string objPool;
+    if (pimUtils::getEnvVar(pimUtils::envVarPimEvalObjPool, objPool)) {
+      parseObjPool(objPool);
+    }
+    // only the default context records command traces and timelines
+    if (this == s_instance) {
+      initTrace();
+      initTimeline();
+    }
+  }
+  return true;
+}
+
+//! @brief  Parse simulation mode. Supported values are "functional" (default) and "perf_only"
+bool
+pimSim::parseSimMode(const std::string& simMode)
+{
+  if (simMode == "functional") {
+    m_isPerfOnly = false;
+  } else if (simMode == "perf_only") {
+    m_isPerfOnly = true;
+  } else {
+    std::printf("PIM-Warning: Invalid simulation mode %s. Supported values are functional and perf_only\n", simMode.c_str());
+    return false;
+  }
+  return true;
+}
+
+//! @brief  Parse row allocation policy. Supported values are "first_fit" (default) and "best_fit"
+bool
+pimSim::parseAllocPolicy(const std::string& allocPolicy)
+{
+  if (allocPolicy == "first_fit") {
+    m_allocPolicy = PimAllocPolicy::FIRST_FIT;
+  } else if (allocPolicy == "best_fit") {
+    m_allocPolicy = PimAllocPolicy::BEST_FIT;
+  } else {
+    std::printf("PIM-Warning: Invalid allocation policy %s. Supported values are first_fit and best_fit\n", allocPolicy.c_str());
+    return false;
+  }
+  return true;
+}
+
+//! @brief  Parse object pool setting. Supported values are "off" (default) and "on"
+bool
+pimSim::parseObjPool(const std::string& objPool)
+{
+  if (objPool == "off") {
+    m_isObjPoolEnabled = false;
+  } else if (objPool == "on") {
+    m_isObjPoolEnabled = true;
+  } else {
+    std::printf("PIM-Warning: Invalid object pool setting %s. Supported values are off and on\n", objPool.c_str());
+    return false;
   }
   return true;
 }
@@ -130,16 +340,21 @@ pimSim::createDevice(PimDeviceEnum deviceType, unsigned numRanks, unsigned numBa
     std::printf("PIM-Error: Init failed\n");
     return false;
   }
-  m_device = std::make_unique<pimDevice>();
-  m_device->init(deviceType, numRanks, numBankPerRank, numSubarrayPerBank, numRows, numCols);
-  if (!m_device->isValid()) {
-    m_device.reset();
+  auto device = std::make_unique<pimDevice>(0);
+  device->init(deviceType, numRanks, numBankPerRank, numSubarrayPerBank, numRows, numCols);
+  if (!device->isValid()) {
     uninit();
     std::printf("PIM-Error: Failed to create PIM device of type %d\n", static_cast<int>(deviceType));
     return false;
   }
+  m_device = device.get();
+  device->setTimelineWriter(m_timelineWriter.get());
+  m_devices.push_back(std::move(device));
   unsigned maxNumThreads = 0; // use max hardware parallelism by default
   initThreadPool(maxNumThreads);
+  if (m_traceWriter) {
+    m_traceWriter->record(PimTraceOp::CREATE_DEVICE, {static_cast<uint64_t>(deviceType), numRanks, numBankPerRank, numSubarrayPerBank, numRows, numCols});
+  }
   return true;
 }
 
@@ -195,19 +410,110 @@ pimSim::createDeviceFromConfig(PimDeviceEnum deviceType, const char* configFileN
     return false;
   }
 
-  m_device = std::make_unique<pimDevice>();
-  m_device->init(deviceType, correctConfigFileName.c_str());
-  if (!m_device->isValid()) {
-    m_device.reset();
+  auto device = std::make_unique<pimDevice>(0);
+  device->init(deviceType, correctConfigFileName.c_str());
+  if (!device->isValid()) {
     uninit();
     std::printf("PIM-Error: Failed to create PIM device of type %d\n", static_cast<int>(deviceType));
     return false;
   }
+  m_device = device.get();
+  device->setTimelineWriter(m_timelineWriter.get());
+  m_devices.push_back(std::move(device));
   unsigned maxNumThreads = m_numThreads;
   initThreadPool(maxNumThreads);
+  if (m_traceWriter) {
+    m_traceWriter->record(PimTraceOp::CREATE_DEVICE_FROM_CONFIG, {static_cast<uint64_t>(deviceType)}, correctConfigFileName.data(), correctConfigFileName.size());
+  }
   return true;
 }
 
+//! @brief  Add a PIM device to the simulator context, e.g., to model another DIMM. Return its device ID
+//!         The first device is created as with createDevice. Other devices share the DRAM params of the context
+PimDeviceId
+pimSim::addDevice(PimDeviceEnum deviceType, unsigned numRanks, unsigned numBankPerRank, unsigned numSubarrayPerBank, unsigned numRows, unsigned numCols)
+{
+  if (m_devices.empty()) {
+    return createDevice(deviceType, numRanks, numBankPerRank, numSubarrayPerBank, numRows, numCols) ? 0 : -1;
+  }
+  pimPerfMon perfMon("createDevice");
+  if (m_devices.size() >= pimResMgr::s_maxNumDevices) {
+    std::printf("PIM-Error: Cannot create more than %u PIM devices\n", pimResMgr::s_maxNumDevices);
+    return -1;
+  }
+  PimDeviceId deviceId = m_devices.size();
+  auto device = std::make_unique<pimDevice>(deviceId);
+  device->init(deviceType, numRanks, numBankPerRank, numSubarrayPerBank, numRows, numCols);
+  if (!device->isValid()) {
+    std::printf("PIM-Error: Failed to create PIM device of type %d\n", static_cast<int>(deviceType));
+    return -1;
+  }
+  device->setTimelineWriter(m_timelineWriter.get());
+  m_devices.push_back(std::move(device));
+  if (m_traceWriter) {
+    m_traceWriter->record(PimTraceOp::ADD_DEVICE, {static_cast<uint64_t>(deviceType), numRanks, numBankPerRank, numSubarrayPerBank, numRows, numCols});
+  }
+  return deviceId;
+}
+
+//! @brief  Set the current device for allocations and device-wide APIs
+bool
+pimSim::setCurrentDevice(PimDeviceId deviceId)
+{
+  if (deviceId < 0 || deviceId >= static_cast<PimDeviceId>(m_devices.size())) {
+    std::printf("PIM-Error: Invalid PIM device ID %d\n", deviceId);
+    return false;
+  }
+  if (m_traceWriter) {
+    m_traceWriter->record(PimTraceOp::SET_DEVICE, {static_cast<uint64_t>(deviceId)});
+  }
+  m_device = m_devices[deviceId].get();
+  return true;
+}
+
+//! @brief  Get the ID of the device owning a PIM object, or -1 if the object is invalid
+PimDeviceId
+pimSim::getObjDeviceId(PimObjId objId) const
+{
+  PimDeviceId deviceId = pimResMgr::getDeviceIdOfObj(objId);
+  if (deviceId < 0 || deviceId >= static_cast<PimDeviceId>(m_devices.size()) ||
+      !m_devices[deviceId]->getResMgr()->isValidObjId(objId)) {
+    return -1;
+  }
+  return deviceId;
+}
+
+//! @brief  Get the device owning a PIM object. Use the current device for invalid IDs, which reports the error
+pimDevice*
+pimSim::getDeviceOfObj(PimObjId objId) const
+{
+  PimDeviceId deviceId = pimResMgr::getDeviceIdOfObj(objId);
+  if (deviceId >= 0 && deviceId < static_cast<PimDeviceId>(m_devices.size())) {
+    return m_devices[deviceId].get();
+  }
+  return m_device;
+}
+
+//! @brief  Execute a command on the device owning its objects, or on the current device for commands
+//!         accessing device-wide states. Objects of other devices are rejected as invalid by the device
+bool
+pimSim::executeCmd(std::unique_ptr<pimCmd> cmd)
+{
+  if (m_devices.size() <= 1) {
+    return m_device->executeCmd(std::move(cmd));
+  }
+  std::vector<PimObjId> objIds;
+  cmd->getObjIds(objIds);
+  pimDevice* device = objIds.empty() ? m_device : getDeviceOfObj(objIds[0]);
+  for (PimObjId objId : objIds) {
+    if (getDeviceOfObj(objId) != device) {
+      std::printf("PIM-Error: PIM objects %d and %d are on different devices\n", objIds[0], objId);
+      return false;
+    }
+  }
+  return device->executeCmd(std::move(cmd));
+}
+
 bool
 pimSim::getDeviceProperties(PimDeviceProperties* deviceProperties) {
   pimPerfMon perfMon("getDeviceProperties");
@@ -232,7 +538,12 @@ pimSim::deleteDevice()
     std::printf("PIM-Error: No PIM device to delete\n");
     return false;
   }
-  m_device.reset();
+  if (m_traceWriter) {
+    m_traceWriter->record(PimTraceOp::DELETE_DEVICE, {});
+  }
+  exportStatsFromEnv();
+  m_device = nullptr;
+  m_devices.clear();
   uninit();
   return true;
 }
@@ -328,6 +639,56 @@ pimSim::getNumCores() const
   return 0;
 }
 
+//! @brief  Get number of PIM cores with allocated memory arrays
+unsigned
+pimSim::getNumMaterializedCores() const
+{
+  if (m_device && m_device->isValid()) {
+    return m_device->getNumMaterializedCores();
+  }
+  return 0;
+}
+
+//! @brief  Get number of bytes of allocated PIM core memory arrays
+uint64_t
+pimSim::getMaterializedBytes() const
+{
+  if (m_device && m_device->isValid()) {
+    return m_device->getMaterializedBytes();
+  }
+  return 0;
+}
+
+//! @brief  Get the resource manager, or nullptr if no device is created
+const pimResMgr*
+pimSim::getResMgr() const
+{
+  if (m_device && m_device->isValid()) {
+    return m_device->getResMgr();
+  }
+  return nullptr;
+}
+
+//! @brief  Get the stream manager, or nullptr if no stream is created
+const pimStreamMgr*
+pimSim::getStreamMgr() const
+{
+  if (m_device && m_device->isValid()) {
+    return m_device->getStreamMgr();
+  }
+  return nullptr;
+}
+
+//! @brief  Get number of bytes of PIM core memory arrays if fully allocated
+uint64_t
+pimSim::getNominalBytes() const
+{
+  if (m_device && m_device->isValid()) {
+    return m_device->getNominalBytes();
+  }
+  return 0;
+}
+
 //! @brief  Get number of rows per PIM core
 unsigned
 pimSim::getNumRows() const
@@ -362,14 +723,231 @@ pimSim::getPerfEnergyModel()
 void
 pimSim::showStats() const
 {
-  m_statsMgr->showStats();
+  if (m_traceWriter) {
+    m_traceWriter->record(PimTraceOp::SHOW_STATS, {});
+  }
+  for (const auto& device : m_devices) {
+    device->synchronizeAll();
+  }
+  if (m_devices.size() <= 1) {
+    pimStatsMgr* statsMgr = m_device ? m_device->getStatsMgr() : m_statsMgr.get();
+    statsMgr->showStats();
+    return;
+  }
+  std::vector<const pimStatsMgr*> deviceStats;
+  for (const auto& device : m_devices) {
+    std::printf("PIM Device %d:\n", device->getDeviceId());
+    device->getStatsMgr()->showStats();
+    deviceStats.push_back(device->getStatsMgr());
+  }
+  pimStatsMgr::showMultiDeviceStats(deviceStats);
 }
 
 //! @brief  Reset PIM command stats
 void
 pimSim::resetStats() const
 {
-  m_statsMgr->resetStats();
+  if (m_traceWriter) {
+    m_traceWriter->record(PimTraceOp::RESET_STATS, {});
+  }
+  for (const auto& device : m_devices) {
+    device->synchronizeAll();
+    device->resetTimeline();
+    device->getStatsMgr()->resetStats();
+  }
+  if (m_statsMgr) {
+    m_statsMgr->resetStats();
+  }
+}
+
+//! @brief  Begin a phase on all devices of current context. Pending stream commands are finished first, so that
+//!         they are attributed to the enclosing phase
+bool
+pimSim::beginPhase(const char* name)
+{
+  if (!isValidDevice()) { return false; }
+  if (!name) {
+    std::printf("PIM-Error: Invalid phase name\n");
+    return false;
+  }
+  if (m_traceWriter) {
+    m_traceWriter->record(PimTraceOp::BEGIN_PHASE, {}, name, std::strlen(name));
+  }
+  for (const auto& device : m_devices) {
+    device->synchronizeAll();
+    device->getStatsMgr()->beginPhase(name);
+  }
+  return true;
+}
+
+//! @brief  End the current phase on all devices of current context
+bool
+pimSim::endPhase()
+{
+  if (!isValidDevice()) { return false; }
+  if (m_traceWriter) {
+    m_traceWriter->record(PimTraceOp::END_PHASE, {});
+  }
+  bool ok = true;
+  for (const auto& device : m_devices) {
+    device->synchronizeAll();
+    ok &= device->getStatsMgr()->endPhase();
+  }
+  if (!ok) {
+    std::printf("PIM-Error: No phase to end\n");
+  }
+  return ok;
+}
+
+//! @brief  Export stats of all devices of current context into a JSON or CSV file, together with simulator
+//!         wall-clock time since init. The file is written to a temporary file first and then renamed, so
+//!         that readers never see a partially written file
+bool
+pimSim::exportStats(const char* fileName, PimStatsFormat format) const
+{
+  if (!isValidDevice()) { return false; }
+  if (!fileName || !*fileName) {
+    std::printf("PIM-Error: Invalid stats file name\n");
+    return false;
+  }
+  if (format != PIM_STATS_JSON && format != PIM_STATS_CSV) {
+    std::printf("PIM-Error: Invalid stats format %d\n", static_cast<int>(format));
+    return false;
+  }
+  std::vector<const pimStatsMgr*> deviceStats;
+  for (const auto& device : m_devices) {
+    device->synchronizeAll();
+    deviceStats.push_back(device->getStatsMgr());
+  }
+  double msWallClock = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_initTime).count();
+
+  std::ostringstream os;
+  if (format == PIM_STATS_JSON) {
+    os << "{\n";
+    os << "  \"simulator\": {\"context_id\": " << m_contextId << ", \"num_devices\": " << m_devices.size()
+       << ", \"ms_wall_clock\": " << std::to_string(msWallClock) << "},\n";
+    os << "  \"devices\": [";
+    const char* sep = "\n    ";
+    for (const pimStatsMgr* stats : deviceStats) {
+      os << sep;
+      stats->exportJson(os, "    ");
+      sep = ",\n    ";
+    }
+    os << "\n  ]";
+    if (deviceStats.size() > 1) {
+      os << ",\n  \"multi_device\": ";
+      pimStatsMgr::exportMultiDeviceJson(os, deviceStats);
+    }
+    os << "\n}\n";
+  } else {
+    pimStatsMgr::exportCsvHeader(os);
+    os << ",simulator,context_id,," << m_contextId << ",,,,,,,,,,,\n";
+    os << ",simulator,num_devices,," << m_devices.size() << ",,,,,,,,,,,\n";
+    os << ",simulator,ms_wall_clock,," << std::to_string(msWallClock) << ",,,,,,,,,,,\n";
+    for (const pimStatsMgr* stats : deviceStats) {
+      stats->exportCsv(os);
+    }
+    if (deviceStats.size() > 1) {
+      pimStatsMgr::exportMultiDeviceCsv(os, deviceStats);
+    }
+  }
+
+  std::string tmpFileName = std::string(fileName) + ".tmp";
+  std::ofstream file(tmpFileName, std::ios::binary);
+  file << os.str();
+  file.close();
+  if (!file || std::rename(tmpFileName.c_str(), fileName) != 0) {
+    std::printf("PIM-Error: Failed to write stats file %s\n", fileName);
+    std::remove(tmpFileName.c_str());
+    return false;
+  }
+  std::printf("PIM-Info: Exported PIM stats to %s\n", fileName);
+  return true;
+}
+
+//! @brief  Export stats if environment variable PIMEVAL_STATS_OUTPUT is set. Format is CSV for a .csv file,
+//!         and JSON otherwise. Only the default context exports, as with command traces
+void
+pimSim::exportStatsFromEnv() const
+{
+  std::string fileName;
+  if (this != s_instance || !pimUtils::getEnvVar(pimUtils::envVarPimEvalStatsOutput, fileName) || fileName.empty()) {
+    return;
+  }
+  bool isCsv = fileName.size() >= 4 && fileName.compare(fileName.size() - 4, 4, ".csv") == 0;
+  exportStats(fileName.c_str(), isCsv ? PIM_STATS_CSV : PIM_STATS_JSON);
+}
+
+//! @brief  Create an asynchronous command stream
+PimStreamId
+pimSim::pimStreamCreate()
+{
+  pimPerfMon perfMon("pimStreamCreate");
+  if (!isValidDevice()) { return -1; }
+  PimStreamId stream = m_device->createStream();
+  if (m_traceWriter) {
+    m_traceWriter->record(PimTraceOp::STREAM_CREATE, {static_cast<uint64_t>(stream)});
+  }
+  return stream;
+}
+
+//! @brief  Destroy a stream after its pending commands are finished
+bool
+pimSim::pimStreamDestroy(PimStreamId stream)
+{
+  pimPerfMon perfMon("pimStreamDestroy");
+  if (!isValidDevice()) { return false; }
+  if (m_traceWriter) {
+    m_traceWriter->record(PimTraceOp::STREAM_DESTROY, {static_cast<uint64_t>(stream)});
+  }
+  return m_device->destroyStream(stream);
+}
+
+//! @brief  Set the stream of subsequent commands issued by the calling thread
+bool
+pimSim::pimSetStream(PimStreamId stream)
+{
+  if (!isValidDevice()) { return false; }
+  if (m_traceWriter) {
+    m_traceWriter->record(PimTraceOp::SET_STREAM, {static_cast<uint64_t>(stream)});
+  }
+  return m_device->setCurrentStream(stream);
+}
+
+//! @brief  Wait until all commands of a stream are finished
+bool
+pimSim::pimStreamSynchronize(PimStreamId stream)
+{
+  pimPerfMon perfMon("pimStreamSynchronize");
+  if (!isValidDevice()) { return false; }
+  if (m_traceWriter) {
+    m_traceWriter->record(PimTraceOp::STREAM_SYNCHRONIZE, {static_cast<uint64_t>(stream)});
+  }
+  return m_device->synchronizeStream(stream);
+}
+
+//! @brief  Record an event on a stream
+PimEventId
+pimSim::pimEventRecord(PimStreamId stream)
+{
+  if (!isValidDevice()) { return -1; }
+  PimEventId event = m_device->recordEvent(stream);
+  if (m_traceWriter) {
+    m_traceWriter->record(PimTraceOp::EVENT_RECORD, {static_cast<uint64_t>(stream), static_cast<uint64_t>(event)});
+  }
+  return event;
+}
+
+//! @brief  Block the host until an event is completed
+bool
+pimSim::pimEventWait(PimEventId event)
+{
+  pimPerfMon perfMon("pimEventWait");
+  if (!isValidDevice()) { return false; }
+  if (m_traceWriter) {
+    m_traceWriter->record(PimTraceOp::EVENT_WAIT, {static_cast<uint64_t>(event)});
+  }
+  return m_device->waitEvent(event);
 }
 
 //! @brief  Allocate a PIM object
@@ -378,7 +956,11 @@ pimSim::pimAlloc(PimAllocEnum allocType, uint64_t numElements, unsigned bitsPerE
 {
   pimPerfMon perfMon("pimAlloc");
   if (!isValidDevice()) { return -1; }
-  return m_device->pimAlloc(allocType, numElements, bitsPerElement, dataType);
+  PimObjId objId = m_device->pimAlloc(allocType, numElements, bitsPerElement, dataType);
+  if (m_traceWriter) {
+    m_traceWriter->record(PimTraceOp::ALLOC, {static_cast<uint64_t>(allocType), numElements, bitsPerElement, static_cast<uint64_t>(dataType), static_cast<uint64_t>(objId)});
+  }
+  return objId;
 }
 
 //! @brief  Allocate a PIM object that is associated with an existing ojbect
@@ -387,7 +969,11 @@ pimSim::pimAllocAssociated(unsigned bitsPerElement, PimObjId assocId, PimDataTyp
 {
   pimPerfMon perfMon("pimAllocAssociated");
   if (!isValidDevice()) { return -1; }
-  return m_device->pimAllocAssociated(bitsPerElement, assocId, dataType);
+  PimObjId objId = getDeviceOfObj(assocId)->pimAllocAssociated(bitsPerElement, assocId, dataType);
+  if (m_traceWriter) {
+    m_traceWriter->record(PimTraceOp::ALLOC_ASSOCIATED, {bitsPerElement, static_cast<uint64_t>(assocId), static_cast<uint64_t>(dataType), static_cast<uint64_t>(objId)});
+  }
+  return objId;
 }
 
 // @brief  Free a PIM object
@@ -396,7 +982,104 @@ pimSim::pimFree(PimObjId obj)
 {
   pimPerfMon perfMon("pimFree");
   if (!isValidDevice()) { return false; }
-  return m_device->pimFree(obj);
+  if (m_traceWriter) {
+    m_traceWriter->record(PimTraceOp::FREE, {static_cast<uint64_t>(obj)});
+  }
+  return getDeviceOfObj(obj)->pimFree(obj);
+}
+
+//! @brief  Release freed objects kept for reuse
+bool
+pimSim::pimTrimObjectPool()
+{
+  pimPerfMon perfMon("pimTrimObjectPool");
+  if (!isValidDevice()) { return false; }
+  if (m_traceWriter) {
+    m_traceWriter->record(PimTraceOp::TRIM_OBJECT_POOL, {});
+  }
+  for (const auto& device : m_devices) {
+    device->pimTrimObjectPool();
+  }
+  return true;
+}
+
+//! @brief  Compact rows of live objects to defragment PIM cores
+bool
+pimSim::pimCompact()
+{
+  pimPerfMon perfMon("pimCompact");
+  if (!isValidDevice()) { return false; }
+  if (m_traceWriter) {
+    m_traceWriter->record(PimTraceOp::COMPACT, {});
+  }
+  for (const auto& device : m_devices) {
+    device->pimCompact();
+  }
+  return true;
+}
+
+//! @brief  Save states of all devices of current context into a checkpoint file
+bool
+pimSim::saveCheckpoint(const char* fileName)
+{
+  pimPerfMon perfMon("pimSaveCheckpoint");
+  if (!isValidDevice()) { return false; }
+  if (!fileName) {
+    std::printf("PIM-Error: Invalid checkpoint file name\n");
+    return false;
+  }
+  if (m_traceWriter) {
+    m_traceWriter->record(PimTraceOp::SAVE_CHECKPOINT, {}, fileName, std::strlen(fileName));
+  }
+  pimCheckpointWriter writer;
+  if (!writer.open(fileName)) {
+    return false;
+  }
+  writer.write(static_cast<uint32_t>(m_devices.size()));
+  for (const auto& device : m_devices) {
+    device->saveCheckpoint(writer);
+  }
+  uint64_t numBytes = writer.getOffset();
+  if (!writer.close()) {
+    std::printf("PIM-Error: Failed to write checkpoint file %s\n", fileName);
+    return false;
+  }
+  std::printf("PIM-Info: Saved checkpoint of %zu PIM device(s) to %s (%llu bytes)\n", m_devices.size(), fileName, (unsigned long long)numBytes);
+  return true;
+}
+
+//! @brief  Restore states of all devices of current context from a checkpoint file. The devices need to be
+//!         created with the same number, simulation targets and dimensions as when the checkpoint was saved
+bool
+pimSim::loadCheckpoint(const char* fileName)
+{
+  pimPerfMon perfMon("pimLoadCheckpoint");
+  if (!isValidDevice()) { return false; }
+  if (!fileName) {
+    std::printf("PIM-Error: Invalid checkpoint file name\n");
+    return false;
+  }
+  if (m_traceWriter) {
+    m_traceWriter->record(PimTraceOp::LOAD_CHECKPOINT, {}, fileName, std::strlen(fileName));
+  }
+  pimCheckpointReader reader;
+  if (!reader.open(fileName)) {
+    return false;
+  }
+  uint32_t numDevices = 0;
+  if (!reader.read(numDevices) || numDevices != m_devices.size()) {
+    std::printf("PIM-Error: Checkpoint file %s has %u PIM device(s), expecting %zu\n", fileName, numDevices, m_devices.size());
+    return false;
+  }
+  for (const auto& device : m_devices) {
+    if (!device->loadCheckpoint(reader)) {
+      // a device is not modified if its configuration does not match, otherwise it may be partially restored
+      std::printf("PIM-Error: Failed to load checkpoint of PIM device %d from %s\n", device->getDeviceId(), fileName);
+      return false;
+    }
+  }
+  std::printf("PIM-Info: Loaded checkpoint of %zu PIM device(s) from %s\n", m_devices.size(), fileName);
+  return true;
 }
 
 //! @brief  Create an obj referencing to a range of an existing obj
@@ -405,7 +1088,11 @@ pimSim::pimCreateRangedRef(PimObjId refId, uint64_t idxBegin, uint64_t idxEnd)
 {
   pimPerfMon perfMon("pimCreateRangedRef");
   if (!isValidDevice()) { return -1; }
-  return m_device->pimCreateRangedRef(refId, idxBegin, idxEnd);
+  PimObjId objId = getDeviceOfObj(refId)->pimCreateRangedRef(refId, idxBegin, idxEnd);
+  if (m_traceWriter) {
+    m_traceWriter->record(PimTraceOp::CREATE_RANGED_REF, {static_cast<uint64_t>(refId), idxBegin, idxEnd, static_cast<uint64_t>(objId)});
+  }
+  return objId;
 }
 
 //! @brief  Create an obj referencing to negation of an existing obj based on dual-contact memory cells
@@ -414,7 +1101,11 @@ pimSim::pimCreateDualContactRef(PimObjId refId)
 {
   pimPerfMon perfMon("pimCreateDualContactRef");
   if (!isValidDevice()) { return -1; }
-  return m_device->pimCreateDualContactRef(refId);
+  PimObjId objId = getDeviceOfObj(refId)->pimCreateDualContactRef(refId);
+  if (m_traceWriter) {
+    m_traceWriter->record(PimTraceOp::CREATE_DUAL_CONTACT_REF, {static_cast<uint64_t>(refId), static_cast<uint64_t>(objId)});
+  }
+  return objId;
 }
 
 // @brief  Copy data from main memory to PIM device within a range
@@ -423,7 +1114,12 @@ pimSim::pimCopyMainToDevice(void* src, PimObjId dest, uint64_t idxBegin, uint64_
 {
   pimPerfMon perfMon("pimCopyMainToDevice");
   if (!isValidDevice()) { return false; }
-  return m_device->pimCopyMainToDevice(src, dest, idxBegin, idxEnd);
+  if (m_traceWriter) {
+    uint64_t numBytes = getHostBytes(dest, idxBegin, idxEnd);
+    traceRecord(PimCmdEnum::COPY_H2D, {0, 0, static_cast<uint64_t>(dest), idxBegin, idxEnd, getHostBytes(dest, 0, 0)},
+                m_traceWriter->isRecordPayload() ? src : nullptr, numBytes);
+  }
+  return getDeviceOfObj(dest)->pimCopyMainToDevice(src, dest, idxBegin, idxEnd);
 }
 
 // @brief  Copy data from PIM device to main memory within a range
@@ -432,7 +1128,10 @@ pimSim::pimCopyDeviceToMain(PimObjId src, void* dest, uint64_t idxBegin, uint64_
 {
   pimPerfMon perfMon("pimCopyDeviceToMain");
   if (!isValidDevice()) { return false; }
-  return m_device->pimCopyDeviceToMain(src, dest, idxBegin, idxEnd);
+  if (m_traceWriter) {
+    traceRecord(PimCmdEnum::COPY_D2H, {0, 0, static_cast<uint64_t>(src), idxBegin, idxEnd, getHostBytes(src, 0, 0)});
+  }
+  return getDeviceOfObj(src)->pimCopyDeviceToMain(src, dest, idxBegin, idxEnd);
 }
 
 // @brief  Copy data from main memory to PIM device with type within a range
@@ -441,7 +1140,12 @@ pimSim::pimCopyMainToDeviceWithType(PimCopyEnum copyType, void* src, PimObjId de
 {
   pimPerfMon perfMon("pimCopyMainToDevice");
   if (!isValidDevice()) { return false; }
-  return m_device->pimCopyMainToDeviceWithType(copyType, src, dest, idxBegin, idxEnd);
+  if (m_traceWriter) {
+    uint64_t numBytes = getHostBytes(dest, idxBegin, idxEnd);
+    traceRecord(PimCmdEnum::COPY_H2D, {1, static_cast<uint64_t>(copyType), static_cast<uint64_t>(dest), idxBegin, idxEnd, getHostBytes(dest, 0, 0)},
+                m_traceWriter->isRecordPayload() ? src : nullptr, numBytes);
+  }
+  return getDeviceOfObj(dest)->pimCopyMainToDeviceWithType(copyType, src, dest, idxBegin, idxEnd);
 }
 
 // @brief  Copy data from PIM device to main memory with type within a range
@@ -450,7 +1154,10 @@ pimSim::pimCopyDeviceToMainWithType(PimCopyEnum copyType, PimObjId src, void* de
 {
   pimPerfMon perfMon("pimCopyDeviceToMain");
   if (!isValidDevice()) { return false; }
-  return m_device->pimCopyDeviceToMainWithType(copyType, src, dest, idxBegin, idxEnd);
+  if (m_traceWriter) {
+    traceRecord(PimCmdEnum::COPY_D2H, {1, static_cast<uint64_t>(copyType), static_cast<uint64_t>(src), idxBegin, idxEnd, getHostBytes(src, 0, 0)});
+  }
+  return getDeviceOfObj(src)->pimCopyDeviceToMainWithType(copyType, src, dest, idxBegin, idxEnd);
 }
 
 // @brief  Copy data from PIM device to device within a range
@@ -459,7 +1166,8 @@ pimSim::pimCopyDeviceToDevice(PimObjId src, PimObjId dest, uint64_t idxBegin, ui
 {
   pimPerfMon perfMon("pimCopyDeviceToDevice");
   if (!isValidDevice()) { return false; }
-  return m_device->pimCopyDeviceToDevice(src, dest, idxBegin, idxEnd);
+  traceCmd(PimCmdEnum::COPY_D2D, src, dest, idxBegin, idxEnd);
+  return getDeviceOfObj(src)->pimCopyDeviceToDevice(src, dest, idxBegin, idxEnd);
 }
 
 // @brief  Load vector with a scalar value
@@ -469,8 +1177,9 @@ pimSim::pimBroadcast(PimObjId dest, T value)
   pimPerfMon perfMon("pimBroadcast");
   if (!isValidDevice()) { return false; }
   uint64_t signExtBits = pimUtils::castTypeToBits(value);
+  traceCmd(PimCmdEnum::BROADCAST, getTraceValueType<T>(), dest, signExtBits);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdBroadcast>(PimCmdEnum::BROADCAST, dest, signExtBits);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 // @brief  PIM OP: add
@@ -479,8 +1188,9 @@ pimSim::pimAdd(PimObjId src1, PimObjId src2, PimObjId dest)
 {
   pimPerfMon perfMon("pimAdd");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::ADD, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc2>(PimCmdEnum::ADD, src1, src2, dest);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 // @brief  PIM OP: sub
@@ -489,8 +1199,9 @@ pimSim::pimSub(PimObjId src1, PimObjId src2, PimObjId dest)
 {
   pimPerfMon perfMon("pimSub");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::SUB, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc2>(PimCmdEnum::SUB, src1, src2, dest);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 // @brief PIM OP: div
@@ -499,8 +1210,9 @@ pimSim::pimDiv(PimObjId src1, PimObjId src2, PimObjId dest)
 {
   pimPerfMon perfMon("pimDiv");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::DIV, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc2>(PimCmdEnum::DIV, src1, src2, dest);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 // @brief  PIM OP: abs v-layout
@@ -509,8 +1221,9 @@ pimSim::pimAbs(PimObjId src, PimObjId dest)
 {
   pimPerfMon perfMon("pimAbs");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::ABS, src, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::ABS, src, dest);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 // @brief  PIM OP: mul
@@ -519,8 +1232,9 @@ pimSim::pimMul(PimObjId src1, PimObjId src2, PimObjId dest)
 {
   pimPerfMon perfMon("pimMul");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::MUL, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc2>(PimCmdEnum::MUL, src1, src2, dest);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 // @brief  PIM OP: and
@@ -529,8 +1243,9 @@ pimSim::pimAnd(PimObjId src1, PimObjId src2, PimObjId dest)
 {
   pimPerfMon perfMon("pimAnd");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::AND, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc2>(PimCmdEnum::AND, src1, src2, dest);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 // @brief  PIM OP: or
@@ -539,8 +1254,9 @@ pimSim::pimOr(PimObjId src1, PimObjId src2, PimObjId dest)
 {
   pimPerfMon perfMon("pimOr");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::OR, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc2>(PimCmdEnum::OR, src1, src2, dest);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 // @brief  PIM OP: xor
@@ -549,8 +1265,9 @@ pimSim::pimXor(PimObjId src1, PimObjId src2, PimObjId dest)
 {
   pimPerfMon perfMon("pimXor");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::XOR, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc2>(PimCmdEnum::XOR, src1, src2, dest);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 // @brief  PIM OP: xnor
@@ -559,8 +1276,9 @@ pimSim::pimXnor(PimObjId src1, PimObjId src2, PimObjId dest)
 {
   pimPerfMon perfMon("pimXnor");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::XNOR, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc2>(PimCmdEnum::XNOR, src1, src2, dest);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 // @brief  PIM OP: gt
@@ -569,8 +1287,9 @@ pimSim::pimGT(PimObjId src1, PimObjId src2, PimObjId dest)
 {
   pimPerfMon perfMon("pimGT");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::GT, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc2>(PimCmdEnum::GT, src1, src2, dest);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 // @brief  PIM OP: lt
@@ -579,8 +1298,9 @@ pimSim::pimLT(PimObjId src1, PimObjId src2, PimObjId dest)
 {
   pimPerfMon perfMon("pimLT");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::LT, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc2>(PimCmdEnum::LT, src1, src2, dest);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 // @brief  PIM OP: eq
@@ -589,8 +1309,9 @@ pimSim::pimEQ(PimObjId src1, PimObjId src2, PimObjId dest)
 {
   pimPerfMon perfMon("pimEQ");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::EQ, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc2>(PimCmdEnum::EQ, src1, src2, dest);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 // @brief  PIM OP: min
@@ -599,8 +1320,9 @@ pimSim::pimMin(PimObjId src1, PimObjId src2, PimObjId dest)
 {
   pimPerfMon perfMon("pimMin");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::MIN, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc2>(PimCmdEnum::MIN, src1, src2, dest);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 // @brief  PIM OP: max
@@ -609,119 +1331,134 @@ pimSim::pimMax(PimObjId src1, PimObjId src2, PimObjId dest)
 {
   pimPerfMon perfMon("pimMax");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::MAX, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc2>(PimCmdEnum::MAX, src1, src2, dest);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 bool pimSim::pimAdd(PimObjId src, PimObjId dest, uint64_t scalarValue)
 {
   pimPerfMon perfMon("pimAddScalar");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::ADD_SCALAR, src, dest, scalarValue);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::ADD_SCALAR, src, dest, scalarValue);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 bool pimSim::pimSub(PimObjId src, PimObjId dest, uint64_t scalarValue)
 {
   pimPerfMon perfMon("pimSubScalar");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::SUB_SCALAR, src, dest, scalarValue);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::SUB_SCALAR, src, dest, scalarValue);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 bool pimSim::pimMul(PimObjId src, PimObjId dest, uint64_t scalarValue)
 {
   pimPerfMon perfMon("pimMulScalar");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::MUL_SCALAR, src, dest, scalarValue);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::MUL_SCALAR, src, dest, scalarValue);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 bool pimSim::pimDiv(PimObjId src, PimObjId dest, uint64_t scalarValue)
 {
   pimPerfMon perfMon("pimDivScalar");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::DIV_SCALAR, src, dest, scalarValue);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::DIV_SCALAR, src, dest, scalarValue);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 bool pimSim::pimAnd(PimObjId src, PimObjId dest, uint64_t scalarValue)
 {
   pimPerfMon perfMon("pimAndScalar");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::AND_SCALAR, src, dest, scalarValue);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::AND_SCALAR, src, dest, scalarValue);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 bool pimSim::pimOr(PimObjId src, PimObjId dest, uint64_t scalarValue)
 {
   pimPerfMon perfMon("pimOrScalar");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::OR_SCALAR, src, dest, scalarValue);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::OR_SCALAR, src, dest, scalarValue);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 bool pimSim::pimXor(PimObjId src, PimObjId dest, uint64_t scalarValue)
 {
   pimPerfMon perfMon("pimXorScalar");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::XOR_SCALAR, src, dest, scalarValue);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::XOR_SCALAR, src, dest, scalarValue);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 bool pimSim::pimXnor(PimObjId src, PimObjId dest, uint64_t scalarValue)
 {
   pimPerfMon perfMon("pimXnorScalar");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::XNOR_SCALAR, src, dest, scalarValue);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::XNOR_SCALAR, src, dest, scalarValue);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 bool pimSim::pimGT(PimObjId src, PimObjId dest, uint64_t scalarValue)
 {
   pimPerfMon perfMon("pimGTScalar");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::GT_SCALAR, src, dest, scalarValue);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::GT_SCALAR, src, dest, scalarValue);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 bool pimSim::pimLT(PimObjId src, PimObjId dest, uint64_t scalarValue)
 {
   pimPerfMon perfMon("pimLTScalar");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::LT_SCALAR, src, dest, scalarValue);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::LT_SCALAR, src, dest, scalarValue);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 bool pimSim::pimEQ(PimObjId src, PimObjId dest, uint64_t scalarValue)
 {
   pimPerfMon perfMon("pimEQScalar");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::EQ_SCALAR, src, dest, scalarValue);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::EQ_SCALAR, src, dest, scalarValue);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 bool pimSim::pimMin(PimObjId src, PimObjId dest, uint64_t scalarValue)
 {
   pimPerfMon perfMon("pimMinScalar");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::MIN_SCALAR, src, dest, scalarValue);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::MIN_SCALAR, src, dest, scalarValue);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 bool pimSim::pimMax(PimObjId src, PimObjId dest, uint64_t scalarValue)
 {
   pimPerfMon perfMon("pimMaxScalar");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::MAX_SCALAR, src, dest, scalarValue);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::MAX_SCALAR, src, dest, scalarValue);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 bool pimSim::pimScaledAdd(PimObjId src1, PimObjId src2, PimObjId dest, uint64_t scalarValue) {
   pimPerfMon perfMon("pimScaledAdd");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::SCALED_ADD, src1, src2, dest, scalarValue);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc2>(PimCmdEnum::SCALED_ADD, src1, src2, dest, scalarValue);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 // @brief  PIM OP: popcount
@@ -730,8 +1467,9 @@ pimSim::pimPopCount(PimObjId src, PimObjId dest)
 {
   pimPerfMon perfMon("pimPopCount");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::POPCOUNT, src, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::POPCOUNT, src, dest);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 template <typename T> bool
@@ -740,8 +1478,9 @@ pimSim::pimRedSum(PimObjId src, T* sum)
   pimPerfMon perfMon("pimRedSum");
   if (!isValidDevice()) { return false; }
   *sum = 0;
+  traceCmd(PimCmdEnum::REDSUM, getTraceValueType<T>(), src);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdRedSum<T>>(PimCmdEnum::REDSUM, src, sum);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 template <typename T> bool
@@ -750,8 +1489,9 @@ pimSim::pimRedSumRanged(PimObjId src, uint64_t idxBegin, uint64_t idxEnd, T* sum
   pimPerfMon perfMon("pimRedSumRanged");
   if (!isValidDevice()) { return false; }
   *sum = 0;
+  traceCmd(PimCmdEnum::REDSUM_RANGE, getTraceValueType<T>(), src, idxBegin, idxEnd);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdRedSum<T>>(PimCmdEnum::REDSUM_RANGE, src, sum, idxBegin, idxEnd);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 bool
@@ -759,8 +1499,9 @@ pimSim::pimRotateElementsRight(PimObjId src)
 {
   pimPerfMon perfMon("pimRotateElementsRight");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::ROTATE_ELEM_R, src);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdRotate>(PimCmdEnum::ROTATE_ELEM_R, src);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 bool
@@ -768,8 +1509,9 @@ pimSim::pimRotateElementsLeft(PimObjId src)
 {
   pimPerfMon perfMon("pimRotateElementsLeft");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::ROTATE_ELEM_L, src);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdRotate>(PimCmdEnum::ROTATE_ELEM_L, src);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 bool
@@ -777,8 +1519,9 @@ pimSim::pimShiftElementsRight(PimObjId src)
 {
   pimPerfMon perfMon("pimShiftElementsRight");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::SHIFT_ELEM_R, src);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdRotate>(PimCmdEnum::SHIFT_ELEM_R, src);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 bool
@@ -786,8 +1529,9 @@ pimSim::pimShiftElementsLeft(PimObjId src)
 {
   pimPerfMon perfMon("pimShiftElementsLeft");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::SHIFT_ELEM_L, src);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdRotate>(PimCmdEnum::SHIFT_ELEM_L, src);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 bool
@@ -795,8 +1539,9 @@ pimSim::pimShiftBitsRight(PimObjId src, PimObjId dest, unsigned shiftAmount)
 {
   pimPerfMon perfMon("pimShiftBitsRight");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::SHIFT_BITS_R, src, dest, shiftAmount);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::SHIFT_BITS_R, src, dest, shiftAmount);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 bool
@@ -804,8 +1549,9 @@ pimSim::pimShiftBitsLeft(PimObjId src, PimObjId dest, unsigned shiftAmount)
 {
   pimPerfMon perfMon("pimShiftBitsLeft");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::SHIFT_BITS_L, src, dest, shiftAmount);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::SHIFT_BITS_L, src, dest, shiftAmount);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 bool
@@ -813,8 +1559,9 @@ pimSim::pimOpReadRowToSa(PimObjId objId, unsigned ofst)
 {
   pimPerfMon perfMon("pimOpReadRowToSa");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::ROW_R, objId, ofst);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdReadRowToSa>(PimCmdEnum::ROW_R, objId, ofst);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 bool
@@ -822,8 +1569,9 @@ pimSim::pimOpWriteSaToRow(PimObjId objId, unsigned ofst)
 {
   pimPerfMon perfMon("pimOpWriteSaToRow");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::ROW_W, objId, ofst);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdWriteSaToRow>(PimCmdEnum::ROW_W, objId, ofst);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 bool
@@ -838,8 +1586,9 @@ pimSim::pimOpMove(PimObjId objId, PimRowReg src, PimRowReg dest)
 {
   pimPerfMon perfMon("pimOpMove");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::RREG_MOV, objId, src, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdRRegOp>(PimCmdEnum::RREG_MOV, objId, dest, src);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 bool
@@ -847,8 +1596,9 @@ pimSim::pimOpSet(PimObjId objId, PimRowReg dest, bool val)
 {
   pimPerfMon perfMon("pimOpSet");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::RREG_SET, objId, dest, val);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdRRegOp>(PimCmdEnum::RREG_SET, objId, dest, val);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 bool
@@ -856,8 +1606,9 @@ pimSim::pimOpNot(PimObjId objId, PimRowReg src, PimRowReg dest)
 {
   pimPerfMon perfMon("pimOpNot");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::RREG_NOT, objId, src, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdRRegOp>(PimCmdEnum::RREG_NOT, objId, dest, src);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 bool
@@ -865,8 +1616,9 @@ pimSim::pimOpAnd(PimObjId objId, PimRowReg src1, PimRowReg src2, PimRowReg dest)
 {
   pimPerfMon perfMon("pimOpAnd");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::RREG_AND, objId, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdRRegOp>(PimCmdEnum::RREG_AND, objId, dest, src1, src2);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 bool
@@ -874,8 +1626,9 @@ pimSim::pimOpOr(PimObjId objId, PimRowReg src1, PimRowReg src2, PimRowReg dest)
 {
   pimPerfMon perfMon("pimOpOr");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::RREG_OR, objId, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdRRegOp>(PimCmdEnum::RREG_OR, objId, dest, src1, src2);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 bool
@@ -883,8 +1636,9 @@ pimSim::pimOpNand(PimObjId objId, PimRowReg src1, PimRowReg src2, PimRowReg dest
 {
   pimPerfMon perfMon("pimOpNand");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::RREG_NAND, objId, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdRRegOp>(PimCmdEnum::RREG_NAND, objId, dest, src1, src2);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 bool
@@ -892,8 +1646,9 @@ pimSim::pimOpNor(PimObjId objId, PimRowReg src1, PimRowReg src2, PimRowReg dest)
 {
   pimPerfMon perfMon("pimOpNor");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::RREG_NOR, objId, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdRRegOp>(PimCmdEnum::RREG_NOR, objId, dest, src1, src2);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 bool
@@ -901,8 +1656,9 @@ pimSim::pimOpXor(PimObjId objId, PimRowReg src1, PimRowReg src2, PimRowReg dest)
 {
   pimPerfMon perfMon("pimOpXor");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::RREG_XOR, objId, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdRRegOp>(PimCmdEnum::RREG_XOR, objId, dest, src1, src2);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 bool
@@ -910,8 +1666,9 @@ pimSim::pimOpXnor(PimObjId objId, PimRowReg src1, PimRowReg src2, PimRowReg dest
 {
   pimPerfMon perfMon("pimOpXnor");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::RREG_XNOR, objId, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdRRegOp>(PimCmdEnum::RREG_XNOR, objId, dest, src1, src2);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 bool
@@ -919,8 +1676,9 @@ pimSim::pimOpMaj(PimObjId objId, PimRowReg src1, PimRowReg src2, PimRowReg src3,
 {
   pimPerfMon perfMon("pimOpMaj");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::RREG_MAJ, objId, src1, src2, src3, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdRRegOp>(PimCmdEnum::RREG_MAJ, objId, dest, src1, src2, src3);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 bool
@@ -928,8 +1686,9 @@ pimSim::pimOpSel(PimObjId objId, PimRowReg cond, PimRowReg src1, PimRowReg src2,
 {
   pimPerfMon perfMon("pimOpSel");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::RREG_SEL, objId, cond, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdRRegOp>(PimCmdEnum::RREG_SEL, objId, dest, cond, src1, src2);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 bool
@@ -937,8 +1696,9 @@ pimSim::pimOpRotateRH(PimObjId objId, PimRowReg src)
 {
   pimPerfMon perfMon("pimOpRotateRH");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::RREG_ROTATE_R, objId, src);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdRRegRotate>(PimCmdEnum::RREG_ROTATE_R, objId, src);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 bool
@@ -946,33 +1706,38 @@ pimSim::pimOpRotateLH(PimObjId objId, PimRowReg src)
 {
   pimPerfMon perfMon("pimOpRotateLH");
   if (!isValidDevice()) { return false; }
+  traceCmd(PimCmdEnum::RREG_ROTATE_L, objId, src);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdRRegRotate>(PimCmdEnum::RREG_ROTATE_L, objId, src);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 bool
 pimSim::pimOpAP(int numSrc, va_list args)
 {
-  pimPerfMon perfMon("pimOpAP");
-  if (!isValidDevice()) { return false; }
-
   std::vector<std::pair<PimObjId, unsigned>> srcRows;
   for (int i = 0; i < numSrc; ++i) {
     PimObjId objId = va_arg(args, PimObjId);
     unsigned ofst = va_arg(args, unsigned);
     srcRows.emplace_back(objId, ofst);
   }
+  return pimOpAP(srcRows);
+}
 
+bool
+pimSim::pimOpAP(const std::vector<std::pair<PimObjId, unsigned>>& srcRows)
+{
+  pimPerfMon perfMon("pimOpAP");
+  if (!isValidDevice()) { return false; }
+  if (m_traceWriter) {
+    traceRowList(PimCmdEnum::ROW_AP, srcRows, {});
+  }
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdAnalogAAP>(PimCmdEnum::ROW_AP, srcRows);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
 }
 
 bool
 pimSim::pimOpAAP(int numSrc, int numDest, va_list args)
 {
-  pimPerfMon perfMon("pimOpAAP");
-  if (!isValidDevice()) { return false; }
-
   std::vector<std::pair<PimObjId, unsigned>> srcRows;
   for (int i = 0; i < numSrc; ++i) {
     PimObjId objId = va_arg(args, PimObjId);
@@ -985,9 +1750,35 @@ pimSim::pimOpAAP(int numSrc, int numDest, va_list args)
     int ofst = va_arg(args, unsigned);
     destRows.emplace_back(objId, ofst);
   }
+  return pimOpAAP(srcRows, destRows);
+}
 
+bool
+pimSim::pimOpAAP(const std::vector<std::pair<PimObjId, unsigned>>& srcRows, const std::vector<std::pair<PimObjId, unsigned>>& destRows)
+{
+  pimPerfMon perfMon("pimOpAAP");
+  if (!isValidDevice()) { return false; }
+  if (m_traceWriter) {
+    traceRowList(PimCmdEnum::ROW_AAP, srcRows, destRows);
+  }
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdAnalogAAP>(PimCmdEnum::ROW_AAP, srcRows, destRows);
-  return m_device->executeCmd(std::move(cmd));
+  return executeCmd(std::move(cmd));
+}
+
+//! @brief  Record a trace entry of AP/AAP with lists of src and dest rows
+void
+pimSim::traceRowList(PimCmdEnum cmdType, const std::vector<std::pair<PimObjId, unsigned>>& srcRows, const std::vector<std::pair<PimObjId, unsigned>>& destRows)
+{
+  std::vector<uint64_t> traceArgs = {static_cast<uint64_t>(cmdType), srcRows.size(), destRows.size()};
+  for (const auto& row : srcRows) {
+    traceArgs.push_back(static_cast<uint64_t>(row.first));
+    traceArgs.push_back(row.second);
+  }
+  for (const auto& row : destRows) {
+    traceArgs.push_back(static_cast<uint64_t>(row.first));
+    traceArgs.push_back(row.second);
+  }
+  m_traceWriter->record(PimTraceOp::CMD, traceArgs);
 }
 
 //! @breif parse config file to get memory config file path and maximum number of threads
@@ -1020,6 +1811,21 @@ pimSim::parseConfigFromFile(const std::string& simConfigFileConetnt) {
       m_numThreads = std::stoi(temp);
     }
 
+    temp = pimUtils::getOptionalParam(params, "sim_mode", success);
+    if (success) {
+      parseSimMode(temp);
+    }
+
+    temp = pimUtils::getOptionalParam(params, "alloc_policy", success);
+    if (success) {
+      parseAllocPolicy(temp);
+    }
+
+    temp = pimUtils::getOptionalParam(params, "obj_pool", success);
+    if (success) {
+      parseObjPool(temp);
+    }
+
     temp = pimUtils::getOptionalParam(params, "memory_config_file", success);
     if (!success) {
       std::printf("PIM-Info: PIM device params config file name could not be located in PIMeval config file. Using default values for memory config\n");
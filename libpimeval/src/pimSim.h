@@ -9,27 +9,52 @@
 
 #include "libpimeval.h"
 #include "pimDevice.h"
+#include "pimResMgr.h"
 #include "pimParamsDram.h"
 #include "pimPerfEnergyBase.h"
 #include "pimStats.h"
+#include "pimTrace.h"
+#include "pimTimeline.h"
 #include <vector>
+#include <map>
+#include <mutex>
 #include <cstdarg>
+#include <initializer_list>
+#include <type_traits>
+#include <chrono>
 
 
 //! @class  pimSim
-//! @brief  PIM simulator singleton class
+//! @brief  PIM simulator context
+//!
+//! Each context is an independent simulation with its own devices, config and stats. The singleton is the
+//! default context, and APIs of a host thread go to its current context. A context may have multiple devices,
+//! e.g., to model multiple DIMMs. Allocations go to the current device, and other APIs go to the device owning
+//! their objects, which is encoded in object IDs.
 class pimSim
 {
 public:
   static pimSim* get();
   static void destroy();
+  static void setCurrent(pimSim* sim) { s_current = sim; }
+
+  // Simulator contexts
+  static PimContextId createContext();
+  static bool destroyContext(PimContextId ctx);
+  static bool setContext(PimContextId ctx);
+  PimContextId getContextId() const { return m_contextId; }
 
   // Device creation and deletion
   bool createDevice(PimDeviceEnum deviceType, unsigned numRanks, unsigned numBankPerRank, unsigned numSubarrayPerBank, unsigned numRows, unsigned numCols);
   bool createDeviceFromConfig(PimDeviceEnum deviceType, const char* configFileName);
+  PimDeviceId addDevice(PimDeviceEnum deviceType, unsigned numRanks, unsigned numBankPerRank, unsigned numSubarrayPerBank, unsigned numRows, unsigned numCols);
   bool getDeviceProperties(PimDeviceProperties* deviceProperties);
   bool deleteDevice();
   bool isValidDevice(bool showMsg = true) const;
+  bool setCurrentDevice(PimDeviceId deviceId);
+  PimDeviceId getCurrentDeviceId() const { return m_device ? m_device->getDeviceId() : -1; }
+  unsigned getNumDevices() const { return m_devices.size(); }
+  PimDeviceId getObjDeviceId(PimObjId objId) const;
 
   PimDeviceEnum getDeviceType() const;
   PimDeviceEnum getSimTarget() const;
@@ -41,23 +66,49 @@ public:
   unsigned getNumCores() const;
   unsigned getNumRows() const;
   unsigned getNumCols() const;
+  unsigned getNumMaterializedCores() const;
+  uint64_t getMaterializedBytes() const;
+  uint64_t getNominalBytes() const;
+  const pimStreamMgr* getStreamMgr() const;
+  const pimResMgr* getResMgr() const;
 
   void showStats() const;
   void resetStats() const;
-  pimStatsMgr* getStatsMgr() { return m_statsMgr.get(); }
+  bool exportStats(const char* fileName, PimStatsFormat format) const;
+  bool beginPhase(const char* name);
+  bool endPhase();
+  pimStatsMgr* getStatsMgr() { return m_device ? m_device->getStatsMgr() : m_statsMgr.get(); }
   const pimParamsDram& getParamsDram() const { assert(m_paramsDram); return *m_paramsDram; }
   pimPerfEnergyBase* getPerfEnergyModel();
 
+  bool isPerfOnly() const { return m_isPerfOnly; }
+  PimAllocPolicy getAllocPolicy() const { return m_allocPolicy; }
+  bool isObjPoolEnabled() const { return m_isObjPoolEnabled; }
+
   void initThreadPool(unsigned maxNumThreads);
   pimUtils::threadPool* getThreadPool() { return m_threadPool.get(); }
   unsigned getNumThreads() const { return m_numThreads; }
 
+  // Asynchronous streams
+  PimStreamId pimStreamCreate();
+  bool pimStreamDestroy(PimStreamId stream);
+  bool pimSetStream(PimStreamId stream);
+  bool pimStreamSynchronize(PimStreamId stream);
+  PimEventId pimEventRecord(PimStreamId stream);
+  bool pimEventWait(PimEventId event);
+
   // Resource allocation and deletion
   PimObjId pimAlloc(PimAllocEnum allocType, uint64_t numElements, unsigned bitsPerElement, PimDataType dataType);
   PimObjId pimAllocAssociated(unsigned bitsPerElement, PimObjId assocId, PimDataType dataType);
   bool pimFree(PimObjId obj);
   PimObjId pimCreateRangedRef(PimObjId refId, uint64_t idxBegin, uint64_t idxEnd);
   PimObjId pimCreateDualContactRef(PimObjId refId);
+  bool pimTrimObjectPool();
+  bool pimCompact();
+
+  // Checkpoint and restore
+  bool saveCheckpoint(const char* fileName);
+  bool loadCheckpoint(const char* fileName);
 
   // Data transfer
   bool pimCopyMainToDevice(void* src, PimObjId dest, uint64_t idxBegin = 0, uint64_t idxEnd = 0);
@@ -127,6 +178,8 @@ public:
   // SIMDRAM micro ops
   bool pimOpAP(int numSrc, va_list args);
   bool pimOpAAP(int numSrc, int numDest, va_list args);
+  bool pimOpAP(const std::vector<std::pair<PimObjId, unsigned>>& srcRows);
+  bool pimOpAAP(const std::vector<std::pair<PimObjId, unsigned>>& srcRows, const std::vector<std::pair<PimObjId, unsigned>>& destRows);
 
 private:
   pimSim();
@@ -136,11 +189,44 @@ private:
   bool init(const std::string& simConfigFileContent = "");
   void uninit();
   bool parseConfigFromFile(const std::string& simConfigFileContent);
+  bool parseSimMode(const std::string& simMode);
+  bool parseAllocPolicy(const std::string& allocPolicy);
+  bool parseObjPool(const std::string& objPool);
+  pimDevice* getDeviceOfObj(PimObjId objId) const;
+  bool executeCmd(std::unique_ptr<pimCmd> cmd);
+  void initTrace();
+  void initTimeline();
+  void exportStatsFromEnv() const;
+  void traceRecord(PimCmdEnum cmdType, std::initializer_list<uint64_t> args, const void* payload = nullptr, uint64_t payloadBytes = 0);
+  void traceRowList(PimCmdEnum cmdType, const std::vector<std::pair<PimObjId, unsigned>>& srcRows, const std::vector<std::pair<PimObjId, unsigned>>& destRows);
+  uint64_t getHostBytes(PimObjId objId, uint64_t idxBegin, uint64_t idxEnd) const;
+
+  //! @brief  Record a PIM command with all arguments converted to integers
+  template <typename... Args> void traceCmd(PimCmdEnum cmdType, Args... args) {
+    if (m_traceWriter) {
+      traceRecord(cmdType, {static_cast<uint64_t>(args)...});
+    }
+  }
+  //! @brief  Get trace value type tag of broadcast and reduction sum
+  template <typename T> static uint64_t getTraceValueType() {
+    if constexpr (std::is_floating_point<T>::value) {
+      return static_cast<uint64_t>(PimTraceValueType::FP32);
+    } else if constexpr (std::is_signed<T>::value) {
+      return static_cast<uint64_t>(PimTraceValueType::INT64);
+    }
+    return static_cast<uint64_t>(PimTraceValueType::UINT64);
+  }
 
   static pimSim* s_instance;
-
-  // support one device for now
-  std::unique_ptr<pimDevice> m_device;
+  static thread_local pimSim* s_current;
+  static std::mutex s_contextMutex;
+  static std::map<PimContextId, pimSim*> s_contexts;
+  static PimContextId s_nextContextId;
+
+  PimContextId m_contextId = 0;
+  std::unique_ptr<pimTimelineWriter> m_timelineWriter;  // declared before devices which record into it
+  std::vector<std::unique_ptr<pimDevice>> m_devices;
+  pimDevice* m_device = nullptr; // current device
   std::unique_ptr<pimParamsDram> m_paramsDram;
   std::unique_ptr<pimStatsMgr> m_statsMgr;
   std::unique_ptr<pimUtils::threadPool> m_threadPool;
@@ -148,6 +234,11 @@ private:
   std::string m_memConfigFileName;
   std::string m_configFilesPath;
   bool m_initCalled = false;
+  bool m_isPerfOnly = false;
+  PimAllocPolicy m_allocPolicy = PimAllocPolicy::FIRST_FIT;
+  bool m_isObjPoolEnabled = false;
+  std::unique_ptr<pimTraceWriter> m_traceWriter;
+  std::chrono::time_point<std::chrono::steady_clock> m_initTime;
 
 };
 
@@ -7,9 +7,182 @@
 #include "pimStats.h"
 #include "pimSim.h"
 #include "pimUtils.h"
+#include "pimCmd.h"
+#include "pimCheckpoint.h"
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
 
 
+//! @brief  Format a double for export, with enough digits for analysis scripts. Non-finite values are left empty
+static std::string
+formatDouble(double val)
+{
+  if (!std::isfinite(val)) {
+    return "";
+  }
+  char buf[32];
+  std::snprintf(buf, sizeof(buf), "%.15g", val);
+  return buf;
+}
+
+//! @brief  Format a double as a JSON number. JSON has no inf or nan, so non-finite values become null
+static std::string
+formatJsonDouble(double val)
+{
+  return std::isfinite(val) ? formatDouble(val) : "null";
+}
+
+//! @brief  Quote a CSV field if it contains separators or quotes
+static std::string
+quoteCsv(const std::string& str)
+{
+  if (str.find_first_of(",\"\n") == std::string::npos) {
+    return str;
+  }
+  std::string quoted = "\"";
+  for (char c : str) {
+    if (c == '"') {
+      quoted += '"';
+    }
+    quoted += c;
+  }
+  return quoted + "\"";
+}
+
+//! @brief  Write runtime and energy with their components as JSON fields
+static void
+writeJsonPerfEnergy(std::ostream& os, const pimeval::perfEnergy& perfEnergy)
+{
+  os << "\"ms_runtime\": " << formatJsonDouble(perfEnergy.m_msRuntime)
+     << ", \"ms_read\": " << formatJsonDouble(perfEnergy.m_msRead)
+     << ", \"ms_write\": " << formatJsonDouble(perfEnergy.m_msWrite)
+     << ", \"ms_logic\": " << formatJsonDouble(perfEnergy.m_msLogic)
+     << ", \"ms_other\": " << formatJsonDouble(perfEnergy.getMsOther())
+     << ", \"mj_energy\": " << formatJsonDouble(perfEnergy.m_mjEnergy)
+     << ", \"mj_read\": " << formatJsonDouble(perfEnergy.m_mjRead)
+     << ", \"mj_write\": " << formatJsonDouble(perfEnergy.m_mjWrite)
+     << ", \"mj_logic\": " << formatJsonDouble(perfEnergy.m_mjLogic)
+     << ", \"mj_background\": " << formatJsonDouble(perfEnergy.m_mjBackground)
+     << ", \"mj_other\": " << formatJsonDouble(perfEnergy.getMjOther());
+}
+
+//! @brief  Write runtime and energy with their components as the last CSV columns of a row
+static void
+writeCsvPerfEnergy(std::ostream& os, const pimeval::perfEnergy& perfEnergy)
+{
+  os << "," << formatDouble(perfEnergy.m_msRuntime) << "," << formatDouble(perfEnergy.m_msRead)
+     << "," << formatDouble(perfEnergy.m_msWrite) << "," << formatDouble(perfEnergy.m_msLogic)
+     << "," << formatDouble(perfEnergy.getMsOther()) << "," << formatDouble(perfEnergy.m_mjEnergy)
+     << "," << formatDouble(perfEnergy.m_mjRead) << "," << formatDouble(perfEnergy.m_mjWrite)
+     << "," << formatDouble(perfEnergy.m_mjLogic) << "," << formatDouble(perfEnergy.m_mjBackground)
+     << "," << formatDouble(perfEnergy.getMjOther()) << "\n";
+}
+
+//! @brief  pimStatsMgr ctor
+pimStatsMgr::pimStatsMgr(const pimDevice* device)
+  : m_device(device)
+{
+  // a unique ID to identify per-thread stats of this instance, as the address may be reused
+  static std::atomic<uint64_t> s_nextStatsMgrId(0);
+  m_statsMgrId = s_nextStatsMgrId++;
+}
+
+//! @brief  Get stats of current thread. Allocate a new table at the first record from a thread
+pimStatsMgr::threadStats&
+pimStatsMgr::getThreadStats()
+{
+  thread_local uint64_t t_statsMgrId = UINT64_MAX;
+  thread_local threadStats* t_stats = nullptr;
+  if (t_statsMgrId == m_statsMgrId) {
+    return *t_stats;
+  }
+  thread_local std::unordered_map<uint64_t, threadStats*> t_statsOfMgrs;
+  auto it = t_statsOfMgrs.find(m_statsMgrId);
+  if (it == t_statsOfMgrs.end()) {
+    auto stats = std::make_unique<threadStats>();
+    stats->m_cmdCounters.resize(s_numCmdIndices);
+    std::lock_guard<std::mutex> lock(m_threadStatsMutex);
+    m_threadStats.push_back(std::move(stats));
+    it = t_statsOfMgrs.emplace(m_statsMgrId, m_threadStats.back().get()).first;
+  }
+  t_statsMgrId = m_statsMgrId;
+  t_stats = it->second;
+  return *t_stats;
+}
+
+//! @brief  Get human-readable command name from a dense table index
+std::string
+pimStatsMgr::getCmdName(unsigned cmdIndex)
+{
+  unsigned layoutIdx = cmdIndex % 2;
+  unsigned dataTypeIdx = (cmdIndex / 2) % s_numDataTypes;
+  PimCmdEnum cmdType = static_cast<PimCmdEnum>(cmdIndex / 2 / s_numDataTypes);
+  std::string suffix;
+  if (dataTypeIdx != s_numDataTypes - 1) {
+    suffix = "." + pimUtils::pimDataTypeEnumToStr(static_cast<PimDataType>(dataTypeIdx));
+    suffix += (layoutIdx == 0 ? ".v" : ".h");
+  }
+  return pimCmd::getName(cmdType, suffix);
+}
+
+//! @brief  Merge per-thread command stats by name
+std::map<std::string, std::pair<int, pimeval::perfEnergy>>
+pimStatsMgr::getCmdStats() const
+{
+  std::map<std::string, std::pair<int, pimeval::perfEnergy>> cmdStats;
+  auto merge = [&](const std::string& cmdName, const cmdCounter& counter) {
+    auto& item = cmdStats[cmdName];
+    item.first += counter.m_count;
+    item.second.add(counter.m_perfEnergy);
+  };
+  std::lock_guard<std::mutex> lock(m_threadStatsMutex);
+  for (const auto& stats : m_threadStats) {
+    for (unsigned i = 0; i < s_numCmdIndices; ++i) {
+      if (stats->m_cmdCounters[i].m_count > 0) {
+        merge(getCmdName(i), stats->m_cmdCounters[i]);
+      }
+    }
+    for (const auto& [key, counter] : stats->m_multiRowCmdCounters) {
+      std::string cmdName = getCmdName(key & 0xffffffff);
+      cmdName += "@" + std::to_string((key >> 32) & 0xffff) + "," + std::to_string(key >> 48);
+      merge(cmdName, counter);
+    }
+  }
+  return cmdStats;
+}
+
+//! @brief  Merge per-thread API stats by name
+std::map<std::string, std::pair<int, double>>
+pimStatsMgr::getApiStats() const
+{
+  std::map<std::string, std::pair<int, double>> apiStats;
+  std::lock_guard<std::mutex> lock(m_threadStatsMutex);
+  for (const auto& stats : m_threadStats) {
+    for (const auto& [tag, item] : stats->m_msElapsed) {
+      auto& merged = apiStats[tag];
+      merged.first += item.first;
+      merged.second += item.second;
+    }
+  }
+  return apiStats;
+}
+
+//! @brief  Get total modeled runtime and energy of commands and data copy, and number of commands
+pimeval::perfEnergy
+pimStatsMgr::getTotalPerfEnergy(uint64_t& numCmds) const
+{
+  pimeval::perfEnergy total(m_elapsedTimeCopiedMainToDevice + m_elapsedTimeCopiedDeviceToMain + m_elapsedTimeCopiedDeviceToDevice,
+                            m_mJCopiedMainToDevice + m_mJCopiedDeviceToMain + m_mJCopiedDeviceToDevice);
+  numCmds = 0;
+  for (const auto& it : getCmdStats()) {
+    numCmds += it.second.first;
+    total.add(it.second.second);
+  }
+  return total;
+}
+
 //! @brief  Show PIM stats
 void
 pimStatsMgr::showStats() const
@@ -21,6 +194,49 @@ pimStatsMgr::showStats() const
   showDeviceParams();
   showCopyStats();
   showCmdStats();
+  showResourceStats();
+  showPhaseStats();
+  std::printf("----------------------------------------\n");
+}
+
+//! @brief  Get aggregate stats of multiple devices of a simulator context
+//!         Devices execute in parallel, while the host fans commands out to devices one at a time. Each command
+//!         is modeled to occupy the host memory controller for one tCCD, which is added to the slowest device.
+pimStatsMgr::multiDeviceStats
+pimStatsMgr::getMultiDeviceStats(const std::vector<const pimStatsMgr*>& deviceStats)
+{
+  multiDeviceStats aggregate;
+  for (const pimStatsMgr* stats : deviceStats) {
+    uint64_t numCmds = 0;
+    pimeval::perfEnergy total = stats->getTotalPerfEnergy(numCmds);
+    aggregate.m_numCmds += numCmds;
+    aggregate.m_msSerialized += total.m_msRuntime;
+    aggregate.m_msMaxDevice = std::max(aggregate.m_msMaxDevice, total.m_msRuntime);
+    aggregate.m_mjEnergy += total.m_mjEnergy;
+  }
+  aggregate.m_msFanOut = aggregate.m_numCmds * pimSim::get()->getParamsDram().getNsTCCD_S() / 1000000.0;
+  aggregate.m_msParallel = aggregate.m_msMaxDevice + aggregate.m_msFanOut;
+  return aggregate;
+}
+
+//! @brief  Show aggregate stats of multiple devices of a simulator context
+void
+pimStatsMgr::showMultiDeviceStats(const std::vector<const pimStatsMgr*>& deviceStats)
+{
+  std::printf("----------------------------------------\n");
+  std::printf("PIM Multi-Device Stats:\n");
+  std::printf(" %44s : %10s %14s %14s\n", "PIM-DEVICE", "CNT", "EstimatedRuntime(ms)", "EstimatedEnergyConsumption(mJ)");
+  for (const pimStatsMgr* stats : deviceStats) {
+    uint64_t numCmds = 0;
+    pimeval::perfEnergy total = stats->getTotalPerfEnergy(numCmds);
+    std::string name = "device " + std::to_string(stats->m_device ? stats->m_device->getDeviceId() : -1);
+    std::printf(" %44s : %10llu %14f %14f\n", name.c_str(), (unsigned long long)numCmds, total.m_msRuntime, total.m_mjEnergy);
+  }
+  multiDeviceStats aggregate = getMultiDeviceStats(deviceStats);
+  std::printf(" %44s : %10llu %14f %14f\n", "TOTAL ---------", (unsigned long long)aggregate.m_numCmds, aggregate.m_msSerialized, aggregate.m_mjEnergy);
+  std::printf(" %44s : %14f ms\n", "Host Fan-Out", aggregate.m_msFanOut);
+  std::printf(" %44s : %14f ms (%.2fx speedup over serialized)\n", "Parallel Runtime", aggregate.m_msParallel,
+              aggregate.m_msParallel > 0.0 ? aggregate.m_msSerialized / aggregate.m_msParallel : 0.0);
   std::printf("----------------------------------------\n");
 }
 
@@ -40,7 +256,8 @@ pimStatsMgr::showApiStats() const
   double msTotalElapsedAlloc = 0.0;
   double msTotalElapsedCopy = 0.0;
   double msTotalElapsedCompute = 0.0;
-  for (const auto& it : m_msElapsed) {
+  std::map<std::string, std::pair<int, double>> apiStats = getApiStats();
+  for (const auto& it : apiStats) {
     std::printf(" %30s : %10d %14f\n", it.first.c_str(), it.second.first, it.second.second);
     totCalls += it.second.first;
     msTotalElapsed += it.second.second;
@@ -71,23 +288,54 @@ pimStatsMgr::showDeviceParams() const
 {
   const pimParamsDram& paramsDram = pimSim::get()->getParamsDram();
   std::printf("PIM Params:\n");
-  std::printf(" %30s : %s\n", "PIM Device Type Enum",
-              pimUtils::pimDeviceEnumToStr(pimSim::get()->getDeviceType()).c_str());
-  std::printf(" %30s : %s\n", "PIM Simulation Target",
-              pimUtils::pimDeviceEnumToStr(pimSim::get()->getSimTarget()).c_str());
-  std::printf(" %30s : %u, %u, %u, %u, %u\n", "Rank, Bank, Subarray, Row, Col",
-              pimSim::get()->getNumRanks(),
-              pimSim::get()->getNumBankPerRank(),
-              pimSim::get()->getNumSubarrayPerBank(),
-              pimSim::get()->getNumRowPerSubarray(),
-              pimSim::get()->getNumColPerSubarray());
-  std::printf(" %30s : %u\n", "Number of PIM Cores", pimSim::get()->getNumCores());
-  std::printf(" %30s : %u\n", "Number of Rows per Core", pimSim::get()->getNumRows());
-  std::printf(" %30s : %u\n", "Number of Cols per Core", pimSim::get()->getNumCols());
+  if (m_device) {
+    std::printf(" %30s : %s\n", "PIM Device Type Enum",
+                pimUtils::pimDeviceEnumToStr(m_device->getDeviceType()).c_str());
+    std::printf(" %30s : %s\n", "PIM Simulation Target",
+                pimUtils::pimDeviceEnumToStr(m_device->getSimTarget()).c_str());
+    std::printf(" %30s : %u, %u, %u, %u, %u\n", "Rank, Bank, Subarray, Row, Col",
+                m_device->getNumRanks(),
+                m_device->getNumBankPerRank(),
+                m_device->getNumSubarrayPerBank(),
+                m_device->getNumRowPerSubarray(),
+                m_device->getNumColPerSubarray());
+    std::printf(" %30s : %u\n", "Number of PIM Cores", m_device->getNumCores());
+    std::printf(" %30s : %u\n", "Number of Rows per Core", m_device->getNumRows());
+    std::printf(" %30s : %u\n", "Number of Cols per Core", m_device->getNumCols());
+    std::printf(" %30s : %u of %u cores, %.2f of %.2f MB materialized\n", "PIM Core Memory",
+                m_device->getNumMaterializedCores(), m_device->getNumCores(),
+                m_device->getMaterializedBytes() / (1024.0 * 1024.0),
+                m_device->getNominalBytes() / (1024.0 * 1024.0));
+  }
+  const pimResMgr* resMgr = m_device ? m_device->getResMgr() : nullptr;
+  if (resMgr) {
+    std::printf(" %30s : %s, %llu objects, %llu regions, max %u rows in use per core, %llu compactions moving %llu rows\n",
+                "PIM Allocation", resMgr->getAllocPolicy() == PimAllocPolicy::BEST_FIT ? "best_fit" : "first_fit",
+                (unsigned long long)resMgr->getNumObjsAllocated(), (unsigned long long)resMgr->getNumRegionsAllocated(),
+                resMgr->getMaxRowsInUse(), (unsigned long long)resMgr->getNumCompactions(),
+                (unsigned long long)resMgr->getNumRowsCompacted());
+    uint64_t numObjPoolHits = resMgr->getNumObjPoolHits();
+    uint64_t numObjPoolRequests = numObjPoolHits + resMgr->getNumObjPoolMisses();
+    if (resMgr->isObjPoolEnabled()) {
+      std::printf(" %30s : %llu of %llu allocations reused (%.2f%%), %llu objects pooled\n", "PIM Object Pool",
+                  (unsigned long long)numObjPoolHits, (unsigned long long)numObjPoolRequests,
+                  numObjPoolRequests == 0 ? 0.0 : numObjPoolHits * 100.0 / numObjPoolRequests,
+                  (unsigned long long)resMgr->getNumPooledObjs());
+    } else {
+      std::printf(" %30s : off\n", "PIM Object Pool");
+    }
+  }
   std::printf(" %30s : %f GB/s\n", "Typical Rank BW", paramsDram.getTypicalRankBW());
   std::printf(" %30s : %f\n", "Row Read (ns)", paramsDram.getNsRowRead());
   std::printf(" %30s : %f\n", "Row Write (ns)", paramsDram.getNsRowWrite());
   std::printf(" %30s : %f\n", "tCCD (ns)", paramsDram.getNsTCCD_S());
+  const pimActThrottle* actThrottle = (m_device && m_device->getPerfEnergyModel()) ? m_device->getPerfEnergyModel()->getActThrottle() : nullptr;
+  if (actThrottle) {
+    unsigned numCores = actThrottle->getNumCoresPerRank();
+    std::printf(" %30s : %g power budget, %.2f ACTs per tFAW, %.2fx row read slowdown with %u cores per rank active\n",
+                "Activation Throttle", actThrottle->getPowerBudget(), actThrottle->getActsPerWindow(),
+                actThrottle->getFactor(numCores, paramsDram.getNsRowRead()), numCores);
+  }
   #if defined(DEBUG)
   std::printf(" %30s : %f\n", "AAP (ns)", paramsDram.getNsAAP());
   #endif
@@ -104,10 +352,10 @@ pimStatsMgr::showCopyStats() const
   uint64_t totalBytes = bytesCopiedMainToDevice + bytesCopiedDeviceToMain;
   double totalMsRuntime = m_elapsedTimeCopiedMainToDevice + m_elapsedTimeCopiedDeviceToMain + m_elapsedTimeCopiedDeviceToDevice;
   double totalMjEnergy = m_mJCopiedMainToDevice + m_mJCopiedDeviceToMain + m_mJCopiedDeviceToDevice;
-  std::printf(" %44s : %llu bytes\n", "Host to Device", bytesCopiedMainToDevice);
-  std::printf(" %44s : %llu bytes\n", "Device to Host", bytesCopiedDeviceToMain);
-  std::printf(" %44s : %llu bytes\n", "Device to Device", bytesCopiedDeviceToDevice);
-  std::printf(" %44s : %llu bytes %14f ms Estimated Runtime %14f mj Estimated Energy\n", "TOTAL ---------", totalBytes, totalMsRuntime, totalMjEnergy);
+  std::printf(" %44s : %llu bytes\n", "Host to Device", (unsigned long long)bytesCopiedMainToDevice);
+  std::printf(" %44s : %llu bytes\n", "Device to Host", (unsigned long long)bytesCopiedDeviceToMain);
+  std::printf(" %44s : %llu bytes\n", "Device to Device", (unsigned long long)bytesCopiedDeviceToDevice);
+  std::printf(" %44s : %llu bytes %14f ms Estimated Runtime %14f mj Estimated Energy\n", "TOTAL ---------", (unsigned long long)totalBytes, totalMsRuntime, totalMjEnergy);
 }
 
 //! @brief  Show PIM cmd and perf stats
@@ -119,7 +367,8 @@ pimStatsMgr::showCmdStats() const
   int totalCmd = 0;
   double totalMsRuntime = 0.0;
   double totalMjEnergy = 0.0;
-  for (const auto& it : m_cmdPerf) {
+  std::map<std::string, std::pair<int, pimeval::perfEnergy>> cmdStats = getCmdStats();
+  for (const auto& it : cmdStats) {
     std::printf(" %44s : %10d %14f %14f\n", it.first.c_str(), it.second.first, it.second.second.m_msRuntime, it.second.second.m_mjEnergy);
     totalCmd += it.second.first;
     totalMsRuntime += it.second.second.m_msRuntime;
@@ -133,7 +382,7 @@ pimStatsMgr::showCmdStats() const
   int numL = 0;
   int numActivate = 0;
   int numPrecharge = 0;
-  for (const auto& it : m_cmdPerf) {
+  for (const auto& it : cmdStats) {
     if (it.first == "row_r") {
       numR += it.second.first;
       numActivate += it.second.first;
@@ -152,19 +401,499 @@ pimStatsMgr::showCmdStats() const
   }
 }
 
+//! @brief  Get the per-rank and per-core resource timeline of the device, or nullptr if there is no command
+const pimResourceTimeline*
+pimStatsMgr::getResourceTimeline() const
+{
+  const pimPerfEnergyBase* perfEnergyModel = m_device ? m_device->getPerfEnergyModel() : nullptr;
+  if (!perfEnergyModel || !perfEnergyModel->getResourceTimeline().hasTimeline()) {
+    return nullptr;
+  }
+  return &perfEnergyModel->getResourceTimeline();
+}
+
+//! @brief  Show modeled runtime of the resource timeline, with commands overlapped across ranks, cores and streams
+void
+pimStatsMgr::showResourceStats() const
+{
+  const pimResourceTimeline* timeline = getResourceTimeline();
+  if (!timeline) {
+    return;
+  }
+  double msSerialized = timeline->getMsSerialized();
+  double msOverlapped = timeline->getMsOverlapped();
+  std::printf("PIM Resource Timeline Stats:\n");
+  std::printf(" %44s : %14f ms\n", "Host-Device Copy", timeline->getMsCopy());
+  std::printf(" %44s : %14f ms\n", "Computation", timeline->getMsCompute());
+  std::printf(" %44s : %14f ms\n", "Serialized Runtime", msSerialized);
+  std::printf(" %44s : %14f ms (%.2fx speedup over serialized)\n", "Overlapped Runtime", msOverlapped,
+              msOverlapped > 0.0 ? msSerialized / msOverlapped : 0.0);
+}
+
+//! @brief  Get device params to be exported
+std::vector<pimStatsMgr::deviceParam>
+pimStatsMgr::getDeviceParams() const
+{
+  const pimParamsDram& paramsDram = pimSim::get()->getParamsDram();
+  std::vector<deviceParam> params;
+  if (m_device) {
+    params.push_back({"device_id", std::to_string(m_device->getDeviceId()), false});
+    params.push_back({"device_type", pimUtils::pimDeviceEnumToStr(m_device->getDeviceType()), true});
+    params.push_back({"sim_target", pimUtils::pimDeviceEnumToStr(m_device->getSimTarget()), true});
+    params.push_back({"sim_mode", pimSim::get()->isPerfOnly() ? "perf_only" : "functional", true});
+    params.push_back({"num_ranks", std::to_string(m_device->getNumRanks()), false});
+    params.push_back({"num_bank_per_rank", std::to_string(m_device->getNumBankPerRank()), false});
+    params.push_back({"num_subarray_per_bank", std::to_string(m_device->getNumSubarrayPerBank()), false});
+    params.push_back({"num_row_per_subarray", std::to_string(m_device->getNumRowPerSubarray()), false});
+    params.push_back({"num_col_per_subarray", std::to_string(m_device->getNumColPerSubarray()), false});
+    params.push_back({"num_cores", std::to_string(m_device->getNumCores()), false});
+    params.push_back({"num_rows_per_core", std::to_string(m_device->getNumRows()), false});
+    params.push_back({"num_cols_per_core", std::to_string(m_device->getNumCols()), false});
+    params.push_back({"num_materialized_cores", std::to_string(m_device->getNumMaterializedCores()), false});
+    params.push_back({"materialized_bytes", std::to_string(m_device->getMaterializedBytes()), false});
+    params.push_back({"nominal_bytes", std::to_string(m_device->getNominalBytes()), false});
+    const pimResMgr* resMgr = m_device->getResMgr();
+    if (resMgr) {
+      params.push_back({"alloc_policy", resMgr->getAllocPolicy() == PimAllocPolicy::BEST_FIT ? "best_fit" : "first_fit", true});
+      params.push_back({"max_rows_in_use", std::to_string(resMgr->getMaxRowsInUse()), false});
+      params.push_back({"num_compactions", std::to_string(resMgr->getNumCompactions()), false});
+      params.push_back({"num_rows_compacted", std::to_string(resMgr->getNumRowsCompacted()), false});
+      params.push_back({"obj_pool", resMgr->isObjPoolEnabled() ? "on" : "off", true});
+      params.push_back({"num_obj_pool_hits", std::to_string(resMgr->getNumObjPoolHits()), false});
+      params.push_back({"num_obj_pool_misses", std::to_string(resMgr->getNumObjPoolMisses()), false});
+      params.push_back({"num_pooled_objs", std::to_string(resMgr->getNumPooledObjs()), false});
+    }
+  }
+  params.push_back({"typical_rank_bw_gbps", formatDouble(paramsDram.getTypicalRankBW()), false});
+  params.push_back({"row_read_ns", formatDouble(paramsDram.getNsRowRead()), false});
+  params.push_back({"row_write_ns", formatDouble(paramsDram.getNsRowWrite()), false});
+  params.push_back({"tccd_ns", formatDouble(paramsDram.getNsTCCD_S()), false});
+  params.push_back({"aap_ns", formatDouble(paramsDram.getNsAAP()), false});
+  return params;
+}
+
+//! @brief  Export stats of this device as a JSON object, with each line prefixed by indent
+void
+pimStatsMgr::exportJson(std::ostream& os, const std::string& indent) const
+{
+  os << "{\n";
+  os << indent << "  \"params\": {";
+  const char* sep = "\n";
+  for (const deviceParam& param : getDeviceParams()) {
+    os << sep << indent << "    " << pimUtils::quoteJson(param.m_name) << ": " << (param.m_isString ? pimUtils::quoteJson(param.m_value) : (param.m_value.empty() ? "null" : param.m_value));
+    sep = ",\n";
+  }
+  os << "\n" << indent << "  },\n";
+
+  os << indent << "  \"commands\": [";
+  sep = "\n";
+  for (const auto& [cmdName, item] : getCmdStats()) {
+    os << sep << indent << "    {\"name\": " << pimUtils::quoteJson(cmdName) << ", \"count\": " << item.first << ", ";
+    writeJsonPerfEnergy(os, item.second);
+    os << "}";
+    sep = ",\n";
+  }
+  os << "\n" << indent << "  ],\n";
+
+  os << indent << "  \"copy\": {\n";
+  os << indent << "    \"host_to_device\": {\"bytes\": " << m_bitsCopiedMainToDevice / 8
+     << ", \"ms_runtime\": " << formatJsonDouble(m_elapsedTimeCopiedMainToDevice) << ", \"mj_energy\": " << formatJsonDouble(m_mJCopiedMainToDevice) << "},\n";
+  os << indent << "    \"device_to_host\": {\"bytes\": " << m_bitsCopiedDeviceToMain / 8
+     << ", \"ms_runtime\": " << formatJsonDouble(m_elapsedTimeCopiedDeviceToMain) << ", \"mj_energy\": " << formatJsonDouble(m_mJCopiedDeviceToMain) << "},\n";
+  os << indent << "    \"device_to_device\": {\"bytes\": " << m_bitsCopiedDeviceToDevice / 8
+     << ", \"ms_runtime\": " << formatJsonDouble(m_elapsedTimeCopiedDeviceToDevice) << ", \"mj_energy\": " << formatJsonDouble(m_mJCopiedDeviceToDevice) << "}\n";
+  os << indent << "  },\n";
+
+  os << indent << "  \"api\": [";
+  sep = "\n";
+  double msHostElapsed = 0.0;
+  for (const auto& [tag, item] : getApiStats()) {
+    os << sep << indent << "    {\"name\": " << pimUtils::quoteJson(tag) << ", \"count\": " << item.first << ", \"ms_elapsed\": " << formatJsonDouble(item.second) << "}";
+    msHostElapsed += item.second;
+    sep = ",\n";
+  }
+  os << "\n" << indent << "  ],\n";
+
+  os << indent << "  \"phases\": [";
+  sep = "\n";
+  for (unsigned child : m_phases.empty() ? std::vector<unsigned>() : m_phases[0].m_children) {
+    os << sep;
+    exportPhaseJson(os, indent + "    ", child);
+    sep = ",\n";
+  }
+  os << "\n" << indent << "  ],\n";
+
+  if (const pimResourceTimeline* timeline = getResourceTimeline()) {
+    os << indent << "  \"timeline\": {\"count\": " << timeline->getNumCmds()
+       << ", \"ms_serialized\": " << formatJsonDouble(timeline->getMsSerialized())
+       << ", \"ms_overlapped\": " << formatJsonDouble(timeline->getMsOverlapped()) << "},\n";
+  }
+
+  uint64_t numCmds = 0;
+  pimeval::perfEnergy total = getTotalPerfEnergy(numCmds);
+  os << indent << "  \"total\": {\"count\": " << numCmds << ", ";
+  writeJsonPerfEnergy(os, total);
+  os << ", \"ms_host_elapsed\": " << formatJsonDouble(msHostElapsed) << "}\n";
+  os << indent << "}";
+}
+
+//! @brief  Export aggregate stats of multiple devices as a JSON object
+void
+pimStatsMgr::exportMultiDeviceJson(std::ostream& os, const std::vector<const pimStatsMgr*>& deviceStats)
+{
+  multiDeviceStats aggregate = getMultiDeviceStats(deviceStats);
+  os << "{\"count\": " << aggregate.m_numCmds << ", \"ms_serialized\": " << formatJsonDouble(aggregate.m_msSerialized)
+     << ", \"ms_fan_out\": " << formatJsonDouble(aggregate.m_msFanOut) << ", \"ms_parallel\": " << formatJsonDouble(aggregate.m_msParallel)
+     << ", \"mj_energy\": " << formatJsonDouble(aggregate.m_mjEnergy) << "}";
+}
+
+//! @brief  Export CSV header. All sections share one table, with unused columns left empty
+void
+pimStatsMgr::exportCsvHeader(std::ostream& os)
+{
+  os << "device,section,name,count,value,ms_runtime,ms_read,ms_write,ms_logic,ms_other,"
+     << "mj_energy,mj_read,mj_write,mj_logic,mj_background,mj_other\n";
+}
+
+//! @brief  Export stats of this device as CSV rows
+void
+pimStatsMgr::exportCsv(std::ostream& os) const
+{
+  std::string device = m_device ? std::to_string(m_device->getDeviceId()) : "";
+  for (const deviceParam& param : getDeviceParams()) {
+    os << device << ",param," << param.m_name << ",," << quoteCsv(param.m_value) << ",,,,,,,,,,,\n";
+  }
+  for (const auto& [cmdName, item] : getCmdStats()) {
+    os << device << ",command," << quoteCsv(cmdName) << "," << item.first << ",";
+    writeCsvPerfEnergy(os, item.second);
+  }
+  const std::pair<const char*, uint64_t> copyBits[] = {
+    {"host_to_device", m_bitsCopiedMainToDevice},
+    {"device_to_host", m_bitsCopiedDeviceToMain},
+    {"device_to_device", m_bitsCopiedDeviceToDevice},
+  };
+  const pimeval::perfEnergy copyPerfEnergy[] = {
+    pimeval::perfEnergy(m_elapsedTimeCopiedMainToDevice, m_mJCopiedMainToDevice),
+    pimeval::perfEnergy(m_elapsedTimeCopiedDeviceToMain, m_mJCopiedDeviceToMain),
+    pimeval::perfEnergy(m_elapsedTimeCopiedDeviceToDevice, m_mJCopiedDeviceToDevice),
+  };
+  for (unsigned i = 0; i < 3; ++i) {
+    os << device << ",copy," << copyBits[i].first << ",," << copyBits[i].second / 8 << ",";
+    os << formatDouble(copyPerfEnergy[i].m_msRuntime) << ",,,,," << formatDouble(copyPerfEnergy[i].m_mjEnergy) << ",,,,,\n";
+  }
+  for (const auto& [tag, item] : getApiStats()) {
+    os << device << ",api," << quoteCsv(tag) << "," << item.first << ",," << formatDouble(item.second) << ",,,,,,,,,,\n";
+  }
+  // phases are named by their paths, e.g., layer1/conv
+  std::vector<std::pair<unsigned, std::string>> phases;
+  if (!m_phases.empty()) {
+    for (auto it = m_phases[0].m_children.rbegin(); it != m_phases[0].m_children.rend(); ++it) {
+      phases.emplace_back(*it, m_phases[*it].m_name);
+    }
+  }
+  while (!phases.empty()) {
+    auto [node, path] = phases.back();
+    phases.pop_back();
+    const phaseNode& phase = m_phases[node];
+    os << device << ",phase," << quoteCsv(path) << "," << phase.m_totals.m_numCmds << "," << phase.m_numCalls << ","
+       << formatDouble(phase.m_totals.m_msRuntime) << ",,,,," << formatDouble(phase.m_totals.m_mjEnergy) << ",,,,,\n";
+    os << device << ",phase_copy," << quoteCsv(path) << ",," << phase.m_totals.m_bitsCopied / 8 << ","
+       << formatDouble(phase.m_totals.m_msCopy) << ",,,,,,,,,,\n";
+    os << device << ",phase_host," << quoteCsv(path) << ",,," << formatDouble(phase.m_msHostElapsed) << ",,,,,,,,,,\n";
+    for (auto it = phase.m_children.rbegin(); it != phase.m_children.rend(); ++it) {
+      phases.emplace_back(*it, path + "/" + m_phases[*it].m_name);
+    }
+  }
+
+  if (const pimResourceTimeline* timeline = getResourceTimeline()) {
+    os << device << ",timeline,serialized," << timeline->getNumCmds() << ",," << formatDouble(timeline->getMsSerialized()) << ",,,,,,,,,,\n";
+    os << device << ",timeline,overlapped,,," << formatDouble(timeline->getMsOverlapped()) << ",,,,,,,,,,\n";
+  }
+
+  uint64_t numCmds = 0;
+  pimeval::perfEnergy total = getTotalPerfEnergy(numCmds);
+  os << device << ",total,all," << numCmds << ",";
+  writeCsvPerfEnergy(os, total);
+}
+
+//! @brief  Export aggregate stats of multiple devices as CSV rows
+void
+pimStatsMgr::exportMultiDeviceCsv(std::ostream& os, const std::vector<const pimStatsMgr*>& deviceStats)
+{
+  multiDeviceStats aggregate = getMultiDeviceStats(deviceStats);
+  os << ",multi_device,serialized," << aggregate.m_numCmds << ",," << formatDouble(aggregate.m_msSerialized)
+     << ",,,,," << formatDouble(aggregate.m_mjEnergy) << ",,,,,\n";
+  os << ",multi_device,fan_out,,," << formatDouble(aggregate.m_msFanOut) << ",,,,,,,,,,\n";
+  os << ",multi_device,parallel,,," << formatDouble(aggregate.m_msParallel) << ",,,,,,,,,,\n";
+}
+
+//! @brief  Get totals recorded by all threads and copy stats
+pimStatsMgr::recordedTotals
+pimStatsMgr::getRecordedTotals() const
+{
+  recordedTotals totals;
+  {
+    std::lock_guard<std::mutex> lock(m_threadStatsMutex);
+    for (const auto& stats : m_threadStats) {
+      totals.m_numCmds += stats->m_numCmdsRecorded;
+      totals.m_msRuntime += stats->m_recorded.m_msRuntime;
+      totals.m_mjEnergy += stats->m_recorded.m_mjEnergy;
+    }
+  }
+  totals.m_bitsCopied = m_bitsCopiedMainToDevice + m_bitsCopiedDeviceToMain + m_bitsCopiedDeviceToDevice;
+  totals.m_msCopy = m_elapsedTimeCopiedMainToDevice + m_elapsedTimeCopiedDeviceToMain + m_elapsedTimeCopiedDeviceToDevice;
+  return totals;
+}
+
+//! @brief  Begin a phase nested in the current phase. A phase of the same name under the same parent is reused
+void
+pimStatsMgr::beginPhase(const std::string& name)
+{
+  if (m_phases.empty()) {
+    m_phases.emplace_back(); // root
+  }
+  unsigned parent = m_openPhases.empty() ? 0 : m_openPhases.back().m_node;
+  unsigned node = 0;
+  auto& children = m_phases[parent].m_children;
+  auto it = std::find_if(children.begin(), children.end(), [&](unsigned child) { return m_phases[child].m_name == name; });
+  if (it != children.end()) {
+    node = *it;
+  } else {
+    node = m_phases.size();
+    children.push_back(node);
+    m_phases.emplace_back();
+    m_phases[node].m_name = name;
+    m_phases[node].m_depth = m_phases[parent].m_depth + 1;
+  }
+  m_openPhases.push_back({node, getRecordedTotals(), std::chrono::steady_clock::now()});
+}
+
+//! @brief  End the current phase and attribute stats recorded since it began. Return false if no phase is open
+bool
+pimStatsMgr::endPhase()
+{
+  if (m_openPhases.empty()) {
+    return false;
+  }
+  openPhase phase = m_openPhases.back();
+  m_openPhases.pop_back();
+  recordedTotals now = getRecordedTotals();
+  phaseNode& node = m_phases[phase.m_node];
+  node.m_numCalls++;
+  node.m_totals.m_numCmds += now.m_numCmds - phase.m_begin.m_numCmds;
+  node.m_totals.m_msRuntime += now.m_msRuntime - phase.m_begin.m_msRuntime;
+  node.m_totals.m_mjEnergy += now.m_mjEnergy - phase.m_begin.m_mjEnergy;
+  node.m_totals.m_bitsCopied += now.m_bitsCopied - phase.m_begin.m_bitsCopied;
+  node.m_totals.m_msCopy += now.m_msCopy - phase.m_begin.m_msCopy;
+  node.m_msHostElapsed += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - phase.m_wallBegin).count();
+  return true;
+}
+
+//! @brief  Show stats of the phase tree. Runtime and energy include data copy
+void
+pimStatsMgr::showPhaseStats() const
+{
+  if (m_phases.size() <= 1) {
+    return;
+  }
+  std::printf("PIM Phase Stats:\n");
+  std::printf(" %-44s : %8s %10s %14s %14s %14s %14s\n", "PIM-PHASE", "CALLS", "CMDS", "Runtime(ms)", "Energy(mJ)",
+              "CopyBytes", "HostElapsed(ms)");
+  // depth-first in the order phases first began
+  std::vector<unsigned> nodes(m_phases[0].m_children.rbegin(), m_phases[0].m_children.rend());
+  while (!nodes.empty()) {
+    const phaseNode& node = m_phases[nodes.back()];
+    nodes.pop_back();
+    std::string name = std::string(2 * (node.m_depth - 1), ' ') + node.m_name;
+    std::printf(" %-44s : %8llu %10llu %14f %14f %14llu %14f\n", name.c_str(), (unsigned long long)node.m_numCalls,
+                (unsigned long long)node.m_totals.m_numCmds, node.m_totals.m_msRuntime, node.m_totals.m_mjEnergy,
+                (unsigned long long)node.m_totals.m_bitsCopied / 8, node.m_msHostElapsed);
+    nodes.insert(nodes.end(), node.m_children.rbegin(), node.m_children.rend());
+  }
+  if (!m_openPhases.empty()) {
+    std::printf(" %-44s : %zu phase(s) not ended yet\n", "Open Phases", m_openPhases.size());
+  }
+}
+
+//! @brief  Export a phase and its children as a JSON object
+void
+pimStatsMgr::exportPhaseJson(std::ostream& os, const std::string& indent, unsigned node) const
+{
+  const phaseNode& phase = m_phases[node];
+  os << indent << "{\"name\": " << pimUtils::quoteJson(phase.m_name) << ", \"calls\": " << phase.m_numCalls
+     << ", \"commands\": " << phase.m_totals.m_numCmds << ", \"ms_runtime\": " << formatJsonDouble(phase.m_totals.m_msRuntime)
+     << ", \"mj_energy\": " << formatJsonDouble(phase.m_totals.m_mjEnergy) << ", \"copy_bytes\": " << phase.m_totals.m_bitsCopied / 8
+     << ", \"ms_copy\": " << formatJsonDouble(phase.m_totals.m_msCopy) << ", \"ms_host_elapsed\": " << formatJsonDouble(phase.m_msHostElapsed)
+     << ", \"children\": [";
+  const char* sep = "\n";
+  for (unsigned child : phase.m_children) {
+    os << sep;
+    exportPhaseJson(os, indent + "  ", child);
+    sep = ",\n";
+  }
+  os << (phase.m_children.empty() ? "" : "\n" + indent) << "]}";
+}
+
 //! @brief  Reset PIM stats
 void
 pimStatsMgr::resetStats()
 {
-  m_cmdPerf.clear();
-  m_msElapsed.clear();
+  {
+    std::lock_guard<std::mutex> lock(m_threadStatsMutex);
+    for (auto& stats : m_threadStats) {
+      std::fill(stats->m_cmdCounters.begin(), stats->m_cmdCounters.end(), cmdCounter());
+      stats->m_multiRowCmdCounters.clear();
+      stats->m_msElapsed.clear();
+    }
+  }
   m_bitsCopiedMainToDevice = 0;
   m_bitsCopiedDeviceToMain = 0;
   m_bitsCopiedDeviceToDevice = 0;
+  m_elapsedTimeCopiedMainToDevice = 0.0;
+  m_elapsedTimeCopiedDeviceToMain = 0.0;
+  m_elapsedTimeCopiedDeviceToDevice = 0.0;
+  m_mJCopiedMainToDevice = 0.0;
+  m_mJCopiedDeviceToMain = 0.0;
+  m_mJCopiedDeviceToDevice = 0.0;
+
+  // keep the phase tree and open phases, which restart from now
+  for (phaseNode& node : m_phases) {
+    node.m_numCalls = 0;
+    node.m_totals = recordedTotals();
+    node.m_msHostElapsed = 0.0;
+  }
+  if (!m_openPhases.empty()) {
+    recordedTotals now = getRecordedTotals();
+    for (openPhase& phase : m_openPhases) {
+      phase.m_begin = now;
+      phase.m_wallBegin = std::chrono::steady_clock::now();
+    }
+  }
+}
+
+//! @brief  Save merged command counters, API stats and copy stats into a checkpoint
+void
+pimStatsMgr::saveCheckpoint(pimCheckpointWriter& writer) const
+{
+  std::vector<cmdCounter> cmdCounters(s_numCmdIndices);
+  std::map<uint64_t, cmdCounter> multiRowCmdCounters;
+  std::map<std::string, std::pair<int, double>> apiStats;
+  {
+    auto merge = [](cmdCounter& merged, const cmdCounter& counter) {
+      merged.m_count += counter.m_count;
+      merged.m_perfEnergy.add(counter.m_perfEnergy);
+    };
+    std::lock_guard<std::mutex> lock(m_threadStatsMutex);
+    for (const auto& stats : m_threadStats) {
+      for (unsigned i = 0; i < s_numCmdIndices; ++i) {
+        merge(cmdCounters[i], stats->m_cmdCounters[i]);
+      }
+      for (const auto& [key, counter] : stats->m_multiRowCmdCounters) {
+        merge(multiRowCmdCounters[key], counter);
+      }
+      for (const auto& [tag, item] : stats->m_msElapsed) {
+        auto& merged = apiStats[tag];
+        merged.first += item.first;
+        merged.second += item.second;
+      }
+    }
+  }
+
+  writer.writeSection(PimCheckpointSection::STATS);
+  writer.write(s_numCmdTypes);
+  writer.write(s_numDataTypes);
+  uint32_t numCmdCounters = std::count_if(cmdCounters.begin(), cmdCounters.end(), [](const cmdCounter& counter) { return counter.m_count > 0; });
+  writer.write(numCmdCounters);
+  for (unsigned i = 0; i < s_numCmdIndices; ++i) {
+    if (cmdCounters[i].m_count > 0) {
+      writer.write(i);
+      writer.write(cmdCounters[i]);
+    }
+  }
+  writer.write(static_cast<uint32_t>(multiRowCmdCounters.size()));
+  for (const auto& [key, counter] : multiRowCmdCounters) {
+    writer.write(key);
+    writer.write(counter);
+  }
+  writer.write(static_cast<uint32_t>(apiStats.size()));
+  for (const auto& [tag, item] : apiStats) {
+    writer.writeString(tag);
+    writer.write(item.first);
+    writer.write(item.second);
+  }
+
+  writer.write(m_bitsCopiedMainToDevice);
+  writer.write(m_bitsCopiedDeviceToMain);
+  writer.write(m_bitsCopiedDeviceToDevice);
+  writer.write(m_elapsedTimeCopiedMainToDevice);
+  writer.write(m_elapsedTimeCopiedDeviceToMain);
+  writer.write(m_elapsedTimeCopiedDeviceToDevice);
+  writer.write(m_mJCopiedMainToDevice);
+  writer.write(m_mJCopiedDeviceToMain);
+  writer.write(m_mJCopiedDeviceToDevice);
+}
+
+//! @brief  Replace all stats with those from a checkpoint, which are restored into the table of calling thread.
+//!         Command types added after the checkpoint was saved are appended, so command indices stay valid
+bool
+pimStatsMgr::loadCheckpoint(pimCheckpointReader& reader)
+{
+  unsigned numCmdTypes = 0;
+  unsigned numDataTypes = 0;
+  if (!reader.readSection(PimCheckpointSection::STATS) || !reader.read(numCmdTypes) || !reader.read(numDataTypes) ||
+      numCmdTypes > s_numCmdTypes || numDataTypes != s_numDataTypes) {
+    return false;
+  }
+  resetStats();
+  threadStats& stats = getThreadStats();
+
+  uint32_t numCmdCounters = 0;
+  if (!reader.read(numCmdCounters)) {
+    return false;
+  }
+  for (uint32_t i = 0; i < numCmdCounters; ++i) {
+    unsigned cmdIndex = 0;
+    cmdCounter counter;
+    if (!reader.read(cmdIndex) || !reader.read(counter) || cmdIndex >= s_numCmdIndices) {
+      return false;
+    }
+    stats.m_cmdCounters[cmdIndex] = counter;
+  }
+  uint32_t numMultiRowCmdCounters = 0;
+  if (!reader.read(numMultiRowCmdCounters)) {
+    return false;
+  }
+  for (uint32_t i = 0; i < numMultiRowCmdCounters; ++i) {
+    uint64_t key = 0;
+    cmdCounter counter;
+    if (!reader.read(key) || !reader.read(counter) || (key & 0xffffffff) >= s_numCmdIndices) {
+      return false;
+    }
+    stats.m_multiRowCmdCounters[key] = counter;
+  }
+  uint32_t numApis = 0;
+  if (!reader.read(numApis)) {
+    return false;
+  }
+  for (uint32_t i = 0; i < numApis; ++i) {
+    std::string tag;
+    std::pair<int, double> item;
+    if (!reader.readString(tag) || !reader.read(item.first) || !reader.read(item.second)) {
+      return false;
+    }
+    // API stats are keyed by tag pointers, which need to outlive the stats
+    const char* tagPtr = m_restoredTags.insert(tag).first->c_str();
+    stats.m_msElapsed[tagPtr] = item;
+  }
+
+  return reader.read(m_bitsCopiedMainToDevice) && reader.read(m_bitsCopiedDeviceToMain) &&
+         reader.read(m_bitsCopiedDeviceToDevice) && reader.read(m_elapsedTimeCopiedMainToDevice) &&
+         reader.read(m_elapsedTimeCopiedDeviceToMain) && reader.read(m_elapsedTimeCopiedDeviceToDevice) &&
+         reader.read(m_mJCopiedMainToDevice) && reader.read(m_mJCopiedDeviceToMain) && reader.read(m_mJCopiedDeviceToDevice);
 }
 
 //! @brief pimPerfMon ctor
-pimPerfMon::pimPerfMon(const std::string& tag)
+pimPerfMon::pimPerfMon(const char* tag)
 {
   m_startTime = std::chrono::high_resolution_clock::now();
   m_tag = tag;
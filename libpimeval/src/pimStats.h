@@ -13,72 +13,210 @@
 #include <cstdint>
 #include <string>
 #include <map>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <chrono>
+#include <set>
+#include <ostream>
+
+class pimDevice;
+class pimCheckpointWriter;
+class pimCheckpointReader;
 
 //! @class  pimPerfMon
 //! @brief  PIM performance monitor
 class pimPerfMon
 {
 public:
-  pimPerfMon(const std::string& tag);
+  pimPerfMon(const char* tag);
   ~pimPerfMon();
 
 private:
   std::chrono::time_point<std::chrono::high_resolution_clock> m_startTime;
-  std::string m_tag;
+  const char* m_tag;
 };
 
 
 //! @class  pimStats
 //! @brief  PIM stats manager
+//!
+//! Commands are counted in a dense table indexed by (PimCmdEnum, PimDataType, layout) without
+//! building names. Each thread records into its own table, and tables are merged by name only
+//! when stats are shown. Show and reset are expected to be called when no command is in flight.
+//! Each PIM device has its own stats manager. The simulator keeps one for API calls before any device.
 class pimStatsMgr
 {
 public:
-  pimStatsMgr() {}
+  pimStatsMgr(const pimDevice* device = nullptr);
   ~pimStatsMgr() {}
 
   void showStats() const;
   void resetStats();
-  
-  void recordCmd(const std::string& cmdName, pimeval::perfEnergy mPerfEnergy) {
-    auto& item = m_cmdPerf[cmdName];
-    item.first++;
-    item.second.m_msRuntime += mPerfEnergy.m_msRuntime;
-    item.second.m_mjEnergy += mPerfEnergy.m_mjEnergy;
+  static void showMultiDeviceStats(const std::vector<const pimStatsMgr*>& deviceStats);
+  void exportJson(std::ostream& os, const std::string& indent) const;
+  void exportCsv(std::ostream& os) const;
+  static void exportMultiDeviceJson(std::ostream& os, const std::vector<const pimStatsMgr*>& deviceStats);
+  static void exportMultiDeviceCsv(std::ostream& os, const std::vector<const pimStatsMgr*>& deviceStats);
+  static void exportCsvHeader(std::ostream& os);
+  void saveCheckpoint(pimCheckpointWriter& writer) const;
+  void beginPhase(const std::string& name);
+  bool endPhase();
+  bool loadCheckpoint(pimCheckpointReader& reader);
+
+  //! @brief  Record a command with data type and layout, e.g., add.int32.v
+  void recordCmd(PimCmdEnum cmdType, PimDataType dataType, bool isVLayout, pimeval::perfEnergy mPerfEnergy) {
+    threadStats& stats = getThreadStats();
+    stats.m_cmdCounters[getCmdIndex(cmdType, dataType, isVLayout)].add(mPerfEnergy);
+    stats.m_numCmdsRecorded++;
+    stats.m_recorded.add(mPerfEnergy);
+  }
+  //! @brief  Record a command without data type, e.g., row_r
+  void recordCmd(PimCmdEnum cmdType, pimeval::perfEnergy mPerfEnergy) {
+    threadStats& stats = getThreadStats();
+    stats.m_cmdCounters[getCmdIndex(cmdType)].add(mPerfEnergy);
+    stats.m_numCmdsRecorded++;
+    stats.m_recorded.add(mPerfEnergy);
+  }
+  //! @brief  Record a multi-row command with number of src and dest rows, e.g., row_aap@3,1
+  void recordCmd(PimCmdEnum cmdType, unsigned numSrcRows, unsigned numDestRows, pimeval::perfEnergy mPerfEnergy) {
+    uint64_t key = (uint64_t)getCmdIndex(cmdType) | ((uint64_t)numSrcRows << 32) | ((uint64_t)numDestRows << 48);
+    threadStats& stats = getThreadStats();
+    stats.m_multiRowCmdCounters[key].add(mPerfEnergy);
+    stats.m_numCmdsRecorded++;
+    stats.m_recorded.add(mPerfEnergy);
   }
 
-  void recordMsElapsed(const std::string& tag, double elapsed) {
-    auto& item = m_msElapsed[tag];
+  void recordMsElapsed(const char* tag, double elapsed) {
+    auto& item = getThreadStats().m_msElapsed[tag];
     item.first++;
     item.second += elapsed;
   }
 
+  //! @brief  Get total modeled energy recorded by the calling thread. Not cleared by reset, used for deltas
+  double getThreadMjEnergy() { return getThreadStats().m_recorded.m_mjEnergy; }
+  //! @brief  Get totals and components recorded by the calling thread. Not cleared by reset, used for deltas
+  pimeval::perfEnergy getThreadPerfEnergy() { return getThreadStats().m_recorded; }
+
+  std::map<std::string, std::pair<int, pimeval::perfEnergy>> getCmdStats() const;
+  std::map<std::string, std::pair<int, double>> getApiStats() const;
+  pimeval::perfEnergy getTotalPerfEnergy(uint64_t& numCmds) const;
+
   void recordCopyMainToDevice(uint64_t numBits, pimeval::perfEnergy mPerfEnergy) {
     m_bitsCopiedMainToDevice += numBits;
     m_elapsedTimeCopiedMainToDevice += mPerfEnergy.m_msRuntime;
     m_mJCopiedMainToDevice += mPerfEnergy.m_mjEnergy;
+    threadStats& stats = getThreadStats();
+    stats.m_recorded.add(mPerfEnergy);
   }
 
   void recordCopyDeviceToMain(uint64_t numBits, pimeval::perfEnergy mPerfEnergy) {
     m_bitsCopiedDeviceToMain += numBits; 
     m_elapsedTimeCopiedDeviceToMain += mPerfEnergy.m_msRuntime;
     m_mJCopiedDeviceToMain += mPerfEnergy.m_mjEnergy;
+    threadStats& stats = getThreadStats();
+    stats.m_recorded.add(mPerfEnergy);
   }
   
   void recordCopyDeviceToDevice(uint64_t numBits, pimeval::perfEnergy mPerfEnergy) {
     m_bitsCopiedDeviceToDevice += numBits;
     m_elapsedTimeCopiedDeviceToDevice += mPerfEnergy.m_msRuntime;
     m_mJCopiedDeviceToDevice += mPerfEnergy.m_mjEnergy;
+    threadStats& stats = getThreadStats();
+    stats.m_recorded.add(mPerfEnergy);
   }
 
 private:
+  //! @brief  Command counter of one table entry, with runtime and energy components
+  struct cmdCounter {
+    uint64_t m_count = 0;
+    pimeval::perfEnergy m_perfEnergy;
+    void add(const pimeval::perfEnergy& mPerfEnergy) {
+      ++m_count;
+      m_perfEnergy.add(mPerfEnergy);
+    }
+  };
+  //! @brief  Stats recorded by one thread
+  struct threadStats {
+    std::vector<cmdCounter> m_cmdCounters;
+    std::unordered_map<uint64_t, cmdCounter> m_multiRowCmdCounters;
+    std::unordered_map<const char*, std::pair<int, double>> m_msElapsed;
+    pimeval::perfEnergy m_recorded;
+    uint64_t m_numCmdsRecorded = 0;
+  };
+
+  static constexpr unsigned s_numCmdTypes = static_cast<unsigned>(PimCmdEnum::ROW_CLONE) + 1;
+  static constexpr unsigned s_numDataTypes = static_cast<unsigned>(PIM_FP32) + 2; // last one for untyped
+  static constexpr unsigned s_numCmdIndices = s_numCmdTypes * s_numDataTypes * 2;
+
+  static unsigned getCmdIndex(PimCmdEnum cmdType, PimDataType dataType, bool isVLayout) {
+    return ((static_cast<unsigned>(cmdType) * s_numDataTypes) + static_cast<unsigned>(dataType)) * 2 + (isVLayout ? 0 : 1);
+  }
+  static unsigned getCmdIndex(PimCmdEnum cmdType) {
+    return ((static_cast<unsigned>(cmdType) * s_numDataTypes) + s_numDataTypes - 1) * 2;
+  }
+  //! @brief  Aggregate of multiple devices running in parallel
+  struct multiDeviceStats {
+    uint64_t m_numCmds = 0;
+    double m_msSerialized = 0.0;
+    double m_msMaxDevice = 0.0;
+    double m_msFanOut = 0.0;
+    double m_msParallel = 0.0;
+    double m_mjEnergy = 0.0;
+  };
+  //! @brief  Totals recorded by all threads, which are not cleared by reset. Deltas are attributed to phases
+  struct recordedTotals {
+    uint64_t m_numCmds = 0;
+    double m_msRuntime = 0.0;
+    double m_mjEnergy = 0.0;
+    uint64_t m_bitsCopied = 0;
+    double m_msCopy = 0.0;
+  };
+  //! @brief  A node of the phase tree. Phases of the same name under the same parent share a node
+  struct phaseNode {
+    std::string m_name;
+    unsigned m_depth = 0;
+    std::vector<unsigned> m_children;
+    uint64_t m_numCalls = 0;
+    recordedTotals m_totals;
+    double m_msHostElapsed = 0.0;
+  };
+  //! @brief  A phase which has begun but not ended
+  struct openPhase {
+    unsigned m_node = 0;
+    recordedTotals m_begin;
+    std::chrono::steady_clock::time_point m_wallBegin;
+  };
+  //! @brief  A device parameter with its value formatted for export
+  struct deviceParam {
+    std::string m_name;
+    std::string m_value;
+    bool m_isString;
+  };
+
+  static std::string getCmdName(unsigned cmdIndex);
+  threadStats& getThreadStats();
+  static multiDeviceStats getMultiDeviceStats(const std::vector<const pimStatsMgr*>& deviceStats);
+  std::vector<deviceParam> getDeviceParams() const;
+  recordedTotals getRecordedTotals() const;
+  void exportPhaseJson(std::ostream& os, const std::string& indent, unsigned node) const;
+
   void showApiStats() const;
   void showDeviceParams() const;
   void showCopyStats() const;
   void showCmdStats() const;
+  void showResourceStats() const;
+  const pimResourceTimeline* getResourceTimeline() const;
+  void showPhaseStats() const;
 
-  std::map<std::string, std::pair<int, pimeval::perfEnergy>> m_cmdPerf;
-  std::map<std::string, std::pair<int, double>> m_msElapsed;
+  const pimDevice* m_device;
+  uint64_t m_statsMgrId;
+  mutable std::mutex m_threadStatsMutex;
+  std::vector<std::unique_ptr<threadStats>> m_threadStats;
+  std::set<std::string> m_restoredTags;  // owns API tags restored from a checkpoint
+  std::vector<phaseNode> m_phases;  // phase tree, with the root at index 0 once any phase begins
+  std::vector<openPhase> m_openPhases;
 
   uint64_t m_bitsCopiedMainToDevice = 0;
   uint64_t m_bitsCopiedDeviceToMain = 0;
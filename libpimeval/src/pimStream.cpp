@@ -0,0 +1,304 @@
+// File: pimStream.cpp
+// PIMeval Simulator - Asynchronous Command Streams
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "pimStream.h"
+#include "pimDevice.h"
+#include "pimResMgr.h"
+#include "pimSim.h"
+#include "pimStats.h"
+#include "pimPerfEnergyBase.h"
+#include <cstdio>
+#include <algorithm>
+#include <iterator>
+
+
+//! @brief  pimStreamMgr ctor. Start the executor thread, which issues commands in the simulator context of the device
+pimStreamMgr::pimStreamMgr(pimDevice* device)
+  : m_device(device)
+{
+  pimSim* sim = pimSim::get();
+  m_thread = std::thread([this, sim] {
+    pimSim::setCurrent(sim);
+    workerThread();
+  });
+}
+
+//! @brief  pimStreamMgr dtor. Finish all pending commands and stop the executor thread
+pimStreamMgr::~pimStreamMgr()
+{
+  synchronizeAll();
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_terminate = true;
+  }
+  m_taskCond.notify_all();
+  m_thread.join();
+}
+
+//! @brief  Create a stream
+PimStreamId
+pimStreamMgr::createStream()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  PimStreamId stream = m_nextStreamId++;
+  m_streams[stream] = streamInfo();
+  return stream;
+}
+
+//! @brief  Destroy a stream after its pending commands are finished. Events recorded on it are released
+bool
+pimStreamMgr::destroyStream(PimStreamId stream)
+{
+  if (!synchronizeStream(stream)) {
+    return false;
+  }
+  getResourceTimeline().releaseStream(stream);
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_streams.erase(stream);
+  for (auto it = m_events.begin(); it != m_events.end();) {
+    it = (it->second.m_stream == stream) ? m_events.erase(it) : std::next(it);
+  }
+  return true;
+}
+
+//! @brief  Check if a stream ID is valid
+bool
+pimStreamMgr::isValidStream(PimStreamId stream) const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_streams.find(stream) != m_streams.end();
+}
+
+//! @brief  Wait until all commands of a stream are finished. Return false if any of them failed
+bool
+pimStreamMgr::synchronizeStream(PimStreamId stream)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  auto it = m_streams.find(stream);
+  if (it == m_streams.end()) {
+    std::printf("PIM-Error: Invalid PIM stream ID %d\n", stream);
+    return false;
+  }
+  m_doneCond.wait(lock, [&] { return it->second.m_numPending == 0; });
+  bool ok = !it->second.m_hasError;
+  it->second.m_hasError = false;
+  pimResourceTimeline& timeline = getResourceTimeline();
+  timeline.waitHost(timeline.getMsStreamReady(stream));
+  return ok;
+}
+
+//! @brief  Wait until all commands of all streams are finished
+void
+pimStreamMgr::synchronizeAll()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_doneCond.wait(lock, [&] { return m_numPending == 0; });
+  pimResourceTimeline& timeline = getResourceTimeline();
+  timeline.waitHost(timeline.getMsAllStreamsReady());
+}
+
+//! @brief  Record an event which completes when all prior commands of a stream are finished
+PimEventId
+pimStreamMgr::recordEvent(PimStreamId stream)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_streams.find(stream);
+  if (it == m_streams.end()) {
+    std::printf("PIM-Error: Invalid PIM stream ID %d\n", stream);
+    return -1;
+  }
+  PimEventId event = m_nextEventId++;
+  m_events[event].m_stream = stream;
+  streamTask task;
+  task.m_stream = stream;
+  task.m_event = event;
+  it->second.m_numPending++;
+  m_numPending++;
+  m_tasks.push_back(std::move(task));
+  m_taskCond.notify_one();
+  return event;
+}
+
+//! @brief  Block the host until an event is completed, then release the event
+bool
+pimStreamMgr::waitEvent(PimEventId event)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  auto it = m_events.find(event);
+  if (it == m_events.end()) {
+    std::printf("PIM-Error: Invalid PIM event ID %d\n", event);
+    return false;
+  }
+  m_doneCond.wait(lock, [&] { return it->second.m_isDone; });
+  getResourceTimeline().waitHost(it->second.m_msDone);
+  m_events.erase(it);
+  return true;
+}
+
+//! @brief  Enqueue a PIM command to a stream. Invalid commands are rejected here, and execution is deferred to the executor
+bool
+pimStreamMgr::enqueue(PimStreamId stream, std::unique_ptr<pimCmd> cmd)
+{
+  if (!isValidStream(stream)) {
+    std::printf("PIM-Error: Invalid PIM stream ID %d\n", stream);
+    return false;
+  }
+  if (!cmd->sanityCheck()) {
+    return false;
+  }
+  streamTask task;
+  task.m_isDeviceWide = !getDependencies(*cmd, task.m_objIds);
+  task.m_cmd = std::move(cmd);
+  task.m_stream = stream;
+  task.m_msIssue = getResourceTimeline().getMsHostReady();
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_streams.find(stream);
+  if (it == m_streams.end()) {
+    std::printf("PIM-Error: Invalid PIM stream ID %d\n", stream);
+    return false;
+  }
+  it->second.m_numPending++;
+  m_numPending++;
+  if (task.m_isDeviceWide) {
+    m_numPendingDeviceWide++;
+  }
+  for (PimObjId objId : task.m_objIds) {
+    m_pendingObjs[objId]++;
+  }
+  m_tasks.push_back(std::move(task));
+  m_taskCond.notify_one();
+  return true;
+}
+
+//! @brief  Block the host until pending stream commands that a synchronous command depends on are finished
+void
+pimStreamMgr::waitForCmd(const pimCmd& cmd)
+{
+  std::vector<PimObjId> objIds;
+  bool isDeviceWide = !getDependencies(cmd, objIds);
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_doneCond.wait(lock, [&] { return !hasPendingDependency(isDeviceWide, objIds); });
+}
+
+//! @brief  Block the host until pending stream commands accessing a PIM object are finished
+void
+pimStreamMgr::waitForObj(PimObjId objId)
+{
+  std::vector<PimObjId> objIds;
+  pimResMgr* resMgr = m_device->getResMgr();
+  if (resMgr->isValidObjId(objId)) {
+    PimObjId refId = resMgr->getObjInfo(objId).getRefObjId();
+    objIds.push_back(refId >= 0 ? refId : objId);
+  }
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_doneCond.wait(lock, [&] { return !hasPendingDependency(false, objIds); });
+}
+
+//! @brief  Get the resource timeline of the device, which models time of stream commands
+pimResourceTimeline&
+pimStreamMgr::getResourceTimeline() const
+{
+  return m_device->getPerfEnergyModel()->getResourceTimeline();
+}
+
+//! @brief  Get PIM objects accessed by a command. Reference objects are mapped to the objects they reference.
+//!         Return false if the command accesses device-wide states
+bool
+pimStreamMgr::getDependencies(const pimCmd& cmd, std::vector<PimObjId>& objIds) const
+{
+  if (!cmd.getObjIds(objIds)) {
+    return false;
+  }
+  pimResMgr* resMgr = m_device->getResMgr();
+  for (PimObjId& objId : objIds) {
+    if (resMgr->isValidObjId(objId)) {
+      PimObjId refId = resMgr->getObjInfo(objId).getRefObjId();
+      if (refId >= 0) {
+        objId = refId;
+      }
+    }
+  }
+  return true;
+}
+
+//! @brief  Check if there are pending commands accessing any of the objects. Caller holds the lock
+bool
+pimStreamMgr::hasPendingDependency(bool isDeviceWide, const std::vector<PimObjId>& objIds) const
+{
+  if (isDeviceWide) {
+    return m_numPending > 0;
+  }
+  if (m_numPendingDeviceWide > 0) {
+    return true;
+  }
+  for (PimObjId objId : objIds) {
+    auto it = m_pendingObjs.find(objId);
+    if (it != m_pendingObjs.end() && it->second > 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+//! @brief  Executor thread: run tasks in submission order
+void
+pimStreamMgr::workerThread()
+{
+  while (true) {
+    streamTask task;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_taskCond.wait(lock, [&] { return m_terminate || !m_tasks.empty(); });
+      if (m_tasks.empty()) {
+        return;
+      }
+      task = std::move(m_tasks.front());
+      m_tasks.pop_front();
+    }
+    executeTask(task);
+  }
+}
+
+//! @brief  Execute a task on the resource timeline of the device, and release its dependencies
+void
+pimStreamMgr::executeTask(streamTask& task)
+{
+  bool ok = true;
+  if (task.m_cmd) {
+    ok = m_device->runCmd(*task.m_cmd, task.m_stream, task.m_msIssue);
+    task.m_cmd.reset();
+  }
+  double msStreamReady = getResourceTimeline().getMsStreamReady(task.m_stream);
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_streams.find(task.m_stream);
+  if (it != m_streams.end()) {
+    if (!ok) {
+      it->second.m_hasError = true;
+    }
+    it->second.m_numPending--;
+  }
+  if (task.m_event >= 0) {
+    auto eventIt = m_events.find(task.m_event);
+    if (eventIt != m_events.end()) {
+      eventIt->second.m_isDone = true;
+      eventIt->second.m_msDone = msStreamReady;
+    }
+  }
+  m_numPending--;
+  if (task.m_isDeviceWide) {
+    m_numPendingDeviceWide--;
+  }
+  for (PimObjId objId : task.m_objIds) {
+    auto objIt = m_pendingObjs.find(objId);
+    if (--objIt->second == 0) {
+      m_pendingObjs.erase(objIt);
+    }
+  }
+  m_doneCond.notify_all();
+}
+
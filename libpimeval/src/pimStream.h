@@ -0,0 +1,96 @@
+// File: pimStream.h
+// PIMeval Simulator - Asynchronous Command Streams
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#ifndef LAVA_PIM_STREAM_H
+#define LAVA_PIM_STREAM_H
+
+#include "libpimeval.h"
+#include "pimCmd.h"
+#include <memory>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+class pimDevice;
+class pimResourceTimeline;
+
+
+//! @class  pimStreamMgr
+//! @brief  Execute PIM commands of asynchronous streams on a background thread
+//!
+//! Commands of all streams are executed in submission order by one executor thread, which keeps
+//! per-stream ordering and lets host code overlap with simulation. Pending commands are tracked by
+//! the PIM objects they access, so that synchronous APIs only wait for commands they depend on.
+//! Commands accessing device-wide states such as row registers depend on all pending commands.
+//!
+//! Modeled time of stream commands is kept by the resource timeline of the device: each command is
+//! issued at the modeled host time when it is enqueued, and the host catches up with a stream when it
+//! synchronizes the stream or waits for an event.
+class pimStreamMgr
+{
+public:
+  pimStreamMgr(pimDevice* device);
+  ~pimStreamMgr();
+
+  PimStreamId createStream();
+  bool destroyStream(PimStreamId stream);
+  bool isValidStream(PimStreamId stream) const;
+  bool synchronizeStream(PimStreamId stream);
+  void synchronizeAll();
+  PimEventId recordEvent(PimStreamId stream);
+  bool waitEvent(PimEventId event);
+
+  bool enqueue(PimStreamId stream, std::unique_ptr<pimCmd> cmd);
+  void waitForCmd(const pimCmd& cmd);
+  void waitForObj(PimObjId objId);
+
+private:
+  struct streamTask {
+    std::unique_ptr<pimCmd> m_cmd;
+    PimStreamId m_stream = 0;
+    PimEventId m_event = -1;
+    double m_msIssue = 0.0;
+    bool m_isDeviceWide = false;
+    std::vector<PimObjId> m_objIds;
+  };
+  struct eventInfo {
+    PimStreamId m_stream = 0;
+    bool m_isDone = false;
+    double m_msDone = 0.0;
+  };
+  struct streamInfo {
+    unsigned m_numPending = 0;
+    bool m_hasError = false;
+  };
+
+  void workerThread();
+  void executeTask(streamTask& task);
+  bool getDependencies(const pimCmd& cmd, std::vector<PimObjId>& objIds) const;
+  pimResourceTimeline& getResourceTimeline() const;
+  bool hasPendingDependency(bool isDeviceWide, const std::vector<PimObjId>& objIds) const;
+
+  pimDevice* m_device;
+  std::thread m_thread;
+  mutable std::mutex m_mutex;
+  std::condition_variable m_taskCond;
+  std::condition_variable m_doneCond;
+  std::deque<streamTask> m_tasks;
+  bool m_terminate = false;
+
+  PimStreamId m_nextStreamId = 1;
+  PimEventId m_nextEventId = 0;
+  std::unordered_map<PimStreamId, streamInfo> m_streams;
+  std::unordered_map<PimEventId, eventInfo> m_events;
+  std::unordered_map<PimObjId, unsigned> m_pendingObjs;
+  unsigned m_numPendingDeviceWide = 0;
+  unsigned m_numPending = 0;
+};
+
+#endif
+
@@ -0,0 +1,115 @@
+// File: pimTimeline.cpp
+// PIMeval Simulator - Timeline Export
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "pimTimeline.h"
+#include "pimUtils.h"
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+
+//! @brief  Open a timeline file for writing
+bool
+pimTimelineWriter::open(const std::string& fileName)
+{
+  close();
+  m_file = std::fopen(fileName.c_str(), "w");
+  if (!m_file) {
+    std::printf("PIM-Error: Failed to open timeline file %s for writing\n", fileName.c_str());
+    return false;
+  }
+  std::fputs("[", m_file);
+  m_startTime = std::chrono::steady_clock::now();
+  m_namedDevices.clear();
+  m_namedTracks.clear();
+  m_hasEvents = false;
+  std::printf("PIM-Info: Recording PIM command timeline to %s\n", fileName.c_str());
+  return true;
+}
+
+//! @brief  Finish and close the timeline file. Later events are ignored
+void
+pimTimelineWriter::close()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_file) {
+    std::fputs("\n]\n", m_file);
+    std::fclose(m_file);
+    m_file = nullptr;
+  }
+}
+
+//! @brief  Append an event to the JSON array
+void
+pimTimelineWriter::writeEvent(const std::string& event)
+{
+  std::fputs(m_hasEvents ? ",\n" : "\n", m_file);
+  std::fputs(event.c_str(), m_file);
+  m_hasEvents = true;
+}
+
+//! @brief  Write metadata events to name the process of a device and its wall-clock track
+void
+pimTimelineWriter::writeProcessName(PimDeviceId deviceId)
+{
+  std::string pid = std::to_string(deviceId);
+  writeEvent("{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": " + pid + ", \"args\": {\"name\": \"PIM Device " + pid + "\"}}");
+  writeTrackName(deviceId, static_cast<int>(PimTimelineTrack::WALL_TIME), "Simulator Wall Time");
+}
+
+//! @brief  Write metadata events to name a track and sort it by its tid
+void
+pimTimelineWriter::writeTrackName(PimDeviceId deviceId, int tid, const std::string& name)
+{
+  std::string pid = std::to_string(deviceId);
+  std::string tidStr = std::to_string(tid);
+  writeEvent("{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": " + pid + ", \"tid\": " + tidStr +
+             ", \"args\": {\"name\": " + pimUtils::quoteJson(name) + "}}");
+  writeEvent("{\"name\": \"thread_sort_index\", \"ph\": \"M\", \"pid\": " + pid + ", \"tid\": " + tidStr +
+             ", \"args\": {\"sort_index\": " + tidStr + "}}");
+}
+
+//! @brief  Record a command as a modeled event on the device or host transfer track of its lowest core, and a
+//!         wall-clock event
+void
+pimTimelineWriter::recordCmd(PimDeviceId deviceId, const std::string& name, bool isHostTransfer, PimCoreId coreId,
+                             const std::vector<PimObjId>& objIds, uint64_t numElements, double msStart,
+                             double msRuntime, double mjEnergy, wallTime wallBegin, wallTime wallEnd)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (!m_file) {
+    return;
+  }
+  if (m_namedDevices.insert(deviceId).second) {
+    writeProcessName(deviceId);
+  }
+  PimTimelineTrack track = isHostTransfer ? PimTimelineTrack::HOST_TRANSFER : PimTimelineTrack::DEVICE;
+  int tid = static_cast<int>(track) + 2 * std::max(coreId, 0);
+  if (m_namedTracks.insert({deviceId, tid}).second) {
+    writeTrackName(deviceId, tid, std::string(isHostTransfer ? "Modeled Host Transfer Time" : "Modeled Device Time")
+                   + ", Core " + std::to_string(std::max(coreId, 0)));
+  }
+
+  // timestamps are in microseconds
+  std::ostringstream args;
+  args << std::setprecision(15) << "{\"objs\": [";
+  for (size_t i = 0; i < objIds.size(); ++i) {
+    args << (i == 0 ? "" : ", ") << objIds[i];
+  }
+  args << "], \"elements\": " << numElements << ", \"ms\": " << msRuntime << ", \"mj\": " << mjEnergy << "}";
+  std::ostringstream event;
+  event << std::setprecision(15) << "{\"name\": " << pimUtils::quoteJson(name) << ", \"cat\": \"modeled\", \"ph\": \"X\", \"pid\": " << deviceId
+        << ", \"tid\": " << tid << ", \"ts\": " << msStart * 1000.0 << ", \"dur\": " << msRuntime * 1000.0
+        << ", \"args\": " << args.str() << "}";
+  writeEvent(event.str());
+
+  double usWallBegin = std::chrono::duration<double, std::micro>(wallBegin - m_startTime).count();
+  double usWallDur = std::chrono::duration<double, std::micro>(wallEnd - wallBegin).count();
+  event.str("");
+  event << "{\"name\": " << pimUtils::quoteJson(name) << ", \"cat\": \"wall\", \"ph\": \"X\", \"pid\": " << deviceId
+        << ", \"tid\": " << static_cast<int>(PimTimelineTrack::WALL_TIME) << ", \"ts\": " << usWallBegin << ", \"dur\": " << usWallDur
+        << ", \"args\": " << args.str() << "}";
+  writeEvent(event.str());
+}
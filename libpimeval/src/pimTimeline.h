@@ -0,0 +1,66 @@
+// File: pimTimeline.h
+// PIMeval Simulator - Timeline Export
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#ifndef LAVA_PIM_TIMELINE_H
+#define LAVA_PIM_TIMELINE_H
+
+#include "libpimeval.h"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include <set>
+#include <utility>
+#include <mutex>
+#include <chrono>
+
+//! @brief  Tracks of a device in the timeline, shown as threads of a process per device. Modeled events are on a
+//!         pair of device and host transfer tracks per core, from the tids below
+enum class PimTimelineTrack : int {
+  WALL_TIME = 1,      // real simulator wall-clock time
+  DEVICE = 2,         // modeled PIM computation time, at tid DEVICE + 2 * core
+  HOST_TRANSFER = 3,  // modeled host-device data transfer time, at tid HOST_TRANSFER + 2 * core
+};
+
+//! @class  pimTimelineWriter
+//! @brief  Record PIM commands as timeline events in Chrome trace JSON format
+//!
+//! The file can be opened with chrome://tracing or ui.perfetto.dev. Each device is shown as a process with
+//! a simulator wall-clock track and modeled device and host transfer tracks. Modeled timestamps are start times
+//! on the resource timeline of the device, so commands on disjoint cores overlap as in the overlapped runtime
+//! of the stats. A modeled event is placed on the tracks of the lowest core it occupies. Commands sharing that
+//! core never overlap, so events on a track do not overlap either. Events are appended as they are recorded,
+//! so that a partial file is still readable.
+class pimTimelineWriter
+{
+public:
+  using wallTime = std::chrono::steady_clock::time_point;
+
+  pimTimelineWriter() {}
+  ~pimTimelineWriter() { close(); }
+
+  bool open(const std::string& fileName);
+  void close();
+  void recordCmd(PimDeviceId deviceId, const std::string& name, bool isHostTransfer, PimCoreId coreId,
+                 const std::vector<PimObjId>& objIds, uint64_t numElements, double msStart, double msRuntime,
+                 double mjEnergy, wallTime wallBegin, wallTime wallEnd);
+
+private:
+  void writeProcessName(PimDeviceId deviceId);
+  void writeTrackName(PimDeviceId deviceId, int tid, const std::string& name);
+  void writeEvent(const std::string& event);
+
+  std::FILE* m_file = nullptr;
+  std::mutex m_mutex;
+  wallTime m_startTime;
+  std::unordered_set<PimDeviceId> m_namedDevices;
+  std::set<std::pair<PimDeviceId, int>> m_namedTracks;
+  bool m_hasEvents = false;
+};
+
+#endif
+
@@ -0,0 +1,629 @@
+// File: pimTrace.cpp
+// PIMeval Simulator - Command Trace Recording and Replay
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "pimTrace.h"
+#include "pimSim.h"
+#include "pimCmd.h"
+#include "pimUtils.h"
+#include <cstring>
+#include <algorithm>
+
+static constexpr const char* pimTraceMagic = "PIMTRACE";
+static constexpr uint32_t pimTraceVersion = 1;
+
+//! @brief  Open a trace file for recording
+bool
+pimTraceWriter::open(const std::string& fileName, bool recordPayload)
+{
+  close();
+  m_file = std::fopen(fileName.c_str(), "wb");
+  if (!m_file) {
+    std::printf("PIM-Error: Failed to open trace file %s for writing\n", fileName.c_str());
+    return false;
+  }
+  m_recordPayload = recordPayload;
+  uint8_t version[4];
+  for (unsigned i = 0; i < 4; ++i) {
+    version[i] = static_cast<uint8_t>(pimTraceVersion >> (8 * i));
+  }
+  std::fwrite(pimTraceMagic, 1, 8, m_file);
+  std::fwrite(version, 1, 4, m_file);
+  std::printf("PIM-Info: Recording command trace to %s%s\n", fileName.c_str(), recordPayload ? " with host payloads" : "");
+  return true;
+}
+
+//! @brief  Flush and close the trace file
+void
+pimTraceWriter::close()
+{
+  if (m_file) {
+    std::fclose(m_file);
+    m_file = nullptr;
+  }
+}
+
+//! @brief  Write an unsigned integer as LEB128 varint
+void
+pimTraceWriter::writeVarint(uint64_t val)
+{
+  uint8_t buf[10];
+  unsigned len = 0;
+  do {
+    uint8_t byte = val & 0x7f;
+    val >>= 7;
+    buf[len++] = val ? (byte | 0x80) : byte;
+  } while (val);
+  std::fwrite(buf, 1, len, m_file);
+}
+
+//! @brief  Record a trace entry
+void
+pimTraceWriter::record(PimTraceOp op, std::initializer_list<uint64_t> args, const void* payload, uint64_t payloadBytes)
+{
+  if (!m_file) {
+    return;
+  }
+  record(op, std::vector<uint64_t>(args), payload, payloadBytes);
+}
+
+//! @brief  Record a trace entry with variable number of arguments
+void
+pimTraceWriter::record(PimTraceOp op, const std::vector<uint64_t>& args, const void* payload, uint64_t payloadBytes)
+{
+  if (!m_file) {
+    return;
+  }
+  writeVarint(static_cast<uint64_t>(op));
+  writeVarint(args.size());
+  for (uint64_t arg : args) {
+    writeVarint(arg);
+  }
+  if (!payload) {
+    payloadBytes = 0;
+  }
+  writeVarint(payloadBytes);
+  if (payloadBytes > 0) {
+    std::fwrite(payload, 1, payloadBytes, m_file);
+  }
+}
+
+//! @brief  Open a trace file for reading and check its header
+bool
+pimTraceReader::open(const std::string& fileName)
+{
+  close();
+  m_hasError = false;
+  m_file = std::fopen(fileName.c_str(), "rb");
+  if (!m_file) {
+    std::printf("PIM-Error: Failed to open trace file %s\n", fileName.c_str());
+    m_hasError = true;
+    return false;
+  }
+  long fileBytes = -1;
+  if (std::fseek(m_file, 0, SEEK_END) == 0) {
+    fileBytes = std::ftell(m_file);
+  }
+  if (fileBytes < 0 || std::fseek(m_file, 0, SEEK_SET) != 0) {
+    std::printf("PIM-Error: Failed to get size of trace file %s\n", fileName.c_str());
+    close();
+    m_hasError = true;
+    return false;
+  }
+  m_fileBytes = static_cast<uint64_t>(fileBytes);
+  char magic[8];
+  uint8_t version[4];
+  if (std::fread(magic, 1, 8, m_file) != 8 || std::memcmp(magic, pimTraceMagic, 8) != 0 ||
+      std::fread(version, 1, 4, m_file) != 4) {
+    std::printf("PIM-Error: Invalid trace file %s\n", fileName.c_str());
+    close();
+    m_hasError = true;
+    return false;
+  }
+  uint32_t ver = version[0] | (version[1] << 8) | (version[2] << 16) | (static_cast<uint32_t>(version[3]) << 24);
+  if (ver != pimTraceVersion) {
+    std::printf("PIM-Error: Unsupported trace version %u in %s\n", ver, fileName.c_str());
+    close();
+    m_hasError = true;
+    return false;
+  }
+  return true;
+}
+
+//! @brief  Close the trace file
+void
+pimTraceReader::close()
+{
+  if (m_file) {
+    std::fclose(m_file);
+    m_file = nullptr;
+  }
+}
+
+//! @brief  Number of bytes after the current read position
+uint64_t
+pimTraceReader::getRemainingBytes() const
+{
+  long pos = std::ftell(m_file);
+  return (pos < 0 || static_cast<uint64_t>(pos) > m_fileBytes) ? 0 : m_fileBytes - pos;
+}
+
+//! @brief  Read a LEB128 varint
+bool
+pimTraceReader::readVarint(uint64_t& val)
+{
+  val = 0;
+  for (unsigned shift = 0; shift < 64; shift += 7) {
+    int ch = std::fgetc(m_file);
+    if (ch == EOF) {
+      return false;
+    }
+    val |= static_cast<uint64_t>(ch & 0x7f) << shift;
+    if (!(ch & 0x80)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+//! @brief  Read next record. Return false at end of trace or on error
+bool
+pimTraceReader::next(pimTraceRecord& record)
+{
+  if (!m_file) {
+    return false;
+  }
+  uint64_t op = 0;
+  if (!readVarint(op)) {
+    return false; // end of trace
+  }
+  uint64_t numArgs = 0;
+  if (!readVarint(numArgs)) {
+    m_hasError = true;
+    return false;
+  }
+  // Every argument takes at least one byte and the payload is stored inline. Bound sizes by the rest of the
+  // file, so that a corrupted trace cannot request an arbitrarily large allocation.
+  if (numArgs > getRemainingBytes()) {
+    m_hasError = true;
+    return false;
+  }
+  record.m_op = static_cast<PimTraceOp>(op);
+  record.m_args.resize(numArgs);
+  for (uint64_t i = 0; i < numArgs; ++i) {
+    if (!readVarint(record.m_args[i])) {
+      m_hasError = true;
+      return false;
+    }
+  }
+  uint64_t payloadBytes = 0;
+  if (!readVarint(payloadBytes)) {
+    m_hasError = true;
+    return false;
+  }
+  if (payloadBytes > getRemainingBytes()) {
+    m_hasError = true;
+    return false;
+  }
+  record.m_payload.resize(payloadBytes);
+  if (payloadBytes > 0 && std::fread(record.m_payload.data(), 1, payloadBytes, m_file) != payloadBytes) {
+    m_hasError = true;
+    return false;
+  }
+  return true;
+}
+
+//! @brief  Trace replayer ctor. Use PIM_DEVICE_NONE and null config file name to keep the recorded device
+pimTraceReplayer::pimTraceReplayer(PimDeviceEnum deviceType, const char* configFileName)
+  : m_deviceType(deviceType),
+    m_configFileName(configFileName ? configFileName : "")
+{
+}
+
+//! @brief  pimTraceReplayer dtor. Finish stream commands still using host buffers of the replayer
+pimTraceReplayer::~pimTraceReplayer()
+{
+  for (const auto& it : m_streamBuffers) {
+    pimSim::get()->pimStreamSynchronize(getStreamId(it.first));
+  }
+}
+
+//! @brief  Replay all records in a trace file
+bool
+pimTraceReplayer::replay(const std::string& traceFileName)
+{
+  pimTraceReader reader;
+  if (!reader.open(traceFileName)) {
+    return false;
+  }
+  pimTraceRecord record;
+  uint64_t numRecords = 0;
+  while (reader.next(record)) {
+    if (!replayRecord(record)) {
+      std::printf("PIM-Error: Failed to replay trace record %llu\n", (unsigned long long)numRecords);
+      return false;
+    }
+    ++numRecords;
+  }
+  if (reader.hasError()) {
+    std::printf("PIM-Error: Truncated or corrupted trace file %s\n", traceFileName.c_str());
+    return false;
+  }
+  std::printf("PIM-Info: Replayed %llu trace records from %s\n", (unsigned long long)numRecords, traceFileName.c_str());
+  return true;
+}
+
+//! @brief  Check number of arguments of a record
+bool
+pimTraceReplayer::hasArgs(const pimTraceRecord& record, size_t numArgs) const
+{
+  if (record.m_args.size() < numArgs) {
+    std::printf("PIM-Error: Trace record has %zu arguments, expecting %zu\n", record.m_args.size(), numArgs);
+    return false;
+  }
+  return true;
+}
+
+//! @brief  Map a recorded object ID to the object ID created during replay
+PimObjId
+pimTraceReplayer::getObjId(uint64_t recordedId) const
+{
+  PimObjId objId = static_cast<PimObjId>(recordedId);
+  auto it = m_objIdMap.find(objId);
+  if (it == m_objIdMap.end()) {
+    return m_hasCheckpointObjs ? objId : -1;
+  }
+  return it->second;
+}
+
+//! @brief  Map a recorded stream ID to the stream created during replay. Stream 0 is synchronous
+PimStreamId
+pimTraceReplayer::getStreamId(uint64_t recordedId) const
+{
+  PimStreamId stream = static_cast<PimStreamId>(recordedId);
+  if (stream == 0) {
+    return 0;
+  }
+  auto it = m_streamIdMap.find(stream);
+  return it == m_streamIdMap.end() ? -1 : it->second;
+}
+
+//! @brief  Get a zero-filled host buffer for a command. Buffers of asynchronous commands live until their stream is synchronized
+void*
+pimTraceReplayer::getHostBuffer(uint64_t numBytes)
+{
+  if (m_currentStream == 0) {
+    m_hostBuffer.assign(numBytes, 0);
+    return m_hostBuffer.data();
+  }
+  std::vector<std::vector<uint8_t>>& buffers = m_streamBuffers[m_currentStream];
+  buffers.emplace_back(numBytes, 0);
+  return buffers.back().data();
+}
+
+//! @brief  Replay a trace record
+bool
+pimTraceReplayer::replayRecord(const pimTraceRecord& record)
+{
+  pimSim* sim = pimSim::get();
+  const std::vector<uint64_t>& args = record.m_args;
+  switch (record.m_op) {
+  case PimTraceOp::CREATE_DEVICE:
+  {
+    if (!hasArgs(record, 6)) { return false; }
+    PimDeviceEnum deviceType = (m_deviceType != PIM_DEVICE_NONE) ? m_deviceType : static_cast<PimDeviceEnum>(args[0]);
+    if (!m_configFileName.empty()) {
+      return sim->createDeviceFromConfig(deviceType, m_configFileName.c_str());
+    }
+    return sim->createDevice(deviceType, args[1], args[2], args[3], args[4], args[5]);
+  }
+  case PimTraceOp::CREATE_DEVICE_FROM_CONFIG:
+  {
+    if (!hasArgs(record, 1)) { return false; }
+    PimDeviceEnum deviceType = (m_deviceType != PIM_DEVICE_NONE) ? m_deviceType : static_cast<PimDeviceEnum>(args[0]);
+    std::string configFileName = m_configFileName;
+    if (configFileName.empty()) {
+      configFileName.assign(record.m_payload.begin(), record.m_payload.end());
+    }
+    return sim->createDeviceFromConfig(deviceType, configFileName.empty() ? nullptr : configFileName.c_str());
+  }
+  case PimTraceOp::ADD_DEVICE:
+  {
+    if (!hasArgs(record, 6)) { return false; }
+    PimDeviceEnum deviceType = (m_deviceType != PIM_DEVICE_NONE) ? m_deviceType : static_cast<PimDeviceEnum>(args[0]);
+    return sim->addDevice(deviceType, args[1], args[2], args[3], args[4], args[5]) >= 0;
+  }
+  case PimTraceOp::SET_DEVICE:
+    if (!hasArgs(record, 1)) { return false; }
+    return sim->setCurrentDevice(static_cast<PimDeviceId>(args[0]));
+  case PimTraceOp::DELETE_DEVICE:
+    m_objIdMap.clear();
+    m_hasCheckpointObjs = false;
+    m_streamIdMap.clear();
+    m_eventIdMap.clear();
+    m_currentStream = 0;
+    if (!sim->deleteDevice()) {
+      return false;
+    }
+    m_streamBuffers.clear();
+    return true;
+  case PimTraceOp::SHOW_STATS:
+    sim->showStats();
+    return true;
+  case PimTraceOp::RESET_STATS:
+    sim->resetStats();
+    return true;
+  case PimTraceOp::BEGIN_PHASE:
+  {
+    std::string name(record.m_payload.begin(), record.m_payload.end());
+    return sim->beginPhase(name.c_str());
+  }
+  case PimTraceOp::END_PHASE:
+    return sim->endPhase();
+  case PimTraceOp::TRIM_OBJECT_POOL:
+    return sim->pimTrimObjectPool();
+  case PimTraceOp::COMPACT:
+    return sim->pimCompact();
+  case PimTraceOp::SAVE_CHECKPOINT:
+  {
+    std::string fileName(record.m_payload.begin(), record.m_payload.end());
+    return sim->saveCheckpoint(fileName.c_str());
+  }
+  case PimTraceOp::LOAD_CHECKPOINT:
+  {
+    std::string fileName(record.m_payload.begin(), record.m_payload.end());
+    m_objIdMap.clear();
+    m_hasCheckpointObjs = true;
+    return sim->loadCheckpoint(fileName.c_str());
+  }
+  case PimTraceOp::ALLOC:
+  {
+    if (!hasArgs(record, 5)) { return false; }
+    PimObjId objId = sim->pimAlloc(static_cast<PimAllocEnum>(args[0]), args[1], args[2], static_cast<PimDataType>(args[3]));
+    m_objIdMap[static_cast<PimObjId>(args[4])] = objId;
+    return true;
+  }
+  case PimTraceOp::ALLOC_ASSOCIATED:
+  {
+    if (!hasArgs(record, 4)) { return false; }
+    PimObjId objId = sim->pimAllocAssociated(args[0], getObjId(args[1]), static_cast<PimDataType>(args[2]));
+    m_objIdMap[static_cast<PimObjId>(args[3])] = objId;
+    return true;
+  }
+  case PimTraceOp::FREE:
+  {
+    if (!hasArgs(record, 1)) { return false; }
+    sim->pimFree(getObjId(args[0]));
+    m_objIdMap.erase(static_cast<PimObjId>(args[0]));
+    return true;
+  }
+  case PimTraceOp::CREATE_RANGED_REF:
+  {
+    if (!hasArgs(record, 4)) { return false; }
+    PimObjId objId = sim->pimCreateRangedRef(getObjId(args[0]), args[1], args[2]);
+    m_objIdMap[static_cast<PimObjId>(args[3])] = objId;
+    return true;
+  }
+  case PimTraceOp::CREATE_DUAL_CONTACT_REF:
+  {
+    if (!hasArgs(record, 2)) { return false; }
+    PimObjId objId = sim->pimCreateDualContactRef(getObjId(args[0]));
+    m_objIdMap[static_cast<PimObjId>(args[1])] = objId;
+    return true;
+  }
+  case PimTraceOp::STREAM_CREATE:
+  {
+    if (!hasArgs(record, 1)) { return false; }
+    m_streamIdMap[static_cast<PimStreamId>(args[0])] = sim->pimStreamCreate();
+    return true;
+  }
+  case PimTraceOp::STREAM_DESTROY:
+  {
+    if (!hasArgs(record, 1)) { return false; }
+    PimStreamId stream = static_cast<PimStreamId>(args[0]);
+    sim->pimStreamDestroy(getStreamId(args[0]));
+    m_streamIdMap.erase(stream);
+    m_streamBuffers.erase(stream);
+    if (m_currentStream == stream) {
+      m_currentStream = 0;
+    }
+    return true;
+  }
+  case PimTraceOp::SET_STREAM:
+  {
+    if (!hasArgs(record, 1)) { return false; }
+    if (!sim->pimSetStream(getStreamId(args[0]))) {
+      return false;
+    }
+    m_currentStream = static_cast<PimStreamId>(args[0]);
+    return true;
+  }
+  case PimTraceOp::STREAM_SYNCHRONIZE:
+  {
+    if (!hasArgs(record, 1)) { return false; }
+    sim->pimStreamSynchronize(getStreamId(args[0]));
+    m_streamBuffers.erase(static_cast<PimStreamId>(args[0]));
+    return true;
+  }
+  case PimTraceOp::EVENT_RECORD:
+  {
+    if (!hasArgs(record, 2)) { return false; }
+    m_eventIdMap[static_cast<PimEventId>(args[1])] = sim->pimEventRecord(getStreamId(args[0]));
+    return true;
+  }
+  case PimTraceOp::EVENT_WAIT:
+  {
+    if (!hasArgs(record, 1)) { return false; }
+    auto it = m_eventIdMap.find(static_cast<PimEventId>(args[0]));
+    sim->pimEventWait(it == m_eventIdMap.end() ? -1 : it->second);
+    if (it != m_eventIdMap.end()) {
+      m_eventIdMap.erase(it);
+    }
+    return true;
+  }
+  case PimTraceOp::CMD:
+    return replayCmd(record);
+  default:
+    std::printf("PIM-Error: Unknown trace record opcode %d\n", static_cast<int>(record.m_op));
+  }
+  return false;
+}
+
+//! @brief  Replay a PIM command. Command failures are reported by the simulator and do not stop the replay
+bool
+pimTraceReplayer::replayCmd(const pimTraceRecord& record)
+{
+  if (!hasArgs(record, 1)) { return false; }
+  pimSim* sim = pimSim::get();
+  PimCmdEnum cmdType = static_cast<PimCmdEnum>(record.m_args[0]);
+  std::vector<uint64_t> args(record.m_args.begin() + 1, record.m_args.end());
+  auto obj = [&](size_t i) { return getObjId(args[i]); };
+  auto reg = [&](size_t i) { return static_cast<PimRowReg>(args[i]); };
+  auto need = [&](size_t n) {
+    if (args.size() < n) {
+      std::printf("PIM-Error: Trace record of %s has %zu arguments, expecting %zu\n",
+                  pimCmd::getName(cmdType, "").c_str(), args.size(), n);
+      return false;
+    }
+    return true;
+  };
+
+  switch (cmdType) {
+  case PimCmdEnum::COPY_H2D:
+  {
+    // args: withType, copyType, dest, idxBegin, idxEnd, hostBytes
+    if (!need(6)) { return false; }
+    uint8_t* buffer = static_cast<uint8_t*>(getHostBuffer(std::max<uint64_t>(args[5], record.m_payload.size())));
+    std::copy(record.m_payload.begin(), record.m_payload.end(), buffer);
+    if (args[0]) {
+      sim->pimCopyMainToDeviceWithType(static_cast<PimCopyEnum>(args[1]), buffer, obj(2), args[3], args[4]);
+    } else {
+      sim->pimCopyMainToDevice(buffer, obj(2), args[3], args[4]);
+    }
+    return true;
+  }
+  case PimCmdEnum::COPY_D2H:
+  {
+    // args: withType, copyType, src, idxBegin, idxEnd, hostBytes
+    if (!need(6)) { return false; }
+    void* buffer = getHostBuffer(args[5]);
+    if (args[0]) {
+      sim->pimCopyDeviceToMainWithType(static_cast<PimCopyEnum>(args[1]), obj(2), buffer, args[3], args[4]);
+    } else {
+      sim->pimCopyDeviceToMain(obj(2), buffer, args[3], args[4]);
+    }
+    return true;
+  }
+  case PimCmdEnum::COPY_D2D:
+    if (!need(4)) { return false; }
+    sim->pimCopyDeviceToDevice(obj(0), obj(1), args[2], args[3]);
+    return true;
+  case PimCmdEnum::ADD: if (!need(3)) { return false; } sim->pimAdd(obj(0), obj(1), obj(2)); return true;
+  case PimCmdEnum::SUB: if (!need(3)) { return false; } sim->pimSub(obj(0), obj(1), obj(2)); return true;
+  case PimCmdEnum::MUL: if (!need(3)) { return false; } sim->pimMul(obj(0), obj(1), obj(2)); return true;
+  case PimCmdEnum::DIV: if (!need(3)) { return false; } sim->pimDiv(obj(0), obj(1), obj(2)); return true;
+  case PimCmdEnum::AND: if (!need(3)) { return false; } sim->pimAnd(obj(0), obj(1), obj(2)); return true;
+  case PimCmdEnum::OR: if (!need(3)) { return false; } sim->pimOr(obj(0), obj(1), obj(2)); return true;
+  case PimCmdEnum::XOR: if (!need(3)) { return false; } sim->pimXor(obj(0), obj(1), obj(2)); return true;
+  case PimCmdEnum::XNOR: if (!need(3)) { return false; } sim->pimXnor(obj(0), obj(1), obj(2)); return true;
+  case PimCmdEnum::GT: if (!need(3)) { return false; } sim->pimGT(obj(0), obj(1), obj(2)); return true;
+  case PimCmdEnum::LT: if (!need(3)) { return false; } sim->pimLT(obj(0), obj(1), obj(2)); return true;
+  case PimCmdEnum::EQ: if (!need(3)) { return false; } sim->pimEQ(obj(0), obj(1), obj(2)); return true;
+  case PimCmdEnum::MIN: if (!need(3)) { return false; } sim->pimMin(obj(0), obj(1), obj(2)); return true;
+  case PimCmdEnum::MAX: if (!need(3)) { return false; } sim->pimMax(obj(0), obj(1), obj(2)); return true;
+  case PimCmdEnum::SCALED_ADD: if (!need(4)) { return false; } sim->pimScaledAdd(obj(0), obj(1), obj(2), args[3]); return true;
+  case PimCmdEnum::ADD_SCALAR: if (!need(3)) { return false; } sim->pimAdd(obj(0), obj(1), args[2]); return true;
+  case PimCmdEnum::SUB_SCALAR: if (!need(3)) { return false; } sim->pimSub(obj(0), obj(1), args[2]); return true;
+  case PimCmdEnum::MUL_SCALAR: if (!need(3)) { return false; } sim->pimMul(obj(0), obj(1), args[2]); return true;
+  case PimCmdEnum::DIV_SCALAR: if (!need(3)) { return false; } sim->pimDiv(obj(0), obj(1), args[2]); return true;
+  case PimCmdEnum::AND_SCALAR: if (!need(3)) { return false; } sim->pimAnd(obj(0), obj(1), args[2]); return true;
+  case PimCmdEnum::OR_SCALAR: if (!need(3)) { return false; } sim->pimOr(obj(0), obj(1), args[2]); return true;
+  case PimCmdEnum::XOR_SCALAR: if (!need(3)) { return false; } sim->pimXor(obj(0), obj(1), args[2]); return true;
+  case PimCmdEnum::XNOR_SCALAR: if (!need(3)) { return false; } sim->pimXnor(obj(0), obj(1), args[2]); return true;
+  case PimCmdEnum::GT_SCALAR: if (!need(3)) { return false; } sim->pimGT(obj(0), obj(1), args[2]); return true;
+  case PimCmdEnum::LT_SCALAR: if (!need(3)) { return false; } sim->pimLT(obj(0), obj(1), args[2]); return true;
+  case PimCmdEnum::EQ_SCALAR: if (!need(3)) { return false; } sim->pimEQ(obj(0), obj(1), args[2]); return true;
+  case PimCmdEnum::MIN_SCALAR: if (!need(3)) { return false; } sim->pimMin(obj(0), obj(1), args[2]); return true;
+  case PimCmdEnum::MAX_SCALAR: if (!need(3)) { return false; } sim->pimMax(obj(0), obj(1), args[2]); return true;
+  case PimCmdEnum::ABS: if (!need(2)) { return false; } sim->pimAbs(obj(0), obj(1)); return true;
+  case PimCmdEnum::POPCOUNT: if (!need(2)) { return false; } sim->pimPopCount(obj(0), obj(1)); return true;
+  case PimCmdEnum::SHIFT_BITS_R: if (!need(3)) { return false; } sim->pimShiftBitsRight(obj(0), obj(1), args[2]); return true;
+  case PimCmdEnum::SHIFT_BITS_L: if (!need(3)) { return false; } sim->pimShiftBitsLeft(obj(0), obj(1), args[2]); return true;
+  case PimCmdEnum::REDSUM:
+  case PimCmdEnum::REDSUM_RANGE:
+  {
+    // args: value type, src [, idxBegin, idxEnd]
+    bool isRanged = (cmdType == PimCmdEnum::REDSUM_RANGE);
+    if (!need(isRanged ? 4 : 2)) { return false; }
+    void* sum = getHostBuffer(sizeof(uint64_t));
+    if (static_cast<PimTraceValueType>(args[0]) == PimTraceValueType::INT64) {
+      int64_t* sumInt = static_cast<int64_t*>(sum);
+      isRanged ? sim->pimRedSumRanged(obj(1), args[2], args[3], sumInt) : sim->pimRedSum(obj(1), sumInt);
+    } else {
+      uint64_t* sumUInt = static_cast<uint64_t*>(sum);
+      isRanged ? sim->pimRedSumRanged(obj(1), args[2], args[3], sumUInt) : sim->pimRedSum(obj(1), sumUInt);
+    }
+    return true;
+  }
+  case PimCmdEnum::BROADCAST:
+  {
+    // args: value type, dest, value bits
+    if (!need(3)) { return false; }
+    switch (static_cast<PimTraceValueType>(args[0])) {
+    case PimTraceValueType::UINT64: sim->pimBroadcast(obj(1), args[2]); break;
+    case PimTraceValueType::INT64: sim->pimBroadcast(obj(1), static_cast<int64_t>(args[2])); break;
+    case PimTraceValueType::FP32: sim->pimBroadcast(obj(1), pimUtils::castBitsToType<float>(args[2])); break;
+    default: std::printf("PIM-Error: Unknown broadcast value type in trace\n"); return false;
+    }
+    return true;
+  }
+  case PimCmdEnum::ROTATE_ELEM_R: if (!need(1)) { return false; } sim->pimRotateElementsRight(obj(0)); return true;
+  case PimCmdEnum::ROTATE_ELEM_L: if (!need(1)) { return false; } sim->pimRotateElementsLeft(obj(0)); return true;
+  case PimCmdEnum::SHIFT_ELEM_R: if (!need(1)) { return false; } sim->pimShiftElementsRight(obj(0)); return true;
+  case PimCmdEnum::SHIFT_ELEM_L: if (!need(1)) { return false; } sim->pimShiftElementsLeft(obj(0)); return true;
+  case PimCmdEnum::ROW_R: if (!need(2)) { return false; } sim->pimOpReadRowToSa(obj(0), args[1]); return true;
+  case PimCmdEnum::ROW_W: if (!need(2)) { return false; } sim->pimOpWriteSaToRow(obj(0), args[1]); return true;
+  case PimCmdEnum::RREG_MOV: if (!need(3)) { return false; } sim->pimOpMove(obj(0), reg(1), reg(2)); return true;
+  case PimCmdEnum::RREG_SET: if (!need(3)) { return false; } sim->pimOpSet(obj(0), reg(1), args[2] != 0); return true;
+  case PimCmdEnum::RREG_NOT: if (!need(3)) { return false; } sim->pimOpNot(obj(0), reg(1), reg(2)); return true;
+  case PimCmdEnum::RREG_AND: if (!need(4)) { return false; } sim->pimOpAnd(obj(0), reg(1), reg(2), reg(3)); return true;
+  case PimCmdEnum::RREG_OR: if (!need(4)) { return false; } sim->pimOpOr(obj(0), reg(1), reg(2), reg(3)); return true;
+  case PimCmdEnum::RREG_NAND: if (!need(4)) { return false; } sim->pimOpNand(obj(0), reg(1), reg(2), reg(3)); return true;
+  case PimCmdEnum::RREG_NOR: if (!need(4)) { return false; } sim->pimOpNor(obj(0), reg(1), reg(2), reg(3)); return true;
+  case PimCmdEnum::RREG_XOR: if (!need(4)) { return false; } sim->pimOpXor(obj(0), reg(1), reg(2), reg(3)); return true;
+  case PimCmdEnum::RREG_XNOR: if (!need(4)) { return false; } sim->pimOpXnor(obj(0), reg(1), reg(2), reg(3)); return true;
+  case PimCmdEnum::RREG_MAJ: if (!need(5)) { return false; } sim->pimOpMaj(obj(0), reg(1), reg(2), reg(3), reg(4)); return true;
+  case PimCmdEnum::RREG_SEL: if (!need(5)) { return false; } sim->pimOpSel(obj(0), reg(1), reg(2), reg(3), reg(4)); return true;
+  case PimCmdEnum::RREG_ROTATE_R: if (!need(2)) { return false; } sim->pimOpRotateRH(obj(0), reg(1)); return true;
+  case PimCmdEnum::RREG_ROTATE_L: if (!need(2)) { return false; } sim->pimOpRotateLH(obj(0), reg(1)); return true;
+  case PimCmdEnum::ROW_AP:
+  case PimCmdEnum::ROW_AAP:
+  {
+    // args: numSrc, numDest, (objId, ofst) pairs of src rows then dest rows
+    if (!need(2)) { return false; }
+    uint64_t numSrc = args[0];
+    uint64_t numDest = args[1];
+    if (!need(2 + 2 * (numSrc + numDest))) { return false; }
+    std::vector<std::pair<PimObjId, unsigned>> srcRows;
+    std::vector<std::pair<PimObjId, unsigned>> destRows;
+    for (uint64_t i = 0; i < numSrc; ++i) {
+      srcRows.emplace_back(obj(2 + 2 * i), args[3 + 2 * i]);
+    }
+    for (uint64_t i = numSrc; i < numSrc + numDest; ++i) {
+      destRows.emplace_back(obj(2 + 2 * i), args[3 + 2 * i]);
+    }
+    if (cmdType == PimCmdEnum::ROW_AP) {
+      sim->pimOpAP(srcRows);
+    } else {
+      sim->pimOpAAP(srcRows, destRows);
+    }
+    return true;
+  }
+  default:
+    std::printf("PIM-Error: Unsupported command %s in trace\n", pimCmd::getName(cmdType, "").c_str());
+  }
+  return false;
+}
+
@@ -0,0 +1,142 @@
+// File: pimTrace.h
+// PIMeval Simulator - Command Trace Recording and Replay
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#ifndef LAVA_PIM_TRACE_H
+#define LAVA_PIM_TRACE_H
+
+#include "libpimeval.h"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <initializer_list>
+
+//! @brief  Trace record opcodes. PIM commands are recorded as CMD with PimCmdEnum as the first argument
+enum class PimTraceOp : uint8_t {
+  NONE = 0,
+  CREATE_DEVICE,
+  CREATE_DEVICE_FROM_CONFIG,
+  DELETE_DEVICE,
+  SHOW_STATS,
+  RESET_STATS,
+  ALLOC,
+  ALLOC_ASSOCIATED,
+  FREE,
+  CREATE_RANGED_REF,
+  CREATE_DUAL_CONTACT_REF,
+  CMD,
+  TRIM_OBJECT_POOL,
+  COMPACT,
+  ADD_DEVICE,
+  SET_DEVICE,
+  SAVE_CHECKPOINT,
+  LOAD_CHECKPOINT,
+  BEGIN_PHASE,
+  END_PHASE,
+  STREAM_CREATE,
+  STREAM_DESTROY,
+  SET_STREAM,
+  STREAM_SYNCHRONIZE,
+  EVENT_RECORD,
+  EVENT_WAIT,
+};
+
+//! @brief  Data type tag of broadcast and reduction sum records
+enum class PimTraceValueType : uint8_t {
+  UINT64 = 0,
+  INT64,
+  FP32,
+};
+
+//! @class  pimTraceRecord
+//! @brief  A decoded trace record
+struct pimTraceRecord
+{
+  PimTraceOp m_op = PimTraceOp::NONE;
+  std::vector<uint64_t> m_args;
+  std::vector<uint8_t> m_payload;
+};
+
+//! @class  pimTraceWriter
+//! @brief  Record API-level commands into a compact binary trace
+//!
+//! Trace format: 8-byte magic "PIMTRACE" and a 4-byte little-endian version, followed by records.
+//! Each record is an opcode, an argument count, the arguments, a payload length and payload bytes.
+//! All integers in records are LEB128 varints.
+class pimTraceWriter
+{
+public:
+  pimTraceWriter() {}
+  ~pimTraceWriter() { close(); }
+
+  bool open(const std::string& fileName, bool recordPayload);
+  void close();
+  bool isOpen() const { return m_file != nullptr; }
+  bool isRecordPayload() const { return m_recordPayload; }
+  void record(PimTraceOp op, std::initializer_list<uint64_t> args, const void* payload = nullptr, uint64_t payloadBytes = 0);
+  void record(PimTraceOp op, const std::vector<uint64_t>& args, const void* payload = nullptr, uint64_t payloadBytes = 0);
+
+private:
+  void writeVarint(uint64_t val);
+
+  std::FILE* m_file = nullptr;
+  bool m_recordPayload = false;
+};
+
+//! @class  pimTraceReader
+//! @brief  Read records from a binary trace
+class pimTraceReader
+{
+public:
+  pimTraceReader() {}
+  ~pimTraceReader() { close(); }
+
+  bool open(const std::string& fileName);
+  void close();
+  bool next(pimTraceRecord& record);
+  bool hasError() const { return m_hasError; }
+
+private:
+  bool readVarint(uint64_t& val);
+  uint64_t getRemainingBytes() const;
+
+  std::FILE* m_file = nullptr;
+  uint64_t m_fileBytes = 0;
+  bool m_hasError = false;
+};
+
+//! @class  pimTraceReplayer
+//! @brief  Re-execute a recorded trace, optionally against a different device type or config file
+class pimTraceReplayer
+{
+public:
+  pimTraceReplayer(PimDeviceEnum deviceType, const char* configFileName);
+  ~pimTraceReplayer();
+
+  bool replay(const std::string& traceFileName);
+
+private:
+  bool replayRecord(const pimTraceRecord& record);
+  bool replayCmd(const pimTraceRecord& record);
+  bool hasArgs(const pimTraceRecord& record, size_t numArgs) const;
+  PimObjId getObjId(uint64_t recordedId) const;
+  PimStreamId getStreamId(uint64_t recordedId) const;
+  void* getHostBuffer(uint64_t numBytes);
+
+  PimDeviceEnum m_deviceType = PIM_DEVICE_NONE;
+  std::string m_configFileName;
+  std::unordered_map<PimObjId, PimObjId> m_objIdMap;
+  bool m_hasCheckpointObjs = false;  // objects restored from a checkpoint keep their recorded IDs
+  std::vector<uint8_t> m_hostBuffer;
+  std::unordered_map<PimStreamId, PimStreamId> m_streamIdMap;
+  std::unordered_map<PimEventId, PimEventId> m_eventIdMap;
+  PimStreamId m_currentStream = 0;  // recorded ID of the current stream
+  std::unordered_map<PimStreamId, std::vector<std::vector<uint8_t>>> m_streamBuffers;  // kept until the stream is synchronized
+};
+
+#endif
+
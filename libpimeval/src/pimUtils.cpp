@@ -13,7 +13,11 @@
 #include <string>
 #include <filesystem>
 #include <cstdlib>
+#include <cstdio>
 #include <cassert>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
 
 //! @brief  Convert PimStatus enum to string
 std::string
@@ -109,53 +113,183 @@ pimUtils::getNumBitsOfDataType(PimDataType dataType)
   return 0;
 }
 
-//! @brief  Read bits from host
-std::vector<bool>
-pimUtils::readBitsFromHost(void* src, uint64_t numElements, unsigned bitsPerElement)
+namespace {
+
+//! @brief  Portable 64x64 bit matrix transpose with recursive block swapping
+void
+transposeBits64x64Portable(uint64_t* a)
 {
-  std::vector<bool> bits;
-  unsigned char* bytePtr = static_cast<unsigned char*>(src);
-
-  for (uint64_t i = 0; i < numElements * bitsPerElement; i += 8) {
-    uint64_t byteIdx = i / 8;
-    unsigned char byteVal = *(bytePtr + byteIdx);
-    for (int j = 0; j < 8; ++j) {
-      bits.push_back(byteVal & 1);
-      byteVal = byteVal >> 1;
+  uint64_t m = 0x00000000FFFFFFFFULL;
+  for (unsigned j = 32; j != 0; j >>= 1, m ^= (m << j)) {
+    for (unsigned base = 0; base < 64; base += 2 * j) {
+      for (unsigned k = base; k < base + j; ++k) {
+        uint64_t t = ((a[k] >> j) ^ a[k + j]) & m;
+        a[k] ^= (t << j);
+        a[k + j] ^= t;
+      }
     }
   }
+}
 
-  return bits;
+#if defined(__x86_64__) || defined(__i386__)
+//! @brief  64x64 bit matrix transpose using AVX2 for block sizes of 4 words or more
+__attribute__((target("avx2"))) void
+transposeBits64x64Avx2(uint64_t* a)
+{
+  uint64_t m = 0x00000000FFFFFFFFULL;
+  for (unsigned j = 32; j != 0; j >>= 1, m ^= (m << j)) {
+    if (j >= 4) {
+      __m256i vm = _mm256_set1_epi64x(static_cast<long long>(m));
+      __m128i vj = _mm_cvtsi32_si128(static_cast<int>(j));
+      for (unsigned base = 0; base < 64; base += 2 * j) {
+        for (unsigned k = base; k < base + j; k += 4) {
+          __m256i lo = _mm256_load_si256(reinterpret_cast<const __m256i*>(a + k));
+          __m256i hi = _mm256_load_si256(reinterpret_cast<const __m256i*>(a + k + j));
+          __m256i t = _mm256_and_si256(_mm256_xor_si256(_mm256_srl_epi64(lo, vj), hi), vm);
+          _mm256_store_si256(reinterpret_cast<__m256i*>(a + k), _mm256_xor_si256(lo, _mm256_sll_epi64(t, vj)));
+          _mm256_store_si256(reinterpret_cast<__m256i*>(a + k + j), _mm256_xor_si256(hi, t));
+        }
+      }
+    } else {
+      for (unsigned base = 0; base < 64; base += 2 * j) {
+        for (unsigned k = base; k < base + j; ++k) {
+          uint64_t t = ((a[k] >> j) ^ a[k + j]) & m;
+          a[k] ^= (t << j);
+          a[k + j] ^= t;
+        }
+      }
+    }
+  }
 }
 
-//! @brief  Write bits to host
-bool
-pimUtils::writeBitsToHost(void* dest, const std::vector<bool>& bits)
+//! @brief  64x64 bit matrix transpose using AVX-512 for block sizes of 8 words or more
+__attribute__((target("avx512f"))) void
+transposeBits64x64Avx512(uint64_t* a)
 {
-  unsigned char* bytePtr = static_cast<unsigned char*>(dest);
-  uint64_t byteIdx = 0;
-
-  for (uint64_t i = 0; i < bits.size(); i += 8) {
-    unsigned char byteVal = 0;
-    for (int j = 7; j >= 0; --j) {
-      byteVal = byteVal << 1;
-      byteVal |= bits[i + j];
+  uint64_t m = 0x00000000FFFFFFFFULL;
+  for (unsigned j = 32; j != 0; j >>= 1, m ^= (m << j)) {
+    if (j >= 8) {
+      // Zero-masked shifts with all lanes selected. Unmasked shifts expand through _mm512_undefined_epi32(),
+      // which GCC 12 reports with -Wmaybe-uninitialized.
+      __m512i vm = _mm512_set1_epi64(static_cast<long long>(m));
+      __m512i vj = _mm512_set1_epi64(static_cast<long long>(j));
+      for (unsigned base = 0; base < 64; base += 2 * j) {
+        for (unsigned k = base; k < base + j; k += 8) {
+          __m512i lo = _mm512_load_si512(a + k);
+          __m512i hi = _mm512_load_si512(a + k + j);
+          __m512i t = _mm512_and_si512(_mm512_xor_si512(_mm512_maskz_srlv_epi64(0xFF, lo, vj), hi), vm);
+          _mm512_store_si512(a + k, _mm512_xor_si512(lo, _mm512_maskz_sllv_epi64(0xFF, t, vj)));
+          _mm512_store_si512(a + k + j, _mm512_xor_si512(hi, t));
+        }
+      }
+    } else {
+      for (unsigned base = 0; base < 64; base += 2 * j) {
+        for (unsigned k = base; k < base + j; ++k) {
+          uint64_t t = ((a[k] >> j) ^ a[k + j]) & m;
+          a[k] ^= (t << j);
+          a[k + j] ^= t;
+        }
+      }
     }
-    *(bytePtr + byteIdx) = byteVal;
-    byteIdx++;
   }
+}
+#endif
 
-  return true;
+//! @brief  Select the fastest 64x64 bit transpose kernel supported by the host CPU
+void (*selectTransposeBits64x64())(uint64_t*)
+{
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return transposeBits64x64Avx512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return transposeBits64x64Avx2;
+  }
+#endif
+  return transposeBits64x64Portable;
+}
+
+} // namespace
+
+//! @brief  Transpose a 64x64 bit matrix in place. The matrix must be 64-byte aligned.
+void
+pimUtils::transposeBits64x64(uint64_t* matrix)
+{
+  static void (*const transposeFunc)(uint64_t*) = selectTransposeBits64x64();
+  transposeFunc(matrix);
+}
+
+//! @brief  Read elements from host into raw bits without sign extension
+void
+pimUtils::readElementsFromHost(const void* src, uint64_t numElements, unsigned bitsPerElement, uint64_t* out)
+{
+  switch (bitsPerElement) {
+  case 8:
+  {
+    const uint8_t* ptr = static_cast<const uint8_t*>(src);
+    std::copy(ptr, ptr + numElements, out);
+    break;
+  }
+  case 16:
+  {
+    const uint16_t* ptr = static_cast<const uint16_t*>(src);
+    std::copy(ptr, ptr + numElements, out);
+    break;
+  }
+  case 32:
+  {
+    const uint32_t* ptr = static_cast<const uint32_t*>(src);
+    std::copy(ptr, ptr + numElements, out);
+    break;
+  }
+  case 64:
+    std::memcpy(out, src, numElements * sizeof(uint64_t));
+    break;
+  default:
+    assert(0);
+  }
+}
+
+//! @brief  Write raw bits of elements to host
+void
+pimUtils::writeElementsToHost(void* dest, uint64_t numElements, unsigned bitsPerElement, const uint64_t* in)
+{
+  switch (bitsPerElement) {
+  case 8:
+    std::copy(in, in + numElements, static_cast<uint8_t*>(dest));
+    break;
+  case 16:
+    std::copy(in, in + numElements, static_cast<uint16_t*>(dest));
+    break;
+  case 32:
+    std::copy(in, in + numElements, static_cast<uint32_t*>(dest));
+    break;
+  case 64:
+    std::memcpy(dest, in, numElements * sizeof(uint64_t));
+    break;
+  default:
+    assert(0);
+  }
 }
 
 //! @brief  Thread pool ctor
 pimUtils::threadPool::threadPool(size_t numThreads)
-  : m_terminate(false),
-    m_workersRemaining(0)
+  : m_numParked(0),
+    m_terminate(false),
+    m_jobEpoch(0),
+    m_tasksRemaining(0)
 {
+  // one deque per participant; the caller of parallelFor uses deque 0
+  if (numThreads < 1) {
+    numThreads = 1;
+  }
+  for (size_t i = 0; i < numThreads; ++i) {
+    m_queues.push_back(std::make_unique<workQueue>());
+  }
   // reserve one thread for main program
   for (size_t i = 1; i < numThreads; ++i) {
-    m_threads.emplace_back([this] { workerThread(); });
+    m_threads.emplace_back([this, i] { workerThread(i); });
   }
   std::printf("PIM-Info: Created thread pool with %lu threads.\n", m_threads.size());
 }
@@ -164,10 +298,10 @@ pimUtils::threadPool::threadPool(size_t numThreads)
 pimUtils::threadPool::~threadPool()
 {
   {
-    std::unique_lock<std::mutex> lock(m_mutex);
+    std::unique_lock<std::mutex> lock(m_parkMutex);
     m_terminate = true;
   }
-  m_cond.notify_all();
+  m_parkCond.notify_all();
   for (auto& thread : m_threads) {
     if (thread.joinable()) {
       thread.join();
@@ -175,45 +309,118 @@ pimUtils::threadPool::~threadPool()
   }
 }
 
-//! @brief  Entry to process workers in MT
+//! @brief  Run func over [0, numItems) in chunks using all workers and the calling thread
 void
-pimUtils::threadPool::doWork(const std::vector<pimUtils::threadWorker*>& workers)
+pimUtils::threadPool::parallelFor(uint64_t numItems, const rangeFunc& func)
 {
+  if (numItems == 0) {
+    return;
+  }
+  std::unique_lock<std::mutex> submitLock(m_submitMutex);
+
+  // split into a few chunks per participant for load balancing, and hand each participant a contiguous block
+  const uint64_t numQueues = m_queues.size();
+  const uint64_t grainSize = std::max<uint64_t>(1, numItems / (numQueues * 4));
+  const uint64_t numTasks = (numItems + grainSize - 1) / grainSize;
+  m_tasksRemaining.store(numTasks, std::memory_order_relaxed);
+  for (uint64_t q = 0; q < numQueues; ++q) {
+    uint64_t taskBegin = numTasks * q / numQueues;
+    uint64_t taskEnd = numTasks * (q + 1) / numQueues;
+    std::lock_guard<std::mutex> lock(m_queues[q]->m_mutex);
+    for (uint64_t t = taskBegin; t < taskEnd; ++t) {
+      uint64_t begin = t * grainSize;
+      m_queues[q]->m_tasks.push_back({begin, std::min(begin + grainSize, numItems), &func});
+    }
+  }
+
+  // publish the new job and wake up parked workers only if there are any
   {
-    std::unique_lock<std::mutex> lock(m_mutex);
-    for (auto& worker : workers) {
-      m_workers.push(worker);
+    std::unique_lock<std::mutex> lock(m_parkMutex);
+    m_jobEpoch.fetch_add(1, std::memory_order_release);
+    if (m_numParked > 0) {
+      m_parkCond.notify_all();
     }
-    m_workersRemaining = workers.size();
   }
-  m_cond.notify_all();
 
-  // Wait for all workers to be done
-  std::unique_lock<std::mutex> lock(m_mutex);
-  m_cond.wait(lock, [this] { return m_workersRemaining == 0; });
+  // participate, then wait for chunks still running on other threads
+  while (runOneTask(0)) {
+  }
+  while (m_tasksRemaining.load(std::memory_order_acquire) > 0) {
+    std::this_thread::yield();
+  }
+}
+
+//! @brief  Pop a task from the front of own deque
+bool
+pimUtils::threadPool::popTask(size_t threadIdx, rangeTask& task)
+{
+  workQueue& queue = *m_queues[threadIdx];
+  std::lock_guard<std::mutex> lock(queue.m_mutex);
+  if (queue.m_tasks.empty()) {
+    return false;
+  }
+  task = queue.m_tasks.front();
+  queue.m_tasks.pop_front();
+  return true;
 }
 
-//! @brief  Worker thread that process workers
+//! @brief  Steal a task from the back of another deque
+bool
+pimUtils::threadPool::stealTask(size_t threadIdx, rangeTask& task)
+{
+  const size_t numQueues = m_queues.size();
+  for (size_t i = 1; i < numQueues; ++i) {
+    workQueue& queue = *m_queues[(threadIdx + i) % numQueues];
+    std::lock_guard<std::mutex> lock(queue.m_mutex);
+    if (!queue.m_tasks.empty()) {
+      task = queue.m_tasks.back();
+      queue.m_tasks.pop_back();
+      return true;
+    }
+  }
+  return false;
+}
+
+//! @brief  Run one task from own deque or stolen from others. Return false if no task is found
+bool
+pimUtils::threadPool::runOneTask(size_t threadIdx)
+{
+  rangeTask task;
+  if (!popTask(threadIdx, task) && !stealTask(threadIdx, task)) {
+    return false;
+  }
+  (*task.m_func)(task.m_begin, task.m_end);
+  m_tasksRemaining.fetch_sub(1, std::memory_order_acq_rel);
+  return true;
+}
+
+//! @brief  Worker thread that process tasks, spinning briefly before parking when idle
 void
-pimUtils::threadPool::workerThread()
+pimUtils::threadPool::workerThread(size_t threadIdx)
 {
+  const unsigned numSpins = 1024;
   while (true) {
-    threadWorker* worker;
-    {
-      std::unique_lock<std::mutex> lock(m_mutex);
-      m_cond.wait(lock, [this] { return m_terminate || !m_workers.empty(); });
-      if (m_terminate && m_workers.empty()) {
-        return;
-      }
-      worker = m_workers.front();
-      m_workers.pop();
+    uint64_t epoch = m_jobEpoch.load(std::memory_order_acquire);
+    if (runOneTask(threadIdx)) {
+      continue;
+    }
+    bool newJob = false;
+    for (unsigned i = 0; i < numSpins && !newJob; ++i) {
+      std::this_thread::yield();
+      newJob = (m_jobEpoch.load(std::memory_order_acquire) != epoch);
+    }
+    if (newJob) {
+      continue;
     }
-    worker->execute();
-    {
-      std::unique_lock<std::mutex> lock(m_mutex);
-      --m_workersRemaining;
+    std::unique_lock<std::mutex> lock(m_parkMutex);
+    ++m_numParked;
+    m_parkCond.wait(lock, [this, epoch] {
+      return m_terminate || m_jobEpoch.load(std::memory_order_acquire) != epoch;
+    });
+    --m_numParked;
+    if (m_terminate) {
+      return;
     }
-    m_cond.notify_all();
   }
 }
 
@@ -302,6 +509,25 @@ pimUtils::removeAfterSemicolon(const std::string &input) {
     return input;
 }
 
+//! @brief Returns the input string as a quoted JSON string, with quotes, backslashes and control characters escaped
+std::string
+pimUtils::quoteJson(const std::string& str) {
+    std::string quoted = "\"";
+    for (char c : str) {
+        if (c == '"' || c == '\\') {
+            quoted += '\\';
+            quoted += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(static_cast<unsigned char>(c)));
+            quoted += buf;
+        } else {
+            quoted += c;
+        }
+    }
+    return quoted + "\"";
+}
+
 //! @brief Returns the directory path of the input file.
 std::string
 pimUtils::getDirectoryPath(const std::string& filePath) {
@@ -9,7 +9,9 @@
 
 #include "libpimeval.h"
 #include <string>
-#include <queue>
+#include <deque>
+#include <functional>
+#include <memory>
 #include <vector>
 #include <thread>
 #include <atomic>
@@ -22,6 +24,8 @@
 #include <type_traits>
 #include <cstring>
 #include <cstdint>
+#include <new>
+#include <cstddef>
 
 namespace pimUtils
 {
@@ -76,9 +80,15 @@ namespace pimUtils
   std::string getParam(const std::unordered_map<std::string, std::string>& params, const std::string& key);
   std::string getOptionalParam(const std::unordered_map<std::string, std::string>& params, const std::string& key, bool& returnStatus);
   std::string removeAfterSemicolon(const std::string &input);
+  std::string quoteJson(const std::string& str);
 
-  std::vector<bool> readBitsFromHost(void* src, uint64_t numElements, unsigned bitsPerElement);
-  bool writeBitsToHost(void* dest, const std::vector<bool>& bits);
+  // Transpose a 64x64 bit matrix in place. Bit j of word i is moved to bit i of word j.
+  // Dispatches to AVX-512 or AVX2 at runtime if supported by the host CPU.
+  void transposeBits64x64(uint64_t* matrix);
+
+  // Load/store #numElements little-endian host elements of 8/16/32/64 bits from/to raw uint64_t bits
+  void readElementsFromHost(const void* src, uint64_t numElements, unsigned bitsPerElement, uint64_t* out);
+  void writeElementsToHost(void* dest, uint64_t numElements, unsigned bitsPerElement, const uint64_t* in);
   std::string getDirectoryPath(const std::string& filePath);
   bool getEnvVar(const std::string &varName, std::string &varValue);
 
@@ -112,35 +122,79 @@ namespace pimUtils
       {"PIM_DEVICE_BANK_LEVEL", PIM_DEVICE_BANK_LEVEL}
   };
 
+  //! @class  alignedAllocator
+  //! @brief  STL allocator that returns memory aligned to an Align-byte boundary
+  template <typename T, std::size_t Align> class alignedAllocator {
+  public:
+    typedef T value_type;
+    template <typename U> struct rebind { typedef alignedAllocator<U, Align> other; };
+    alignedAllocator() noexcept {}
+    template <typename U> alignedAllocator(const alignedAllocator<U, Align>&) noexcept {}
+    T* allocate(std::size_t n) {
+      return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Align)));
+    }
+    void deallocate(T* p, std::size_t) noexcept {
+      ::operator delete(p, std::align_val_t(Align));
+    }
+    template <typename U> bool operator==(const alignedAllocator<U, Align>&) const noexcept { return true; }
+    template <typename U> bool operator!=(const alignedAllocator<U, Align>&) const noexcept { return false; }
+  };
+
   static constexpr const char* envVarPimEvalTarget = "PIMEVAL_TARGET";
   static constexpr const char* envVarPimEvalConfigPath = "PIMEVAL_CONFIG_PATH";
   static constexpr const char* envVarPimEvalConfigSim = "PIMEVAL_CONFIG_SIM";
-
-  //! @class  threadWorker
-  //! @brief  Thread worker base class
-  class threadWorker {
-  public:
-    threadWorker() {}
-    virtual ~threadWorker() {}
-    virtual void execute() = 0;
-  };
+  static constexpr const char* envVarPimEvalSimMode = "PIMEVAL_SIM_MODE";
+  static constexpr const char* envVarPimEvalAllocPolicy = "PIMEVAL_ALLOC_POLICY";
+  static constexpr const char* envVarPimEvalObjPool = "PIMEVAL_OBJ_POOL";
+  static constexpr const char* envVarPimEvalTraceFile = "PIMEVAL_TRACE_FILE";
+  static constexpr const char* envVarPimEvalTracePayload = "PIMEVAL_TRACE_PAYLOAD";
+  static constexpr const char* envVarPimEvalStatsOutput = "PIMEVAL_STATS_OUTPUT";
+  static constexpr const char* envVarPimEvalTimelineFile = "PIMEVAL_TIMELINE_FILE";
+  static constexpr const char* envVarPimEvalBitSerialPerfTable = "PIMEVAL_BITSERIAL_PERF_TABLE";
+  static constexpr const char* envVarPimEvalDramTracePrefix = "PIMEVAL_DRAM_TRACE_PREFIX";
+  static constexpr const char* envVarPimEvalActPowerBudget = "PIMEVAL_ACT_POWER_BUDGET";
 
   //! @class  threadPool
-  //! @brief  Thread pool that runs multiple workers in threads
+  //! @brief  Persistent work-stealing thread pool for parallel-for over an index range
+  //!
+  //! The index range is split into chunks that are distributed over per-thread deques. Each
+  //! participant pops chunks from the front of its own deque and steals from the back of others
+  //! when it runs dry. The calling thread participates as one of the workers. Idle workers spin
+  //! briefly before parking on a condition variable.
   class threadPool {
   public:
+    typedef std::function<void(uint64_t begin, uint64_t end)> rangeFunc;
+
     threadPool(size_t numThreads);
     ~threadPool();
-    void doWork(const std::vector<pimUtils::threadWorker*>& workers);
+    void parallelFor(uint64_t numItems, const rangeFunc& func);
+    size_t getNumThreads() const { return m_queues.size(); }
+
   private:
-    void workerThread();
+    struct rangeTask {
+      uint64_t m_begin;
+      uint64_t m_end;
+      const rangeFunc* m_func;
+    };
+    struct workQueue {
+      std::mutex m_mutex;
+      std::deque<rangeTask> m_tasks;
+    };
+
+    void workerThread(size_t threadIdx);
+    bool runOneTask(size_t threadIdx);
+    bool popTask(size_t threadIdx, rangeTask& task);
+    bool stealTask(size_t threadIdx, rangeTask& task);
 
     std::vector<std::thread> m_threads;
-    std::queue<threadWorker*> m_workers;
-    std::mutex m_mutex;
-    std::condition_variable m_cond;
+    std::vector<std::unique_ptr<workQueue>> m_queues;
+    std::mutex m_submitMutex;
+    std::mutex m_parkMutex;
+    std::condition_variable m_parkCond;
+    unsigned m_numParked;
     bool m_terminate;
-    std::atomic<size_t> m_workersRemaining;
+    std::atomic<uint64_t> m_jobEpoch;
+    std::atomic<uint64_t> m_tasksRemaining;
   };
 
 }
@@ -0,0 +1,75 @@
+// Test: Activation throttling by tFAW, tRRD and power budget
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "libpimeval.h"
+#include "../util.h"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+
+
+//! @brief  Get runtime of an add of a number of elements, on a device created with a power budget
+double getAddRuntime(PimDeviceEnum deviceType, const char* powerBudget, uint64_t numElements)
+{
+  if (powerBudget) {
+    setenv("PIMEVAL_ACT_POWER_BUDGET", powerBudget, 1);
+  } else {
+    unsetenv("PIMEVAL_ACT_POWER_BUDGET");
+  }
+  PimStatus status = pimCreateDevice(deviceType, 1, 4, 32, 1024, 256);
+  assert(status == PIM_OK);
+
+  std::vector<int> src(numElements, 7);
+  PimObjId obj1 = pimAlloc(PIM_ALLOC_AUTO, numElements, PIM_INT32);
+  assert(obj1 != -1);
+  PimObjId obj2 = pimAllocAssociated(obj1, PIM_INT32);
+  assert(obj2 != -1);
+  status = pimCopyHostToDevice((void*)src.data(), obj1);
+  assert(status == PIM_OK);
+  status = pimCopyHostToDevice((void*)src.data(), obj2);
+  assert(status == PIM_OK);
+
+  pimResetStats();
+  status = pimAdd(obj1, obj2, obj2);
+  assert(status == PIM_OK);
+  double msRuntime = getCsvRuntimes(exportCsvStats("test-act-throttle.csv"), "timeline")["serialized"];
+
+  pimFree(obj1);
+  pimFree(obj2);
+  pimDeleteDevice();
+  unsetenv("PIMEVAL_ACT_POWER_BUDGET");
+  return msRuntime;
+}
+
+int main()
+{
+  std::cout << "PIM test: Activation throttling" << std::endl;
+
+  bool ok = true;
+  uint64_t numElementsAllCores = 4 * 32 * 256;
+  uint64_t numElementsOneCore = 256;
+  for (PimDeviceEnum deviceType : {PIM_DEVICE_BITSIMD_V, PIM_DEVICE_SIMDRAM}) {
+    double msBase = getAddRuntime(deviceType, nullptr, numElementsAllCores);
+    double msJedec = getAddRuntime(deviceType, "1", numElementsAllCores);
+    double msRelaxed = getAddRuntime(deviceType, "1000", numElementsAllCores);
+    double msOneCoreBase = getAddRuntime(deviceType, nullptr, numElementsOneCore);
+    double msOneCoreJedec = getAddRuntime(deviceType, "1", numElementsOneCore);
+    std::cout << "All cores: " << msBase << " ms unthrottled, " << msJedec << " ms with JEDEC budget, "
+              << msRelaxed << " ms with 1000x budget" << std::endl;
+    std::cout << "One core: " << msOneCoreBase << " ms unthrottled, " << msOneCoreJedec << " ms with JEDEC budget" << std::endl;
+
+    // all subarrays of a rank cannot fire at once within tFAW and tRRD
+    ok = ok && msBase > 0.0 && msJedec > msBase * 2;
+    // a large power budget or a single subarray is not throttled
+    ok = ok && std::abs(msRelaxed - msBase) <= msBase * 1e-9;
+    ok = ok && std::abs(msOneCoreJedec - msOneCoreBase) <= msOneCoreBase * 1e-9;
+  }
+
+  std::cout << (ok ? "Passed!" : "Failed!") << std::endl;
+  return ok ? 0 : 1;
+}
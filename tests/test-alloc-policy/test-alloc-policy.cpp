@@ -0,0 +1,108 @@
+// Test: Row allocation policies
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "libpimeval.h"
+#include "../util.h"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <map>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+
+
+//! @brief  Create a device with one core of 2048 rows and 256 columns, using an allocation policy
+void createDevice(const char* policy)
+{
+  setenv("PIMEVAL_ALLOC_POLICY", policy, 1);
+  PimStatus status = pimCreateDevice(PIM_DEVICE_BITSIMD_V, 1, 1, 2, 1024, 256);
+  assert(status == PIM_OK);
+  std::map<std::string, std::string> params = getCsvParams(exportCsvStats("test-alloc-policy.csv"));
+  assert(params["num_cores"] == "1" && params["num_rows_per_core"] == "2048" && params["alloc_policy"] == policy);
+}
+
+//! @brief  Allocate a vertical object of one region, with as many rows as bits of the data type
+PimObjId allocRows(PimDataType dataType, unsigned numRegions = 1)
+{
+  PimObjId objId = pimAlloc(PIM_ALLOC_V, 256 * numRegions, dataType);
+  assert(objId != -1);
+  return objId;
+}
+
+//! @brief  Leave free rows [0, 64) and [72, 88) in a full core, then allocate 16 and 64 rows.
+//!         First-fit splits the first free range for 16 rows, and then needs to compact rows for 64 rows.
+//!         Best-fit takes the exact 16-row range and keeps 64 rows free.
+bool testPlacement(const char* policy, uint64_t numCompactionsExpected)
+{
+  createDevice(policy);
+  PimObjId obj64 = allocRows(PIM_INT64);     // rows [0, 64)
+  PimObjId objA = allocRows(PIM_INT8);       // rows [64, 72)
+  PimObjId obj16 = allocRows(PIM_INT16);     // rows [72, 88)
+  PimObjId objB = allocRows(PIM_INT8);       // rows [88, 96)
+  PimObjId objFill = allocRows(PIM_INT8, (2048 - 96) / 8);
+  std::map<std::string, std::string> params = getCsvParams(exportCsvStats("test-alloc-policy.csv"));
+  bool ok = params["max_rows_in_use"] == "2048";
+
+  pimFree(obj64);
+  pimFree(obj16);
+  pimTrimObjectPool();
+  PimObjId objNew16 = allocRows(PIM_INT16);
+  PimObjId objNew64 = allocRows(PIM_INT64);
+  params = getCsvParams(exportCsvStats("test-alloc-policy.csv"));
+  std::cout << policy << ": " << params["num_compactions"] << " compactions moving " << params["num_rows_compacted"]
+            << " rows" << std::endl;
+  ok = ok && params["max_rows_in_use"] == "2048" && std::stoull(params["num_compactions"]) == numCompactionsExpected;
+
+  pimFree(objA);
+  pimFree(objB);
+  pimFree(objFill);
+  pimFree(objNew16);
+  pimFree(objNew64);
+  pimDeleteDevice();
+  return ok;
+}
+
+//! @brief  Free three adjacent objects in a full core, with the middle one last, then reuse the merged range
+bool testCoalesce(const char* policy)
+{
+  createDevice(policy);
+  PimObjId obj1 = allocRows(PIM_INT32);      // rows [0, 32)
+  PimObjId obj2 = allocRows(PIM_INT32);      // rows [32, 64)
+  PimObjId obj3 = allocRows(PIM_INT32);      // rows [64, 96)
+  PimObjId objFill = allocRows(PIM_INT8, (2048 - 96) / 8);
+
+  pimFree(obj1);
+  pimFree(obj3);
+  pimFree(obj2);
+  pimTrimObjectPool();
+  PimObjId objNew64 = allocRows(PIM_INT64);
+  PimObjId objNew32 = allocRows(PIM_INT32);
+  std::map<std::string, std::string> params = getCsvParams(exportCsvStats("test-alloc-policy.csv"));
+  bool ok = params["max_rows_in_use"] == "2048" && params["num_compactions"] == "0";
+
+  // no rows are left
+  PimObjId objFull = pimAlloc(PIM_ALLOC_V, 256, PIM_INT8);
+  ok = ok && objFull == -1;
+
+  pimFree(objFill);
+  pimFree(objNew64);
+  pimFree(objNew32);
+  pimDeleteDevice();
+  return ok;
+}
+
+int main()
+{
+  std::cout << "PIM test: Row allocation policies" << std::endl;
+  bool ok = true;
+  ok = testPlacement("first_fit", 1) && ok;
+  ok = testPlacement("best_fit", 0) && ok;
+  ok = testCoalesce("first_fit") && ok;
+  ok = testCoalesce("best_fit") && ok;
+  std::cout << (ok ? "Passed!" : "Failed!") << std::endl;
+  return ok ? 0 : 1;
+}
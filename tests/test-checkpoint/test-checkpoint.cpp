@@ -0,0 +1,142 @@
+// Test: Test checkpoint and restore
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "libpimeval.h"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cassert>
+#include <cstdlib>
+#include <cstdio>
+
+
+bool testCheckpoint(PimDeviceEnum deviceType)
+{
+  unsigned numRanks = 1;
+  unsigned numBankPerRank = 2;
+  unsigned numSubarrayPerBank = 4;
+  unsigned numRows = 1024;
+  unsigned numCols = 1024;
+  std::string fileName = "test-checkpoint.ckpt";
+
+  uint64_t numElements = 10000;
+  uint64_t idxBegin = 1000;
+  uint64_t idxEnd = 3000;
+  std::vector<int> src1(numElements);
+  std::vector<int> src2(numElements);
+  for (uint64_t i = 0; i < numElements; ++i) {
+    src1[i] = i;
+    src2[i] = 7 * i - 3;
+  }
+
+  // warm up a device and save its states, including pooled objects
+  setenv("PIMEVAL_OBJ_POOL", "on", 1);
+  PimStatus status = pimCreateDevice(deviceType, numRanks, numBankPerRank, numSubarrayPerBank, numRows, numCols);
+  assert(status == PIM_OK);
+  PimObjId obj1 = pimAlloc(PIM_ALLOC_AUTO, numElements, PIM_INT32);
+  PimObjId obj2 = pimAllocAssociated(obj1, PIM_INT32);
+  PimObjId obj3 = pimAllocAssociated(obj1, PIM_INT32);
+  PimObjId objTmp = pimAllocAssociated(obj1, PIM_INT32);
+  assert(obj1 != -1 && obj2 != -1 && obj3 != -1 && objTmp != -1);
+  status = pimCopyHostToDevice((void*)src1.data(), obj1);
+  assert(status == PIM_OK);
+  status = pimCopyHostToDevice((void*)src2.data(), obj2);
+  assert(status == PIM_OK);
+  status = pimAdd(obj1, obj2, obj3);
+  assert(status == PIM_OK);
+  PimObjId ref = pimCreateRangedRef(obj3, idxBegin, idxEnd);
+  assert(ref != -1);
+  status = pimFree(objTmp); // kept in object pool
+  assert(status == PIM_OK);
+  status = pimSaveCheckpoint(fileName.c_str());
+  assert(status == PIM_OK);
+  std::cout << "Stats before checkpoint:" << std::endl;
+  pimShowStats();
+
+  // diverge after the checkpoint, then restore
+  status = pimBroadcastInt(obj3, 0);
+  assert(status == PIM_OK);
+  status = pimFree(obj2);
+  assert(status == PIM_OK);
+  PimObjId objNew = pimAlloc(PIM_ALLOC_AUTO, 2 * numElements, PIM_INT32);
+  assert(objNew != -1);
+  status = pimLoadCheckpoint(fileName.c_str());
+  assert(status == PIM_OK);
+  std::cout << "Stats after restore:" << std::endl;
+  pimShowStats();
+
+  bool ok = true;
+  std::vector<int> dest(numElements);
+  status = pimCopyDeviceToHost(obj3, (void*)dest.data());
+  assert(status == PIM_OK);
+  for (uint64_t i = 0; i < numElements; ++i) {
+    if (dest[i] != src1[i] + src2[i]) {
+      std::cout << "Mismatch of restored object at " << i << ": " << dest[i] << std::endl;
+      ok = false;
+      break;
+    }
+  }
+  // restored objects and references are usable
+  int64_t sum = 0;
+  status = pimRedSumInt(ref, &sum);
+  assert(status == PIM_OK);
+  int64_t expectedSum = 0;
+  for (uint64_t i = idxBegin; i < idxEnd; ++i) {
+    expectedSum += src1[i] + src2[i];
+  }
+  std::cout << "Result: RedSum of restored ranged ref: PIM " << sum << " expected " << expectedSum << std::endl;
+  ok = ok && (sum == expectedSum);
+  status = pimSub(obj3, obj2, obj3);
+  assert(status == PIM_OK);
+  status = pimCopyDeviceToHost(obj3, (void*)dest.data());
+  assert(status == PIM_OK);
+  ok = ok && (dest == src1);
+  status = pimFree(objNew); // not in the checkpoint
+  assert(status == PIM_ERROR);
+  pimDeleteDevice();
+
+  // fork the checkpoint into a fresh device
+  status = pimCreateDevice(deviceType, numRanks, numBankPerRank, numSubarrayPerBank, numRows, numCols);
+  assert(status == PIM_OK);
+  status = pimLoadCheckpoint(fileName.c_str());
+  assert(status == PIM_OK);
+  PimObjId obj4 = pimAllocAssociated(obj1, PIM_INT32);
+  assert(obj4 != -1 && obj4 != obj1 && obj4 != obj2 && obj4 != obj3 && obj4 != ref);
+  status = pimMulScalar(obj1, obj4, 2);
+  assert(status == PIM_OK);
+  status = pimCopyDeviceToHost(obj4, (void*)dest.data());
+  assert(status == PIM_OK);
+  for (uint64_t i = 0; i < numElements; ++i) {
+    if (dest[i] != 2 * src1[i]) {
+      std::cout << "Mismatch of forked object at " << i << ": " << dest[i] << std::endl;
+      ok = false;
+      break;
+    }
+  }
+  pimDeleteDevice();
+
+  // a device with different dimensions cannot load the checkpoint
+  status = pimCreateDevice(deviceType, numRanks, numBankPerRank, numSubarrayPerBank, numRows / 2, numCols);
+  assert(status == PIM_OK);
+  status = pimLoadCheckpoint(fileName.c_str());
+  assert(status == PIM_ERROR);
+  pimDeleteDevice();
+
+  std::remove(fileName.c_str());
+  std::cout << (ok ? "Passed!" : "Failed!") << std::endl;
+  return ok;
+}
+
+int main()
+{
+  std::cout << "PIM Regression Test: Checkpoint and Restore" << std::endl;
+
+  bool ok = true;
+  ok = testCheckpoint(PIM_DEVICE_BITSIMD_V) && ok;
+
+  ok = testCheckpoint(PIM_DEVICE_FULCRUM) && ok;
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,121 @@
+// Test: Compaction of PIM rows
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "libpimeval.h"
+#include "../util.h"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <map>
+#include <cassert>
+#include <cstdint>
+#include <cmath>
+
+
+//! @brief  Read all elements of objects and references into host buffers
+std::vector<std::vector<int>> readObjs(const std::vector<std::pair<PimObjId, unsigned>>& objs)
+{
+  std::vector<std::vector<int>> data;
+  for (const auto& [objId, numElements] : objs) {
+    std::vector<int> dest(numElements);
+    PimStatus status = pimCopyDeviceToHost(objId, (void*)dest.data());
+    assert(status == PIM_OK);
+    data.push_back(dest);
+  }
+  return data;
+}
+
+//! @brief  Check compaction counters and the row_clone cost, which is one AAP per row moved in the busiest core
+bool checkCompactions(const char* step, unsigned numCompactions, unsigned numRowsCompacted)
+{
+  std::vector<csvStatsRow> rows = exportCsvStats("test-compact.csv");
+  std::map<std::string, std::string> params = getCsvParams(rows);
+  std::map<std::string, csvStatsRow> cmds = getCsvSection(rows, "command");
+  std::cout << step << ": " << params["num_compactions"] << " compactions moving " << params["num_rows_compacted"]
+            << " rows" << std::endl;
+  bool ok = params["num_compactions"] == std::to_string(numCompactions) &&
+            params["num_rows_compacted"] == std::to_string(numRowsCompacted);
+  auto it = cmds.find("row_clone");
+  if (it == cmds.end()) {
+    std::cout << "Error: Missing row_clone command in stats" << std::endl;
+    return false;
+  }
+  double msExpected = std::stod(params["aap_ns"]) * numRowsCompacted / 1000000.0;  // single core
+  double msRuntime = std::stod(it->second[5]);
+  std::cout << step << ": row_clone count " << it->second[3] << ", " << msRuntime << " ms" << std::endl;
+  return ok && it->second[3] == std::to_string(numCompactions) && std::fabs(msRuntime - msExpected) <= msExpected * 1e-6;
+}
+
+int main()
+{
+  std::cout << "PIM test: Compaction of PIM rows" << std::endl;
+
+  // one core of 2048 rows and 256 columns, with vertical objects of one region taking as many rows as bits
+  PimStatus status = pimCreateDevice(PIM_DEVICE_BITSIMD_V, 1, 1, 2, 1024, 256);
+  assert(status == PIM_OK);
+  unsigned numElements = 256;
+  PimObjId objX = pimAlloc(PIM_ALLOC_V, numElements, PIM_INT8);     // rows [0, 8)
+  PimObjId objA = pimAlloc(PIM_ALLOC_V, numElements, PIM_INT32);    // rows [8, 40)
+  PimObjId objB = pimAllocAssociated(objA, PIM_INT32);              // rows [40, 72)
+  PimObjId objY = pimAlloc(PIM_ALLOC_V, numElements, PIM_INT16);    // rows [72, 88)
+  PimObjId objC = pimAlloc(PIM_ALLOC_V, numElements, PIM_INT32);    // rows [88, 120)
+  PimObjId objD = pimAllocAssociated(objC, PIM_INT32);              // rows [120, 152)
+  assert(objX != -1 && objA != -1 && objB != -1 && objY != -1 && objC != -1 && objD != -1);
+  PimObjId refRanged = pimCreateRangedRef(objA, 10, 100);
+  PimObjId refDual = pimCreateDualContactRef(objB);
+  assert(refRanged != -1 && refDual != -1);
+
+  std::vector<PimObjId> objs = {objA, objB, objC, objD};
+  for (unsigned k = 0; k < objs.size(); ++k) {
+    std::vector<int> src(numElements);
+    for (unsigned i = 0; i < numElements; ++i) {
+      src[i] = static_cast<int>(i * 7919 + k * 104729) ^ (k % 2 ? -1 : 0);
+    }
+    status = pimCopyHostToDevice((void*)src.data(), objs[k]);
+    assert(status == PIM_OK);
+  }
+  std::vector<std::pair<PimObjId, unsigned>> views = {{objA, numElements}, {objB, numElements}, {objC, numElements},
+                                                      {objD, numElements}, {refRanged, 90}, {refDual, numElements}};
+  std::vector<std::vector<int>> before = readObjs(views);
+
+  // explicit compaction closes holes of rows [0, 8) and [72, 88), moving four 32-row objects
+  pimFree(objX);
+  pimFree(objY);
+  status = pimCompact();
+  assert(status == PIM_OK);
+  bool ok = checkCompactions("Explicit compaction", 1, 128);
+  ok = ok && readObjs(views) == before;
+
+  // associated objects stay associated after moving
+  status = pimAdd(objC, objD, objD);
+  ok = ok && status == PIM_OK;
+  std::vector<int> sum(numElements);
+  status = pimCopyDeviceToHost(objD, (void*)sum.data());
+  assert(status == PIM_OK);
+  for (unsigned i = 0; i < numElements; ++i) {
+    ok = ok && sum[i] == before[2][i] + before[3][i];
+  }
+  before = readObjs(views);
+
+  // leave free rows [64, 96) and a 40-row tail, so that 64 rows fit only after compaction
+  PimObjId objZ = pimAlloc(PIM_ALLOC_V, numElements * 235, PIM_INT8);  // rows [128, 2008)
+  assert(objZ != -1);
+  pimFree(objC);
+  views.erase(views.begin() + 2);
+  before.erase(before.begin() + 2);
+  PimObjId objLarge = pimAlloc(PIM_ALLOC_V, numElements, PIM_INT64);
+  ok = ok && objLarge != -1;
+  ok = checkCompactions("Compaction on allocation failure", 2, 128 + 32 + 1880) && ok;
+  ok = ok && readObjs(views) == before;
+
+  pimFree(objLarge);
+  pimFree(objZ);
+  pimFree(objA);
+  pimFree(objB);
+  pimFree(objD);
+  pimDeleteDevice();
+  std::cout << (ok ? "Passed!" : "Failed!") << std::endl;
+  return ok ? 0 : 1;
+}
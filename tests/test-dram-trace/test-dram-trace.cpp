@@ -0,0 +1,80 @@
+// Test: DRAM trace export
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "libpimeval.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+
+
+//! @brief  Check a trace file in DRAMsim3 format, and count its reads and writes
+bool checkTraceFile(const std::string& fileName, uint64_t& numReads, uint64_t& numWrites)
+{
+  std::ifstream file(fileName);
+  if (!file) {
+    std::cout << "Missing trace file " << fileName << std::endl;
+    return false;
+  }
+  std::string line;
+  uint64_t prevCycle = 0;
+  while (std::getline(file, line)) {
+    std::istringstream ss(line);
+    uint64_t addr = 0;
+    std::string op;
+    uint64_t cycle = 0;
+    if (!(ss >> std::hex >> addr >> op >> std::dec >> cycle) || (op != "READ" && op != "WRITE") || cycle < prevCycle) {
+      std::cout << "Unexpected trace line: " << line << std::endl;
+      return false;
+    }
+    prevCycle = cycle;
+    (op == "READ" ? numReads : numWrites)++;
+  }
+  return true;
+}
+
+int main()
+{
+  std::cout << "PIM test: DRAM trace export" << std::endl;
+
+  setenv("PIMEVAL_DRAM_TRACE_PREFIX", "test-dram-trace", 1);
+  PimStatus status = pimCreateDevice(PIM_DEVICE_BITSIMD_V, 1, 4, 4, 1024, 256);
+  assert(status == PIM_OK);
+
+  unsigned numElements = 1000;
+  std::vector<int> src1(numElements, 7);
+  std::vector<int> src2(numElements, 9);
+  std::vector<int> dest(numElements);
+  PimObjId obj1 = pimAlloc(PIM_ALLOC_AUTO, numElements, PIM_INT32);
+  assert(obj1 != -1);
+  PimObjId obj2 = pimAllocAssociated(obj1, PIM_INT32);
+  assert(obj2 != -1);
+  status = pimCopyHostToDevice((void*)src1.data(), obj1);
+  assert(status == PIM_OK);
+  status = pimCopyHostToDevice((void*)src2.data(), obj2);
+  assert(status == PIM_OK);
+  status = pimAdd(obj1, obj2, obj2);
+  assert(status == PIM_OK);
+  status = pimCopyDeviceToHost(obj2, (void*)dest.data());
+  assert(status == PIM_OK);
+  pimFree(obj2);
+  pimFree(obj1);
+  pimDeleteDevice();
+
+  // copies write and read rows, and the add reads both operands and writes the result
+  uint64_t numReads = 0;
+  uint64_t numWrites = 0;
+  bool ok = checkTraceFile("test-dram-trace_dev0_ch0.trace", numReads, numWrites);
+  std::remove("test-dram-trace_dev0_ch0.trace");
+  std::cout << "Trace: " << numReads << " reads, " << numWrites << " writes" << std::endl;
+  ok = ok && numReads > 0 && numWrites > 0 && dest[0] == 16;
+
+  std::cout << (ok ? "Passed!" : "Failed!") << std::endl;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,80 @@
+// Test: Lazy materialization of PIM core memory
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "libpimeval.h"
+#include "../util.h"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <map>
+#include <cassert>
+#include <cstdio>
+#include <cstdint>
+
+
+//! @brief  Check number of materialized cores and bytes
+bool checkMaterialized(const char* step, uint64_t numCoresExpected)
+{
+  std::map<std::string, std::string> params = getCsvParams(exportCsvStats("test-lazy-cores.csv"));
+  uint64_t numCores = std::stoull(params["num_cores"]);
+  uint64_t numMaterialized = std::stoull(params["num_materialized_cores"]);
+  uint64_t materializedBytes = std::stoull(params["materialized_bytes"]);
+  uint64_t nominalBytes = std::stoull(params["nominal_bytes"]);
+  std::cout << step << ": " << numMaterialized << " of " << numCores << " cores, " << materializedBytes << " of "
+            << nominalBytes << " bytes materialized" << std::endl;
+  return numMaterialized == numCoresExpected && materializedBytes * numCores == nominalBytes * numMaterialized;
+}
+
+int main()
+{
+  std::cout << "PIM test: Lazy materialization of PIM core memory" << std::endl;
+
+  PimStatus status = pimCreateDevice(PIM_DEVICE_BITSIMD_V, 1, 4, 4, 1024, 256);
+  assert(status == PIM_OK);
+  PimDeviceProperties props;
+  status = pimGetDeviceProperties(&props);
+  assert(status == PIM_OK);
+  unsigned numCores = static_cast<unsigned>(std::stoul(getCsvParams(exportCsvStats("test-lazy-cores.csv"))["num_cores"]));
+  unsigned numCols = props.numColPerSubarray;
+  bool ok = checkMaterialized("Created device", 0);
+
+  // an object in one core materializes only that core
+  PimObjId obj1 = pimAlloc(PIM_ALLOC_AUTO, numCols, PIM_INT32);
+  assert(obj1 != -1);
+  ok = checkMaterialized("Allocated one region", 1) && ok;
+
+  // an allocation that runs out of rows after placing regions on all cores leaves them unmaterialized
+  PimObjId objTooLarge = pimAlloc(PIM_ALLOC_AUTO, static_cast<uint64_t>(numCores) * numCols * 1024, PIM_INT32);
+  ok = ok && objTooLarge == -1;
+  ok = checkMaterialized("Failed allocation", 1) && ok;
+
+  // an associated object on the same core does not materialize more cores
+  PimObjId obj2 = pimAllocAssociated(obj1, PIM_INT32);
+  assert(obj2 != -1);
+  ok = checkMaterialized("Allocated associated object", 1) && ok;
+
+  // an object spanning all cores materializes all of them, and data reads back
+  uint64_t numElements = static_cast<uint64_t>(numCores) * numCols;
+  std::vector<int> src(numElements);
+  std::vector<int> dest(numElements);
+  for (uint64_t i = 0; i < numElements; ++i) {
+    src[i] = static_cast<int>(i * 7);
+  }
+  PimObjId obj3 = pimAlloc(PIM_ALLOC_AUTO, numElements, PIM_INT32);
+  assert(obj3 != -1);
+  status = pimCopyHostToDevice((void*)src.data(), obj3);
+  assert(status == PIM_OK);
+  status = pimCopyDeviceToHost(obj3, (void*)dest.data());
+  assert(status == PIM_OK);
+  ok = ok && src == dest;
+  ok = checkMaterialized("Allocated all cores", numCores) && ok;
+
+  pimFree(obj1);
+  pimFree(obj2);
+  pimFree(obj3);
+  pimDeleteDevice();
+  std::cout << (ok ? "Passed!" : "Failed!") << std::endl;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,105 @@
+// Test: Bit-serial logic families
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "libpimeval.h"
+#include "../util.h"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <map>
+#include <cassert>
+#include <cstdio>
+
+
+//! @brief  Run a few INT32 ops on a device and return the modeled runtime of each command
+bool runOps(PimDeviceEnum deviceType, std::map<std::string, double>& runtimes)
+{
+  unsigned numElements = 1000;
+  PimStatus status = pimCreateDevice(deviceType, 1, 1, 4, 1024, 256);
+  assert(status == PIM_OK);
+
+  std::vector<int> src1(numElements);
+  std::vector<int> src2(numElements);
+  std::vector<int> dest(numElements);
+  for (unsigned i = 0; i < numElements; ++i) {
+    src1[i] = i * 3 - 100;
+    src2[i] = i * 7 + 5;
+  }
+
+  PimObjId obj1 = pimAlloc(PIM_ALLOC_AUTO, numElements, PIM_INT32);
+  assert(obj1 != -1);
+  PimObjId obj2 = pimAllocAssociated(obj1, PIM_INT32);
+  assert(obj2 != -1);
+  PimObjId obj3 = pimAllocAssociated(obj1, PIM_INT32);
+  assert(obj3 != -1);
+  status = pimCopyHostToDevice((void*)src1.data(), obj1);
+  assert(status == PIM_OK);
+  status = pimCopyHostToDevice((void*)src2.data(), obj2);
+  assert(status == PIM_OK);
+
+  bool ok = true;
+  status = pimAdd(obj1, obj2, obj3);
+  assert(status == PIM_OK);
+  status = pimCopyDeviceToHost(obj3, (void*)dest.data());
+  assert(status == PIM_OK);
+  for (unsigned i = 0; i < numElements; ++i) {
+    ok = ok && dest[i] == src1[i] + src2[i];
+  }
+  status = pimXor(obj1, obj2, obj3);
+  assert(status == PIM_OK);
+  status = pimCopyDeviceToHost(obj3, (void*)dest.data());
+  assert(status == PIM_OK);
+  for (unsigned i = 0; i < numElements; ++i) {
+    ok = ok && dest[i] == (src1[i] ^ src2[i]);
+  }
+  status = pimMul(obj1, obj2, obj3);
+  assert(status == PIM_OK);
+
+  runtimes = getCsvRuntimes(exportCsvStats("test-logic-families.csv"), "command");
+
+  pimFree(obj3);
+  pimFree(obj2);
+  pimFree(obj1);
+  pimDeleteDevice();
+  return ok;
+}
+
+int main()
+{
+  std::cout << "PIM test: Bit-serial logic families" << std::endl;
+
+  std::map<std::string, double> baseRuntimes;
+  bool ok = runOps(PIM_DEVICE_BITSIMD_V, baseRuntimes);
+
+  std::vector<std::pair<PimDeviceEnum, std::string>> devices = {
+    { PIM_DEVICE_BITSIMD_V_NAND, "BITSIMD_V_NAND" },
+    { PIM_DEVICE_BITSIMD_V_MAJ, "BITSIMD_V_MAJ" },
+    { PIM_DEVICE_DRISA_NOR, "DRISA_NOR" },
+    { PIM_DEVICE_DRISA_MIXED, "DRISA_MIXED" },
+  };
+  for (const auto& [deviceType, deviceName] : devices) {
+    std::map<std::string, double> runtimes;
+    if (!runOps(deviceType, runtimes)) {
+      std::cout << "Incorrect results on " << deviceName << std::endl;
+      ok = false;
+      continue;
+    }
+    // Each device must have its own table entry rather than the fallback cost, and emulating
+    // XOR with fewer logic primitives can not be cheaper than BitSIMD-V.
+    for (std::string cmd : { "add.int32.v", "xor.int32.v", "mul.int32.v" }) {
+      auto it = runtimes.find(cmd);
+      if (it == runtimes.end() || it->second <= 0.0 || it->second >= 1000000
+          || it->second < baseRuntimes[cmd]) {
+        std::cout << "Unexpected runtime of " << cmd << " on " << deviceName << std::endl;
+        ok = false;
+      }
+    }
+    std::cout << deviceName << ": add " << runtimes["add.int32.v"] << " ms, xor "
+              << runtimes["xor.int32.v"] << " ms, mul " << runtimes["mul.int32.v"] << " ms" << std::endl;
+  }
+
+  std::cout << (ok ? "Passed!" : "Failed!") << std::endl;
+  return ok ? 0 : 1;
+}
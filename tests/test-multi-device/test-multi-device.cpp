@@ -0,0 +1,176 @@
+// Test: Test multiple devices and contexts
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "libpimeval.h"
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <cstdlib>
+#include <cstdio>
+
+
+// Split a vector addition across devices, with each device computing one slice
+bool testMultiDevice(PimDeviceEnum deviceType, unsigned numDevices)
+{
+  unsigned numRanks = 1;
+  unsigned numBankPerRank = 2;
+  unsigned numSubarrayPerBank = 4;
+  unsigned numRows = 1024;
+  unsigned numCols = 1024;
+
+  uint64_t numElements = 30000;
+  std::vector<int> src1(numElements);
+  std::vector<int> src2(numElements);
+  for (uint64_t i = 0; i < numElements; ++i) {
+    src1[i] = i;
+    src2[i] = 5 * i - 7;
+  }
+
+  PimStatus status = pimCreateDevice(deviceType, numRanks, numBankPerRank, numSubarrayPerBank, numRows, numCols);
+  assert(status == PIM_OK);
+  for (unsigned i = 1; i < numDevices; ++i) {
+    PimDeviceId deviceId = pimAddDevice(deviceType, numRanks, numBankPerRank, numSubarrayPerBank, numRows, numCols);
+    assert(deviceId == static_cast<PimDeviceId>(i));
+  }
+  assert(pimGetNumDevices() == numDevices);
+
+  // allocate and copy one slice per device
+  uint64_t sliceSize = (numElements + numDevices - 1) / numDevices;
+  std::vector<PimObjId> objs1(numDevices);
+  std::vector<PimObjId> objs2(numDevices);
+  for (unsigned i = 0; i < numDevices; ++i) {
+    uint64_t idxBegin = i * sliceSize;
+    uint64_t numSliceElements = std::min(sliceSize, numElements - idxBegin);
+    status = pimSetDevice(i);
+    assert(status == PIM_OK);
+    objs1[i] = pimAlloc(PIM_ALLOC_AUTO, numSliceElements, PIM_INT32);
+    assert(objs1[i] != -1);
+    objs2[i] = pimAllocAssociated(objs1[i], PIM_INT32);
+    assert(objs2[i] != -1);
+    assert(pimGetObjectDevice(objs1[i]) == static_cast<PimDeviceId>(i));
+    assert(pimGetObjectDevice(objs2[i]) == static_cast<PimDeviceId>(i));
+    status = pimCopyHostToDevice((void*)(src1.data() + idxBegin), objs1[i]);
+    assert(status == PIM_OK);
+    status = pimCopyHostToDevice((void*)(src2.data() + idxBegin), objs2[i]);
+    assert(status == PIM_OK);
+  }
+
+  // commands go to the device owning their objects regardless of the current device
+  status = pimSetDevice(0);
+  assert(status == PIM_OK);
+  for (unsigned i = 0; i < numDevices; ++i) {
+    status = pimAdd(objs1[i], objs2[i], objs2[i]);
+    assert(status == PIM_OK);
+  }
+
+  // objects of different devices cannot be used together
+  if (numDevices > 1) {
+    status = pimAdd(objs1[0], objs2[1], objs2[0]);
+    assert(status == PIM_ERROR);
+  }
+
+  std::vector<int> dest(numElements);
+  int64_t sum = 0;
+  for (unsigned i = 0; i < numDevices; ++i) {
+    status = pimCopyDeviceToHost(objs2[i], (void*)(dest.data() + i * sliceSize));
+    assert(status == PIM_OK);
+    int64_t sliceSum = 0;
+    status = pimRedSumInt(objs1[i], &sliceSum);
+    assert(status == PIM_OK);
+    sum += sliceSum;
+  }
+
+  bool ok = true;
+  int64_t expectedSum = 0;
+  for (uint64_t i = 0; i < numElements; ++i) {
+    expectedSum += src1[i];
+    if (dest[i] != src1[i] + src2[i]) {
+      std::cout << "Mismatch at " << i << ": " << dest[i] << " expected " << src1[i] + src2[i] << std::endl;
+      ok = false;
+      break;
+    }
+  }
+  std::cout << "Result: RedSum across " << numDevices << " devices: PIM " << sum << " expected " << expectedSum << std::endl;
+  ok = ok && (sum == expectedSum);
+
+  for (unsigned i = 0; i < numDevices; ++i) {
+    pimFree(objs1[i]);
+    pimFree(objs2[i]);
+  }
+
+  std::cout << (ok ? "Passed!" : "Failed!") << std::endl;
+
+  pimShowStats();
+  pimResetStats();
+  pimDeleteDevice();
+  return ok;
+}
+
+// Run two independent simulations in one process
+bool testMultiContext()
+{
+  uint64_t numElements = 4096;
+  std::vector<int> src(numElements, 3);
+
+  PimContextId ctxA = pimGetContext();
+  PimContextId ctxB = pimCreateContext();
+  assert(ctxA == 0 && ctxB > 0);
+
+  PimStatus status = pimCreateDevice(PIM_DEVICE_BITSIMD_V, 1, 2, 4, 1024, 1024);
+  assert(status == PIM_OK);
+  PimObjId objA = pimAlloc(PIM_ALLOC_AUTO, numElements, PIM_INT32);
+  assert(objA != -1);
+  status = pimCopyHostToDevice((void*)src.data(), objA);
+  assert(status == PIM_OK);
+
+  status = pimSetContext(ctxB);
+  assert(status == PIM_OK && pimGetContext() == ctxB);
+  status = pimCreateDevice(PIM_DEVICE_FULCRUM, 1, 2, 4, 1024, 1024);
+  assert(status == PIM_OK);
+  PimObjId objB = pimAlloc(PIM_ALLOC_AUTO, numElements, PIM_INT32);
+  assert(objB != -1);
+  status = pimBroadcastInt(objB, 5);
+  assert(status == PIM_OK);
+  int64_t sumB = 0;
+  status = pimRedSumInt(objB, &sumB);
+  assert(status == PIM_OK);
+
+  status = pimSetContext(ctxA);
+  assert(status == PIM_OK);
+  int64_t sumA = 0;
+  status = pimRedSumInt(objA, &sumA);
+  assert(status == PIM_OK);
+  PimDeviceProperties props;
+  status = pimGetDeviceProperties(&props);
+  assert(status == PIM_OK);
+
+  bool ok = (sumA == 3 * (int64_t)numElements) && (sumB == 5 * (int64_t)numElements) &&
+            props.deviceType == PIM_DEVICE_BITSIMD_V;
+  std::cout << "Result: RedSum of contexts: " << sumA << ", " << sumB << std::endl;
+
+  status = pimDestroyContext(ctxB);
+  assert(status == PIM_OK);
+  assert(pimSetContext(ctxB) == PIM_ERROR);
+  assert(pimDestroyContext(0) == PIM_ERROR);
+  pimFree(objA);
+  pimDeleteDevice();
+
+  std::cout << (ok ? "Passed!" : "Failed!") << std::endl;
+  return ok;
+}
+
+int main()
+{
+  std::cout << "PIM Regression Test: Multiple Devices and Contexts" << std::endl;
+
+  bool ok = true;
+  ok = testMultiDevice(PIM_DEVICE_BITSIMD_V, 3) && ok;
+
+  ok = testMultiDevice(PIM_DEVICE_FULCRUM, 2) && ok;
+
+  ok = testMultiContext() && ok;
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,148 @@
+// Test: Object pool of freed PIM objects
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "libpimeval.h"
+#include "../util.h"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <map>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+
+
+//! @brief  Check object pool counters and rows in use of the single core
+bool checkPool(const char* step, unsigned numHits, unsigned numMisses, unsigned numPooled, unsigned numRowsInUse)
+{
+  std::map<std::string, std::string> params = getCsvParams(exportCsvStats("test-obj-pool.csv"));
+  std::cout << step << ": " << params["num_obj_pool_hits"] << " hits, " << params["num_obj_pool_misses"] << " misses, "
+            << params["num_pooled_objs"] << " pooled, " << params["max_rows_in_use"] << " rows in use" << std::endl;
+  return params["num_obj_pool_hits"] == std::to_string(numHits) && params["num_obj_pool_misses"] == std::to_string(numMisses) &&
+         params["num_pooled_objs"] == std::to_string(numPooled) && params["max_rows_in_use"] == std::to_string(numRowsInUse);
+}
+
+//! @brief  Create a device with one core of 2048 rows and 256 columns
+void createDevice()
+{
+  PimStatus status = pimCreateDevice(PIM_DEVICE_BITSIMD_V, 1, 1, 2, 1024, 256);
+  assert(status == PIM_OK);
+}
+
+//! @brief  The pool is off by default, and freed objects release their rows
+bool testPoolOff()
+{
+  unsetenv("PIMEVAL_OBJ_POOL");
+  createDevice();
+  PimObjId obj1 = pimAlloc(PIM_ALLOC_V, 256, PIM_INT32);
+  PimObjId obj2 = pimAllocAssociated(obj1, PIM_INT32);
+  assert(obj1 != -1 && obj2 != -1);
+  bool ok = getCsvParams(exportCsvStats("test-obj-pool.csv"))["obj_pool"] == "off";
+  ok = checkPool("Pool off, allocated", 0, 0, 0, 64) && ok;
+  pimFree(obj2);
+  pimFree(obj1);
+  ok = checkPool("Pool off, freed", 0, 0, 0, 0) && ok;
+  pimDeleteDevice();
+  return ok;
+}
+
+//! @brief  Freed objects are reused by allocations of the same shape, including associated objects of a reused root
+bool testPoolReuse()
+{
+  setenv("PIMEVAL_OBJ_POOL", "on", 1);
+  createDevice();
+  bool ok = getCsvParams(exportCsvStats("test-obj-pool.csv"))["obj_pool"] == "on";
+  std::vector<int> src(256);
+  std::vector<int> dest(256);
+  for (unsigned i = 0; i < src.size(); ++i) {
+    src[i] = static_cast<int>(i) - 100;
+  }
+
+  PimObjId root = pimAlloc(PIM_ALLOC_V, 256, PIM_INT32);
+  PimObjId assoc = pimAllocAssociated(root, PIM_INT32);
+  assert(root != -1 && assoc != -1);
+  ok = checkPool("Allocated", 0, 2, 0, 64) && ok;
+  pimFree(assoc);
+  pimFree(root);
+  ok = checkPool("Freed root and associated", 0, 2, 2, 64) && ok;
+
+  // the associated object was pooled with the old root, and matches the root reusing its layout
+  PimObjId newRoot = pimAlloc(PIM_ALLOC_V, 256, PIM_INT32);
+  PimObjId newAssoc = pimAllocAssociated(newRoot, PIM_INT32);
+  assert(newRoot != -1 && newAssoc != -1);
+  ok = checkPool("Reused root and associated", 2, 2, 0, 64) && ok;
+  PimStatus status = pimCopyHostToDevice((void*)src.data(), newRoot);
+  assert(status == PIM_OK);
+  status = pimAdd(newRoot, newRoot, newAssoc);
+  ok = ok && status == PIM_OK;
+  status = pimCopyDeviceToHost(newAssoc, (void*)dest.data());
+  assert(status == PIM_OK);
+  for (unsigned i = 0; i < src.size(); ++i) {
+    ok = ok && dest[i] == 2 * src[i];
+  }
+
+  // an associated object freed after its root is reused also matches the reused root
+  pimFree(newRoot);
+  PimObjId thirdRoot = pimAlloc(PIM_ALLOC_V, 256, PIM_INT32);
+  assert(thirdRoot != -1);
+  pimFree(newAssoc);
+  PimObjId thirdAssoc = pimAllocAssociated(thirdRoot, PIM_INT32);
+  assert(thirdAssoc != -1);
+  ok = checkPool("Reused associated freed after root reuse", 4, 2, 0, 64) && ok;
+
+  // other shapes miss, and trim releases pooled rows. 512 elements take two 32-row regions on the core
+  PimObjId objOther = pimAlloc(PIM_ALLOC_V, 512, PIM_INT32);
+  assert(objOther != -1);
+  ok = checkPool("Allocated other shape", 4, 3, 0, 128) && ok;
+  pimFree(objOther);
+  pimFree(thirdAssoc);
+  ok = checkPool("Freed", 4, 3, 2, 128) && ok;
+  status = pimTrimObjectPool();
+  ok = ok && status == PIM_OK;
+  ok = checkPool("Trimmed", 4, 3, 0, 32) && ok;
+
+  pimFree(thirdRoot);
+  pimDeleteDevice();
+  return ok;
+}
+
+//! @brief  An allocation that does not fit releases the pool and retries, without compaction
+bool testTrimOnAllocFailure()
+{
+  setenv("PIMEVAL_OBJ_POOL", "on", 1);
+  createDevice();
+  std::vector<PimObjId> objs;
+  for (unsigned i = 0; i < 2048 / 32; ++i) {
+    PimObjId objId = pimAlloc(PIM_ALLOC_V, 256, PIM_INT32);
+    assert(objId != -1);
+    objs.push_back(objId);
+  }
+  for (PimObjId objId : objs) {
+    pimFree(objId);
+  }
+  bool ok = checkPool("Pooled a full core", 0, 64, 64, 2048);
+
+  // a different shape does not fit beside pooled rows, so the pool is trimmed and the allocation is retried
+  PimObjId objLarge = pimAlloc(PIM_ALLOC_V, 256, PIM_INT64);
+  ok = ok && objLarge != -1;
+  ok = checkPool("Allocated after trim", 0, 65, 0, 64) && ok;
+  ok = ok && getCsvParams(exportCsvStats("test-obj-pool.csv"))["num_compactions"] == "0";
+
+  pimFree(objLarge);
+  pimDeleteDevice();
+  return ok;
+}
+
+int main()
+{
+  std::cout << "PIM test: Object pool of freed PIM objects" << std::endl;
+  bool ok = true;
+  ok = testPoolOff() && ok;
+  ok = testPoolReuse() && ok;
+  ok = testTrimOnAllocFailure() && ok;
+  std::cout << (ok ? "Passed!" : "Failed!") << std::endl;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,105 @@
+// Test: Performance-model-only simulation mode
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "libpimeval.h"
+#include "../util.h"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <map>
+#include <cassert>
+#include <cstdlib>
+#include <cstdint>
+
+
+//! @brief  Run a small workload in functional or perf_only mode, and return its modeled stats and output
+std::map<std::string, csvStatsRow> runWorkload(bool isPerfOnly, std::vector<int>& dest, std::vector<int>& destRanged, int64_t& sum)
+{
+  if (isPerfOnly) {
+    setenv("PIMEVAL_SIM_MODE", "perf_only", 1);
+  } else {
+    unsetenv("PIMEVAL_SIM_MODE");
+  }
+  PimStatus status = pimCreateDevice(PIM_DEVICE_BITSIMD_V, 1, 2, 2, 1024, 256);
+  assert(status == PIM_OK);
+
+  unsigned numElements = 2000;
+  std::vector<int> src1(numElements);
+  std::vector<int> src2(numElements);
+  for (unsigned i = 0; i < numElements; ++i) {
+    src1[i] = i;
+    src2[i] = 3 * i + 1;
+  }
+  PimObjId obj1 = pimAlloc(PIM_ALLOC_AUTO, numElements, PIM_INT32);
+  assert(obj1 != -1);
+  PimObjId obj2 = pimAllocAssociated(obj1, PIM_INT32);
+  assert(obj2 != -1);
+  status = pimCopyHostToDevice((void*)src1.data(), obj1);
+  assert(status == PIM_OK);
+  status = pimCopyHostToDevice((void*)src2.data(), obj2);
+  assert(status == PIM_OK);
+  status = pimAdd(obj1, obj2, obj2);
+  assert(status == PIM_OK);
+  status = pimMulScalar(obj2, obj2, 3);
+  assert(status == PIM_OK);
+  status = pimRedSumInt(obj2, &sum);
+  assert(status == PIM_OK);
+
+  // fill host buffers with a pattern, which perf_only mode must overwrite with zeros
+  dest.assign(numElements, 0x5a5a5a5a);
+  destRanged.assign(numElements, 0x5a5a5a5a);
+  status = pimCopyDeviceToHost(obj2, (void*)dest.data());
+  assert(status == PIM_OK);
+  status = pimCopyDeviceToHost(obj2, (void*)destRanged.data(), 100, 1100);
+  assert(status == PIM_OK);
+
+  std::map<std::string, csvStatsRow> stats =
+      getCsvSections(exportCsvStats("test-perf-only.csv"), {"command", "copy", "total"});
+
+  pimFree(obj1);
+  pimFree(obj2);
+  pimDeleteDevice();
+  unsetenv("PIMEVAL_SIM_MODE");
+  return stats;
+}
+
+int main()
+{
+  std::cout << "PIM test: Performance-model-only simulation mode" << std::endl;
+
+  std::vector<int> dest;
+  std::vector<int> destRanged;
+  int64_t sum = 0;
+  std::map<std::string, csvStatsRow> statsFunctional = runWorkload(false, dest, destRanged, sum);
+  bool ok = !statsFunctional.empty() && sum != 0 && dest[1999] == (1999 + 3 * 1999 + 1) * 3;
+
+  std::map<std::string, csvStatsRow> statsPerfOnly = runWorkload(true, dest, destRanged, sum);
+
+  // modeled stats are the same as in functional mode
+  if (statsPerfOnly != statsFunctional) {
+    std::cout << "Error: Modeled stats of perf_only mode differ from functional mode" << std::endl;
+    for (const auto& [key, fields] : statsFunctional) {
+      if (statsPerfOnly[key] != fields) {
+        std::cout << "  Mismatch of " << key << std::endl;
+      }
+    }
+    ok = false;
+  }
+
+  // data-dependent outputs are zeros, and a ranged copy only writes its range
+  bool isZero = (sum == 0);
+  for (unsigned i = 0; i < dest.size(); ++i) {
+    isZero = isZero && dest[i] == 0;
+    bool isInRange = (i < 1000);
+    isZero = isZero && destRanged[i] == (isInRange ? 0 : 0x5a5a5a5a);
+  }
+  if (!isZero) {
+    std::cout << "Error: Data-dependent outputs of perf_only mode are not zeros" << std::endl;
+    ok = false;
+  }
+
+  std::cout << (ok ? "Passed!" : "Failed!") << std::endl;
+  return ok ? 0 : 1;
+}
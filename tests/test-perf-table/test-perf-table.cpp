@@ -0,0 +1,105 @@
+// Test: Loading generated bit-serial perf tables
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "libpimeval.h"
+#include "../util.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <map>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+
+//! @brief  Write a perf table of one entry for add.int32 of BitSIMD-V
+void writeTable(const std::string& fileName, int version, const std::string& cmd, const std::string& numR)
+{
+  std::ofstream file(fileName);
+  file << "{\n  \"format\": \"pimeval-bitserial-perf-table\",\n  \"version\": " << version << ",\n  \"entries\": [\n"
+       << "    { \"device\": \"PIM_DEVICE_BITSIMD_V\", \"data_type\": \"int32\", \"cmd\": \"" << cmd
+       << "\", \"num_r\": " << numR << ", \"num_w\": 32, \"num_l\": 64 }\n  ]\n}\n";
+}
+
+//! @brief  Create a device with a perf table, and return modeled runtime of add.int32.v and the simulator output
+double runAdd(const char* tableFile, std::string& output)
+{
+  // capture stdout of the simulator
+  std::fflush(stdout);
+  int savedStdout = dup(STDOUT_FILENO);
+  FILE* capture = std::freopen("test-perf-table.log", "w", stdout);
+  assert(capture);
+  if (tableFile) {
+    setenv("PIMEVAL_BITSERIAL_PERF_TABLE", tableFile, 1);
+  }
+  PimStatus status = pimCreateDevice(PIM_DEVICE_BITSIMD_V, 1, 1, 2, 1024, 256);
+  assert(status == PIM_OK);
+  unsetenv("PIMEVAL_BITSERIAL_PERF_TABLE");
+  PimObjId obj1 = pimAlloc(PIM_ALLOC_AUTO, 256, PIM_INT32);
+  PimObjId obj2 = pimAllocAssociated(obj1, PIM_INT32);
+  assert(obj1 != -1 && obj2 != -1);
+  status = pimAdd(obj1, obj2, obj2);
+  assert(status == PIM_OK);
+  status = pimExportStats("test-perf-table.csv", PIM_STATS_CSV);
+  assert(status == PIM_OK);
+  pimDeleteDevice();
+  std::fflush(stdout);
+  dup2(savedStdout, STDOUT_FILENO);
+  close(savedStdout);
+
+  std::ifstream log("test-perf-table.log");
+  std::stringstream content;
+  content << log.rdbuf();
+  output = content.str();
+  std::remove("test-perf-table.log");
+
+  std::map<std::string, double> runtimes = getCsvRuntimes(readCsvStats("test-perf-table.csv"), "command");
+  std::remove("test-perf-table.csv");
+  double msRuntime = runtimes.count("add.int32.v") ? runtimes["add.int32.v"] : -1.0;
+  return msRuntime;
+}
+
+//! @brief  Check that a table is rejected with a warning and the compiled-in table is used
+bool checkFallback(const std::string& what, double msRuntime, double msDefault, const std::string& output, const std::string& error)
+{
+  bool ok = msRuntime == msDefault && output.find(error) != std::string::npos
+            && output.find("PIM-Warning: Use compiled-in bit-serial perf table") != std::string::npos;
+  std::cout << what << ": " << msRuntime << " ms, " << (ok ? "falls back to compiled-in table" : "unexpected") << std::endl;
+  return ok;
+}
+
+int main()
+{
+  std::cout << "PIM test: Loading generated bit-serial perf tables" << std::endl;
+  const char* tableFile = "test-perf-table.json";
+  std::string output;
+  bool ok = true;
+
+  double msDefault = runAdd(nullptr, output);
+  std::cout << "Compiled-in table: " << msDefault << " ms" << std::endl;
+  ok = ok && msDefault > 0.0;
+
+  // an overridden entry changes the modeled runtime
+  writeTable(tableFile, PIMEVAL_BITSERIAL_PERF_TABLE_VERSION, "add", "1000");
+  double msLoaded = runAdd(tableFile, output);
+  bool isLoaded = msLoaded > msDefault && output.find("PIM-Info: Loaded 1 entries") != std::string::npos;
+  std::cout << "Overridden entry: " << msLoaded << " ms, " << (isLoaded ? "loaded" : "unexpected") << std::endl;
+  ok = ok && isLoaded;
+
+  // invalid tables are rejected as a whole
+  writeTable(tableFile, PIMEVAL_BITSERIAL_PERF_TABLE_VERSION + 1, "add", "1000");
+  ok = checkFallback("Wrong version", runAdd(tableFile, output), msDefault, output, "is not of version") && ok;
+  writeTable(tableFile, PIMEVAL_BITSERIAL_PERF_TABLE_VERSION, "no_such_cmd", "1000");
+  ok = checkFallback("Unknown command", runAdd(tableFile, output), msDefault, output, "Unknown entry") && ok;
+  writeTable(tableFile, PIMEVAL_BITSERIAL_PERF_TABLE_VERSION, "add", "-1");
+  ok = checkFallback("Negative count", runAdd(tableFile, output), msDefault, output, "Invalid op counts") && ok;
+  std::remove(tableFile);
+
+  std::cout << (ok ? "Passed!" : "Failed!") << std::endl;
+  return ok ? 0 : 1;
+}
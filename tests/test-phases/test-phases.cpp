@@ -0,0 +1,87 @@
+// Test: Test phases
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "libpimeval.h"
+#include "../util.h"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <map>
+#include <cassert>
+
+
+bool testPhases(PimDeviceEnum deviceType)
+{
+  unsigned numRanks = 1;
+  unsigned numBankPerRank = 2;
+  unsigned numSubarrayPerBank = 4;
+  unsigned numRows = 1024;
+  unsigned numCols = 1024;
+  uint64_t numElements = 10000;
+  std::vector<int> src(numElements, 1);
+  std::string fileName = "test-phases.csv";
+  bool ok = true;
+
+  PimStatus status = pimCreateDevice(deviceType, numRanks, numBankPerRank, numSubarrayPerBank, numRows, numCols);
+  assert(status == PIM_OK);
+  PimObjId obj1 = pimAlloc(PIM_ALLOC_AUTO, numElements, PIM_INT32);
+  PimObjId obj2 = pimAllocAssociated(obj1, PIM_INT32);
+  assert(obj1 != -1 && obj2 != -1);
+  status = pimEndPhase();
+  assert(status == PIM_ERROR);
+
+  status = pimBeginPhase("load");
+  assert(status == PIM_OK);
+  status = pimCopyHostToDevice((void*)src.data(), obj1);
+  assert(status == PIM_OK);
+  status = pimEndPhase();
+  assert(status == PIM_OK);
+
+  status = pimBeginPhase("compute");
+  assert(status == PIM_OK);
+  for (int layer = 0; layer < 2; ++layer) {
+    status = pimBeginPhase("layer");
+    assert(status == PIM_OK);
+    status = pimAdd(obj1, obj1, obj2);
+    assert(status == PIM_OK);
+    status = pimEndPhase();
+    assert(status == PIM_OK);
+  }
+  status = pimMulScalar(obj2, obj2, 3);
+  assert(status == PIM_OK);
+  status = pimEndPhase();
+  assert(status == PIM_OK);
+
+  pimShowStats();
+  auto rows = getCsvSections(exportCsvStats(fileName), {"phase", "phase_copy"});
+  // columns: device, section, name, count, value, ms_runtime, ..., mj_energy at index 10
+  if (rows["phase,load"].size() < 6 || rows["phase,load"][3] != "0" || rows["phase_copy,load"][4] != "40000") {
+    std::cout << "Error: Unexpected stats of phase load" << std::endl;
+    ok = false;
+  }
+  if (rows["phase,compute/layer"].size() < 6 || rows["phase,compute/layer"][3] != "2" || rows["phase,compute/layer"][4] != "2") {
+    std::cout << "Error: Unexpected stats of phase compute/layer" << std::endl;
+    ok = false;
+  }
+  if (rows["phase,compute"].size() < 6 || rows["phase,compute"][3] != "3" ||
+      std::stod(rows["phase,compute"][5]) <= std::stod(rows["phase,compute/layer"][5])) {
+    std::cout << "Error: Unexpected stats of phase compute" << std::endl;
+    ok = false;
+  }
+  pimDeleteDevice();
+  return ok;
+}
+
+int main()
+{
+  std::cout << "PIM Regression Test: Phases" << std::endl;
+
+  bool ok = true;
+  ok &= testPhases(PIM_DEVICE_BITSIMD_V);
+  ok &= testPhases(PIM_DEVICE_FULCRUM);
+
+  std::cout << (ok ? "Passed!" : "Failed!") << std::endl;
+  return 0;
+}
@@ -0,0 +1,120 @@
+// Test: Test ranged reference
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "libpimeval.h"
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <cstdlib>
+#include <cstdio>
+
+
+bool testRangedRef(PimDeviceEnum deviceType)
+{
+  unsigned numRanks = 1;
+  unsigned numBankPerRank = 2;
+  unsigned numSubarrayPerBank = 4;
+  unsigned numRows = 1024;
+  unsigned numCols = 1024;
+
+  uint64_t numElements = 10000;
+  uint64_t idxBegin = 1234;
+  uint64_t idxEnd = 7777;
+  uint64_t numRefElements = idxEnd - idxBegin;
+  std::vector<int> src1(numElements);
+  std::vector<int> src2(numElements);
+  for (uint64_t i = 0; i < numElements; ++i) {
+    src1[i] = i;
+    src2[i] = 3 * i + 1;
+  }
+
+  PimStatus status = pimCreateDevice(deviceType, numRanks, numBankPerRank, numSubarrayPerBank, numRows, numCols);
+  assert(status == PIM_OK);
+
+  PimObjId obj1 = pimAlloc(PIM_ALLOC_AUTO, numElements, PIM_INT32);
+  assert(obj1 != -1);
+  PimObjId obj2 = pimAllocAssociated(obj1, PIM_INT32);
+  assert(obj2 != -1);
+  status = pimCopyHostToDevice((void*)src1.data(), obj1);
+  assert(status == PIM_OK);
+  status = pimCopyHostToDevice((void*)src2.data(), obj2);
+  assert(status == PIM_OK);
+
+  // views of the same range of associated objects are associated
+  PimObjId ref1 = pimCreateRangedRef(obj1, idxBegin, idxEnd);
+  PimObjId ref2 = pimCreateRangedRef(obj2, idxBegin, idxEnd);
+  assert(ref1 != -1 && ref2 != -1);
+  PimObjId tmp = pimAllocAssociated(ref1, PIM_INT32);
+  assert(tmp != -1);
+
+  // compute on views: obj2[range] = obj1[range] + obj2[range] * 2
+  status = pimMulScalar(ref2, tmp, 2);
+  assert(status == PIM_OK);
+  status = pimAdd(ref1, tmp, ref2);
+  assert(status == PIM_OK);
+
+  // copy a view and a sub-range of a view
+  std::vector<int> dest(numElements);
+  status = pimCopyDeviceToHost(obj2, (void*)dest.data());
+  assert(status == PIM_OK);
+  std::vector<int> destRef(numRefElements);
+  status = pimCopyDeviceToHost(ref2, (void*)destRef.data());
+  assert(status == PIM_OK);
+
+  bool ok = true;
+  for (uint64_t i = 0; i < numElements; ++i) {
+    bool inRange = (i >= idxBegin && i < idxEnd);
+    int expected = inRange ? src1[i] + src2[i] * 2 : src2[i];
+    if (dest[i] != expected || (inRange && destRef[i - idxBegin] != expected)) {
+      std::cout << "Mismatch at " << i << ": " << dest[i] << " expected " << expected << std::endl;
+      ok = false;
+      break;
+    }
+  }
+
+  // reduction sum of a view of a view
+  PimObjId ref3 = pimCreateRangedRef(ref1, 100, 200);
+  assert(ref3 != -1);
+  int64_t sum = 0;
+  status = pimRedSumInt(ref3, &sum);
+  assert(status == PIM_OK);
+  int64_t expectedSum = 0;
+  for (uint64_t i = idxBegin + 100; i < idxBegin + 200; ++i) {
+    expectedSum += src1[i];
+  }
+  std::cout << "Result: RedSum of ranged ref: PIM " << sum << " expected " << expectedSum << std::endl;
+  ok = ok && (sum == expectedSum);
+
+  // invalid range
+  assert(pimCreateRangedRef(obj1, idxEnd, idxBegin) == -1);
+  assert(pimCreateRangedRef(obj1, 0, numElements + 1) == -1);
+
+  status = pimFree(ref3);
+  assert(status == PIM_OK);
+  pimFree(tmp);
+  pimFree(obj1);
+  pimFree(obj2);
+
+  std::cout << (ok ? "Passed!" : "Failed!") << std::endl;
+
+  pimShowStats();
+  pimResetStats();
+  pimDeleteDevice();
+  return ok;
+}
+
+int main()
+{
+  std::cout << "PIM Regression Test: Ranged Reference" << std::endl;
+
+  bool ok = true;
+  ok = testRangedRef(PIM_DEVICE_BITSIMD_V) && ok;
+
+  ok = testRangedRef(PIM_DEVICE_FULCRUM) && ok;
+
+  ok = testRangedRef(PIM_DEVICE_BANK_LEVEL) && ok;
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,151 @@
+// Test: Rank and core resource timeline
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "libpimeval.h"
+#include "../util.h"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <map>
+#include <cassert>
+#include <cstdio>
+#include <cmath>
+
+
+//! @brief  How chunks are issued
+enum class ChunkMode {
+  SYNC,              // synchronous APIs, reading results back
+  SYNC_NO_READBACK,  // synchronous APIs, leaving results on the device
+  STREAMS,           // one stream per chunk, reading results back
+};
+
+//! @brief  Run copy-compute-copy on a number of chunks, with or without a dependency between chunks
+bool runChunks(ChunkMode mode, bool isDependent, std::map<std::string, double>& runtimes)
+{
+  unsigned numChunks = 4;
+  unsigned numElements = 256;
+  std::vector<int> src1(numElements, 3);
+  std::vector<int> src2(numElements, 5);
+  std::vector<std::vector<int>> dest(numChunks, std::vector<int>(numElements));
+
+  pimResetStats();
+  PimObjId acc = -1;
+  std::vector<PimObjId> objs;
+  std::vector<PimStreamId> streams;
+  for (unsigned i = 0; i < numChunks; ++i) {
+    PimObjId obj1 = (isDependent && acc != -1) ? pimAllocAssociated(acc, PIM_INT32) : pimAlloc(PIM_ALLOC_AUTO, numElements, PIM_INT32);
+    assert(obj1 != -1);
+    PimObjId obj2 = pimAllocAssociated(obj1, PIM_INT32);
+    assert(obj2 != -1);
+    if (mode == ChunkMode::STREAMS) {
+      streams.push_back(pimStreamCreate());
+      assert(streams.back() > 0);
+      PimStatus status = pimSetStream(streams.back());
+      assert(status == PIM_OK);
+    }
+    PimStatus status = pimCopyHostToDevice((void*)src1.data(), obj1);
+    assert(status == PIM_OK);
+    status = pimCopyHostToDevice((void*)src2.data(), obj2);
+    assert(status == PIM_OK);
+    if (isDependent && acc != -1) {
+      status = pimAdd(acc, obj2, obj2);
+      assert(status == PIM_OK);
+    }
+    status = pimMul(obj1, obj2, obj2);
+    assert(status == PIM_OK);
+    if (mode != ChunkMode::SYNC_NO_READBACK) {
+      status = pimCopyDeviceToHost(obj2, (void*)dest[i].data());
+      assert(status == PIM_OK);
+    }
+    acc = obj2;
+    objs.push_back(obj1);
+    objs.push_back(obj2);
+  }
+  PimStatus status = pimSetStream(0);
+  assert(status == PIM_OK);
+  for (PimStreamId stream : streams) {
+    status = pimStreamSynchronize(stream);
+    assert(status == PIM_OK);
+    status = pimStreamDestroy(stream);
+    assert(status == PIM_OK);
+  }
+
+  runtimes = getCsvRuntimes(exportCsvStats("test-resource-timeline.csv"), "timeline");
+  for (PimObjId obj : objs) {
+    pimFree(obj);
+  }
+  bool ok = runtimes.count("serialized") && runtimes.count("overlapped") && runtimes["serialized"] > 0.0;
+  if (mode != ChunkMode::SYNC_NO_READBACK && !isDependent) {
+    ok = ok && dest[numChunks - 1][0] == 15;
+  }
+  return ok;
+}
+
+//! @brief  Run chunks and check whether the overlapped runtime is shorter than the serialized one
+bool checkChunks(const std::string& what, ChunkMode mode, bool isDependent, bool isOverlapExpected)
+{
+  std::map<std::string, double> runtimes;
+  bool ok = runChunks(mode, isDependent, runtimes);
+  bool isOverlapped = runtimes["overlapped"] < runtimes["serialized"] * (1.0 - 1e-9);
+  std::cout << what << ": serialized " << runtimes["serialized"] << " ms, overlapped " << runtimes["overlapped"] << " ms" << std::endl;
+  return ok && isOverlapped == isOverlapExpected && runtimes["overlapped"] <= runtimes["serialized"] * (1.0 + 1e-9);
+}
+
+//! @brief  Check that copies of the same bytes to the same ranks take the same time, whether split per rank or not
+bool checkSplitTransfer()
+{
+  // two ranks with one core each, so an object of 256 elements fits one rank and one of 512 elements spans both
+  PimStatus status = pimCreateDevice(PIM_DEVICE_BITSIMD_V, 2, 1, 2, 1024, 256);
+  assert(status == PIM_OK);
+  std::vector<int> src(512, 7);
+  PimObjId objA = pimAlloc(PIM_ALLOC_AUTO, 256, PIM_INT32);
+  PimObjId objB = pimAlloc(PIM_ALLOC_AUTO, 256, PIM_INT32);
+  assert(objA != -1 && objB != -1);
+  pimResetStats();
+  status = pimCopyHostToDevice((void*)src.data(), objA);
+  assert(status == PIM_OK);
+  status = pimCopyHostToDevice((void*)src.data(), objB);
+  assert(status == PIM_OK);
+  std::map<std::string, double> split = getCsvRuntimes(exportCsvStats("test-resource-timeline.csv"), "timeline");
+  pimFree(objA);
+  pimFree(objB);
+
+  PimObjId objAB = pimAlloc(PIM_ALLOC_AUTO, 512, PIM_INT32);
+  assert(objAB != -1);
+  pimResetStats();
+  status = pimCopyHostToDevice((void*)src.data(), objAB);
+  assert(status == PIM_OK);
+  std::map<std::string, double> combined = getCsvRuntimes(exportCsvStats("test-resource-timeline.csv"), "timeline");
+  pimFree(objAB);
+  pimDeleteDevice();
+
+  std::cout << "Copies split per rank: overlapped " << split["overlapped"] << " ms; one copy over both ranks: overlapped "
+            << combined["overlapped"] << " ms" << std::endl;
+  return combined["overlapped"] > 0.0 && std::abs(split["overlapped"] - combined["overlapped"]) <= combined["overlapped"] * 1e-9;
+}
+
+int main()
+{
+  std::cout << "PIM test: Rank and core resource timeline" << std::endl;
+
+  PimStatus status = pimCreateDevice(PIM_DEVICE_BITSIMD_V, 4, 2, 2, 1024, 256);
+  assert(status == PIM_OK);
+
+  bool ok = true;
+  // independent chunks on different cores and ranks overlap, unless the host waits for results of each chunk
+  ok = checkChunks("Independent chunks on streams", ChunkMode::STREAMS, false, true) && ok;
+  ok = checkChunks("Independent synchronous chunks without readback", ChunkMode::SYNC_NO_READBACK, false, true) && ok;
+  ok = checkChunks("Independent synchronous chunks with readback", ChunkMode::SYNC, false, false) && ok;
+  // a chain of dependent chunks does not overlap
+  ok = checkChunks("Dependent chunks on streams", ChunkMode::STREAMS, true, false) && ok;
+
+  pimShowStats();
+  pimDeleteDevice();
+
+  // each rank transfers its own bytes, so splitting a copy by rank does not speed it up
+  ok = checkSplitTransfer() && ok;
+  std::cout << (ok ? "Passed!" : "Failed!") << std::endl;
+  return ok ? 0 : 1;
+}
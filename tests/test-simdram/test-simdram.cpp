@@ -4,9 +4,13 @@
 // See the LICENSE file in the root of this repository for more details.
 
 #include "libpimeval.h"
+#include "../util.h"
 #include <iostream>
 #include <vector>
+#include <string>
+#include <map>
 #include <cassert>
+#include <cstdio>
 
 
 bool createPimDevice()
@@ -157,6 +161,64 @@ bool testMicroOps()
   return true;
 }
 
+bool testPerfModel()
+{
+  unsigned numElements = 1000;
+  std::vector<PimDataType> dataTypes = { PIM_INT8, PIM_INT16, PIM_INT32 };
+  std::vector<std::string> typeNames = { "int8", "int16", "int32" };
+
+  pimResetStats();
+  for (PimDataType dataType : dataTypes) {
+    PimObjId obj1 = pimAlloc(PIM_ALLOC_V1, numElements, dataType);
+    assert(obj1 != -1);
+    PimObjId obj2 = pimAllocAssociated(obj1, dataType);
+    assert(obj2 != -1);
+    PimStatus status = pimBroadcastInt(obj1, 3);
+    assert(status == PIM_OK);
+    status = pimBroadcastInt(obj2, 5);
+    assert(status == PIM_OK);
+    status = pimAdd(obj1, obj2, obj2);
+    assert(status == PIM_OK);
+    status = pimMul(obj1, obj2, obj2);
+    assert(status == PIM_OK);
+    status = pimRotateElementsRight(obj2);
+    assert(status == PIM_OK);
+    int64_t sum = 0;
+    status = pimRedSumInt(obj2, &sum);
+    assert(status == PIM_OK);
+    if (sum != 24 * static_cast<int64_t>(numElements)) {
+      std::cout << "Incorrect reduction sum " << sum << std::endl;
+      return false;
+    }
+    pimFree(obj2);
+    pimFree(obj1);
+  }
+
+  std::map<std::string, double> runtimes = getCsvRuntimes(exportCsvStats("test-simdram.csv"), "command");
+
+  // Costs must be non-zero, and grow with bit width. Multiplication costs more than addition.
+  for (std::string cmd : { "broadcast", "add", "mul", "rotate_elem_r", "redsum" }) {
+    double prevMs = 0.0;
+    for (const std::string& typeName : typeNames) {
+      std::string name = cmd + "." + typeName + ".v";
+      auto it = runtimes.find(name);
+      if (it == runtimes.end() || it->second <= prevMs || it->second >= 1000000) {
+        std::cout << "Unexpected runtime of " << name << std::endl;
+        return false;
+      }
+      prevMs = it->second;
+    }
+  }
+  for (const std::string& typeName : typeNames) {
+    if (runtimes["mul." + typeName + ".v"] <= runtimes["add." + typeName + ".v"]) {
+      std::cout << "Unexpected runtime of mul." << typeName << ".v" << std::endl;
+      return false;
+    }
+  }
+  std::cout << "Perf model OK." << std::endl;
+  return true;
+}
+
 int main()
 {
   std::cout << "PIM test: SIMDRAM micro-ops" << std::endl;
@@ -173,6 +235,12 @@ int main()
     return 1;
   }
 
+  ok = testPerfModel();
+  if (!ok) {
+    std::cout << "Test failed!" << std::endl;
+    return 1;
+  }
+
   pimShowStats();
   std::cout << "All correct!" << std::endl;
   return 0;
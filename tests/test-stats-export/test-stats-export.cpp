@@ -0,0 +1,161 @@
+// Test: Test machine-readable stats export
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "libpimeval.h"
+#include "../util.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <cassert>
+#include <cstdlib>
+#include <cmath>
+
+
+//! @brief  Read a whole file, or return an empty string if it does not exist
+std::string readFile(const std::string& fileName)
+{
+  std::ifstream file(fileName);
+  std::stringstream content;
+  content << file.rdbuf();
+  return content.str();
+}
+
+//! @brief  Check that components and other add up to totals of each command row in a CSV file
+bool checkCsvComponents(const std::string& content)
+{
+  std::stringstream ss(content);
+  std::string line;
+  std::getline(ss, line);
+  csvStatsRow header = splitCsv(line);
+  if (header.size() != 16 || header[5] != "ms_runtime" || header[10] != "mj_energy") {
+    std::cout << "Error: Unexpected CSV header " << line << std::endl;
+    return false;
+  }
+  int numCmdRows = 0;
+  while (std::getline(ss, line)) {
+    csvStatsRow fields = splitCsv(line);
+    if (fields.size() != header.size()) {
+      std::cout << "Error: Unexpected number of CSV fields in " << line << std::endl;
+      return false;
+    }
+    if (fields[1] != "command" || fields[2].find('"') != std::string::npos) {
+      continue;
+    }
+    ++numCmdRows;
+    double msTotal = std::stod(fields[5]);
+    double msSum = std::stod(fields[6]) + std::stod(fields[7]) + std::stod(fields[8]) + std::stod(fields[9]);
+    double mjTotal = std::stod(fields[10]);
+    double mjSum = std::stod(fields[11]) + std::stod(fields[12]) + std::stod(fields[13]) + std::stod(fields[14]) + std::stod(fields[15]);
+    if (std::abs(msTotal - msSum) > 1e-9 * std::abs(msTotal) + 1e-15 || std::abs(mjTotal - mjSum) > 1e-9 * std::abs(mjTotal) + 1e-15) {
+      std::cout << "Error: Components do not add up in " << line << std::endl;
+      return false;
+    }
+  }
+  return numCmdRows > 0;
+}
+
+bool testStatsExport(PimDeviceEnum deviceType)
+{
+  unsigned numRanks = 1;
+  unsigned numBankPerRank = 2;
+  unsigned numSubarrayPerBank = 4;
+  unsigned numRows = 1024;
+  unsigned numCols = 1024;
+  uint64_t numElements = 10000;
+  std::vector<int> src(numElements, 3);
+  std::vector<int> dest(numElements);
+  bool ok = true;
+
+  PimStatus status = pimCreateDevice(deviceType, numRanks, numBankPerRank, numSubarrayPerBank, numRows, numCols);
+  assert(status == PIM_OK);
+  PimObjId obj1 = pimAlloc(PIM_ALLOC_AUTO, numElements, PIM_INT32);
+  PimObjId obj2 = pimAllocAssociated(obj1, PIM_INT32);
+  assert(obj1 != -1 && obj2 != -1);
+  status = pimCopyHostToDevice((void*)src.data(), obj1);
+  assert(status == PIM_OK);
+  status = pimAdd(obj1, obj1, obj2);
+  assert(status == PIM_OK);
+  status = pimBeginPhase("mul\tscalar");
+  assert(status == PIM_OK);
+  status = pimMulScalar(obj2, obj2, 5);
+  assert(status == PIM_OK);
+  status = pimEndPhase();
+  assert(status == PIM_OK);
+  status = pimCopyDeviceToHost(obj2, (void*)dest.data());
+  assert(status == PIM_OK);
+
+  // on-demand export
+  status = pimExportStats("test-stats-export.json", PIM_STATS_JSON);
+  assert(status == PIM_OK);
+  std::string json = readFile("test-stats-export.json");
+  std::remove("test-stats-export.json");
+  for (const char* key : {"\"simulator\"", "\"ms_wall_clock\"", "\"params\"", "\"sim_target\"", "\"add.int32.",
+                          "\"mj_background\"", "\"host_to_device\": {\"bytes\": 40000", "\"total\"",
+                          "\"mul\\u0009scalar\""}) {
+    if (json.find(key) == std::string::npos) {
+      std::cout << "Error: Missing " << key << " in JSON stats" << std::endl;
+      ok = false;
+    }
+  }
+  if (json.find('\t') != std::string::npos) {
+    std::cout << "Error: Unescaped control character in JSON stats" << std::endl;
+    ok = false;
+  }
+  for (const char* key : {": inf", ": -inf", ": nan", ": -nan"}) {
+    if (json.find(key) != std::string::npos) {
+      std::cout << "Error: Non-finite number in JSON stats" << std::endl;
+      ok = false;
+    }
+  }
+  status = pimExportStats("test-stats-export.csv", PIM_STATS_CSV);
+  assert(status == PIM_OK);
+  if (!checkCsvComponents(readFile("test-stats-export.csv"))) {
+    std::cout << "Error: Invalid CSV stats" << std::endl;
+    ok = false;
+  }
+  status = pimExportStats(nullptr, PIM_STATS_JSON);
+  assert(status == PIM_ERROR);
+
+  // reset clears copy bytes, runtime and energy together
+  pimResetStats();
+  status = pimCopyHostToDevice((void*)src.data(), obj1);
+  assert(status == PIM_OK);
+  std::vector<csvStatsRow> rows = exportCsvStats("test-stats-export.csv");
+  double msCopy = getCsvRuntimes(rows, "copy")["host_to_device"];
+  double msSerialized = getCsvRuntimes(rows, "timeline")["serialized"];
+  if (msCopy <= 0.0 || std::abs(msCopy - msSerialized) > 1e-9 * msSerialized) {
+    std::cout << "Error: Copy runtime " << msCopy << " ms after reset differs from timeline " << msSerialized << " ms" << std::endl;
+    ok = false;
+  }
+
+  // multi-device aggregate, and export at device deletion
+  PimDeviceId device1 = pimAddDevice(deviceType, numRanks, numBankPerRank, numSubarrayPerBank, numRows, numCols);
+  assert(device1 == 1);
+  setenv("PIMEVAL_STATS_OUTPUT", "test-stats-export-env.json", 1);
+  pimDeleteDevice();
+  unsetenv("PIMEVAL_STATS_OUTPUT");
+  json = readFile("test-stats-export-env.json");
+  if (json.find("\"multi_device\"") == std::string::npos || json.find("\"num_devices\": 2") == std::string::npos) {
+    std::cout << "Error: Stats are not exported at device deletion" << std::endl;
+    ok = false;
+  }
+  std::remove("test-stats-export-env.json");
+  return ok;
+}
+
+int main()
+{
+  std::cout << "PIM Regression Test: Machine-readable stats export" << std::endl;
+
+  bool ok = true;
+  ok &= testStatsExport(PIM_DEVICE_BITSIMD_V);
+  ok &= testStatsExport(PIM_DEVICE_FULCRUM);
+  ok &= testStatsExport(PIM_DEVICE_BANK_LEVEL);
+
+  std::cout << (ok ? "Passed!" : "Failed!") << std::endl;
+  return 0;
+}
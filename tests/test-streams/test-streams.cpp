@@ -0,0 +1,177 @@
+// Test: Asynchronous command streams
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "libpimeval.h"
+#include "../util.h"
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <map>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <unistd.h>
+#include <sys/wait.h>
+
+
+//! @brief  Run a workload on two streams and check results. Export stats before deleting the device
+bool runWorkload(const char* statsFileName)
+{
+  PimStatus status = pimCreateDevice(PIM_DEVICE_BITSIMD_V, 1, 4, 4, 1024, 256);
+  assert(status == PIM_OK);
+  bool ok = true;
+  unsigned numElements = 4000;
+  std::vector<int> src1(numElements);
+  std::vector<int> src2(numElements);
+  for (unsigned i = 0; i < numElements; ++i) {
+    src1[i] = static_cast<int>(i);
+    src2[i] = 3 - static_cast<int>(i) * 2;
+  }
+  std::vector<int> dest1(numElements);
+  std::vector<int> dest2(numElements);
+  PimObjId obj1 = pimAlloc(PIM_ALLOC_AUTO, numElements, PIM_INT32);
+  assert(obj1 != -1);
+  PimObjId obj2 = pimAllocAssociated(obj1, PIM_INT32);
+  assert(obj2 != -1);
+  PimObjId obj3 = pimAllocAssociated(obj1, PIM_INT32);
+  assert(obj3 != -1);
+  PimObjId objOther = pimAlloc(PIM_ALLOC_AUTO, numElements / 2, PIM_INT32);
+  assert(objOther != -1);
+
+  PimStreamId stream1 = pimStreamCreate();
+  PimStreamId stream2 = pimStreamCreate();
+  assert(stream1 > 0 && stream2 > 0 && stream1 != stream2);
+
+  // commands of different streams execute in submission order, so stream 2 sees the copy of stream 1
+  status = pimSetStream(stream1);
+  assert(status == PIM_OK);
+  status = pimCopyHostToDevice((void*)src1.data(), obj1);
+  ok = ok && status == PIM_OK;
+  status = pimSetStream(stream2);
+  assert(status == PIM_OK);
+  status = pimCopyHostToDevice((void*)src2.data(), obj2);
+  ok = ok && status == PIM_OK;
+  status = pimAdd(obj1, obj2, obj3);
+  ok = ok && status == PIM_OK;
+  status = pimCopyDeviceToHost(obj3, (void*)dest2.data());
+  ok = ok && status == PIM_OK;
+
+  // an invalid command fails when enqueued, and does not fail the stream later
+  status = pimAdd(obj1, objOther, obj3);
+  ok = ok && status == PIM_ERROR;
+
+  // an event completes after prior commands of its stream, and is released after the wait
+  status = pimSetStream(stream1);
+  assert(status == PIM_OK);
+  status = pimMulScalar(obj1, obj1, 3);
+  ok = ok && status == PIM_OK;
+  status = pimCopyDeviceToHost(obj1, (void*)dest1.data());
+  ok = ok && status == PIM_OK;
+  PimEventId event = pimEventRecord(stream1);
+  ok = ok && event >= 0;
+  status = pimEventWait(event);
+  ok = ok && status == PIM_OK;
+  for (unsigned i = 0; i < numElements; ++i) {
+    ok = ok && dest1[i] == src1[i] * 3;
+  }
+  status = pimEventWait(event);
+  ok = ok && status == PIM_ERROR;
+
+  // synchronize makes results of a stream available
+  status = pimStreamSynchronize(stream2);
+  ok = ok && status == PIM_OK;
+  for (unsigned i = 0; i < numElements; ++i) {
+    ok = ok && dest2[i] == src1[i] + src2[i];
+  }
+
+  // synchronous commands on stream 0 wait for pending commands on the same objects
+  status = pimSetStream(stream2);
+  assert(status == PIM_OK);
+  status = pimAddScalar(obj3, obj3, 10);
+  ok = ok && status == PIM_OK;
+  status = pimSetStream(0);
+  assert(status == PIM_OK);
+  int64_t sum = 0;
+  status = pimRedSumInt(obj3, &sum);
+  ok = ok && status == PIM_OK;
+  int64_t sumExpected = 0;
+  for (unsigned i = 0; i < numElements; ++i) {
+    sumExpected += src1[i] + src2[i] + 10;
+  }
+  ok = ok && sum == sumExpected;
+
+  // events of a destroyed stream are released
+  event = pimEventRecord(stream2);
+  ok = ok && event >= 0;
+  status = pimStreamDestroy(stream2);
+  ok = ok && status == PIM_OK;
+  status = pimEventWait(event);
+  ok = ok && status == PIM_ERROR;
+  status = pimStreamDestroy(stream1);
+  ok = ok && status == PIM_OK;
+
+  pimFree(obj1);
+  pimFree(obj2);
+  pimFree(obj3);
+  pimFree(objOther);
+  status = pimExportStats(statsFileName, PIM_STATS_CSV);
+  assert(status == PIM_OK);
+  pimDeleteDevice();
+  return ok;
+}
+
+int main()
+{
+  std::cout << "PIM test: Asynchronous command streams" << std::endl;
+
+  // only the default context records traces, and the trace is closed at exit, so record in a child process
+  std::fflush(stdout);
+  pid_t pid = fork();
+  assert(pid >= 0);
+  if (pid == 0) {
+    setenv("PIMEVAL_TRACE_FILE", "test-streams.trace", 1);
+    setenv("PIMEVAL_TRACE_PAYLOAD", "1", 1);
+    std::exit(runWorkload("test-streams-recorded.csv") ? 0 : 1);
+  }
+  int childStatus = 0;
+  waitpid(pid, &childStatus, 0);
+  bool ok = WIFEXITED(childStatus) && WEXITSTATUS(childStatus) == 0;
+  std::map<std::string, csvStatsRow> statsRecorded =
+      getCsvSections(readCsvStats("test-streams-recorded.csv"), {"command", "copy"});
+  std::remove("test-streams-recorded.csv");
+  ok = ok && !statsRecorded.empty();
+
+  // replay the streamed trace without its final device deletion, and compare command stats
+  std::ifstream traceFile("test-streams.trace", std::ios::binary);
+  std::vector<char> trace((std::istreambuf_iterator<char>(traceFile)), std::istreambuf_iterator<char>());
+  traceFile.close();
+  std::remove("test-streams.trace");
+  if (trace.size() <= 15 || trace.back() != 0 || trace[trace.size() - 3] != 3) {  // DELETE_DEVICE, 0 args, 0 bytes
+    std::cout << "Error: Unexpected end of recorded trace" << std::endl;
+    std::cout << "Failed!" << std::endl;
+    return 1;
+  }
+  {
+    std::ofstream file("test-streams-keep.trace", std::ios::binary);
+    file.write(trace.data(), trace.size() - 3);
+  }
+  PimStatus status = pimReplayTrace("test-streams-keep.trace", PIM_DEVICE_NONE, nullptr);
+  std::remove("test-streams-keep.trace");
+  ok = ok && status == PIM_OK;
+  if (status == PIM_OK) {
+    std::map<std::string, csvStatsRow> statsReplayed =
+        getCsvSections(exportCsvStats("test-streams.csv"), {"command", "copy"});
+    if (statsReplayed != statsRecorded) {
+      std::cout << "Error: Command stats of replay differ from the recorded run" << std::endl;
+      ok = false;
+    }
+    pimDeleteDevice();
+  }
+
+  std::cout << (ok ? "Passed!" : "Failed!") << std::endl;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,298 @@
+// Test: Chrome trace command timeline
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "libpimeval.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <map>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cctype>
+#include <unistd.h>
+#include <sys/wait.h>
+
+
+//! @brief  A parsed JSON value. Only the parts needed by the test are kept
+struct jsonValue {
+  char m_type = 'n';  // 'n'ull, 'b'ool, 'd'ouble, 's'tring, 'a'rray, 'o'bject
+  double m_num = 0.0;
+  std::string m_str;
+  std::vector<jsonValue> m_arr;
+  std::map<std::string, jsonValue> m_obj;
+};
+
+//! @brief  Minimal strict JSON parser
+class jsonParser
+{
+public:
+  jsonParser(const std::string& text) : m_text(text) {}
+
+  bool parse(jsonValue& val)
+  {
+    return parseValue(val) && (skipSpace(), m_pos == m_text.size());
+  }
+
+private:
+  void skipSpace()
+  {
+    while (m_pos < m_text.size() && std::isspace(static_cast<unsigned char>(m_text[m_pos]))) {
+      ++m_pos;
+    }
+  }
+
+  bool expect(char c)
+  {
+    skipSpace();
+    if (m_pos < m_text.size() && m_text[m_pos] == c) {
+      ++m_pos;
+      return true;
+    }
+    return false;
+  }
+
+  bool parseString(std::string& str)
+  {
+    if (!expect('"')) {
+      return false;
+    }
+    while (m_pos < m_text.size() && m_text[m_pos] != '"') {
+      char c = m_text[m_pos++];
+      if (static_cast<unsigned char>(c) < 0x20) {
+        return false;
+      }
+      if (c == '\\') {
+        if (m_pos >= m_text.size()) {
+          return false;
+        }
+        char esc = m_text[m_pos++];
+        if (esc == 'u') {
+          if (m_pos + 4 > m_text.size()) {
+            return false;
+          }
+          c = static_cast<char>(std::stoi(m_text.substr(m_pos, 4), nullptr, 16));
+          m_pos += 4;
+        } else if (esc == '"' || esc == '\\' || esc == '/') {
+          c = esc;
+        } else if (esc == 'n' || esc == 't' || esc == 'r' || esc == 'b' || esc == 'f') {
+          c = ' ';
+        } else {
+          return false;
+        }
+      }
+      str += c;
+    }
+    return expect('"');
+  }
+
+  bool parseValue(jsonValue& val)
+  {
+    skipSpace();
+    if (m_pos >= m_text.size()) {
+      return false;
+    }
+    char c = m_text[m_pos];
+    if (c == '"') {
+      val.m_type = 's';
+      return parseString(val.m_str);
+    }
+    if (c == '[') {
+      val.m_type = 'a';
+      ++m_pos;
+      if (expect(']')) {
+        return true;
+      }
+      do {
+        val.m_arr.emplace_back();
+        if (!parseValue(val.m_arr.back())) {
+          return false;
+        }
+      } while (expect(','));
+      return expect(']');
+    }
+    if (c == '{') {
+      val.m_type = 'o';
+      ++m_pos;
+      if (expect('}')) {
+        return true;
+      }
+      do {
+        std::string key;
+        if (!parseString(key) || !expect(':') || !parseValue(val.m_obj[key])) {
+          return false;
+        }
+      } while (expect(','));
+      return expect('}');
+    }
+    for (const char* literal : {"null", "true", "false"}) {
+      if (m_text.compare(m_pos, std::string(literal).size(), literal) == 0) {
+        val.m_type = (literal[0] == 'n' ? 'n' : 'b');
+        m_pos += std::string(literal).size();
+        return true;
+      }
+    }
+    size_t end = m_text.find_first_not_of("-+.0123456789eE", m_pos);
+    if (end == m_pos) {
+      return false;
+    }
+    val.m_type = 'd';
+    val.m_num = std::stod(m_text.substr(m_pos, end - m_pos));
+    m_pos = end;
+    return true;
+  }
+
+  const std::string& m_text;
+  size_t m_pos = 0;
+};
+
+//! @brief  Check if two events of [begin, end) in microseconds overlap, beyond rounding of printed timestamps
+bool isOverlapped(const std::pair<double, double>& a, const std::pair<double, double>& b)
+{
+  const double usTolerance = 1e-6;
+  return a.first + usTolerance < b.second && b.first + usTolerance < a.second;
+}
+
+//! @brief  Run copies and computation of two independent chunks on separate streams
+bool recordWorkload()
+{
+  setenv("PIMEVAL_TIMELINE_FILE", "test-timeline.json", 1);
+  PimStatus status = pimCreateDevice(PIM_DEVICE_BITSIMD_V, 4, 2, 2, 1024, 256);
+  assert(status == PIM_OK);
+  unsigned numElements = 256;
+  std::vector<int> src(numElements, 3);
+  std::vector<int> destA(numElements);
+  std::vector<int> destB(numElements);
+
+  PimObjId objA1 = pimAlloc(PIM_ALLOC_AUTO, numElements, PIM_INT32);
+  PimObjId objA2 = pimAllocAssociated(objA1, PIM_INT32);
+  PimObjId objB1 = pimAlloc(PIM_ALLOC_AUTO, numElements, PIM_INT32);
+  PimObjId objB2 = pimAllocAssociated(objB1, PIM_INT32);
+  assert(objA1 != -1 && objA2 != -1 && objB1 != -1 && objB2 != -1);
+  PimStreamId streamA = pimStreamCreate();
+  PimStreamId streamB = pimStreamCreate();
+  assert(streamA > 0 && streamB > 0);
+
+  // issue each step for both chunks before the next step, so that steps of the two chunks interleave
+  const std::vector<std::pair<PimStreamId, std::vector<PimObjId>>> chunks = {
+    {streamA, {objA1, objA2}},
+    {streamB, {objB1, objB2}},
+  };
+  for (unsigned step = 0; step < 3; ++step) {
+    for (const auto& [stream, objs] : chunks) {
+      status = pimSetStream(stream);
+      assert(status == PIM_OK);
+      if (step == 0) {
+        status = pimCopyHostToDevice((void*)src.data(), objs[0]);
+        assert(status == PIM_OK);
+        status = pimCopyHostToDevice((void*)src.data(), objs[1]);
+      } else if (step == 1) {
+        status = pimMul(objs[0], objs[1], objs[1]);
+      } else {
+        status = pimCopyDeviceToHost(objs[1], (void*)(stream == streamA ? destA.data() : destB.data()));
+      }
+      assert(status == PIM_OK);
+    }
+  }
+  status = pimSetStream(0);
+  assert(status == PIM_OK);
+  bool ok = pimStreamSynchronize(streamA) == PIM_OK && pimStreamSynchronize(streamB) == PIM_OK;
+  ok = ok && destA[0] == 9 && destB[numElements - 1] == 9;
+  pimStreamDestroy(streamA);
+  pimStreamDestroy(streamB);
+  pimDeleteDevice();
+  return ok;
+}
+
+int main()
+{
+  std::cout << "PIM test: Chrome trace command timeline" << std::endl;
+
+  // only the default context records timelines, and the file is closed at exit, so record in a child process
+  std::fflush(stdout);
+  pid_t pid = fork();
+  assert(pid >= 0);
+  if (pid == 0) {
+    std::exit(recordWorkload() ? 0 : 1);
+  }
+  int childStatus = 0;
+  waitpid(pid, &childStatus, 0);
+  bool ok = WIFEXITED(childStatus) && WEXITSTATUS(childStatus) == 0;
+
+  std::ifstream file("test-timeline.json");
+  std::stringstream content;
+  content << file.rdbuf();
+  file.close();
+  std::remove("test-timeline.json");
+  std::string text = content.str();
+  jsonValue root;
+  if (!jsonParser(text).parse(root) || root.m_type != 'a') {
+    std::cout << "Error: Timeline is not a valid JSON array" << std::endl;
+    std::cout << "Failed!" << std::endl;
+    return 1;
+  }
+
+  // modeled events on device tracks (even tids from 2) and host transfer tracks (odd tids from 3), as [begin, end)
+  // in microseconds, and modeled events of each track
+  std::vector<std::pair<double, double>> deviceEvents;
+  std::vector<std::pair<double, double>> transferEvents;
+  std::map<int, std::vector<std::pair<double, double>>> trackEvents;
+  unsigned numWallEvents = 0;
+  for (const jsonValue& event : root.m_arr) {
+    auto ph = event.m_obj.find("ph");
+    if (event.m_type != 'o' || ph == event.m_obj.end() || ph->second.m_str != "X") {
+      continue;
+    }
+    const jsonValue& cat = event.m_obj.at("cat");
+    double ts = event.m_obj.at("ts").m_num;
+    double dur = event.m_obj.at("dur").m_num;
+    int tid = static_cast<int>(event.m_obj.at("tid").m_num);
+    if (ts < 0.0 || dur < 0.0) {
+      std::cout << "Error: Negative timestamp of " << event.m_obj.at("name").m_str << std::endl;
+      ok = false;
+    }
+    if (cat.m_str == "wall") {
+      ++numWallEvents;
+      continue;
+    }
+    if (tid >= 2) {
+      (tid % 2 == 0 ? deviceEvents : transferEvents).push_back({ts, ts + dur});
+      trackEvents[tid].push_back({ts, ts + dur});
+    }
+  }
+  std::cout << "Modeled events: " << deviceEvents.size() << " device, " << transferEvents.size()
+            << " host transfer; wall events: " << numWallEvents << std::endl;
+  ok = ok && deviceEvents.size() == 2 && transferEvents.size() == 6 && numWallEvents == 8;
+
+  // the two tracks share the resource timeline, so a copy of one chunk overlaps computation of the other
+  bool hasOverlap = false;
+  for (const auto& device : deviceEvents) {
+    for (const auto& transfer : transferEvents) {
+      hasOverlap |= isOverlapped(transfer, device);
+    }
+  }
+  std::cout << "Host transfer overlaps device computation: " << (hasOverlap ? "yes" : "no") << std::endl;
+  ok = ok && hasOverlap;
+
+  // concurrent commands are on different tracks, so that no events of a track overlap
+  bool isTrackOverlapped = false;
+  for (const auto& [tid, events] : trackEvents) {
+    for (size_t i = 0; i < events.size(); ++i) {
+      for (size_t j = i + 1; j < events.size(); ++j) {
+        isTrackOverlapped |= isOverlapped(events[i], events[j]);
+      }
+    }
+  }
+  bool isDeviceOverlapped = deviceEvents.size() == 2 && isOverlapped(deviceEvents[0], deviceEvents[1]);
+  std::cout << "Modeled tracks: " << trackEvents.size() << ", computation of the chunks overlaps: "
+            << (isDeviceOverlapped ? "yes" : "no") << ", events overlap within a track: "
+            << (isTrackOverlapped ? "yes" : "no") << std::endl;
+  ok = ok && isDeviceOverlapped && !isTrackOverlapped;
+
+  std::cout << (ok ? "Passed!" : "Failed!") << std::endl;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,135 @@
+// Test: Command trace record and replay
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "libpimeval.h"
+#include "../util.h"
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <map>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <unistd.h>
+#include <sys/wait.h>
+
+
+//! @brief  Run a workload with command trace recording, and export its stats before deleting the device
+bool recordWorkload()
+{
+  setenv("PIMEVAL_TRACE_FILE", "test-trace-replay.trace", 1);
+  setenv("PIMEVAL_TRACE_PAYLOAD", "1", 1);
+  PimStatus status = pimCreateDevice(PIM_DEVICE_BITSIMD_V, 2, 2, 2, 1024, 256);
+  assert(status == PIM_OK);
+  unsigned numElements = 3000;
+  std::vector<int> src1(numElements);
+  std::vector<int> src2(numElements);
+  for (unsigned i = 0; i < numElements; ++i) {
+    src1[i] = i;
+    src2[i] = 7 - static_cast<int>(i);
+  }
+  std::vector<int> dest(numElements);
+  PimObjId obj1 = pimAlloc(PIM_ALLOC_AUTO, numElements, PIM_INT32);
+  assert(obj1 != -1);
+  PimObjId obj2 = pimAllocAssociated(obj1, PIM_INT32);
+  assert(obj2 != -1);
+  PimObjId obj3 = pimAllocAssociated(obj1, PIM_INT32);
+  assert(obj3 != -1);
+  status = pimCopyHostToDevice((void*)src1.data(), obj1);
+  assert(status == PIM_OK);
+  status = pimCopyHostToDevice((void*)src2.data(), obj2);
+  assert(status == PIM_OK);
+  status = pimAdd(obj1, obj2, obj3);
+  assert(status == PIM_OK);
+  status = pimMulScalar(obj3, obj3, 5);
+  assert(status == PIM_OK);
+  status = pimBroadcastInt(obj2, 9);
+  assert(status == PIM_OK);
+  int64_t sum = 0;
+  status = pimRedSumInt(obj3, &sum);
+  assert(status == PIM_OK);
+  status = pimCopyDeviceToHost(obj3, (void*)dest.data(), 10, 2010);
+  assert(status == PIM_OK);
+  pimFree(obj2);
+  status = pimExportStats("test-trace-replay-recorded.csv", PIM_STATS_CSV);
+  assert(status == PIM_OK);
+  pimDeleteDevice();
+  return sum == 5 * 7 * static_cast<int64_t>(numElements) && dest[0] == 5 * 7;
+}
+
+//! @brief  Write raw bytes to a file
+void writeFile(const std::string& fileName, const std::vector<char>& bytes)
+{
+  std::ofstream file(fileName, std::ios::binary);
+  file.write(bytes.data(), bytes.size());
+}
+
+int main()
+{
+  std::cout << "PIM test: Command trace record and replay" << std::endl;
+
+  // only the default context records traces, and the trace is closed at exit, so record in a child process
+  std::fflush(stdout);
+  pid_t pid = fork();
+  assert(pid >= 0);
+  if (pid == 0) {
+    std::exit(recordWorkload() ? 0 : 1);
+  }
+  int childStatus = 0;
+  waitpid(pid, &childStatus, 0);
+  bool ok = WIFEXITED(childStatus) && WEXITSTATUS(childStatus) == 0;
+  std::map<std::string, csvStatsRow> statsRecorded =
+      getCsvSections(readCsvStats("test-trace-replay-recorded.csv"), {"command", "copy", "total"});
+  std::remove("test-trace-replay-recorded.csv");
+  ok = ok && !statsRecorded.empty();
+
+  // replay the trace without its final device deletion, and compare modeled stats
+  std::ifstream traceFile("test-trace-replay.trace", std::ios::binary);
+  std::vector<char> trace((std::istreambuf_iterator<char>(traceFile)), std::istreambuf_iterator<char>());
+  traceFile.close();
+  if (trace.size() <= 15 || trace.back() != 0 || trace[trace.size() - 3] != 3) {  // DELETE_DEVICE, 0 args, 0 bytes
+    std::cout << "Error: Unexpected end of recorded trace" << std::endl;
+    std::cout << "Failed!" << std::endl;
+    return 1;
+  }
+  std::vector<char> traceKeepDevice(trace.begin(), trace.end() - 3);
+  writeFile("test-trace-replay-keep.trace", traceKeepDevice);
+  PimStatus status = pimReplayTrace("test-trace-replay-keep.trace", PIM_DEVICE_NONE, nullptr);
+  ok = ok && status == PIM_OK;
+  if (status == PIM_OK) {
+    std::map<std::string, csvStatsRow> statsReplayed =
+        getCsvSections(exportCsvStats("test-trace-replay.csv"), {"command", "copy", "total"});
+    if (statsReplayed != statsRecorded) {
+      std::cout << "Error: Modeled stats of replay differ from the recorded run" << std::endl;
+      ok = false;
+    }
+    pimDeleteDevice();
+  }
+
+  // the complete trace replays with its device deletion
+  status = pimReplayTrace("test-trace-replay.trace", PIM_DEVICE_NONE, nullptr);
+  ok = ok && status == PIM_OK;
+
+  // a truncated trace and a trace with a huge payload length fail cleanly
+  std::vector<char> truncated(trace.begin(), trace.begin() + trace.size() / 2 + 7);  // cut within a copy record
+  writeFile("test-trace-replay-bad.trace", truncated);
+  status = pimReplayTrace("test-trace-replay-bad.trace", PIM_DEVICE_NONE, nullptr);
+  ok = ok && status == PIM_ERROR;
+  pimDeleteDevice();
+  std::vector<char> corrupted(trace.begin(), trace.begin() + 12);
+  std::vector<char> hugeRecord = {4, 0, '\xff', '\xff', '\xff', '\xff', '\xff', '\xff', '\xff', '\xff', 0x3f};  // SHOW_STATS
+  corrupted.insert(corrupted.end(), hugeRecord.begin(), hugeRecord.end());
+  writeFile("test-trace-replay-bad.trace", corrupted);
+  status = pimReplayTrace("test-trace-replay-bad.trace", PIM_DEVICE_NONE, nullptr);
+  ok = ok && status == PIM_ERROR;
+
+  std::remove("test-trace-replay.trace");
+  std::remove("test-trace-replay-keep.trace");
+  std::remove("test-trace-replay-bad.trace");
+  std::cout << (ok ? "Passed!" : "Failed!") << std::endl;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,108 @@
+// Test: Shared utilities of PIM tests
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#ifndef LAVA_PIM_TESTS_UTIL_H
+#define LAVA_PIM_TESTS_UTIL_H
+
+#include "libpimeval.h"
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdio>
+
+//! @brief  Fields of a row of CSV stats: device, section, name, count, value or bytes, ms_runtime, and so on
+typedef std::vector<std::string> csvStatsRow;
+
+//! @brief  Split a CSV line without quoted fields. A trailing comma ends the row with an empty field
+inline csvStatsRow splitCsv(const std::string& line)
+{
+  csvStatsRow fields;
+  std::stringstream ss(line);
+  std::string field;
+  while (std::getline(ss, field, ',')) {
+    fields.push_back(field);
+  }
+  if (!line.empty() && line.back() == ',') {
+    fields.push_back("");
+  }
+  return fields;
+}
+
+//! @brief  Read the rows of a CSV stats file after its header
+inline std::vector<csvStatsRow> readCsvStats(const std::string& fileName)
+{
+  std::vector<csvStatsRow> rows;
+  std::ifstream file(fileName);
+  std::string line;
+  std::getline(file, line);
+  while (std::getline(file, line)) {
+    rows.push_back(splitCsv(line));
+  }
+  return rows;
+}
+
+//! @brief  Export CSV stats of the current device to a file, and read them back and remove the file
+inline std::vector<csvStatsRow> exportCsvStats(const std::string& fileName)
+{
+  if (pimExportStats(fileName.c_str(), PIM_STATS_CSV) != PIM_OK) {
+    return {};
+  }
+  std::vector<csvStatsRow> rows = readCsvStats(fileName);
+  std::remove(fileName.c_str());
+  return rows;
+}
+
+//! @brief  Get the rows of a section, e.g., "param", "command", "copy" or "timeline", keyed by name
+inline std::map<std::string, csvStatsRow> getCsvSection(const std::vector<csvStatsRow>& rows, const std::string& section)
+{
+  std::map<std::string, csvStatsRow> sectionRows;
+  for (const csvStatsRow& fields : rows) {
+    if (fields.size() > 2 && fields[1] == section) {
+      sectionRows[fields[2]] = fields;
+    }
+  }
+  return sectionRows;
+}
+
+//! @brief  Get the rows of a few sections, keyed by section and name, e.g., "command,add.int32.v"
+inline std::map<std::string, csvStatsRow> getCsvSections(const std::vector<csvStatsRow>& rows,
+                                                         const std::vector<std::string>& sections)
+{
+  std::map<std::string, csvStatsRow> sectionRows;
+  for (const std::string& section : sections) {
+    for (const auto& [name, fields] : getCsvSection(rows, section)) {
+      sectionRows[section + "," + name] = fields;
+    }
+  }
+  return sectionRows;
+}
+
+//! @brief  Get the values of device params, keyed by name
+inline std::map<std::string, std::string> getCsvParams(const std::vector<csvStatsRow>& rows)
+{
+  std::map<std::string, std::string> params;
+  for (const auto& [name, fields] : getCsvSection(rows, "param")) {
+    if (fields.size() > 4) {
+      params[name] = fields[4];
+    }
+  }
+  return params;
+}
+
+//! @brief  Get the modeled runtime in ms of the rows of a section, keyed by name
+inline std::map<std::string, double> getCsvRuntimes(const std::vector<csvStatsRow>& rows, const std::string& section)
+{
+  std::map<std::string, double> runtimes;
+  for (const auto& [name, fields] : getCsvSection(rows, section)) {
+    if (fields.size() > 5 && !fields[5].empty()) {
+      runtimes[name] = std::stod(fields[5]);
+    }
+  }
+  return runtimes;
+}
+
+#endif
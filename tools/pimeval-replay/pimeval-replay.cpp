@@ -0,0 +1,69 @@
+// Tool: PIMeval command trace replay
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "libpimeval.h"
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <cstdlib>
+#include <cstdio>
+
+static const std::unordered_map<std::string, PimDeviceEnum> deviceTypeMap = {
+  {"PIM_FUNCTIONAL", PIM_FUNCTIONAL},
+  {"PIM_DEVICE_BITSIMD_V", PIM_DEVICE_BITSIMD_V},
+  {"PIM_DEVICE_BITSIMD_V_NAND", PIM_DEVICE_BITSIMD_V_NAND},
+  {"PIM_DEVICE_BITSIMD_V_MAJ", PIM_DEVICE_BITSIMD_V_MAJ},
+  {"PIM_DEVICE_BITSIMD_V_AP", PIM_DEVICE_BITSIMD_V_AP},
+  {"PIM_DEVICE_DRISA_NOR", PIM_DEVICE_DRISA_NOR},
+  {"PIM_DEVICE_DRISA_MIXED", PIM_DEVICE_DRISA_MIXED},
+  {"PIM_DEVICE_SIMDRAM", PIM_DEVICE_SIMDRAM},
+  {"PIM_DEVICE_BITSIMD_H", PIM_DEVICE_BITSIMD_H},
+  {"PIM_DEVICE_FULCRUM", PIM_DEVICE_FULCRUM},
+  {"PIM_DEVICE_BANK_LEVEL", PIM_DEVICE_BANK_LEVEL},
+};
+
+void usage()
+{
+  std::cout << "Usage: pimeval-replay <trace-file> [-d <PimDeviceEnum>] [-c <config-file>]\n"
+            << "  Replay a command trace recorded with environment variable PIMEVAL_TRACE_FILE.\n"
+            << "  -d : override the recorded device type, e.g., PIM_DEVICE_BITSIMD_V\n"
+            << "  -c : override the recorded device dimensions with a simulator config file\n";
+}
+
+int main(int argc, char* argv[])
+{
+  std::string traceFile;
+  std::string configFile;
+  PimDeviceEnum deviceType = PIM_DEVICE_NONE;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "-h" || arg == "--help") {
+      usage();
+      return 0;
+    } else if (arg == "-d" && i + 1 < argc) {
+      auto it = deviceTypeMap.find(argv[++i]);
+      if (it == deviceTypeMap.end()) {
+        std::cout << "Error: Unknown device type " << argv[i] << std::endl;
+        return 1;
+      }
+      deviceType = it->second;
+    } else if (arg == "-c" && i + 1 < argc) {
+      configFile = argv[++i];
+    } else if (traceFile.empty() && arg[0] != '-') {
+      traceFile = arg;
+    } else {
+      usage();
+      return 1;
+    }
+  }
+  if (traceFile.empty()) {
+    usage();
+    return 1;
+  }
+
+  PimStatus status = pimReplayTrace(traceFile.c_str(), deviceType, configFile.empty() ? nullptr : configFile.c_str());
+  return status == PIM_OK ? 0 : 1;
+}